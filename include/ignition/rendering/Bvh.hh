@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_RENDERING_BVH_HH_
+#define IGNITION_RENDERING_BVH_HH_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "ignition/rendering/config.hh"
+#include "ignition/rendering/Export.hh"
+#include "ignition/rendering/MeshDescriptor.hh"
+
+namespace ignition
+{
+  namespace rendering
+  {
+    inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declarations
+    class BvhPrivate;
+    class MeshBvhPrivate;
+
+    /// \class Bvh Bvh.hh ignition/rendering/Bvh.hh
+    /// \brief Bounding volume hierarchy over a set of axis aligned boxes.
+    /// It finds the closest primitive hit by a ray while only testing the
+    /// primitives whose box is crossed by the ray, closest first.
+    class IGNITION_RENDERING_VISIBLE Bvh
+    {
+      /// \brief Callback used to test a ray against a primitive.
+      /// The first argument is the index of the primitive. On hit, the
+      /// callback sets the second argument to the hit distance and returns
+      /// true.
+      public: using IntersectFunc = std::function<bool(unsigned int, double &)>;
+
+      /// \brief Constructor
+      public: Bvh();
+
+      /// \brief Destructor
+      public: ~Bvh();
+
+      /// \brief Build the hierarchy, replacing any previous one
+      /// \param[in] _boxes Bounding box of each primitive. The index of a box
+      /// in the vector is the index of the primitive.
+      public: void Build(const std::vector<math::AxisAlignedBox> &_boxes);
+
+      /// \brief Get the number of primitives in the hierarchy
+      /// \return Number of primitives
+      public: unsigned int PrimitiveCount() const;
+
+      /// \brief Find the closest primitive hit by a ray. Distances are
+      /// expressed in multiples of the length of _dir.
+      /// \param[in] _origin Ray origin
+      /// \param[in] _dir Ray direction
+      /// \param[in] _intersect Function that tests the ray against a
+      /// primitive
+      /// \param[out] _distance Distance to the closest hit
+      /// \param[out] _index Index of the closest primitive hit
+      /// \return True if a primitive was hit
+      public: bool Intersect(const math::Vector3d &_origin,
+                  const math::Vector3d &_dir,
+                  const IntersectFunc &_intersect,
+                  double &_distance, unsigned int &_index) const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<BvhPrivate> dataPtr;
+    };
+
+    /// \class MeshBvh Bvh.hh ignition/rendering/Bvh.hh
+    /// \brief Bounding volume hierarchy over the triangles of a mesh, used to
+    /// intersect rays with the mesh without testing every triangle. The
+    /// triangles are copied so the hierarchy can be kept after the mesh is
+    /// destroyed.
+    class IGNITION_RENDERING_VISIBLE MeshBvh
+    {
+      /// \brief Constructor
+      /// \param[in] _vertices Vertex positions
+      /// \param[in] _indices Vertex indices, three per triangle
+      public: MeshBvh(const std::vector<math::Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices);
+
+      /// \brief Constructor that gathers the triangles of a mesh the way
+      /// the mesh factories load it: only the given submesh if one is named,
+      /// recentered if requested.
+      /// \param[in] _desc Descriptor of the mesh, with a loaded mesh
+      public: explicit MeshBvh(const MeshDescriptor &_desc);
+
+      /// \brief Destructor
+      public: ~MeshBvh();
+
+      /// \brief Get the number of triangles
+      /// \return Number of triangles
+      public: unsigned int TriangleCount() const;
+
+      /// \brief Get the bounding box of the mesh
+      /// \return Bounding box of all the triangles
+      public: math::AxisAlignedBox BoundingBox() const;
+
+      /// \brief Find the closest triangle hit by a ray, in the mesh frame.
+      /// Like Ogre's ray queries, only the front face of a triangle, with
+      /// counter-clockwise winding, can be hit. Distances are expressed in
+      /// multiples of the length of _dir.
+      /// \param[in] _origin Ray origin
+      /// \param[in] _dir Ray direction
+      /// \param[out] _distance Distance to the closest hit
+      /// \return True if a triangle was hit
+      public: bool Intersect(const math::Vector3d &_origin,
+                  const math::Vector3d &_dir, double &_distance) const;
+
+      /// \brief Private data pointer
+      private: std::unique_ptr<MeshBvhPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #define IGNITION_RENDERING_CAMERA_HH_
 
 #include <string>
+#include <vector>
 
 #include <ignition/common/Event.hh>
 #include <ignition/math/Matrix4.hh>
@@ -149,6 +150,15 @@ namespace ignition
       public: virtual VisualPtr VisualAt(const ignition::math::Vector2i
                   &_mousePos) = 0;
 
+      /// \brief Get the visuals for a batch of mouse positions. This is
+      /// equivalent to calling VisualAt for each position but render engines
+      /// may resolve the whole batch at once, e.g. with a single render and
+      /// readback of the area covering all the positions.
+      /// \param[in] _mousePos Mouse positions
+      /// \return Visual for each position, null if no visual was found
+      public: virtual std::vector<VisualPtr> VisualsAt(
+                  const std::vector<ignition::math::Vector2i> &_mousePos) = 0;
+
       /// \brief Renders a new frame.
       /// This is a convenience function for single-camera scenes. It wraps the
       /// pre-render, render, and post-render into a single
@@ -163,6 +173,27 @@ namespace ignition
       /// \return A newly allocated Image for storing this cameras images
       public: virtual Image CreateImage() const = 0;
 
+      /// \brief Get an image buffer for capturing images from this camera's
+      /// image pool. The image is sized like the ones made by CreateImage,
+      /// but its memory goes back to the pool when the last copy of the
+      /// image is destroyed. Capture loops that acquire a new image every
+      /// frame therefore reuse the same few buffers instead of allocating a
+      /// full frame each time.
+      /// \return An Image for storing this cameras images
+      /// \sa SetImageBufferPool
+      public: virtual Image AcquireImage() = 0;
+
+      /// \brief Set the pool AcquireImage takes images from. Cameras with
+      /// the same image size and format can share a pool. Each camera
+      /// creates its own pool on first use if none is set.
+      /// \param[in] _pool Image pool
+      public: virtual void SetImageBufferPool(ImagePoolPtr _pool) = 0;
+
+      /// \brief Get the pool AcquireImage takes images from
+      /// \return The image pool, null if no image was acquired yet and no
+      /// pool was set
+      public: virtual ImagePoolPtr ImageBufferPool() const = 0;
+
       /// \brief Renders a new frame and writes the results to the given image.
       /// This is a convenience function for single-camera scenes. It wraps the
       /// pre-render, render, post-render, and get-image calls into a single
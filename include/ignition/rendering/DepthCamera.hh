@@ -75,6 +75,47 @@ namespace ignition
           std::function<void(const float *_pointCloud, unsigned int _width,
           unsigned int _height, unsigned int _depth,
           const std::string &_format)> _subscriber) = 0;
+
+      /// \brief Connect to the new depth frame view signal. Unlike
+      /// ConnectNewDepthFrame and ConnectNewRgbPointCloud, the data passed
+      /// to the subscriber is not copied into separate output buffers.
+      /// Subscribers receive a view into the camera's internal readback
+      /// buffer which is only valid for the duration of the callback.
+      /// \param[in] _subscriber Subscriber callback function
+      /// The arguments of the callback function are:
+      ///   _data Interleaved point cloud data. Each point is represented by
+      ///         _channels 32 bit floating point values [X, Y, Z, RGBA],
+      ///         see ConnectNewRgbPointCloud for how to decode the color.
+      ///         The depth of a pixel is its X value, i.e. the depth at
+      ///         (row, col) is _data[row * _rowStride + col * _channels]
+      ///  _width Image width
+      ///  _height Image height
+      ///  _channels Number of floats per pixel
+      ///  _rowStride Number of floats between the start of two rows
+      ///  _format Pixel format of _data
+      /// \return Pointer to the new Connection. This must be kept in scope
+      public: virtual ignition::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const float *_data, unsigned int _width,
+          unsigned int _height, unsigned int _channels,
+          unsigned int _rowStride, const std::string &_format)>
+          _subscriber) = 0;
+
+      /// \brief Enable or disable asynchronous readback of depth data.
+      /// When enabled, the depth data of a frame is copied from the GPU
+      /// while the next frame renders, and it is delivered to subscribers
+      /// of ConnectNewDepthFrame and ConnectNewRgbPointCloud one update
+      /// later. This avoids stalling the CPU until the GPU finishes
+      /// rendering, at the cost of one frame of latency. No data is
+      /// delivered on the first update after enabling asynchronous readback.
+      /// Disabled by default.
+      /// \param[in] _async True to enable asynchronous readback
+      /// \sa AsyncReadback
+      public: virtual void SetAsyncReadback(bool _async) = 0;
+
+      /// \brief Get whether asynchronous readback of depth data is enabled.
+      /// \return True if asynchronous readback is enabled
+      /// \sa SetAsyncReadback
+      public: virtual bool AsyncReadback() const = 0;
     };
   }
   }
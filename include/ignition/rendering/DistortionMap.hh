@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_RENDERING_DISTORTIONMAP_HH_
+#define IGNITION_RENDERING_DISTORTIONMAP_HH_
+
+#include <memory>
+#include <string>
+
+#include <ignition/math/Vector2.hh>
+
+#include <ignition/common/SuppressWarning.hh>
+
+#include "ignition/rendering/config.hh"
+#include "ignition/rendering/Export.hh"
+
+namespace ignition
+{
+  namespace rendering
+  {
+    inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declarations
+    class DistortionMapPrivate;
+
+    /// \class DistortionMap DistortionMap.hh
+    /// ignition/rendering/DistortionMap.hh
+    /// \brief Lookup table used by distortion render passes. It is a square
+    /// map that stores, for each pixel of the distorted image, the normalized
+    /// coordinates of the undistorted image to sample, or (-1, -1) if there
+    /// is nothing to sample. Pixels that no undistorted pixel maps to are
+    /// filled by interpolating their neighbours.
+    ///
+    /// Maps only depend on the lens and the map size, so cameras with the
+    /// same intrinsics can share one map, see Shared.
+    class IGNITION_RENDERING_VISIBLE DistortionMap
+    {
+      /// \brief Build a distortion map using Brown's distortion model. The
+      /// rows of the map are built in parallel.
+      /// \param[in] _size Width and height of the map in pixels
+      /// \param[in] _focalLength Focal length in pixels
+      /// \param[in] _center Normalized distortion center
+      /// \param[in] _k1 Radial distortion coefficient k1
+      /// \param[in] _k2 Radial distortion coefficient k2
+      /// \param[in] _k3 Radial distortion coefficient k3
+      /// \param[in] _p1 Tangential distortion coefficient p1
+      /// \param[in] _p2 Tangential distortion coefficient p2
+      public: DistortionMap(unsigned int _size, double _focalLength,
+                  const math::Vector2d &_center, double _k1, double _k2,
+                  double _k3, double _p1, double _p2);
+
+      /// \brief Destructor
+      public: ~DistortionMap();
+
+      /// \brief Get a distortion map shared with all the other users of the
+      /// same parameters. The map is built on first use and freed when the
+      /// last user releases it. If _cachePath is not empty, maps are also
+      /// read from and written to that directory so they are only built
+      /// once across runs. Safe to call from several threads: callers
+      /// asking for a map that is being built wait for it, while maps with
+      /// other parameters are built concurrently.
+      /// \param[in] _size Width and height of the map in pixels
+      /// \param[in] _focalLength Focal length in pixels
+      /// \param[in] _center Normalized distortion center
+      /// \param[in] _k1 Radial distortion coefficient k1
+      /// \param[in] _k2 Radial distortion coefficient k2
+      /// \param[in] _k3 Radial distortion coefficient k3
+      /// \param[in] _p1 Tangential distortion coefficient p1
+      /// \param[in] _p2 Tangential distortion coefficient p2
+      /// \param[in] _cachePath Directory of the on-disk map cache, empty to
+      /// not use one
+      /// \return The distortion map
+      public: static std::shared_ptr<const DistortionMap> Shared(
+                  unsigned int _size, double _focalLength,
+                  const math::Vector2d &_center, double _k1, double _k2,
+                  double _k3, double _p1, double _p2,
+                  const std::string &_cachePath = "");
+
+      /// \brief Apply Brown's distortion model to normalized image
+      /// coordinates
+      /// \param[in] _in Normalized undistorted coordinates
+      /// \param[in] _center Normalized distortion center
+      /// \param[in] _k1 Radial distortion coefficient k1
+      /// \param[in] _k2 Radial distortion coefficient k2
+      /// \param[in] _k3 Radial distortion coefficient k3
+      /// \param[in] _p1 Tangential distortion coefficient p1
+      /// \param[in] _p2 Tangential distortion coefficient p2
+      /// \param[in] _width Width of the image in pixels
+      /// \param[in] _f Focal length in pixels
+      /// \return Normalized distorted coordinates
+      public: static math::Vector2d Distort(const math::Vector2d &_in,
+                  const math::Vector2d &_center, double _k1, double _k2,
+                  double _k3, double _p1, double _p2, unsigned int _width,
+                  double _f);
+
+      /// \brief Get the width and height of the map
+      /// \return Size of the map in pixels
+      public: unsigned int Size() const;
+
+      /// \brief Get the map data, two floats per pixel, row by row
+      /// \return Pointer to the map data
+      public: const float *Data() const;
+
+      /// \brief Get the map value of a pixel
+      /// \param[in] _x Column of the pixel
+      /// \param[in] _y Row of the pixel
+      /// \return Normalized undistorted coordinates to sample, (-1, -1) if
+      /// there is nothing to sample or the pixel is out of the map
+      public: math::Vector2d Value(int _x, int _y) const;
+
+      /// \brief Get a string that identifies the parameters of the map, the
+      /// same for all the maps built with the same parameters. It is used to
+      /// share resources made from the map, e.g. textures.
+      /// \return Key of the map
+      public: std::string Key() const;
+
+      /// \brief Get the scale to apply to the distorted image so it is
+      /// cropped to remove the black pixels at its corners. Only barrel
+      /// distortion (k1 < 0) is cropped.
+      /// \return Scale of the distorted image, (1, 1) if it is not cropped
+      public: math::Vector2d CropScale() const;
+
+      /// \brief Write the map to a file
+      /// \param[in] _filename Path of the file
+      /// \return True if the map was written
+      public: bool Save(const std::string &_filename) const;
+
+      /// \brief Read the map from a file written with Save. The file must
+      /// have been written for the same parameters.
+      /// \param[in] _filename Path of the file
+      /// \return True if the map was read
+      public: bool Load(const std::string &_filename);
+
+      /// \brief Get the number of maps built since the program started.
+      /// Maps read from the on-disk cache are not counted.
+      /// \return Number of built maps
+      public: static unsigned int BuildCount();
+
+      /// \brief Constructor that sets up the parameters of the map without
+      /// building it
+      /// \param[in] _dataPtr Private data holding the parameters
+      private: explicit DistortionMap(
+                   std::unique_ptr<DistortionMapPrivate> _dataPtr);
+
+      /// \brief Build the map
+      private: void Build();
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Pointer to private data
+      private: std::unique_ptr<DistortionMapPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+    }
+  }
+}
+#endif
@@ -190,6 +190,53 @@ namespace ignition
       /// \return The vertical resolution.
       /// \sa VerticalRayCount()
       public: virtual double VerticalResolution() const = 0;
+
+      /// \brief Enable or disable adaptive resolution of the textures
+      /// rendered in the first pass. Range data is rendered into up to six
+      /// cubemap faces which are then sampled by each ray. By default all
+      /// faces have the same square resolution, computed from the overall ray
+      /// density. When adaptive resolution is enabled, the width and height
+      /// of each face are computed from the spacing of the rays that sample
+      /// it, and rays on the edge between two faces are sampled from the
+      /// face with more rays so that faces holding only a few edge rays are
+      /// not rendered. This greatly reduces the number of pixels rendered for
+      /// sensors with a narrow vertical field of view, at the cost of
+      /// slightly less accurate ranges for sensors with very few rays. Must
+      /// be called before the sensor is first rendered. Disabled by default.
+      /// \param[in] _adaptive True to enable adaptive resolution
+      /// \sa AdaptiveCubemapResolution
+      public: virtual void SetAdaptiveCubemapResolution(bool _adaptive) = 0;
+
+      /// \brief Get whether adaptive resolution of the first pass textures
+      /// is enabled.
+      /// \return True if adaptive resolution is enabled
+      /// \sa SetAdaptiveCubemapResolution
+      public: virtual bool AdaptiveCubemapResolution() const = 0;
+
+      /// \brief Sample the range data of this sensor from the cubemap
+      /// rendered by another GpuRays sensor. Several lidars mounted at the
+      /// same position, e.g. on the same link of a robot, can then share one
+      /// set of first pass renders instead of each rendering the scene up to
+      /// six times. Each sensor keeps its own rays and field of view, the
+      /// source renders every cubemap face that any of its sensors need and
+      /// renders them at most once per frame. Sharing only takes effect if
+      /// both sensors are at the same world position and have the same clip
+      /// planes and clamping, otherwise this sensor renders its own cubemap.
+      /// The cubemap is rendered at the resolution of the source, so the
+      /// source should be the sensor with the highest ray density. The
+      /// relative pose of the two sensors must not change after the sensor
+      /// is first rendered. Must be called before the sensor is first
+      /// rendered. Pass nullptr to render a cubemap of its own.
+      /// \param[in] _source Sensor that renders the shared cubemap. It
+      /// must not share the cubemap of another sensor itself.
+      /// \sa CubemapSource
+      public: virtual void SetCubemapSource(const GpuRaysPtr &_source) = 0;
+
+      /// \brief Get the sensor whose cubemap is sampled by this sensor.
+      /// \return Cubemap source or nullptr if this sensor renders its own
+      /// cubemap
+      /// \sa SetCubemapSource
+      public: virtual GpuRaysPtr CubemapSource() const = 0;
     };
   }
   }
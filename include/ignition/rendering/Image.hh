@@ -91,6 +91,9 @@ namespace ignition
       public: template <typename T>
               T *Data();
 
+      /// \brief ImagePool sets up the buffers of the images it hands out
+      friend class ImagePool;
+
       /// \brief Image width in pixels
       private: unsigned int width = 0;
 
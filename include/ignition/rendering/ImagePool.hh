@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_RENDERING_IMAGEPOOL_HH_
+#define IGNITION_RENDERING_IMAGEPOOL_HH_
+
+#include <memory>
+
+#include <ignition/common/SuppressWarning.hh>
+
+#include "ignition/rendering/config.hh"
+#include "ignition/rendering/Image.hh"
+#include "ignition/rendering/PixelFormat.hh"
+#include "ignition/rendering/Export.hh"
+
+namespace ignition
+{
+  namespace rendering
+  {
+    inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+    //
+    // forward declarations
+    class ImagePoolPrivate;
+
+    /// \class ImagePool ImagePool.hh ignition/rendering/ImagePool.hh
+    /// \brief Recycles the memory of images. An image acquired from the pool
+    /// owns a buffer like any other image, but when the last copy of the
+    /// image is destroyed the buffer is handed back to the pool instead of
+    /// being freed, and the next image of the same memory size reuses it.
+    /// Images can be released from any thread and may outlive the pool.
+    class IGNITION_RENDERING_VISIBLE ImagePool
+    {
+      /// \brief Constructor
+      public: ImagePool();
+
+      /// \brief Destructor. Frees the buffers that are not in use.
+      public: ~ImagePool();
+
+      /// \brief Copying a pool is not allowed
+      public: ImagePool(const ImagePool &) = delete;
+
+      /// \brief Copying a pool is not allowed
+      public: ImagePool &operator=(const ImagePool &) = delete;
+
+      /// \brief Get an image from the pool, reusing a released buffer of the
+      /// same memory size if there is one. The content of a reused buffer is
+      /// not cleared.
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      /// \param[in] _format Image pixel format
+      /// \return The image
+      public: Image Acquire(unsigned int _width, unsigned int _height,
+                  PixelFormat _format);
+
+      /// \brief Get the number of buffers allocated by the pool since it was
+      /// created. Acquiring an image only allocates when no released buffer
+      /// of the right size is available.
+      /// \return Number of allocated buffers
+      public: unsigned int AllocationCount() const;
+
+      /// \brief Get the number of released buffers waiting to be reused
+      /// \return Number of free buffers
+      public: unsigned int FreeCount() const;
+
+      /// \brief Set the maximum number of released buffers kept for reuse.
+      /// Buffers released while the pool is full are freed. The default
+      /// is 8.
+      /// \param[in] _count Maximum number of free buffers
+      public: void SetMaxFreeCount(unsigned int _count);
+
+      /// \brief Get the maximum number of released buffers kept for reuse
+      /// \return Maximum number of free buffers
+      /// \sa SetMaxFreeCount
+      public: unsigned int MaxFreeCount() const;
+
+      /// \brief Free all the buffers that are not in use
+      public: void Clear();
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Pointer to private data. It is shared with the images in
+      /// use so they can return their buffers after the pool is destroyed.
+      private: std::shared_ptr<ImagePoolPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+    }
+  }
+}
+#endif
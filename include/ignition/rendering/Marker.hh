@@ -141,6 +141,31 @@ namespace ignition
       /// \param[in] _value The new positional vector of the point
       public: virtual void SetPoint(unsigned int _index,
                   const ignition::math::Vector3d &_value) = 0;
+
+      /// \brief Replace all the points of the marker in one call. This is
+      /// much faster than ClearPoints followed by AddPoint for each point
+      /// when the marker has many points, e.g. large point clouds.
+      /// \param[in] _positions Point positions, tightly packed x y z for
+      /// each point
+      /// \param[in] _colors Point colors, one for each point. If null,
+      /// the points are white.
+      /// \param[in] _count Number of points
+      /// \sa AppendPoints
+      public: virtual void SetPoints(const float *_positions,
+                  const ignition::math::Color *_colors,
+                  unsigned int _count) = 0;
+
+      /// \brief Add points to the end of the points of the marker in one
+      /// call.
+      /// \param[in] _positions Point positions, tightly packed x y z for
+      /// each point
+      /// \param[in] _colors Point colors, one for each point. If null,
+      /// the points are white.
+      /// \param[in] _count Number of points
+      /// \sa SetPoints
+      public: virtual void AppendPoints(const float *_positions,
+                  const ignition::math::Color *_colors,
+                  unsigned int _count) = 0;
     };
     }
   }
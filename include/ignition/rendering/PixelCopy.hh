@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_RENDERING_PIXELCOPY_HH_
+#define IGNITION_RENDERING_PIXELCOPY_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ignition/rendering/config.hh"
+#include "ignition/rendering/Export.hh"
+
+namespace ignition
+{
+  namespace rendering
+  {
+    inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+    //
+    // The functions below copy image data read back from the GPU into
+    // tightly packed CPU buffers. Rows of GPU textures are often padded, so
+    // every function takes the size in bytes of a source row. Vectorized
+    // (SSE2) code paths are used when available, with a scalar fallback
+    // otherwise.
+
+    /// \brief Copy image rows, removing any padding at the end of the
+    /// source rows.
+    /// \param[in] _src Source image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[out] _dst Destination image data
+    /// \param[in] _dstRowBytes Size in bytes of a destination row
+    /// \param[in] _rowBytes Number of bytes to copy from each row
+    /// \param[in] _height Number of rows to copy
+    IGNITION_RENDERING_VISIBLE
+    void copyPixelRows(const void *_src, size_t _srcRowBytes,
+        void *_dst, size_t _dstRowBytes, size_t _rowBytes,
+        unsigned int _height);
+
+    /// \brief Copy a four channel float image into a tightly packed three
+    /// channel image, dropping the fourth (alpha) channel and any padding at
+    /// the end of the source rows.
+    /// \param[in] _src Source RGBA image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[out] _dst Destination RGB image data. Must hold
+    /// _width * _height * 3 floats
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    IGNITION_RENDERING_VISIBLE
+    void copyRgbaToRgb(const float *_src, size_t _srcRowBytes,
+        float *_dst, unsigned int _width, unsigned int _height);
+
+    /// \brief Copy a single channel of an interleaved float image into a
+    /// tightly packed single channel image, removing any padding at the end
+    /// of the source rows.
+    /// \param[in] _src Source image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[in] _channels Number of channels in the source image
+    /// \param[in] _channel Index of the channel to copy
+    /// \param[out] _dst Destination image data. Must hold
+    /// _width * _height floats
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    IGNITION_RENDERING_VISIBLE
+    void copyChannel(const float *_src, size_t _srcRowBytes,
+        unsigned int _channels, unsigned int _channel,
+        float *_dst, unsigned int _width, unsigned int _height);
+
+    /// \brief Copy an 8 bit single channel image into a 16 bit single
+    /// channel image, widening each value and removing any padding at the end
+    /// of the source rows. Values are not rescaled.
+    /// \param[in] _src Source image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[out] _dst Destination image data. Must hold
+    /// _width * _height values
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    IGNITION_RENDERING_VISIBLE
+    void copyL8ToL16(const uint8_t *_src, size_t _srcRowBytes,
+        uint16_t *_dst, unsigned int _width, unsigned int _height);
+
+    /// \brief Copy an 8 bit per channel RGBA image into a tightly packed
+    /// RGB image, dropping the alpha channel and any padding at the end of
+    /// the source rows.
+    /// \param[in] _src Source RGBA image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[out] _dst Destination RGB image data. Must hold
+    /// _width * _height * 3 bytes
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    IGNITION_RENDERING_VISIBLE
+    void copyRgba8ToRgb8(const uint8_t *_src, size_t _srcRowBytes,
+        uint8_t *_dst, unsigned int _width, unsigned int _height);
+
+    /// \brief Convert an 8 bit per channel RGBA image into an image of 32 bit
+    /// values, one per pixel, removing any padding at the end of the source
+    /// rows. Each value is r | g << 8 | b << 16 | a << 24, masked with
+    /// _mask. This decodes ids that were rendered as colors.
+    /// \param[in] _src Source RGBA image data
+    /// \param[in] _srcRowBytes Size in bytes of a source row, including
+    /// padding
+    /// \param[in] _mask Mask applied to each value, e.g. 0xFF to only keep
+    /// the red channel
+    /// \param[out] _dst Destination image data. Must hold
+    /// _width * _height values
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    IGNITION_RENDERING_VISIBLE
+    void copyRgba8ToUint32(const uint8_t *_src, size_t _srcRowBytes,
+        uint32_t _mask, uint32_t *_dst, unsigned int _width,
+        unsigned int _height);
+    }
+  }
+}
+#endif
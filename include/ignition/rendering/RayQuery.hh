@@ -17,6 +17,8 @@
 #ifndef IGNITION_RENDERING_RAYQUERY_HH_
 #define IGNITION_RENDERING_RAYQUERY_HH_
 
+#include <vector>
+
 #include <ignition/common/SuppressWarning.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -31,6 +33,22 @@ namespace ignition
   {
     inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
     //
+    /// \enum RayQueryMode
+    /// \brief Method used by a ray query to find intersections
+    enum IGNITION_RENDERING_VISIBLE RayQueryMode
+    {
+      /// \brief Render engine default. Ogre2 reads the camera selection
+      /// buffer on the GPU when the query is set from a camera, and tests the
+      /// triangles of the meshes whose bounding box is hit otherwise.
+      RQM_DEFAULT = 0,
+
+      /// \brief Test rays on the CPU against bounding volume hierarchies
+      /// kept for each mesh, and built once per call over the bounding boxes
+      /// of the scene objects. Suited to casting many rays per call, without
+      /// a camera.
+      RQM_BVH = 1
+    };
+
     /// \brief A class that stores ray query intersection results.
     class IGNITION_RENDERING_VISIBLE RayQueryResult
     {
@@ -91,6 +109,41 @@ namespace ignition
       /// \brief Compute intersections
       /// \return A vector of intersection results
       public: virtual RayQueryResult ClosestPoint() = 0;
+
+      /// \brief Set the method used to compute intersections.
+      /// Render engines that do not support a mode use RQM_DEFAULT instead.
+      /// \param[in] _mode Ray query mode
+      public: virtual void SetMode(RayQueryMode _mode) = 0;
+
+      /// \brief Get the method used to compute intersections
+      /// \return Ray query mode
+      public: virtual RayQueryMode Mode() const = 0;
+
+      /// \brief Compute the closest intersection of a batch of rays. This is
+      /// equivalent to calling SetOrigin, SetDirection and ClosestPoint for
+      /// each ray, but render engines may share work across the batch, e.g.
+      /// in RQM_BVH mode. The origin and direction of the query are left
+      /// unspecified.
+      /// \param[in] _origins Origin of each ray
+      /// \param[in] _directions Direction of each ray, of the same size as
+      /// _origins
+      /// \return Closest intersection of each ray, empty if the number of
+      /// origins and directions differ
+      public: virtual std::vector<RayQueryResult> ClosestPointsAlongRays(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions) = 0;
+
+      /// \brief Compute the closest intersection of a batch of rays cast
+      /// from a camera. This is equivalent to calling SetFromCamera and
+      /// ClosestPoint for each ray but render engines may resolve the whole
+      /// batch at once, e.g. with a single render and readback. The origin
+      /// and direction of the query are left unspecified.
+      /// \param[in] _camera Camera to construct the rays
+      /// \param[in] _coords normalized device coords [-1, +1] of each ray
+      /// \return Closest intersection of each ray
+      public: virtual std::vector<RayQueryResult> ClosestPoints(
+                const CameraPtr &_camera,
+                const std::vector<math::Vector2d> &_coords) = 0;
     };
     }
   }
@@ -62,6 +62,7 @@ namespace ignition
     class Grid;
     class Heightmap;
     class Image;
+    class ImagePool;
     class InertiaVisual;
     class Light;
     class LightVisual;
@@ -166,6 +167,10 @@ namespace ignition
     /// \brief Shared pointer to Image
     typedef shared_ptr<Image> ImagePtr;
 
+    /// \typedef ImagePoolPtr
+    /// \brief Shared pointer to ImagePool
+    typedef shared_ptr<ImagePool> ImagePoolPtr;
+
     /// \typedef InertiaVisualPtr
     /// \def Shared pointer to InertiaVisual
     typedef shared_ptr<InertiaVisual> InertiaVisualPtr;
@@ -20,6 +20,7 @@
 #include <array>
 #include <string>
 #include <limits>
+#include <vector>
 
 #include <ignition/common/Material.hh>
 #include <ignition/common/Mesh.hh>
@@ -1278,6 +1279,30 @@ namespace ignition
       /// SetCameraPassCountPerGpuFlush
       public: virtual bool LegacyAutoGpuFlush() const = 0;
 
+      /// \brief Render a batch of sensors in a single frame. This is
+      /// equivalent to the ideal render loop described in
+      /// SetCameraPassCountPerGpuFlush:
+      ///
+      /// \code
+      ///   scene->PreRender();
+      ///   for (auto &camera in _cameras)
+      ///     camera->Render();
+      ///   for (auto &camera in _cameras)
+      ///     camera->PostRender();
+      ///   scene->PostRender();
+      /// \endcode
+      ///
+      /// but render engines may use the knowledge of the whole batch to
+      /// reduce per sensor overhead, e.g. ogre2 submits the work of all
+      /// sensors to the GPU before reading back any of their data and starts
+      /// a single new frame for the whole batch. GPU commands are still
+      /// flushed whenever SetCameraPassCountPerGpuFlush passes are queued.
+      /// Must not be called between PreRender and PostRender.
+      /// \param[in] _cameras Cameras and camera based sensors (e.g. depth
+      /// cameras, gpu rays) to render
+      public: virtual void RenderSensors(
+                  const std::vector<CameraPtr> &_cameras) = 0;
+
       /// \brief Remove and destroy all objects from the scene graph. This does
       /// not completely destroy scene resources, so new objects can be created
       /// and added to the scene afterwards.
@@ -73,6 +73,20 @@ namespace ignition
           std::function<void(const uint8_t *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber) = 0;
 
+      /// \brief Connect to the new label ID image event. Each pixel holds
+      /// the label id in semantic mode, or the composite id
+      /// (label << 16 | instance count) in panoptic mode. When the colored
+      /// map is enabled, colors are mapped back to ids on the CPU, otherwise
+      /// the ids are decoded directly from the rendered image.
+      /// \param[in] _subscriber Subscriber callback function.
+      /// The callback function arguments are:
+      /// <label id data, width, height>
+      /// \return Pointer to the new Connection. This must be kept in scope
+      public: virtual ignition::common::ConnectionPtr
+        ConnectNewLabelIdFrame(
+          std::function<void(const uint32_t *, unsigned int,
+          unsigned int)> _subscriber) = 0;
+
       /// \brief Set Segmentation Type
       /// \param[in] _type Segmentation Type
       public: virtual void SetSegmentationType(SegmentationType _type) = 0;
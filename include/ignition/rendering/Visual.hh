@@ -151,6 +151,27 @@ namespace ignition
       /// \return The visual. nullptr is returned if cloning failed.
       public: virtual VisualPtr Clone(const std::string &_name,
                   NodePtr _newParent) const = 0;
+
+      /// \brief Clone the visual (and its children) as an instance of this
+      /// visual. Unlike Clone, the materials of the visual, its geometries
+      /// and its children are shared with the instance instead of being
+      /// copied, so the instance only differs by its transform. Engines
+      /// that support it, such as ogre2, draw all the instances of a mesh
+      /// with GPU instancing, in a single draw call per submesh. Each
+      /// instance is still a visual with its own id, so picking and
+      /// segmentation work as usual. Changes to a shared material apply to
+      /// all the instances. The meshes of this visual and of its instances
+      /// own the shared materials together, so the materials are destroyed
+      /// along with the last of these meshes. Geometries that are not
+      /// created from a mesh descriptor get a copy of their material.
+      /// \param[in] _name Name of the instance. Set this to an empty
+      /// string to auto-generate a unique name for the instance.
+      /// \param[in] _newParent Parent of the instance. Set to nullptr if
+      /// the instance should have no parent.
+      /// \return The instance. nullptr is returned if cloning failed.
+      /// \sa Clone
+      public: virtual VisualPtr CloneInstance(const std::string &_name,
+                  NodePtr _newParent) const = 0;
     };
     }
   }
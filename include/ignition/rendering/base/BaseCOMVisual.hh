@@ -50,6 +50,9 @@ namespace ignition
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       public: virtual void SetInertial(
                   const ignition::math::Inertiald &_inertial) override;
@@ -103,6 +106,14 @@ namespace ignition
       T::PreRender();
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseCOMVisual<T>::PreRenderEveryFrame() const
+    {
+      // the COM sphere is updated in PreRender by derived classes
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseCOMVisual<T>::Init()
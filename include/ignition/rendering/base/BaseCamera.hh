@@ -17,7 +17,9 @@
 #ifndef IGNITION_RENDERING_BASE_BASECAMERA_HH_
 #define IGNITION_RENDERING_BASE_BASECAMERA_HH_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <ignition/math/Matrix3.hh>
 #include <ignition/math/Pose3.hh>
@@ -28,6 +30,7 @@
 
 #include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/Image.hh"
+#include "ignition/rendering/ImagePool.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/Scene.hh"
 #include "ignition/rendering/base/BaseRenderTarget.hh"
@@ -93,6 +96,15 @@ namespace ignition
 
       public: virtual Image CreateImage() const override;
 
+      // Documentation inherited.
+      public: virtual Image AcquireImage() override;
+
+      // Documentation inherited.
+      public: virtual void SetImageBufferPool(ImagePoolPtr _pool) override;
+
+      // Documentation inherited.
+      public: virtual ImagePoolPtr ImageBufferPool() const override;
+
       public: virtual void Capture(Image &_image) override;
 
       public: virtual void Copy(Image &_image) const override;
@@ -108,6 +120,11 @@ namespace ignition
       public: virtual VisualPtr VisualAt(const ignition::math::Vector2i
                   &_mousePos) override;
 
+      // Documentation inherited.
+      public: virtual std::vector<VisualPtr> VisualsAt(
+                  const std::vector<ignition::math::Vector2i> &_mousePos)
+                  override;
+
       // Documentation inherited.
       public: virtual math::Matrix4d ProjectionMatrix() const override;
 
@@ -210,6 +227,9 @@ namespace ignition
 
       protected: ImagePtr imageBuffer;
 
+      /// \brief Pool of the images handed out by AcquireImage
+      protected: ImagePoolPtr imagePool;
+
       /// \brief Near clipping plane distance
       protected: double nearClip = 0.01;
 
@@ -405,6 +425,30 @@ namespace ignition
       return Image(width, height, format);
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    Image BaseCamera<T>::AcquireImage()
+    {
+      if (!this->imagePool)
+        this->imagePool = std::make_shared<ImagePool>();
+      return this->imagePool->Acquire(this->ImageWidth(),
+          this->ImageHeight(), this->ImageFormat());
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseCamera<T>::SetImageBufferPool(ImagePoolPtr _pool)
+    {
+      this->imagePool = _pool;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    ImagePoolPtr BaseCamera<T>::ImageBufferPool() const
+    {
+      return this->imagePool;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseCamera<T>::Update()
@@ -634,6 +678,18 @@ namespace ignition
       return VisualPtr();
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    std::vector<VisualPtr> BaseCamera<T>::VisualsAt(
+        const std::vector<ignition::math::Vector2i> &_mousePos)
+    {
+      std::vector<VisualPtr> result;
+      result.reserve(_mousePos.size());
+      for (const auto &mousePos : _mousePos)
+        result.push_back(this->VisualAt(mousePos));
+      return result;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseCamera<T>::SetHFOV(const math::Angle &_hfov)
@@ -50,6 +50,18 @@ namespace ignition
       public: virtual ignition::common::ConnectionPtr ConnectNewRGBPointCloud(
           std::function<void(const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber);
+
+      // Documentation inherited.
+      public: virtual ignition::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const float *, unsigned int, unsigned int,
+          unsigned int, unsigned int, const std::string &)> _subscriber)
+          override;
+
+      // Documentation inherited.
+      public: virtual void SetAsyncReadback(bool _async) override;
+
+      // Documentation inherited.
+      public: virtual bool AsyncReadback() const override;
     };
 
     //////////////////////////////////////////////////
@@ -94,6 +106,34 @@ namespace ignition
     {
       return nullptr;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    ignition::common::ConnectionPtr
+        BaseDepthCamera<T>::ConnectNewDepthFrameView(
+          std::function<void(const float *, unsigned int, unsigned int,
+          unsigned int, unsigned int, const std::string &)>)
+    {
+      return nullptr;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseDepthCamera<T>::SetAsyncReadback(bool _async)
+    {
+      if (_async)
+      {
+        ignerr << "Asynchronous readback not supported for render engine: "
+               << this->Scene()->Engine()->Name() << std::endl;
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseDepthCamera<T>::AsyncReadback() const
+    {
+      return false;
+    }
   }
   }
 }
@@ -56,6 +56,9 @@ namespace ignition
       // Documentation inherited
       public: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void SetTransformMode(TransformMode _mode) override;
 
@@ -310,6 +313,14 @@ namespace ignition
       this->modeDirty = false;
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseGizmoVisual<T>::PreRenderEveryFrame() const
+    {
+      // the gizmo mode is applied in PreRender
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseGizmoVisual<T>::SetTransformMode(TransformMode _mode)
@@ -17,6 +17,7 @@
 #ifndef IGNITION_RENDERING_BASE_BASEGPURAYS_HH_
 #define IGNITION_RENDERING_BASE_BASEGPURAYS_HH_
 
+#include <memory>
 #include <string>
 
 #include <ignition/common/Event.hh>
@@ -151,6 +152,20 @@ namespace ignition
       // Documentation inherited.
       public: virtual double VerticalResolution() const override;
 
+      // Documentation inherited.
+      public: virtual void SetAdaptiveCubemapResolution(bool _adaptive)
+          override;
+
+      // Documentation inherited.
+      public: virtual bool AdaptiveCubemapResolution() const override;
+
+      // Documentation inherited.
+      public: virtual void SetCubemapSource(const GpuRaysPtr &_source)
+          override;
+
+      // Documentation inherited.
+      public: virtual GpuRaysPtr CubemapSource() const override;
+
       /// \brief maximum value used for data outside sensor range
       public: float dataMaxVal = ignition::math::INF_D;
 
@@ -200,6 +215,13 @@ namespace ignition
       /// \brief Number of channels used to store the data
       protected: unsigned int channels = 1u;
 
+      /// \brief True to compute the resolution of each cubemap face from the
+      /// density of the rays that sample it
+      protected: bool adaptiveCubemapResolution = false;
+
+      /// \brief Sensor that renders the cubemap sampled by this sensor
+      protected: std::weak_ptr<GpuRays> cubemapSource;
+
       private: friend class OgreScene;
     };
 
@@ -446,6 +468,34 @@ namespace ignition
     {
       return this->vResolution;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseGpuRays<T>::SetAdaptiveCubemapResolution(bool _adaptive)
+    {
+      this->adaptiveCubemapResolution = _adaptive;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseGpuRays<T>::AdaptiveCubemapResolution() const
+    {
+      return this->adaptiveCubemapResolution;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseGpuRays<T>::SetCubemapSource(const GpuRaysPtr &_source)
+    {
+      this->cubemapSource = _source;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    GpuRaysPtr BaseGpuRays<T>::CubemapSource() const
+    {
+      return this->cubemapSource.lock();
+    }
     }
   }
 }
@@ -48,6 +48,9 @@ namespace ignition
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       public: virtual void SetInertial(
                   const ignition::math::Inertiald &_inertial) override;
@@ -79,6 +82,14 @@ namespace ignition
       T::PreRender();
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseInertiaVisual<T>::PreRenderEveryFrame() const
+    {
+      // the inertia box is updated in PreRender by derived classes
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseInertiaVisual<T>::Init()
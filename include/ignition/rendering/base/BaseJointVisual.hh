@@ -53,6 +53,9 @@ namespace ignition
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited.
       protected: virtual void Destroy() override;
 
@@ -227,6 +230,14 @@ namespace ignition
       }
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseJointVisual<T>::PreRenderEveryFrame() const
+    {
+      // joint axes are updated in PreRender
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseJointVisual<T>::Init()
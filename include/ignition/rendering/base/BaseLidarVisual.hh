@@ -44,6 +44,9 @@ namespace ignition
       // Documentation inherited
       public: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void Destroy() override;
 
@@ -218,6 +221,14 @@ namespace ignition
       T::PreRender();
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseLidarVisual<T>::PreRenderEveryFrame() const
+    {
+      // lidar points are updated in PreRender by derived classes
+      return true;
+    }
+
     /////////////////////////////////////////////////
     template <class T>
     void BaseLidarVisual<T>::Destroy()
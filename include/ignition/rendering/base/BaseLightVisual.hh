@@ -48,6 +48,9 @@ namespace ignition
       // Documentation inherited.
       protected: virtual void PreRender() override;
 
+      // Documentation inherited.
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       // Documentation inherited
       public: virtual void SetType(LightVisualType _type) override;
 
@@ -101,6 +104,14 @@ namespace ignition
       T::PreRender();
     }
 
+    /////////////////////////////////////////////////
+    template <class T>
+    bool BaseLightVisual<T>::PreRenderEveryFrame() const
+    {
+      // the light visual is updated in PreRender by derived classes
+      return true;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseLightVisual<T>::Init()
@@ -88,6 +88,16 @@ namespace ignition
       public: virtual void SetPoint(unsigned int _index,
                   const ignition::math::Vector3d &_value) override;
 
+      // Documentation inherited
+      public: virtual void SetPoints(const float *_positions,
+                  const ignition::math::Color *_colors,
+                  unsigned int _count) override;
+
+      // Documentation inherited
+      public: virtual void AppendPoints(const float *_positions,
+                  const ignition::math::Color *_colors,
+                  unsigned int _count) override;
+
       /// \brief Life time of a marker
       IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
       protected: std::chrono::steady_clock::duration lifetime =
@@ -227,6 +237,29 @@ namespace ignition
     {
       // no op
     }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseMarker<T>::SetPoints(const float *_positions,
+                  const ignition::math::Color *_colors, unsigned int _count)
+    {
+      this->ClearPoints();
+      this->AppendPoints(_positions, _colors, _count);
+    }
+
+    /////////////////////////////////////////////////
+    template <class T>
+    void BaseMarker<T>::AppendPoints(const float *_positions,
+                  const ignition::math::Color *_colors, unsigned int _count)
+    {
+      // fall back to adding the points one by one
+      for (unsigned int i = 0u; i < _count; ++i)
+      {
+        const float *p = _positions + i * 3u;
+        this->AddPoint(ignition::math::Vector3d(p[0], p[1], p[2]),
+            _colors ? _colors[i] : ignition::math::Color::White);
+      }
+    }
     }
   }
 }
@@ -24,6 +24,7 @@
 #include "ignition/rendering/Material.hh"
 #include "ignition/rendering/Scene.hh"
 #include "ignition/rendering/ShaderType.hh"
+#include "ignition/rendering/base/BaseScene.hh"
 
 namespace ignition
 {
@@ -321,6 +322,11 @@ namespace ignition
 
       protected: virtual void Reset();
 
+      /// \brief Mark this material as needing to be pre-rendered by the next
+      /// scene PreRender call. Engines call this when a property changes that
+      /// is only applied in PreRender.
+      protected: void SetPreRenderDirty();
+
       /// \brief Ambient color
       protected: math::Color ambient;
 
@@ -1023,6 +1029,19 @@ namespace ignition
       // do nothing
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseMaterial<T>::SetPreRenderDirty()
+    {
+      auto scene = std::dynamic_pointer_cast<BaseScene>(T::Scene());
+      if (!scene)
+        return;
+
+      auto material =
+          std::dynamic_pointer_cast<Material>(this->shared_from_this());
+      scene->SetMaterialPreRenderDirty(material);
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseMaterial<T>::SetDepthMaterial(const double /*far*/,
@@ -24,6 +24,7 @@
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/Storage.hh"
 #include "ignition/rendering/base/BaseObject.hh"
+#include "ignition/rendering/base/BaseScene.hh"
 
 namespace ignition
 {
@@ -305,10 +306,17 @@ namespace ignition
         subMesh->SetMaterial(_material, false);
       }
 
+      // become an owner of shared materials before releasing the current
+      // material, which may be the same
+      bool owner = _unique;
+      auto baseScene = std::dynamic_pointer_cast<BaseScene>(this->Scene());
+      if (!owner && baseScene)
+        owner = baseScene->AcquireMaterial(_material);
+
       if (this->material && this->ownsMaterial)
         this->Scene()->DestroyMaterial(this->material);
 
-      this->ownsMaterial = _unique;
+      this->ownsMaterial = owner;
       this->material = _material;
     }
 
@@ -436,13 +444,20 @@ namespace ignition
       MaterialPtr origMaterial = this->material;
       bool origUnique = this->ownsMaterial;
 
+      // become an owner of shared materials before releasing the original
+      // material, which may be the same
+      bool owner = _unique;
+      auto baseScene = std::dynamic_pointer_cast<BaseScene>(this->Scene());
+      if (!owner && baseScene)
+        owner = baseScene->AcquireMaterial(_material);
+
       this->SetMaterialImpl(_material);
 
       if (origMaterial && origUnique)
         this->Scene()->DestroyMaterial(origMaterial);
 
       this->material = _material;
-      this->ownsMaterial = _unique;
+      this->ownsMaterial = owner;
     }
 
     //////////////////////////////////////////////////
@@ -17,10 +17,12 @@
 #ifndef IGNITION_RENDERING_BASE_BASENODE_HH_
 #define IGNITION_RENDERING_BASE_BASENODE_HH_
 
+#include <cstdint>
 #include <map>
 #include <string>
 
 #include "ignition/rendering/Node.hh"
+#include "ignition/rendering/Sensor.hh"
 #include "ignition/rendering/Storage.hh"
 #include "ignition/rendering/base/BaseStorage.hh"
 
@@ -173,6 +175,16 @@ namespace ignition
 
       public: virtual void PreRender() override;
 
+      /// \brief Get whether this node, or one of its descendants, needs to
+      /// be visited by the next PreRender call.
+      /// \return True if the node needs to be pre-rendered
+      public: bool PreRenderDirty() const;
+
+      /// \brief Mark this node as needing to be visited by the next
+      /// PreRender call. Ancestors are marked as well so that the scene graph
+      /// traversal reaches this node.
+      public: void SetPreRenderDirty();
+
       // Documentation inherited
       public: virtual void SetUserData(const std::string &_key, Variant _value)
         override;
@@ -185,6 +197,50 @@ namespace ignition
 
       protected: virtual void PreRenderChildren();
 
+      /// \brief Get whether this node needs to be pre-rendered every frame,
+      /// even if it did not change. Subtrees in which no node needs to be
+      /// pre-rendered every frame are skipped by PreRender until
+      /// SetPreRenderDirty is called on one of their nodes.
+      /// \return True to pre-render this node every frame
+      protected: virtual bool PreRenderEveryFrame() const;
+
+      /// \brief Record that the local transform of this node changed and
+      /// notify the parent of this node that one of its descendants moved.
+      /// Called after the local pose or scale of this node changes. The
+      /// descendants are not visited, their world transform versions are
+      /// brought up to date when they are read.
+      /// \param[in] _scale True if the scale of this node changed
+      protected: void LocalTransformChanged(bool _scale);
+
+      /// \brief Get the version of the world pose and scale of this node.
+      /// The version changes when the local transform or the parent of this
+      /// node changes, or when the world transform of the parent changes.
+      /// Caches that depend on the world transform store the version and
+      /// compare it when they are read.
+      /// \return Version of the world transform of this node
+      protected: uint64_t WorldTransformVersion() const;
+
+      /// \brief Get the version of the world scale of this node. Same as
+      /// WorldTransformVersion but only changes when the world scale may
+      /// have changed.
+      /// \return Version of the world scale of this node
+      protected: uint64_t WorldScaleVersion() const;
+
+      /// \brief Called when a descendant of this node is added, removed or
+      /// moved. The default implementation does nothing.
+      protected: virtual void DescendantsChanged();
+
+      /// \brief Record that a child was just detached from this node
+      /// \param[in] _child Detached child
+      private: void ChildDetached(NodePtr _child);
+
+      /// \brief Record that the parent of this node changed
+      private: void ParentChanged();
+
+      /// \brief Bring the world transform versions of this node up to date
+      /// with its local transform and the versions of its parent
+      private: void UpdateWorldVersions() const;
+
       protected: virtual math::Pose3d RawLocalPose() const = 0;
 
       protected: virtual void SetRawLocalPose(const math::Pose3d &_pose) = 0;
@@ -212,6 +268,32 @@ namespace ignition
 
       /// \brief A map of custom key value data
       protected: std::map<std::string, Variant> userData;
+
+      /// \brief True if this node or one of its descendants needs to be
+      /// visited by the next PreRender call
+      protected: bool preRenderDirty = true;
+
+      /// \brief True if the local transform or the parent of this node
+      /// changed since the world transform versions were last updated
+      private: mutable bool localTransformDirty = true;
+
+      /// \brief True if the local scale or the parent of this node changed
+      /// since the world transform versions were last updated
+      private: mutable bool localScaleDirty = true;
+
+      /// \brief Version of the world transform of this node
+      private: mutable uint64_t worldTransformVersion = 0u;
+
+      /// \brief Version of the world scale of this node
+      private: mutable uint64_t worldScaleVersion = 0u;
+
+      /// \brief World transform version of the parent when the versions of
+      /// this node were last updated
+      private: mutable uint64_t parentTransformVersion = 0u;
+
+      /// \brief World scale version of the parent when the versions of this
+      /// node were last updated
+      private: mutable uint64_t parentScaleVersion = 0u;
     };
 
     //////////////////////////////////////////////////
@@ -254,6 +336,15 @@ namespace ignition
       if (this->AttachChild(_child))
       {
         this->Children()->Add(_child);
+
+        // make sure the next PreRender call reaches the new child
+        auto baseChild = std::dynamic_pointer_cast<BaseNode<T>>(_child);
+        if (!baseChild || baseChild->PreRenderDirty())
+          this->SetPreRenderDirty();
+
+        if (baseChild)
+          baseChild->ParentChanged();
+        this->DescendantsChanged();
       }
     }
 
@@ -262,7 +353,7 @@ namespace ignition
     NodePtr BaseNode<T>::RemoveChild(NodePtr _child)
     {
       NodePtr child = this->Children()->Remove(_child);
-      if (child) this->DetachChild(child);
+      if (child) this->ChildDetached(child);
       return child;
     }
 
@@ -271,7 +362,7 @@ namespace ignition
     NodePtr BaseNode<T>::RemoveChildById(unsigned int _id)
     {
       NodePtr child = this->Children()->RemoveById(_id);
-      if (child) this->DetachChild(child);
+      if (child) this->ChildDetached(child);
       return child;
     }
 
@@ -280,7 +371,7 @@ namespace ignition
     NodePtr BaseNode<T>::RemoveChildByName(const std::string &_name)
     {
       NodePtr child = this->Children()->RemoveByName(_name);
-      if (child) this->DetachChild(child);
+      if (child) this->ChildDetached(child);
       return child;
     }
 
@@ -289,7 +380,7 @@ namespace ignition
     NodePtr BaseNode<T>::RemoveChildByIndex(unsigned int _index)
     {
       NodePtr child = this->Children()->RemoveByIndex(_index);
-      if (child) this->DetachChild(child);
+      if (child) this->ChildDetached(child);
       return child;
     }
 
@@ -315,12 +406,61 @@ namespace ignition
     template <class T>
     void BaseNode<T>::PreRenderChildren()
     {
+      // only visit children whose subtree changed or needs to be
+      // pre-rendered every frame. Nodes marked dirty while the children are
+      // visited set preRenderDirty again.
+      this->preRenderDirty = false;
+      bool childDirty = false;
       unsigned int count = this->ChildCount();
 
       for (unsigned int i = 0; i < count; ++i)
       {
-        this->ChildByIndex(i)->PreRender();
+        NodePtr child = this->ChildByIndex(i);
+        auto baseChild = std::dynamic_pointer_cast<BaseNode<T>>(child);
+        if (baseChild && !baseChild->PreRenderDirty())
+          continue;
+
+        // sensors are pre-rendered every frame by the scene, see
+        // BaseScene::PreRender
+        if (std::dynamic_pointer_cast<Sensor>(child))
+          continue;
+
+        child->PreRender();
+        childDirty = childDirty || !baseChild || baseChild->PreRenderDirty();
       }
+
+      this->preRenderDirty = this->preRenderDirty || childDirty ||
+          this->PreRenderEveryFrame();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseNode<T>::PreRenderDirty() const
+    {
+      return this->preRenderDirty;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::SetPreRenderDirty()
+    {
+      this->preRenderDirty = true;
+
+      // Ancestors that are already dirty may be in the middle of visiting
+      // their children, so keep going up to the root
+      auto parent = std::dynamic_pointer_cast<BaseNode<T>>(this->Parent());
+      while (parent && parent.get() != this)
+      {
+        parent->preRenderDirty = true;
+        parent = std::dynamic_pointer_cast<BaseNode<T>>(parent->Parent());
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseNode<T>::PreRenderEveryFrame() const
+    {
+      return false;
     }
 
     //////////////////////////////////////////////////
@@ -353,6 +493,91 @@ namespace ignition
       }
 
       this->SetRawLocalPose(pose);
+      this->LocalTransformChanged(false);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::LocalTransformChanged(bool _scale)
+    {
+      this->localTransformDirty = true;
+      if (_scale)
+        this->localScaleDirty = true;
+
+      auto parent = std::dynamic_pointer_cast<BaseNode<T>>(this->Parent());
+      if (parent)
+        parent->DescendantsChanged();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    uint64_t BaseNode<T>::WorldTransformVersion() const
+    {
+      this->UpdateWorldVersions();
+      return this->worldTransformVersion;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    uint64_t BaseNode<T>::WorldScaleVersion() const
+    {
+      this->UpdateWorldVersions();
+      return this->worldScaleVersion;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::UpdateWorldVersions() const
+    {
+      uint64_t parentTransform = 0u;
+      uint64_t parentScale = 0u;
+      auto parent = std::dynamic_pointer_cast<BaseNode<T>>(this->Parent());
+      if (parent)
+      {
+        parent->UpdateWorldVersions();
+        parentTransform = parent->worldTransformVersion;
+        parentScale = parent->worldScaleVersion;
+      }
+
+      if (this->localTransformDirty || this->localScaleDirty ||
+          parentTransform != this->parentTransformVersion)
+      {
+        ++this->worldTransformVersion;
+      }
+      if (this->localScaleDirty || parentScale != this->parentScaleVersion)
+        ++this->worldScaleVersion;
+
+      this->parentTransformVersion = parentTransform;
+      this->parentScaleVersion = parentScale;
+      this->localTransformDirty = false;
+      this->localScaleDirty = false;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::DescendantsChanged()
+    {
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::ChildDetached(NodePtr _child)
+    {
+      this->DetachChild(_child);
+
+      auto baseChild = std::dynamic_pointer_cast<BaseNode<T>>(_child);
+      if (baseChild)
+        baseChild->ParentChanged();
+      this->DescendantsChanged();
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseNode<T>::ParentChanged()
+    {
+      // the versions of the old and new parents are not related
+      this->localTransformDirty = true;
+      this->localScaleDirty = true;
     }
 
     //////////////////////////////////////////////////
@@ -526,6 +751,7 @@ namespace ignition
     void BaseNode<T>::SetOrigin(const math::Vector3d &_origin)
     {
       this->origin = _origin;
+      this->LocalTransformChanged(false);
     }
 
     //////////////////////////////////////////////////
@@ -548,6 +774,9 @@ namespace ignition
     {
       math::Pose3d rawPose = this->LocalPose();
       this->SetLocalScaleImpl(_scale);
+
+      // SetLocalPose notifies the parent, only record the scale change here
+      this->localScaleDirty = true;
       this->SetLocalPose(rawPose);
     }
 
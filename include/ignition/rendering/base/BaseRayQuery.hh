@@ -17,6 +17,9 @@
 #ifndef IGNITION_RENDERING_BASE_BASERAYQUERY_HH_
 #define IGNITION_RENDERING_BASE_BASERAYQUERY_HH_
 
+#include <vector>
+
+#include <ignition/common/Console.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -62,11 +65,30 @@ namespace ignition
       // Documentation inherited
       public: virtual RayQueryResult ClosestPoint() override;
 
+      // Documentation inherited
+      public: virtual std::vector<RayQueryResult> ClosestPoints(
+                const CameraPtr &_camera,
+                const std::vector<math::Vector2d> &_coords) override;
+
+      // Documentation inherited
+      public: virtual void SetMode(RayQueryMode _mode) override;
+
+      // Documentation inherited
+      public: virtual RayQueryMode Mode() const override;
+
+      // Documentation inherited
+      public: virtual std::vector<RayQueryResult> ClosestPointsAlongRays(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions) override;
+
       /// \brief Ray origin
       protected: math::Vector3d origin;
 
       /// \brief Ray direction
       protected: math::Vector3d direction;
+
+      /// \brief Method used to compute intersections
+      protected: RayQueryMode mode = RQM_DEFAULT;
     };
 
     //////////////////////////////////////////////////
@@ -149,6 +171,60 @@ namespace ignition
       result.distance = -1;
       return result;
     }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    std::vector<RayQueryResult> BaseRayQuery<T>::ClosestPoints(
+        const CameraPtr &_camera, const std::vector<math::Vector2d> &_coords)
+    {
+      std::vector<RayQueryResult> results;
+      results.reserve(_coords.size());
+      for (const auto &coord : _coords)
+      {
+        this->SetFromCamera(_camera, coord);
+        results.push_back(this->ClosestPoint());
+      }
+      return results;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseRayQuery<T>::SetMode(RayQueryMode _mode)
+    {
+      this->mode = _mode;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    RayQueryMode BaseRayQuery<T>::Mode() const
+    {
+      return this->mode;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    std::vector<RayQueryResult> BaseRayQuery<T>::ClosestPointsAlongRays(
+        const std::vector<math::Vector3d> &_origins,
+        const std::vector<math::Vector3d> &_directions)
+    {
+      std::vector<RayQueryResult> results;
+      if (_origins.size() != _directions.size())
+      {
+        ignerr << "Number of ray origins [" << _origins.size()
+               << "] and directions [" << _directions.size()
+               << "] differ" << std::endl;
+        return results;
+      }
+
+      results.reserve(_origins.size());
+      for (unsigned int i = 0; i < _origins.size(); ++i)
+      {
+        this->SetOrigin(_origins[i]);
+        this->SetDirection(_directions[i]);
+        results.push_back(this->ClosestPoint());
+      }
+      return results;
+    }
     }
   }
 }
@@ -18,6 +18,8 @@
 #define IGNITION_RENDERING_BASE_BASESCENE_HH_
 
 #include <array>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -573,6 +575,36 @@ namespace ignition
 
       public: virtual void PreRender() override;
 
+      /// \brief Mark a material as needing to be pre-rendered by the next
+      /// PreRender call. Only materials that were marked since the last
+      /// PreRender call are pre-rendered. Unregistering a material unmarks it.
+      /// \param[in] _material Material to pre-render
+      public: void SetMaterialPreRenderDirty(MaterialPtr _material);
+
+      /// \brief Share the ownership of a material. Geometries that are
+      /// assigned the material afterwards, even without asking for a unique
+      /// copy, become owners of the material as well. The material is only
+      /// destroyed once all of its owners, including the current one, called
+      /// DestroyMaterial.
+      /// \param[in] _material Material to share
+      /// \sa AcquireMaterial
+      public: void ShareMaterial(MaterialPtr _material);
+
+      /// \brief Become an owner of a material, if its ownership is shared.
+      /// \param[in] _material Material to acquire
+      /// \return True if the material is shared and the caller is now one
+      /// of its owners, in which case it must call DestroyMaterial once it is
+      /// done with the material
+      /// \sa ShareMaterial
+      public: bool AcquireMaterial(MaterialPtr _material);
+
+      /// \brief Create a mesh from the descriptor of another mesh that
+      /// shares the materials of that mesh instead of copying them. See
+      /// ShareMaterial.
+      /// \param[in] _mesh Mesh to create an instance of
+      /// \return The new mesh, null if it could not be created
+      public: MeshPtr CreateMeshInstance(MeshPtr _mesh);
+
       public: virtual void Clear() override;
 
       public: virtual void Destroy() override;
@@ -590,6 +622,10 @@ namespace ignition
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      public: virtual void RenderSensors(
+                  const std::vector<CameraPtr> &_cameras) override;
+
       protected: virtual unsigned int CreateObjectId();
 
       protected: virtual std::string CreateObjectName(unsigned int _id,
@@ -715,6 +751,17 @@ namespace ignition
                      const std::string &_name,
                      const MeshDescriptor &_desc) = 0;
 
+      /// \brief Implementation for creating a mesh that shares the materials
+      /// of another mesh. The ownership of the materials is already shared.
+      /// The default implementation creates a mesh from the same descriptor
+      /// and assigns the materials to it.
+      /// \param[in] _id unique object id.
+      /// \param[in] _name unique object name.
+      /// \param[in] _mesh Mesh to create an instance of
+      /// \return The new mesh, null if it could not be created
+      protected: virtual MeshPtr CreateMeshInstanceImpl(unsigned int _id,
+                     const std::string &_name, MeshPtr _mesh);
+
       /// \brief Implementation for creating a capsule geometry object
       /// \param[in] _id unique object id.
       /// \param[in] _name unique object name.
@@ -858,6 +905,15 @@ namespace ignition
 
       IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
       private: NodeStorePtr nodes;
+
+      /// \brief Materials to pre-render in the next PreRender call, indexed
+      /// by material id
+      private: std::map<unsigned int, std::weak_ptr<Material>>
+          preRenderMaterials;
+
+      /// \brief Number of owners of the materials whose ownership is shared,
+      /// indexed by material id
+      private: std::map<unsigned int, unsigned int> materialOwners;
       IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
     };
     }
@@ -54,6 +54,12 @@ namespace ignition
           std::function<void(const uint8_t *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber) override;
 
+      // Documentation inherited
+      public: virtual ignition::common::ConnectionPtr
+        ConnectNewLabelIdFrame(
+          std::function<void(const uint32_t *, unsigned int,
+          unsigned int)> _subscriber) override;
+
       // Documentation inherited
       public: virtual void SetSegmentationType(
         SegmentationType _type) override;
@@ -136,6 +142,15 @@ namespace ignition
       return nullptr;
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    ignition::common::ConnectionPtr BaseSegmentationCamera<T>::
+      ConnectNewLabelIdFrame(
+          std::function<void(const uint32_t *, unsigned int, unsigned int)>)
+    {
+      return nullptr;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseSegmentationCamera<T>::SetSegmentationType(SegmentationType _type)
@@ -17,9 +17,12 @@
 #ifndef IGNITION_RENDERING_BASE_BASESTORAGE_HH_
 #define IGNITION_RENDERING_BASE_BASESTORAGE_HH_
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -80,7 +83,30 @@ namespace ignition
 
       protected: virtual bool IsValidIter(ConstUIter _iter) const;
 
+      /// \brief Erase an item from the map and its indices
+      /// \param[in] _iter Iterator to the item to erase
+      /// \return Iterator following the erased item
+      protected: UIter EraseImpl(UIter _iter);
+
+      /// \brief Insert an item into the ordered index at its key position
+      /// \param[in] _iter Iterator to the newly added item
+      protected: void IndexInsert(UIter _iter);
+
+      /// \brief Remove an item from the ordered index
+      /// \param[in] _iter Iterator to the item about to be erased
+      protected: void IndexErase(UIter _iter);
+
       protected: UMap map;
+
+      /// \brief Index of items by key, for constant time lookups
+      protected: std::unordered_map<std::string, UIter> keyIndex;
+
+      /// \brief Iterators to the items in key order, for constant time
+      /// access by index. Kept up to date by every add and remove, so const
+      /// accessors never modify it and are safe to call concurrently.
+      /// Appending or removing the last item is constant time, adding or
+      /// removing in the middle shifts the entries after it, O(n).
+      protected: std::vector<ConstUIter> orderedIndex;
     };
 
     //////////////////////////////////////////////////
@@ -191,7 +217,28 @@ namespace ignition
 
       protected: virtual UIter RemoveConstness(ConstUIter _iter);
 
+      /// \brief Insert an item into the ordered index at its name position
+      /// \param[in] _iter Iterator to the newly added item
+      protected: void IndexInsert(UIter _iter);
+
+      /// \brief Remove an item from the ordered index
+      /// \param[in] _iter Iterator to the item about to be erased
+      protected: void IndexErase(UIter _iter);
+
       protected: UStore store;
+
+      /// \brief Index of items by id, for constant time lookups
+      protected: std::unordered_map<unsigned int, UIter> idIndex;
+
+      /// \brief Index of items by name, for constant time lookups
+      protected: std::unordered_map<std::string, UIter> nameIndex;
+
+      /// \brief Iterators to the items in name order, for constant time
+      /// access by index. Kept up to date by every add and remove, so const
+      /// accessors never modify it and are safe to call concurrently.
+      /// Appending or removing the last item is constant time, adding or
+      /// removing in the middle shifts the entries after it, O(n).
+      protected: std::vector<ConstUIter> orderedIndex;
     };
 
     //////////////////////////////////////////////////
@@ -409,7 +456,7 @@ namespace ignition
     template <class T, class U>
     bool BaseMap<T, U>::ContainsKey(const std::string &_key) const
     {
-      return this->map.count(_key) > 0;
+      return this->keyIndex.count(_key) > 0;
     }
 
     //////////////////////////////////////////////////
@@ -472,7 +519,9 @@ namespace ignition
         return false;
       }
 
-      this->map[_key] = derived;
+      auto iter = this->map.emplace(_key, derived).first;
+      this->keyIndex[_key] = iter;
+      this->IndexInsert(iter);
       return true;
     }
 
@@ -480,11 +529,11 @@ namespace ignition
     template <class T, class U>
     void BaseMap<T, U>::Remove(const std::string &_key)
     {
-      auto iter = this->map.find(_key);
+      auto iter = this->keyIndex.find(_key);
 
-      if (this->IsValidIter(iter))
+      if (iter != this->keyIndex.end())
       {
-        this->map.erase(iter);
+        this->EraseImpl(iter->second);
       }
     }
 
@@ -498,7 +547,7 @@ namespace ignition
       {
         if (iter->second == _value)
         {
-          this->map.erase(iter);
+          iter = this->EraseImpl(iter);
           continue;
         }
 
@@ -511,6 +560,8 @@ namespace ignition
     void BaseMap<T, U>::RemoveAll()
     {
       this->map.clear();
+      this->keyIndex.clear();
+      this->orderedIndex.clear();
     }
 
     //////////////////////////////////////////////////
@@ -518,8 +569,8 @@ namespace ignition
     typename BaseMap<T, U>::UPtr
     BaseMap<T, U>::Derived(const std::string &_key) const
     {
-      auto iter = this->map.find(_key);
-      return (this->IsValidIter(iter)) ? iter->second : nullptr;
+      auto iter = this->keyIndex.find(_key);
+      return (iter != this->keyIndex.end()) ? iter->second->second : nullptr;
     }
 
     //////////////////////////////////////////////////
@@ -533,9 +584,7 @@ namespace ignition
         return nullptr;
       }
 
-      auto iter = this->map.begin();
-      std::advance(iter, _index);
-      return iter->second;
+      return this->orderedIndex[_index]->second;
     }
 
     //////////////////////////////////////////////////
@@ -545,6 +594,57 @@ namespace ignition
       return _iter != this->map.end();
     }
 
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    typename BaseMap<T, U>::UIter
+    BaseMap<T, U>::EraseImpl(UIter _iter)
+    {
+      this->IndexErase(_iter);
+
+      this->keyIndex.erase(_iter->first);
+      return this->map.erase(_iter);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    void BaseMap<T, U>::IndexInsert(UIter _iter)
+    {
+      // appending is the common case, avoid the search
+      if (std::next(_iter) == this->map.end())
+      {
+        this->orderedIndex.push_back(_iter);
+        return;
+      }
+
+      auto pos = std::lower_bound(this->orderedIndex.begin(),
+          this->orderedIndex.end(), _iter->first,
+          [](ConstUIter _item, const std::string &_key)
+          {
+            return _item->first < _key;
+          });
+      this->orderedIndex.insert(pos, _iter);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    void BaseMap<T, U>::IndexErase(UIter _iter)
+    {
+      if (!this->orderedIndex.empty() && this->orderedIndex.back() == _iter)
+      {
+        this->orderedIndex.pop_back();
+        return;
+      }
+
+      auto pos = std::lower_bound(this->orderedIndex.begin(),
+          this->orderedIndex.end(), _iter->first,
+          [](ConstUIter _item, const std::string &_key)
+          {
+            return _item->first < _key;
+          });
+      if (pos != this->orderedIndex.end() && *pos == _iter)
+        this->orderedIndex.erase(pos);
+    }
+
     //////////////////////////////////////////////////
     template <class T, class U>
     BaseStore<T, U>::BaseStore()
@@ -689,6 +789,9 @@ namespace ignition
     void BaseStore<T, U>::RemoveAll()
     {
       this->store.clear();
+      this->idIndex.clear();
+      this->nameIndex.clear();
+      this->orderedIndex.clear();
     }
 
     //////////////////////////////////////////////////
@@ -816,18 +919,15 @@ namespace ignition
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIter(ConstTPtr _object) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
+      if (!_object)
+        return this->store.end();
 
-      for (auto iter = begin; iter != end; ++iter)
-      {
-        if (iter->second == _object)
-        {
-          return iter;
-        }
-      }
+      // look up by id and make sure it is the same object
+      auto iter = this->ConstIterById(_object->Id());
+      if (this->IsValidIter(iter) && iter->second == _object)
+        return iter;
 
-      return end;
+      return this->store.end();
     }
 
     //////////////////////////////////////////////////
@@ -835,18 +935,8 @@ namespace ignition
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIterById(unsigned int _id) const
     {
-      auto begin = this->store.begin();
-      auto end = this->store.end();
-
-      for (auto iter = begin; iter != end; ++iter)
-      {
-        if (iter->second->Id() == _id)
-        {
-          return iter;
-        }
-      }
-
-      return end;
+      auto iter = this->idIndex.find(_id);
+      return (iter != this->idIndex.end()) ? iter->second : this->store.end();
     }
 
     //////////////////////////////////////////////////
@@ -854,7 +944,9 @@ namespace ignition
     typename BaseStore<T, U>::ConstUIter
     BaseStore<T, U>::ConstIterByName(const std::string &_name) const
     {
-      return this->store.find(_name);
+      auto iter = this->nameIndex.find(_name);
+      return (iter != this->nameIndex.end()) ?
+          iter->second : this->store.end();
     }
 
     //////////////////////////////////////////////////
@@ -868,9 +960,7 @@ namespace ignition
         return this->store.end();
       }
 
-      auto iter = this->store.begin();
-      std::advance(iter, _index);
-      return iter;
+      return this->orderedIndex[_index];
     }
 
     //////////////////////////////////////////////////
@@ -929,7 +1019,10 @@ namespace ignition
         return false;
       }
 
-      this->store[name] = _object;
+      auto iter = this->store.emplace(name, _object).first;
+      this->idIndex[id] = iter;
+      this->nameIndex[name] = iter;
+      this->IndexInsert(iter);
       return true;
     }
 
@@ -943,7 +1036,11 @@ namespace ignition
         return nullptr;
       }
 
+      this->IndexErase(_iter);
+
       UPtr result = _iter->second;
+      this->idIndex.erase(result->Id());
+      this->nameIndex.erase(_iter->first);
       this->store.erase(_iter);
       return result;
     }
@@ -972,6 +1069,46 @@ namespace ignition
           this->store.erase(_iter, _iter) : this->store.end();
     }
 
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    void BaseStore<T, U>::IndexInsert(UIter _iter)
+    {
+      // appending is the common case, avoid the search
+      if (std::next(_iter) == this->store.end())
+      {
+        this->orderedIndex.push_back(_iter);
+        return;
+      }
+
+      auto pos = std::lower_bound(this->orderedIndex.begin(),
+          this->orderedIndex.end(), _iter->first,
+          [](ConstUIter _item, const std::string &_key)
+          {
+            return _item->first < _key;
+          });
+      this->orderedIndex.insert(pos, _iter);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T, class U>
+    void BaseStore<T, U>::IndexErase(UIter _iter)
+    {
+      if (!this->orderedIndex.empty() && this->orderedIndex.back() == _iter)
+      {
+        this->orderedIndex.pop_back();
+        return;
+      }
+
+      auto pos = std::lower_bound(this->orderedIndex.begin(),
+          this->orderedIndex.end(), _iter->first,
+          [](ConstUIter _item, const std::string &_key)
+          {
+            return _item->first < _key;
+          });
+      if (pos != this->orderedIndex.end() && *pos == _iter)
+        this->orderedIndex.erase(pos);
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     BaseCompositeStore<T>::BaseCompositeStore()
@@ -17,14 +17,18 @@
 #ifndef IGNITION_RENDERING_BASE_BASEVISUAL_HH_
 #define IGNITION_RENDERING_BASE_BASEVISUAL_HH_
 
+#include <cstdint>
 #include <map>
 #include <string>
 
 #include <ignition/math/AxisAlignedBox.hh>
 
+#include "ignition/rendering/Mesh.hh"
 #include "ignition/rendering/Visual.hh"
 #include "ignition/rendering/Storage.hh"
 #include "ignition/rendering/RenderEngine.hh"
+#include "ignition/rendering/Sensor.hh"
+#include "ignition/rendering/base/BaseScene.hh"
 #include "ignition/rendering/base/BaseStorage.hh"
 
 namespace ignition
@@ -118,10 +122,71 @@ namespace ignition
       public: virtual VisualPtr Clone(const std::string &_name,
                   NodePtr _newParent) const override;
 
+      // Documentation inherited.
+      public: virtual VisualPtr CloneInstance(const std::string &_name,
+                  NodePtr _newParent) const override;
+
       protected: virtual void PreRenderChildren() override;
 
       protected: virtual void PreRenderGeometries();
 
+      /// \brief Visuals only need to be pre-rendered when they, their
+      /// children or their geometries change. Visuals that need to be
+      /// pre-rendered every frame must override this function.
+      /// \return False
+      protected: virtual bool PreRenderEveryFrame() const override;
+
+      /// \brief Compute the world frame bounding box of this visual and
+      /// its descendants. Called by BoundingBox when the cached box is out of
+      /// date. The default implementation merges the bounding boxes of the
+      /// child visuals.
+      /// \return Axis aligned bounding box in the world frame
+      protected: virtual ignition::math::AxisAlignedBox BoundingBoxImpl()
+              const;
+
+      /// \brief Compute the local frame bounding box of this visual and its
+      /// descendants. Called by LocalBoundingBox when the cached box is out
+      /// of date. The default implementation merges the local bounding boxes
+      /// of the child visuals.
+      /// \return Axis aligned bounding box in the local frame
+      protected: virtual ignition::math::AxisAlignedBox LocalBoundingBoxImpl()
+              const;
+
+      /// \brief Get whether the bounds of the geometries attached to this
+      /// visual only change when geometries are added or removed. Bounding
+      /// boxes of subtrees that contain a visual without static bounds are
+      /// not cached. The default implementation returns true if the visual
+      /// is not pre-rendered every frame and all geometries are meshes.
+      /// \return True if the bounds of the attached geometries are static
+      protected: virtual bool HasStaticBounds() const;
+
+      /// \brief Invalidate the cached bounding boxes of this visual and of
+      /// its ancestors. Derived classes must call this when something that
+      /// affects the bounds, other than a pose or scale, changes.
+      /// \param[in] _descendants True to invalidate the bounding boxes of
+      /// all descendant visuals as well, e.g. when the visibility of the
+      /// whole subtree changes
+      protected: void MarkBoundingBoxDirty(bool _descendants = false);
+
+      // Documentation inherited.
+      protected: virtual void DescendantsChanged() override;
+
+      /// \brief Get whether this visual or one of its descendant visuals
+      /// does not have static bounds
+      /// \return True if the bounding boxes of this visual cannot be cached
+      /// \sa HasStaticBounds
+      private: bool BoundsVolatile() const;
+
+      /// \brief Clone the visual and its children
+      /// \param[in] _name Name of the cloned visual
+      /// \param[in] _newParent Parent of the cloned visual
+      /// \param[in] _instance True to share the materials with the cloned
+      /// visual instead of copying them
+      /// \return The cloned visual, nullptr if cloning failed
+      /// \sa Clone, CloneInstance
+      private: VisualPtr CloneImpl(const std::string &_name,
+                  NodePtr _newParent, bool _instance) const;
+
       protected: virtual GeometryStorePtr Geometries() const = 0;
 
       protected: virtual bool AttachGeometry(GeometryPtr _geometry) = 0;
@@ -137,6 +202,30 @@ namespace ignition
       /// \brief The bounding box of the visual
       protected: ignition::math::AxisAlignedBox boundingBox;
 
+      /// \brief Cached world frame bounding box of the visual
+      private: mutable ignition::math::AxisAlignedBox worldBoundingBox;
+
+      /// \brief Cached local frame bounding box of the visual
+      private: mutable ignition::math::AxisAlignedBox localBoundingBox;
+
+      /// \brief True if worldBoundingBox needs to be recomputed
+      private: mutable bool worldBoundingBoxDirty = true;
+
+      /// \brief World transform version worldBoundingBox was computed with
+      private: mutable uint64_t worldBoundingBoxVersion = 0u;
+
+      /// \brief True if localBoundingBox needs to be recomputed
+      private: mutable bool localBoundingBoxDirty = true;
+
+      /// \brief World scale version localBoundingBox was computed with
+      private: mutable uint64_t localBoundingBoxVersion = 0u;
+
+      /// \brief Cached result of BoundsVolatile
+      private: mutable bool boundsVolatile = true;
+
+      /// \brief True if boundsVolatile needs to be recomputed
+      private: mutable bool boundsVolatileDirty = true;
+
       /// \brief True if wireframe mode is enabled else false
       protected: bool wireframe = false;
     };
@@ -179,6 +268,7 @@ namespace ignition
       }
 
       this->SetRawLocalPose(rawPose);
+      this->LocalTransformChanged(false);
     }
 
     //////////////////////////////////////////////////
@@ -209,6 +299,8 @@ namespace ignition
       if (this->AttachGeometry(_geometry))
       {
         this->Geometries()->Add(_geometry);
+        this->SetPreRenderDirty();
+        this->MarkBoundingBoxDirty();
       }
     }
 
@@ -219,6 +311,7 @@ namespace ignition
       if (this->DetachGeometry(_geometry))
       {
         this->Geometries()->Remove(_geometry);
+        this->MarkBoundingBoxDirty();
       }
       return _geometry;
     }
@@ -306,8 +399,8 @@ namespace ignition
     template <class T>
     void BaseVisual<T>::PreRender()
     {
+      // T::PreRender pre-renders the children
       T::PreRender();
-      this->PreRenderChildren();
       this->PreRenderGeometries();
     }
 
@@ -333,10 +426,28 @@ namespace ignition
         ignerr << "Cast failed in BaseVisual::PreRenderChildren" << std::endl;
         return;
       }
+
+      // only visit children whose subtree changed or needs to be
+      // pre-rendered every frame. Nodes marked dirty while the children are
+      // visited set preRenderDirty again.
+      this->preRenderDirty = false;
+      bool childDirty = false;
       for (auto it = children_->Begin(); it != children_->End(); ++it)
       {
+        if (!it->second->PreRenderDirty())
+          continue;
+
+        // sensors are pre-rendered every frame by the scene, see
+        // BaseScene::PreRender
+        if (std::dynamic_pointer_cast<Sensor>(it->second))
+          continue;
+
         it->second->PreRender();
+        childDirty = childDirty || it->second->PreRenderDirty();
       }
+
+      this->preRenderDirty = this->preRenderDirty || childDirty ||
+          this->PreRenderEveryFrame();
     }
 
     //////////////////////////////////////////////////
@@ -349,9 +460,22 @@ namespace ignition
       {
         GeometryPtr geometry = this->GeometryByIndex(i);
         geometry->PreRender();
+
+        // Meshes only update their materials in PreRender, which is also
+        // done by Scene::PreRender. Other geometries, e.g. markers, text and
+        // particle emitters, may need to be updated every frame.
+        if (!std::dynamic_pointer_cast<Mesh>(geometry))
+          this->preRenderDirty = true;
       }
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseVisual<T>::PreRenderEveryFrame() const
+    {
+      return false;
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     bool BaseVisual<T>::Wireframe() const
@@ -380,6 +504,38 @@ namespace ignition
     //////////////////////////////////////////////////
     template <class T>
     ignition::math::AxisAlignedBox BaseVisual<T>::LocalBoundingBox() const
+    {
+      // the local bounding box is relative to the pose of this visual but
+      // it does depend on its world scale
+      uint64_t version = this->WorldScaleVersion();
+      if (this->localBoundingBoxDirty ||
+          version != this->localBoundingBoxVersion || this->BoundsVolatile())
+      {
+        this->localBoundingBox = this->LocalBoundingBoxImpl();
+        this->localBoundingBoxDirty = false;
+        this->localBoundingBoxVersion = version;
+      }
+      return this->localBoundingBox;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    ignition::math::AxisAlignedBox BaseVisual<T>::BoundingBox() const
+    {
+      uint64_t version = this->WorldTransformVersion();
+      if (this->worldBoundingBoxDirty ||
+          version != this->worldBoundingBoxVersion || this->BoundsVolatile())
+      {
+        this->worldBoundingBox = this->BoundingBoxImpl();
+        this->worldBoundingBoxDirty = false;
+        this->worldBoundingBoxVersion = version;
+      }
+      return this->worldBoundingBox;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    ignition::math::AxisAlignedBox BaseVisual<T>::LocalBoundingBoxImpl() const
     {
       ignition::math::AxisAlignedBox box;
 
@@ -408,7 +564,7 @@ namespace ignition
 
     //////////////////////////////////////////////////
     template <class T>
-    ignition::math::AxisAlignedBox BaseVisual<T>::BoundingBox() const
+    ignition::math::AxisAlignedBox BaseVisual<T>::BoundingBoxImpl() const
     {
       ignition::math::AxisAlignedBox box;
 
@@ -431,6 +587,78 @@ namespace ignition
       return box;
     }
 
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseVisual<T>::HasStaticBounds() const
+    {
+      // visuals that are updated every frame may change their bounds
+      if (this->PreRenderEveryFrame())
+        return false;
+
+      for (unsigned int i = 0; i < this->GeometryCount(); ++i)
+      {
+        if (!std::dynamic_pointer_cast<Mesh>(this->GeometryByIndex(i)))
+          return false;
+      }
+      return true;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    bool BaseVisual<T>::BoundsVolatile() const
+    {
+      if (!this->boundsVolatileDirty)
+        return this->boundsVolatile;
+
+      bool result = !this->HasStaticBounds();
+      auto childNodes =
+          std::dynamic_pointer_cast<BaseStore<ignition::rendering::Node, T>>(
+          this->Children());
+      if (childNodes)
+      {
+        for (auto it = childNodes->Begin();
+            !result && it != childNodes->End(); ++it)
+        {
+          auto visual = std::dynamic_pointer_cast<BaseVisual<T>>(it->second);
+          result = visual && visual->BoundsVolatile();
+        }
+      }
+
+      this->boundsVolatile = result;
+      this->boundsVolatileDirty = false;
+      return result;
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseVisual<T>::MarkBoundingBoxDirty(bool _descendants)
+    {
+      // the boxes of the descendants are checked against the world
+      // transform versions when they are read
+      if (_descendants)
+        this->LocalTransformChanged(true);
+
+      // the bounds of all ancestor visuals include this visual
+      this->worldBoundingBoxDirty = true;
+      this->localBoundingBoxDirty = true;
+      this->boundsVolatileDirty = true;
+      auto parent = std::dynamic_pointer_cast<BaseVisual<T>>(this->Parent());
+      while (parent && parent.get() != this)
+      {
+        parent->worldBoundingBoxDirty = true;
+        parent->localBoundingBoxDirty = true;
+        parent->boundsVolatileDirty = true;
+        parent = std::dynamic_pointer_cast<BaseVisual<T>>(parent->Parent());
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    void BaseVisual<T>::DescendantsChanged()
+    {
+      this->MarkBoundingBoxDirty();
+    }
+
     //////////////////////////////////////////////////
     template <class T>
     void BaseVisual<T>::AddVisibilityFlags(uint32_t _flags)
@@ -450,6 +678,7 @@ namespace ignition
     void BaseVisual<T>::SetVisibilityFlags(uint32_t _flags)
     {
       this->visibilityFlags = _flags;
+      this->MarkBoundingBoxDirty();
 
       // recursively set child visuals' visibility flags
       auto childNodes =
@@ -480,6 +709,22 @@ namespace ignition
     template <class T>
     VisualPtr BaseVisual<T>::Clone(const std::string &_name,
         NodePtr _newParent) const
+    {
+      return this->CloneImpl(_name, _newParent, false);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    VisualPtr BaseVisual<T>::CloneInstance(const std::string &_name,
+        NodePtr _newParent) const
+    {
+      return this->CloneImpl(_name, _newParent, true);
+    }
+
+    //////////////////////////////////////////////////
+    template <class T>
+    VisualPtr BaseVisual<T>::CloneImpl(const std::string &_name,
+        NodePtr _newParent, bool _instance) const
     {
       ScenePtr scene_ = this->Scene();
       if (nullptr == scene_)
@@ -530,7 +775,13 @@ namespace ignition
         VisualPtr visual = std::dynamic_pointer_cast<Visual>(child);
         // recursively delete all cloned visuals if the child cannot be
         // retrieved, or if cloning the child visual failed
-        if (!visual || !visual->Clone("", result))
+        VisualPtr clone;
+        if (visual)
+        {
+          clone = _instance ? visual->CloneInstance("", result) :
+              visual->Clone("", result);
+        }
+        if (!clone)
         {
           ignerr << "Cloning a child visual failed.\n";
           scene_->DestroyVisual(result, true);
@@ -539,10 +790,36 @@ namespace ignition
       }
 
       for (unsigned int i = 0; i < this->GeometryCount(); ++i)
-        result->AddGeometry(this->GeometryByIndex(i)->Clone());
+      {
+        GeometryPtr geometry = this->GeometryByIndex(i);
+        if (!_instance)
+        {
+          result->AddGeometry(geometry->Clone());
+          continue;
+        }
+
+        // create meshes from the same descriptor that share the materials,
+        // so the instances use the same vertex data and material as this
+        // visual. Other geometries get their own copy of the material.
+        MeshPtr mesh = std::dynamic_pointer_cast<Mesh>(geometry);
+        auto baseScene = std::dynamic_pointer_cast<BaseScene>(scene_);
+        GeometryPtr instance;
+        if (mesh && !mesh->Descriptor().meshName.empty() && baseScene)
+          instance = baseScene->CreateMeshInstance(mesh);
+        else
+          instance = geometry->Clone();
+
+        if (!instance)
+        {
+          ignerr << "Cloning a geometry failed.\n";
+          scene_->DestroyVisual(result, true);
+          return nullptr;
+        }
+        result->AddGeometry(instance);
+      }
 
       if (this->Material())
-        result->SetMaterial(this->Material());
+        result->SetMaterial(this->Material(), !_instance);
 
       for (const auto &[key, val] : this->userData)
         result->SetUserData(key, val);
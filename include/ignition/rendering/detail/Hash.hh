@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_RENDERING_DETAIL_HASH_HH_
+#define IGNITION_RENDERING_DETAIL_HASH_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ignition/rendering/config.hh"
+
+namespace ignition
+{
+  namespace rendering
+  {
+    inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Offset basis of the 64 bit FNV-1a hash, the hash of no bytes
+      constexpr uint64_t kFnv1aOffset = 14695981039346656037ull;
+
+      /// \internal
+      /// \brief Hash bytes with the 64 bit FNV-1a function. Used to build
+      /// keys of on-disk caches, so the result must not change between
+      /// versions or platforms.
+      /// \param[in] _data Bytes to hash
+      /// \param[in] _size Number of bytes to hash
+      /// \param[in] _hash Hash of the previous bytes, kFnv1aOffset for the
+      /// first ones. It has no default so that a string literal followed by
+      /// a hash does not resolve to this overload.
+      /// \return Hash of the previous bytes followed by _data
+      inline uint64_t fnv1a(const void *_data, size_t _size, uint64_t _hash)
+      {
+        const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+        for (size_t i = 0u; i < _size; ++i)
+        {
+          _hash ^= bytes[i];
+          _hash *= 1099511628211ull;
+        }
+        return _hash;
+      }
+
+      /// \internal
+      /// \brief Hash the characters of a string with the 64 bit FNV-1a
+      /// function
+      /// \param[in] _data String to hash
+      /// \param[in] _hash Hash of the previous bytes
+      /// \return Hash of the previous bytes followed by _data
+      inline uint64_t fnv1a(const std::string &_data,
+          uint64_t _hash = kFnv1aOffset)
+      {
+        return fnv1a(_data.data(), _data.size(), _hash);
+      }
+    }
+    }
+  }
+}
+#endif
@@ -63,6 +63,14 @@ namespace ignition
       public: void AddPoint(const double _x, const double _y, const double _z,
             const ignition::math::Color &_color = ignition::math::Color::White);
 
+      /// \brief Add several points to the point list at once
+      /// \param[in] _positions Point positions, x y z for each point
+      /// \param[in] _colors Point colors, one for each point. If null,
+      /// the points are white.
+      /// \param[in] _count Number of points
+      public: void AddPoints(const float *_positions,
+                  const ignition::math::Color *_colors, unsigned int _count);
+
       /// \brief Change the location of an existing point in the point list
       /// \param[in] _index Index of the point to set
       /// \param[in] _value ignition::math::Vector3d value to set the point to
@@ -69,6 +69,16 @@ namespace ignition
       public: virtual void AddPoint(const ignition::math::Vector3d &_pt,
                            const ignition::math::Color &_color) override;
 
+      // Documentation inherited
+      public: virtual void SetPoints(const float *_positions,
+                           const ignition::math::Color *_colors,
+                           unsigned int _count) override;
+
+      // Documentation inherited
+      public: virtual void AppendPoints(const float *_positions,
+                           const ignition::math::Color *_colors,
+                           unsigned int _count) override;
+
       // Documentation inherited
       public: virtual void ClearPoints() override;
 
@@ -17,9 +17,12 @@
 #ifndef IGNITION_RENDERING_OGRE_OGREMESHFACTORY_HH_
 #define IGNITION_RENDERING_OGRE_OGREMESHFACTORY_HH_
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "ignition/rendering/Bvh.hh"
 #include "ignition/rendering/MeshDescriptor.hh"
 #include "ignition/rendering/ogre/OgreRenderTypes.hh"
 #include "ignition/rendering/ogre/Export.hh"
@@ -60,11 +63,24 @@ namespace ignition
       /// \param[in] _name Name of the template material to remove.
       public: void ClearMaterialsCache(const std::string &_name);
 
+      /// \brief Get the bounding volume hierarchy over the triangles of a
+      /// mesh created by this factory, in the mesh frame. It is built when
+      /// the mesh is first created, while its triangles are known to be
+      /// available, and kept with the factory.
+      /// \param[in] _name Name of the ogre mesh
+      /// \return Triangle hierarchy or null if the mesh was not created by
+      /// this factory
+      public: std::shared_ptr<MeshBvh> TriangleBvh(const std::string &_name);
+
       protected: OgreScenePtr scene;
 
       /// \brief Vector with the template materials, we keep the pointer to be
       /// able to remove it when nobody is using it.
       protected: std::vector<MaterialPtr> materialCache;
+
+      /// \brief Triangle hierarchies of the meshes created by this factory,
+      /// indexed by ogre mesh name
+      protected: std::map<std::string, std::shared_ptr<MeshBvh>> triangleBvhs;
     };
 
     class IGNITION_RENDERING_OGRE_VISIBLE OgreSubMeshStoreFactory
@@ -18,6 +18,7 @@
 #define IGNITION_RENDERING_OGRE_OGRERAYQUERY_HH_
 
 #include <memory>
+#include <vector>
 
 #include "ignition/rendering/base/BaseRayQuery.hh"
 #include "ignition/rendering/ogre/OgreIncludes.hh"
@@ -52,6 +53,21 @@ namespace ignition
       // Documentation inherited
       public: virtual RayQueryResult ClosestPoint();
 
+      // Documentation inherited
+      public: virtual std::vector<RayQueryResult> ClosestPointsAlongRays(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions);
+
+      /// \brief Get the closest point of each ray by testing the triangles
+      /// of the mesh hierarchies kept by the mesh factory, visited through a
+      /// hierarchy over the bounding boxes of the entities of the scene.
+      /// \param[in] _origins Origin of each ray
+      /// \param[in] _directions Direction of each ray
+      /// \return Closest intersection of each ray
+      private: std::vector<RayQueryResult> ClosestPointsByBvh(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions);
+
       /// \brief Get the mesh information for the given mesh.
       /// \param[in] _mesh Mesh to get info about.
       /// \param[out] _vertexCount Number of vertices in the mesh.
@@ -242,6 +242,9 @@ namespace ignition
       protected: Ogre::SceneManager *ogreSceneManager;
 
       private: friend class OgreRenderEngine;
+
+      /// \brief Make ray query our friend so it can use the mesh factory
+      private: friend class OgreRayQuery;
     };
     }
   }
@@ -53,11 +53,11 @@ namespace ignition
       public: virtual void SetVisibilityFlags(uint32_t _flags) override;
 
       // Documentation inherited.
-      public: virtual ignition::math::AxisAlignedBox LocalBoundingBox()
-              const override;
+      protected: virtual ignition::math::AxisAlignedBox
+              LocalBoundingBoxImpl() const override;
 
       // Documentation inherited.
-      public: virtual ignition::math::AxisAlignedBox BoundingBox()
+      protected: virtual ignition::math::AxisAlignedBox BoundingBoxImpl()
               const override;
 
       /// \brief Recursively loop through this visual's children
@@ -70,6 +70,17 @@ namespace ignition
                      ignition::math::AxisAlignedBox &_box, bool _local,
                      const ignition::math::Pose3d &_pose) const;
 
+      /// \brief Merge the bounding boxes of the objects attached to this
+      /// visual, excluding child visuals.
+      /// \param[in,out] _box The bounding box.
+      /// \param[in] _local A flag indicating if the local bounding box is to
+      /// be calculated.
+      /// \param[in] _pose World pose of the visual the local bounding box is
+      /// relative to
+      private: void AttachedObjectBounds(
+                     ignition::math::AxisAlignedBox &_box, bool _local,
+                     const ignition::math::Pose3d &_pose) const;
+
       /// \brief Wrapper function for BoundsHelper to reduce redundant
       /// world pose access
       /// \param[in,out] _box The bounding box.
@@ -72,6 +72,31 @@ void OgreDynamicLines::AddPoint(double _x, double _y,
   this->AddPoint(ignition::math::Vector3d(_x, _y, _z), _color);
 }
 
+/////////////////////////////////////////////////
+void OgreDynamicLines::AddPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->points.reserve(this->dataPtr->points.size() + _count);
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const float *p = _positions + i * 3u;
+    this->dataPtr->points.push_back(
+        ignition::math::Vector3d(p[0], p[1], p[2]));
+  }
+
+  if (_colors)
+  {
+    this->dataPtr->colors.insert(this->dataPtr->colors.end(), _colors,
+        _colors + _count);
+  }
+  else
+  {
+    this->dataPtr->colors.resize(this->dataPtr->colors.size() + _count,
+        ignition::math::Color::White);
+  }
+  this->dataPtr->dirty = true;
+}
+
 /////////////////////////////////////////////////
 void OgreDynamicLines::SetPoint(unsigned int _index,
                             const ignition::math::Vector3d &_value)
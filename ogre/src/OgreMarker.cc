@@ -235,6 +235,21 @@ void OgreMarker::AddPoint(const ignition::math::Vector3d &_pt,
   this->dataPtr->dynamicRenderable->AddPoint(_pt, _color);
 }
 
+//////////////////////////////////////////////////
+void OgreMarker::SetPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->dynamicRenderable->Clear();
+  this->dataPtr->dynamicRenderable->AddPoints(_positions, _colors, _count);
+}
+
+//////////////////////////////////////////////////
+void OgreMarker::AppendPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->dynamicRenderable->AddPoints(_positions, _colors, _count);
+}
+
 //////////////////////////////////////////////////
 void OgreMarker::ClearPoints()
 {
@@ -358,6 +358,12 @@ void OgreMaterial::SetShaderType(enum ShaderType _type)
 void OgreMaterial::PreRender()
 {
   this->UpdateShaderParams();
+
+  // shader params can be changed through the pointers returned by
+  // VertexShaderParams and FragmentShaderParams at any time, so keep
+  // checking them every frame
+  if (this->vertexShaderParams || this->fragmentShaderParams)
+    this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -457,6 +463,7 @@ void OgreMaterial::SetVertexShader(const std::string &_path)
 
   this->vertexShaderPath = _path;
   this->vertexShaderParams.reset(new ShaderParams);
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -508,6 +515,7 @@ void OgreMaterial::SetFragmentShader(const std::string &_path)
 
   this->fragmentShaderPath = _path;
   this->fragmentShaderParams.reset(new ShaderParams);
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
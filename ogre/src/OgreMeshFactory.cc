@@ -80,6 +80,12 @@ Ogre::Entity *OgreMeshFactory::OgreEntity(const MeshDescriptor &_desc)
 
   std::string name = this->MeshName(_desc);
   Ogre::SceneManager *sceneManager = this->scene->OgreSceneManager();
+
+  // build the triangle hierarchy while the mesh is known to be alive, the
+  // descriptor only points to a mesh that may be freed later on
+  if (_desc.mesh && !this->triangleBvhs.count(name))
+    this->triangleBvhs[name] = std::make_shared<MeshBvh>(_desc);
+
   return sceneManager->createEntity(name);
 }
 
@@ -125,6 +131,16 @@ void OgreMeshFactory::ClearMaterialsCache(const std::string &_name)
     this->materialCache.erase(it);
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<MeshBvh> OgreMeshFactory::TriangleBvh(
+    const std::string &_name)
+{
+  auto bvhIt = this->triangleBvhs.find(_name);
+  if (bvhIt == this->triangleBvhs.end())
+    return nullptr;
+  return bvhIt->second;
+}
+
 //////////////////////////////////////////////////
 bool OgreMeshFactory::LoadImpl(const MeshDescriptor &_desc)
 {
@@ -235,6 +235,7 @@ void OgreNode::SetInheritScale(bool _inherit)
     return;
 
   this->ogreNode->setInheritScale(_inherit);
+  this->LocalTransformChanged(true);
 }
 
 //////////////////////////////////////////////////
@@ -15,13 +15,19 @@
  *
  */
 
+#include <memory>
 #include <typeinfo>
+#include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Matrix4.hh>
 
+#include "ignition/rendering/Bvh.hh"
 #include "ignition/rendering/ogre/OgreIncludes.hh"
 #include "ignition/rendering/ogre/OgreCamera.hh"
 #include "ignition/rendering/ogre/OgreConversions.hh"
+#include "ignition/rendering/ogre/OgreMeshFactory.hh"
 #include "ignition/rendering/ogre/OgreRayQuery.hh"
 #include "ignition/rendering/ogre/OgreScene.hh"
 
@@ -62,6 +68,9 @@ void OgreRayQuery::SetFromCamera(const CameraPtr &_camera,
 //////////////////////////////////////////////////
 RayQueryResult OgreRayQuery::ClosestPoint()
 {
+  if (this->mode == RQM_BVH)
+    return this->ClosestPointsByBvh({this->origin}, {this->direction})[0];
+
   RayQueryResult result;
   OgreScenePtr ogreScene = std::dynamic_pointer_cast<OgreScene>(this->Scene());
   if (!ogreScene)
@@ -149,6 +158,113 @@ RayQueryResult OgreRayQuery::ClosestPoint()
   return result;
 }
 
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> OgreRayQuery::ClosestPointsAlongRays(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions)
+{
+  if (this->mode != RQM_BVH || _origins.size() != _directions.size())
+    return BaseRayQuery::ClosestPointsAlongRays(_origins, _directions);
+
+  return this->ClosestPointsByBvh(_origins, _directions);
+}
+
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> OgreRayQuery::ClosestPointsByBvh(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions)
+{
+  std::vector<RayQueryResult> results(_origins.size());
+  OgreScenePtr ogreScene = std::dynamic_pointer_cast<OgreScene>(this->Scene());
+  if (!ogreScene || !ogreScene->meshFactory)
+    return results;
+
+  /// \brief Entity that rays are tested against
+  struct Candidate
+  {
+    /// \brief Triangles of the entity mesh
+    std::shared_ptr<MeshBvh> bvh;
+
+    /// \brief Transform from world to entity mesh frame
+    math::Matrix4d worldToLocal;
+
+    /// \brief Id of the visual that owns the entity
+    unsigned int objectId;
+  };
+
+  // gather the visible entities created by the mesh factory, the scene
+  // hierarchy changes from one call to the next so it is rebuilt every time
+  std::vector<Candidate> candidates;
+  std::vector<math::AxisAlignedBox> boxes;
+  auto entityIt = ogreScene->OgreSceneManager()->getMovableObjectIterator(
+      Ogre::EntityFactory::FACTORY_TYPE_NAME);
+  while (entityIt.hasMoreElements())
+  {
+    Ogre::Entity *ogreEntity = static_cast<Ogre::Entity *>(entityIt.getNext());
+    if (!ogreEntity->isAttached() || !ogreEntity->getVisible())
+      continue;
+
+    auto userAny = ogreEntity->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
+
+    const Ogre::AxisAlignedBox &aabb = ogreEntity->getWorldBoundingBox(true);
+    if (!aabb.isFinite())
+      continue;
+
+    std::shared_ptr<MeshBvh> bvh =
+        ogreScene->meshFactory->TriangleBvh(ogreEntity->getMesh()->getName());
+    if (!bvh || bvh->TriangleCount() == 0u)
+      continue;
+
+    boxes.push_back(math::AxisAlignedBox(
+        OgreConversions::Convert(aabb.getMinimum()),
+        OgreConversions::Convert(aabb.getMaximum())));
+
+    Candidate candidate;
+    candidate.bvh = bvh;
+    candidate.worldToLocal = OgreConversions::Convert(
+        ogreEntity->getParentNode()->_getFullTransform()).Inverse();
+    candidate.objectId = Ogre::any_cast<unsigned int>(userAny);
+    candidates.push_back(candidate);
+  }
+
+  if (candidates.empty())
+    return results;
+
+  Bvh sceneBvh;
+  sceneBvh.Build(boxes);
+
+  for (unsigned int i = 0; i < _origins.size(); ++i)
+  {
+    const math::Vector3d &origin = _origins[i];
+    const math::Vector3d &dir = _directions[i];
+
+    // the transform is affine so distances along the ray are the same in
+    // the world and mesh frames
+    double distance;
+    unsigned int index;
+    bool hit = sceneBvh.Intersect(origin, dir,
+        [&](unsigned int _candidate, double &_t)
+        {
+          const Candidate &c = candidates[_candidate];
+          math::Vector3d localOrigin = c.worldToLocal * origin;
+          math::Vector3d localDir =
+              c.worldToLocal * (origin + dir) - localOrigin;
+          return c.bvh->Intersect(localOrigin, localDir, _t);
+        }, distance, index);
+
+    if (hit)
+    {
+      results[i].distance = distance;
+      results[i].point = origin + dir * distance;
+      results[i].objectId = candidates[index].objectId;
+    }
+  }
+
+  return results;
+}
+
 //////////////////////////////////////////////////
 void OgreRayQuery::MeshInformation(const Ogre::Mesh *_mesh,
                                    size_t &_vertex_count,
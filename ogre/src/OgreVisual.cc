@@ -107,6 +107,9 @@ void OgreVisual::SetVisible(bool _visible)
     return;
 
   this->ogreNode->setVisible(_visible);
+
+  // visibility cascades to the whole subtree
+  this->MarkBoundingBoxDirty(true);
 }
 
 //////////////////////////////////////////////////
@@ -196,7 +199,7 @@ bool OgreVisual::DetachGeometry(GeometryPtr _geometry)
 }
 
 //////////////////////////////////////////////////
-ignition::math::AxisAlignedBox OgreVisual::LocalBoundingBox() const
+ignition::math::AxisAlignedBox OgreVisual::LocalBoundingBoxImpl() const
 {
   ignition::math::AxisAlignedBox box;
   this->BoundsHelper(box, true /* local frame */);
@@ -204,10 +207,23 @@ ignition::math::AxisAlignedBox OgreVisual::LocalBoundingBox() const
 }
 
 //////////////////////////////////////////////////
-ignition::math::AxisAlignedBox OgreVisual::BoundingBox() const
+ignition::math::AxisAlignedBox OgreVisual::BoundingBoxImpl() const
 {
   ignition::math::AxisAlignedBox box;
-  this->BoundsHelper(box, false /* world frame */);
+  this->AttachedObjectBounds(box, false /* world frame */, this->WorldPose());
+
+  // world frame boxes can be merged without loss of precision so reuse the
+  // cached bounding boxes of the child visuals
+  auto childNodes = std::dynamic_pointer_cast<OgreNodeStore>(this->Children());
+  if (!childNodes)
+    return box;
+
+  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
+  {
+    OgreVisualPtr visual = std::dynamic_pointer_cast<OgreVisual>(it->second);
+    if (visual)
+      box.Merge(visual->BoundingBox());
+  }
   return box;
 }
 
@@ -225,6 +241,28 @@ void OgreVisual::BoundsHelper(ignition::math::AxisAlignedBox &_box,
   if (!this->ogreNode)
     return;
 
+  this->AttachedObjectBounds(_box, _local, _pose);
+
+  auto childNodes = std::dynamic_pointer_cast<OgreNodeStore>(this->Children());
+  if (!childNodes)
+    return;
+
+  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
+  {
+    NodePtr child = it->second;
+    OgreVisualPtr visual = std::dynamic_pointer_cast<OgreVisual>(child);
+    if (visual)
+      visual->BoundsHelper(_box, _local, _pose);
+  }
+}
+
+//////////////////////////////////////////////////
+void OgreVisual::AttachedObjectBounds(ignition::math::AxisAlignedBox &_box,
+    bool _local, const ignition::math::Pose3d &_pose) const
+{
+  if (!this->ogreNode)
+    return;
+
   this->ogreNode->_updateBounds();
   this->ogreNode->_update(false, true);
 
@@ -281,18 +319,6 @@ void OgreVisual::BoundsHelper(ignition::math::AxisAlignedBox &_box,
       _box.Merge(box);
     }
   }
-
-  auto childNodes = std::dynamic_pointer_cast<OgreNodeStore>(this->Children());
-  if (!childNodes)
-    return;
-
-  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
-  {
-    NodePtr child = it->second;
-    OgreVisualPtr visual = std::dynamic_pointer_cast<OgreVisual>(child);
-    if (visual)
-      visual->BoundsHelper(_box, _local, _pose);
-  }
 }
 
 //////////////////////////////////////////////////
@@ -38,6 +38,7 @@ namespace Ogre
   class Material;
   class RenderTarget;
   class Texture;
+  struct TextureBox;
   class Viewport;
 }
 
@@ -101,6 +102,18 @@ namespace ignition
           std::function<void(const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber) override;
 
+      // Documentation inherited.
+      public: virtual ignition::common::ConnectionPtr ConnectNewDepthFrameView(
+          std::function<void(const float *, unsigned int, unsigned int,
+          unsigned int, unsigned int, const std::string &)> _subscriber)
+          override;
+
+      // Documentation inherited.
+      public: virtual void SetAsyncReadback(bool _async) override;
+
+      // Documentation inherited.
+      public: virtual bool AsyncReadback() const override;
+
       /// \brief Implementation of the render call
       public: virtual void Render() override;
 
@@ -141,6 +154,15 @@ namespace ignition
       /// \brief Create the camera.
       protected: void CreateCamera();
 
+      /// \brief Copy depth data read back from the GPU into the depth
+      /// buffer and notify subscribers of new depth and point cloud data
+      /// \param[in] _box Texture box containing the depth texture data
+      private: void ProcessDepthData(const Ogre::TextureBox &_box);
+
+      /// \brief Destroy the async texture tickets used for asynchronous
+      /// readback, discarding any pending download
+      private: void DestroyReadbackTickets();
+
       /// \brief Notifies us that the shadow node definition is about to be
       /// updated. This means our compositor workspace must be destroyed
       /// because the shadow node definition it's using will become a
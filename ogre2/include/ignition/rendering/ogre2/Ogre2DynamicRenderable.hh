@@ -72,6 +72,21 @@ namespace ignition
       /// \brief Update the dynamic renderable
       public: void Update();
 
+      /// \brief Enable or disable streaming mode, meant for geometry that
+      /// changes every frame. In streaming mode the vertex buffer only grows,
+      /// only the vertices that changed since a buffer region was last
+      /// written are uploaded to it, and the unused tail of the buffer is not
+      /// drawn instead of being filled with the last vertex. Triangle
+      /// operation types are always fully uploaded since their normals
+      /// depend on neighbouring vertices. Streaming is disabled by default.
+      /// \param[in] _streaming True to enable streaming mode
+      public: void SetStreaming(bool _streaming);
+
+      /// \brief Get whether streaming mode is enabled
+      /// \return True if streaming mode is enabled
+      /// \sa SetStreaming
+      public: bool Streaming() const;
+
       /// \brief Get the ogre object associated with this dynamic renderable
       public: Ogre::MovableObject *OgreObject() const;
 
@@ -95,6 +110,29 @@ namespace ignition
       public: void SetPoint(unsigned int _index,
                             const ignition::math::Vector3d &_value);
 
+      /// \brief Replace the point list with tightly packed float positions.
+      /// The positions are uploaded as they are on the next Update, without
+      /// going through math::Vector3d, which makes this the fastest way to
+      /// update large point or line lists every frame. Triangle normals are
+      /// generated as usual for triangle operation types.
+      /// \param[in] _positions Point positions, x y z for each point
+      /// \param[in] _colors Point colors, one for each point. If null,
+      /// the points are white.
+      /// \param[in] _count Number of points
+      public: void SetPoints(const float *_positions,
+            const ignition::math::Color *_colors, unsigned int _count);
+
+      /// \brief Add tightly packed float positions to the end of the point
+      /// list. Only the added points are uploaded on the next Update in
+      /// streaming mode.
+      /// \param[in] _positions Point positions, x y z for each point
+      /// \param[in] _colors Point colors, one for each point. If null,
+      /// the points are white.
+      /// \param[in] _count Number of points
+      /// \sa SetPoints
+      public: void AppendPoints(const float *_positions,
+            const ignition::math::Color *_colors, unsigned int _count);
+
       /// \brief Change the color of an existing point in the point list
       /// \param[in] _index Index of the point to set
       /// \param[in] _color color to set the point to
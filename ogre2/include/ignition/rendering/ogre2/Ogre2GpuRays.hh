@@ -127,8 +127,12 @@ namespace ignition
       /// \brief Create the texture which is used to render gpu rays data.
       private: virtual void CreateGpuRaysTextures();
 
-      /// \brief Update the render targets in the 1st pass
-      private: void UpdateRenderTarget1stPass();
+      /// \brief Update the render targets in the 1st pass. The cubemap is
+      /// rendered at most once per frame, so that sensors sharing it do not
+      /// render it again.
+      /// \return True if the cubemap was rendered, false if it was already
+      /// rendered during the current frame
+      private: bool UpdateRenderTarget1stPass();
 
       /// \brief Update the 2nd pass render target
       private: void UpdateRenderTarget2ndPass();
@@ -140,6 +144,23 @@ namespace ignition
       /// \brief Set up 1st pass material, texture, and compositor
       private: void Setup1stPass();
 
+      /// \brief Create the camera, texture and compositor workspace that
+      /// render one face of the cubemap in the 1st pass
+      /// \param[in] _faceIndex Index of the cubemap face
+      private: void CreateCubemapFace(unsigned int _faceIndex);
+
+      /// \brief Check whether the cubemap of the sensor set by
+      /// SetCubemapSource can be sampled by this sensor and if so, set up
+      /// the source and the rotation from this sensor to the source.
+      /// \return True if the cubemap of the source is shared
+      private: bool SetupCubemapSource();
+
+      /// \brief Get the sensor that renders the cubemap sampled by this
+      /// sensor
+      /// \return This sensor, the cubemap source, or nullptr if the cubemap
+      /// source has been destroyed
+      private: Ogre2GpuRays *CubemapOwner();
+
       /// \brief Set up 2nd pass material, texture, and compositor
       private: void Setup2ndPass();
 
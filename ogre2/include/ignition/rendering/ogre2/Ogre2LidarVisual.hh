@@ -74,6 +74,10 @@ namespace ignition
       /// \brief Clear data stored by dynamiclines
       private: void ClearVisualData();
 
+      /// \brief Update the point cloud displayed when the visual type is
+      /// LVT_POINTS, uploading the whole scan at once
+      private: void UpdatePointCloud();
+
       // Documentation inherited
       public: virtual void SetVisible(bool _visible) override;
 
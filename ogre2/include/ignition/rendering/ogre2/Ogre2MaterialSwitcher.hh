@@ -59,6 +59,14 @@ namespace ignition
       public: std::string EntityName(
               const ignition::math::Color &_color) const;
 
+      /// \brief Get the item with a specific color. The item is only valid
+      /// until items are removed from the scene, i.e. it should be looked up
+      /// right after rendering.
+      /// \param[in] _color The item's color.
+      /// \return The item or nullptr if no item has this color
+      public: Ogre::Item *EntityItem(
+              const ignition::math::Color &_color) const;
+
       /// \brief Reset the color value incrementor
       public: void Reset();
 
@@ -80,6 +88,10 @@ namespace ignition
       /// renderable name
       private: std::map<unsigned int, std::string> colorDict;
 
+      /// \brief Color dictionary that maps the unique color value to
+      /// renderable
+      private: std::map<unsigned int, Ogre::Item *> colorItemDict;
+
       /// \brief A map of ogre sub item pointer to their original hlms material
       private: std::map<Ogre::SubItem *, Ogre::HlmsDatablock *> datablockMap;
 
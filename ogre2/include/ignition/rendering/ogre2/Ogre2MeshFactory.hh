@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "ignition/rendering/config.hh"
+#include "ignition/rendering/Bvh.hh"
 #include "ignition/rendering/MeshDescriptor.hh"
 #include "ignition/rendering/ogre2/Ogre2Mesh.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderTypes.hh"
@@ -57,6 +58,15 @@ namespace ignition
       /// mesh
       public: virtual Ogre2MeshPtr Create(const MeshDescriptor &_desc);
 
+      /// \brief Create a mesh from a descriptor, assigning the given
+      /// materials to its submeshes without copying them
+      /// \param[in] _desc Mesh descriptor containing data needed to create a
+      /// mesh
+      /// \param[in] _materials Materials of the submeshes, by submesh index.
+      /// Submeshes without a material get a copy of their default material.
+      public: Ogre2MeshPtr Create(const MeshDescriptor &_desc,
+                  const std::vector<MaterialPtr> &_materials);
+
       /// \brief Cleanup and clear all internal ogre v2 meshes created by this
       /// factory
       public: virtual void Clear();
@@ -97,6 +107,15 @@ namespace ignition
       /// \brief Remove internal material cache for a specific material
       public: void ClearMaterialsCache(const std::string &_name);
 
+      /// \brief Get the bounding volume hierarchy over the triangles of a
+      /// mesh created by this factory, in the mesh frame. It is built when
+      /// the mesh is first created, while its triangles are known to be
+      /// available, and kept until the factory is cleared.
+      /// \param[in] _name Name of the ogre mesh
+      /// \return Triangle hierarchy or null if the mesh was not created by
+      /// this factory
+      public: std::shared_ptr<MeshBvh> TriangleBvh(const std::string &_name);
+
       /// \brief Pointer to private data class
       private: std::unique_ptr<Ogre2MeshFactoryPrivate> dataPtr;
     };
@@ -110,6 +129,15 @@ namespace ignition
       public: Ogre2SubMeshStoreFactory(Ogre2ScenePtr _scene,
                   Ogre::Item *_item);
 
+      /// \brief Constructor
+      /// \param[in] _scene Pointer to the scene object
+      /// \param[in] _item Parent ogre item
+      /// \param[in] _materials Materials to assign to the submeshes without
+      /// copying them, by submesh index
+      public: Ogre2SubMeshStoreFactory(Ogre2ScenePtr _scene,
+                  Ogre::Item *_item,
+                  const std::vector<MaterialPtr> &_materials);
+
       /// \brief Destructor
       public: virtual ~Ogre2SubMeshStoreFactory();
 
@@ -18,6 +18,7 @@
 #define IGNITION_RENDERING_OGRE2_OGRE2RAYQUERY_HH_
 
 #include <memory>
+#include <vector>
 
 #include "ignition/rendering/base/BaseRayQuery.hh"
 #include "ignition/rendering/ogre2/Ogre2Object.hh"
@@ -51,6 +52,16 @@ namespace ignition
       // Documentation inherited
       public: virtual RayQueryResult ClosestPoint();
 
+      // Documentation inherited
+      public: virtual std::vector<RayQueryResult> ClosestPoints(
+                const CameraPtr &_camera,
+                const std::vector<math::Vector2d> &_coords);
+
+      // Documentation inherited
+      public: virtual std::vector<RayQueryResult> ClosestPointsAlongRays(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions);
+
       /// \brief Get closest point by selection buffer.
       /// This is executed on the GPU.
       private: RayQueryResult ClosestPointBySelectionBuffer();
@@ -59,6 +70,17 @@ namespace ignition
       /// This is executed on the CPU.
       private: RayQueryResult ClosestPointByIntersection();
 
+      /// \brief Get the closest point of each ray by testing the triangles
+      /// of the mesh hierarchies kept by the mesh factory, visited through a
+      /// hierarchy over the bounding boxes of the items of the scene.
+      /// This is executed on the CPU.
+      /// \param[in] _origins Origin of each ray
+      /// \param[in] _directions Direction of each ray
+      /// \return Closest intersection of each ray
+      private: std::vector<RayQueryResult> ClosestPointsByBvh(
+                const std::vector<math::Vector3d> &_origins,
+                const std::vector<math::Vector3d> &_directions);
+
       /// \brief Private data pointer
       private: std::unique_ptr<Ogre2RayQueryPrivate> dataPtr;
 
@@ -136,7 +136,25 @@ namespace ignition
       /// \return list of scenes
       protected: virtual SceneStorePtr Scenes() const override;
 
-      // Documentation Inherited.
+      /// \brief Engine implementation of Load function.
+      /// \param[in] _params Parameters to be passed to the render engine.
+      /// In addition to the parameters of the other engines, it accepts
+      /// "meshCachePath" : path of a directory in which converted meshes
+      ///                   are stored, to be loaded directly by later runs.
+      ///                   The mesh cache is disabled if empty.
+      /// "distortionCachePath" : path of a directory in which lens
+      ///                   distortion maps are stored, to be loaded
+      ///                   directly by later runs. Disabled if empty.
+      /// "heightmapUploadRows" : number of heightmap rows uploaded to the
+      ///                   GPU each frame. Large heightmaps then appear a
+      ///                   few frames after being created instead of
+      ///                   stalling the frame they are created in. If 0
+      ///                   (default), heightmaps are uploaded at once.
+      /// "hlmsCachePath" : path of a directory in which generated shaders
+      ///                   and compiled shader microcode are stored when
+      ///                   the engine is destroyed, to be loaded by later
+      ///                   runs on the same GPU and driver. The shader
+      ///                   cache is disabled if empty.
       protected: virtual bool LoadImpl(
           const std::map<std::string, std::string> &_params) override;
 
@@ -177,6 +195,14 @@ namespace ignition
       /// \brief Attempt to initialize engine and catch exeption if they occur
       private: void InitAttempt();
 
+      /// \brief Load the shader and microcode caches from the hlms cache
+      /// directory, if enabled
+      private: void LoadHlmsCache();
+
+      /// \brief Save the shader and microcode caches to the hlms cache
+      /// directory, if enabled
+      private: void SaveHlmsCache();
+
       /// \brief Get a list of all supported FSAA levels for this render system
       /// \return a list of FSAA levels
       public: std::vector<unsigned int> FSAALevels() const;
@@ -209,6 +235,43 @@ namespace ignition
       public: Ogre::CompositorWorkspaceListener
           *TerraWorkspaceListener() const;
 
+      /// \internal
+      /// \brief Record that a material uses an Ogre texture. Textures are
+      /// shared by all scenes so the count is kept by the render engine.
+      /// \param[in] _name Name of the Ogre texture
+      public: void AcquireTexture(const std::string &_name);
+
+      /// \internal
+      /// \brief Record that a material no longer uses an Ogre texture
+      /// \param[in] _name Name of the Ogre texture
+      /// \return Number of materials still using the texture. The texture
+      /// can be unloaded when this is 0.
+      public: unsigned int ReleaseTexture(const std::string &_name);
+
+      /// \internal
+      /// \brief Get the number of materials using an Ogre texture
+      /// \param[in] _name Name of the Ogre texture
+      /// \return Number of materials using the texture
+      public: unsigned int TextureUseCount(const std::string &_name) const;
+
+      /// \internal
+      /// \brief Get the directory in which converted meshes are cached
+      /// \return Path of the mesh cache directory, empty if the cache is
+      /// disabled
+      public: std::string MeshCachePath() const;
+
+      /// \internal
+      /// \brief Get the directory in which lens distortion maps are cached
+      /// \return Path of the distortion map cache directory, empty if the
+      /// cache is disabled
+      public: std::string DistortionCachePath() const;
+
+      /// \internal
+      /// \brief Get the number of heightmap rows uploaded to the GPU each
+      /// frame
+      /// \return Number of rows, 0 if heightmaps are uploaded at once
+      public: unsigned int HeightmapUploadRows() const;
+
       /// \brief Pointer to the ogre's overlay system
       private: Ogre::v1::OverlaySystem *ogreOverlaySystem = nullptr;
 
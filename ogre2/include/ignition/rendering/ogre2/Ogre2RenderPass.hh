@@ -24,6 +24,11 @@
 #include "ignition/rendering/ogre2/Export.hh"
 #include "ignition/rendering/ogre2/Ogre2Object.hh"
 
+namespace Ogre
+{
+  class Camera;
+}
+
 namespace ignition
 {
   namespace rendering
@@ -68,6 +73,27 @@ namespace ignition
       /// \brief Create the render pass using ogre compositor
       public: virtual void CreateRenderPass();
 
+      /// \brief Set the camera and image size the render pass is applied
+      /// to. This is done by the render target before the render pass is
+      /// created.
+      /// \param[in] _camera Ogre camera
+      /// \param[in] _width Image width in pixels
+      /// \param[in] _height Image height in pixels
+      public: void SetCamera(Ogre::Camera *_camera, unsigned int _width,
+                  unsigned int _height);
+
+      /// \brief Get the ogre camera the render pass is applied to
+      /// \return Ogre camera or null if not set
+      protected: Ogre::Camera *OgreCamera() const;
+
+      /// \brief Get the width of the image the render pass is applied to
+      /// \return Image width in pixels
+      protected: unsigned int ImageWidth() const;
+
+      /// \brief Get the height of the image the render pass is applied to
+      /// \return Image height in pixels
+      protected: unsigned int ImageHeight() const;
+
       /// \brief Name of the ogre compositor node definition
       protected: std::string ogreCompositorNodeDefName;
 
@@ -109,6 +109,10 @@ namespace ignition
       // Documentation inherited.
       public: virtual bool LegacyAutoGpuFlush() const override;
 
+      // Documentation inherited.
+      public: virtual void RenderSensors(
+                  const std::vector<CameraPtr> &_cameras) override;
+
       /// \brief Get a pointer to the ogre scene manager
       /// \return Pointer to the ogre scene manager
       public: virtual Ogre::SceneManager *OgreSceneManager() const;
@@ -158,6 +162,8 @@ namespace ignition
       /// \param[in] _startNewFrame whether we ignore
       /// SetCameraPassCountPerGpuFlush.
       /// Only PostRender should set this to true.
+      /// \remark Passes are only counted while inside RenderSensors, which
+      /// flushes once after all sensors have rendered.
       public: void FlushGpuCommandsAndStartNewFrame(uint8_t _numPasses,
                                                     bool _startNewFrame);
 
@@ -191,6 +197,47 @@ namespace ignition
       /// \return True if the number of shadow casting lights changed
       /// \sa ShadowsDirty
       public: bool ShadowsDirty() const;
+
+      /// \internal
+      /// \brief Notify the scene that the user data or the geometries of a
+      /// visual changed. The visual is added to a log of changed visuals so
+      /// that sensors caching data per visual, e.g. the temperature of
+      /// visuals seen by thermal cameras, only update the visuals that
+      /// changed.
+      /// \param[in] _id Id of the visual that changed
+      /// \sa ChangedVisuals
+      public: void MarkVisualDataChanged(unsigned int _id);
+
+      /// \internal
+      /// \brief Get the visuals that changed since a position in the log of
+      /// changed visuals. The log is bounded, so old entries are dropped
+      /// when many visuals change between two reads.
+      /// \param[in,out] _version Position in the log up to which the caller
+      /// is up to date. Set to the end of the log.
+      /// \param[out] _ids Ids of the visuals that changed since _version.
+      /// The same id may appear more than once.
+      /// \return False if entries after _version were dropped, in which
+      /// case the caller must consider all visuals changed
+      /// \sa MarkVisualDataChanged
+      public: bool ChangedVisuals(uint64_t &_version,
+                  std::vector<unsigned int> &_ids) const;
+
+      /// \internal
+      /// \brief Unload a texture that is no longer used by any material.
+      /// Datablocks not created by materials, e.g. by the terrain or by
+      /// users, may still use it, so the queued textures are checked against
+      /// all datablocks in one batch at the start of the next frame or when
+      /// the scene is cleared or destroyed. This way destroying many
+      /// materials only looks through the datablocks once.
+      /// \param[in] _name Name of the Ogre texture
+      public: void QueueTextureUnload(const std::string &_name);
+
+      /// \internal
+      /// \brief Get the number of frames ended so far. Ogre scene nodes are
+      /// not updated within a frame, so everything rendered during the same
+      /// frame sees the same scene.
+      /// \return Number of frames ended
+      public: uint64_t FrameCount() const;
       /// \endcond
 
       // Documentation inherited
@@ -295,6 +342,10 @@ namespace ignition
                      const std::string &_name, const MeshDescriptor &_desc)
                      override;
 
+      // Documentation inherited
+      protected: virtual MeshPtr CreateMeshInstanceImpl(unsigned int _id,
+                     const std::string &_name, MeshPtr _mesh) override;
+
       // Documentation inherited
       protected: virtual CapsulePtr CreateCapsuleImpl(unsigned int _id,
                      const std::string &_name) override;
@@ -359,10 +410,17 @@ namespace ignition
       public: const std::vector<std::weak_ptr<Ogre2Heightmap>> &Heightmaps()
           const;
 
-      /// \brief Create a compositor shadow node with the same number of shadow
-      /// textures as the number of shadow casting lights
+      /// \brief Select a compositor shadow node with enough shadow textures
+      /// for the shadow casting lights, creating it if needed, and mark the
+      /// cameras' shadows dirty if it changed
       protected: void UpdateShadowNode();
 
+      /// \internal
+      /// \brief Get the name of the compositor shadow node definition the
+      /// cameras of this scene should use
+      /// \return Name of the shadow node definition
+      public: const std::string &ShadowNodeName() const;
+
       /// \brief Create ogre compositor shadow node definition. The function
       /// takes a vector of parameters that describe the type, number, and
       /// resolution of textures create. Note that it is not necessary to
@@ -405,6 +463,10 @@ namespace ignition
       /// \brief Create the vaiours storage objects
       private: void CreateStores();
 
+      /// \brief Unload the textures queued with QueueTextureUnload that are
+      /// not used by any datablock
+      private: void UnloadQueuedTextures();
+
       /// \brief Remove internal material cache for a specific material
       /// \param[in] _name Name of the template material to remove.
       public: void ClearMaterialsCache(const std::string &_name);
@@ -441,6 +503,9 @@ namespace ignition
 
       /// \brief Make the render engine our friend
       private: friend class Ogre2RenderEngine;
+
+      /// \brief Make ray query our friend so it can use the mesh factory
+      private: friend class Ogre2RayQuery;
     };
     }
   }
@@ -72,6 +72,12 @@ namespace ignition
         std::function<void(const uint8_t *, unsigned int, unsigned int,
         unsigned int, const std::string &)>  _subscriber) override;
 
+      // Documentation inherited
+      public: virtual ignition::common::ConnectionPtr
+        ConnectNewLabelIdFrame(
+        std::function<void(const uint32_t *, unsigned int,
+        unsigned int)> _subscriber) override;
+
       // Documentation inherited
       public: virtual void Render() override;
 
@@ -86,6 +92,13 @@ namespace ignition
       public: void LabelMapFromColoredBuffer(
                   uint8_t * _labelBuffer) const override;
 
+      /// \brief Fill the label id buffer from the RGBA8 segmentation texture
+      /// data
+      /// \param[in] _data Texture data
+      /// \param[in] _bytesPerRow Size in bytes of a texture row
+      protected: void LabelIdsFromTexture(const uint8_t *_data,
+                     size_t _bytesPerRow);
+
       /// \brief Create the camera.
       protected: void CreateCamera();
 
@@ -19,12 +19,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
 
 #include "ignition/rendering/config.hh"
 #include "ignition/rendering/ogre2/Export.hh"
 
 namespace Ogre
 {
+  class CompositorWorkspace;
   class Item;
   class RenderTarget;
   class SceneManager;
@@ -44,6 +49,8 @@ namespace ignition
     /// color is assigned to each entity. Whenever a selection request is made,
     /// the selection buffer camera renders to a 1x1 sized offscreen buffer.
     /// The color value of that pixel gives the identity of the entity.
+    /// Batches of nearby pixels are queried by rendering their bounding
+    /// rectangle at the camera's resolution and reading it back once.
     class IGNITION_RENDERING_OGRE2_VISIBLE Ogre2SelectionBuffer
     {
       /// \brief Constructor
@@ -75,6 +82,19 @@ namespace ignition
       public: bool ExecuteQuery(const int _x, const int _y, Ogre::Item *&_item,
           math::Vector3d &_point);
 
+      /// \brief Perform selection operations for a batch of pixels. Nearby
+      /// pixels are grouped and the bounding rectangle of each group is
+      /// rendered in a single selection pass and read back once. Pixels far
+      /// apart are rendered in separate passes.
+      /// \param[in] _pixels Coordinates of each pixel to query.
+      /// \param[out] _items Ogre item at each pixel, nullptr if there is none.
+      /// \param[out] _points 3D point of intersection at each pixel.
+      /// \return True if the selection pass was rendered, false if no pixel
+      /// is inside the camera image or the camera is not ready
+      public: bool ExecuteQuery(const std::vector<math::Vector2i> &_pixels,
+          std::vector<Ogre::Item *> &_items,
+          std::vector<math::Vector3d> &_points);
+
       /// \brief Set dimension of the selection buffer
       /// \param[in] _width X dimension in pixels.
       /// \param[in] _height Y dimension in pixels.
@@ -89,6 +109,31 @@ namespace ignition
       /// \brief Create the render texture
       private: void CreateRTTBuffer();
 
+      /// \brief Create the render texture used to query more than one pixel
+      /// \param[in] _width Width of the queried rectangle in pixels
+      /// \param[in] _height Height of the queried rectangle in pixels
+      private: void CreateRegionRTT(unsigned int _width,
+          unsigned int _height);
+
+      /// \brief Delete the render texture used to query more than one pixel
+      private: void DeleteRegionRTT();
+
+      /// \brief Render the bounding rectangle of a group of pixels and read
+      /// back the item and point at each of them
+      /// \param[in] _pixels Coordinates of all the queried pixels
+      /// \param[in] _indices Indices of the pixels of the group, all inside
+      /// the camera image
+      /// \param[in,out] _items Ogre item at each pixel
+      /// \param[in,out] _points 3D point of intersection at each pixel
+      private: void QueryRegion(const std::vector<math::Vector2i> &_pixels,
+          const std::vector<unsigned int> &_indices,
+          std::vector<Ogre::Item *> &_items,
+          std::vector<math::Vector3d> &_points);
+
+      /// \brief Render the selection pass of a compositor workspace
+      /// \param[in] _workspace Workspace to render
+      private: void UpdateWorkspace(Ogre::CompositorWorkspace *_workspace);
+
       /// \brief Create the selection buffer offscreen render texture.
       // private: void CreateRTTOverlays();
 
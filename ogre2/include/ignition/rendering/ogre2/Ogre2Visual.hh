@@ -18,6 +18,7 @@
 #define IGNITION_RENDERING_OGRE2_OGRE2VISUAL_HH_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "ignition/rendering/base/BaseVisual.hh"
@@ -56,13 +57,17 @@ namespace ignition
       public: virtual void SetVisibilityFlags(uint32_t _flags) override;
 
       // Documentation inherited.
-      public: virtual ignition::math::AxisAlignedBox BoundingBox()
-                  const override;
+      public: virtual void SetUserData(const std::string &_key,
+                  Variant _value) override;
 
       // Documentation inherited.
-      public: virtual ignition::math::AxisAlignedBox LocalBoundingBox()
+      protected: virtual ignition::math::AxisAlignedBox BoundingBoxImpl()
                   const override;
 
+      // Documentation inherited.
+      protected: virtual ignition::math::AxisAlignedBox
+                  LocalBoundingBoxImpl() const override;
+
       /// \brief Recursively loop through this visual's children
       /// to obtain the bounding box.
       /// \param[in,out] _box The bounding box.
@@ -73,6 +78,17 @@ namespace ignition
                      ignition::math::AxisAlignedBox &_box, bool _local,
                      const ignition::math::Pose3d &_pose) const;
 
+      /// \brief Merge the bounding boxes of the objects attached to this
+      /// visual, excluding child visuals.
+      /// \param[in,out] _box The bounding box.
+      /// \param[in] _local A flag indicating if the local bounding box is to
+      /// be calculated.
+      /// \param[in] _pose World pose of the visual the local bounding box is
+      /// relative to
+      private: void AttachedObjectBounds(
+                     ignition::math::AxisAlignedBox &_box, bool _local,
+                     const ignition::math::Pose3d &_pose) const;
+
       /// \brief Wrapper function for BoundsHelper to reduce redundant
       /// world pose access
       /// \param[in,out] _box The bounding box.
@@ -93,6 +109,11 @@ namespace ignition
       /// \brief Initialize the visual
       protected: virtual void Init() override;
 
+      /// \brief Notify the scene that the user data or the geometries of
+      /// this visual changed
+      /// \sa Ogre2Scene::MarkVisualDataChanged
+      private: void MarkDataChanged();
+
       /// \brief Get a shared pointer to this.
       /// \return Shared pointer to this
       private: Ogre2VisualPtr SharedThis();
@@ -15,6 +15,9 @@
  *
  */
 
+#include <map>
+#include <vector>
+
 #include "ignition/rendering/ogre2/Ogre2Camera.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderTarget.hh"
@@ -242,7 +245,14 @@ Ogre2SelectionBuffer *Ogre2Camera::SelectionBuffer() const
 //////////////////////////////////////////////////
 VisualPtr Ogre2Camera::VisualAt(const ignition::math::Vector2i &_mousePos)
 {
-  VisualPtr result;
+  return this->VisualsAt({_mousePos})[0];
+}
+
+//////////////////////////////////////////////////
+std::vector<VisualPtr> Ogre2Camera::VisualsAt(
+    const std::vector<ignition::math::Vector2i> &_mousePos)
+{
+  std::vector<VisualPtr> result(_mousePos.size());
 
   if (!this->selectionBuffer)
   {
@@ -260,21 +270,43 @@ VisualPtr Ogre2Camera::VisualAt(const ignition::math::Vector2i &_mousePos)
   }
 
   float ratio = screenScalingFactor();
-  ignition::math::Vector2i mousePos(
-      static_cast<int>(std::rint(ratio * _mousePos.X())),
-      static_cast<int>(std::rint(ratio * _mousePos.Y())));
-  Ogre::Item *ogreItem = this->selectionBuffer->OnSelectionClick(
-      mousePos.X(), mousePos.Y());
+  std::vector<ignition::math::Vector2i> pixels;
+  pixels.reserve(_mousePos.size());
+  for (const auto &mousePos : _mousePos)
+  {
+    pixels.emplace_back(
+        static_cast<int>(std::rint(ratio * mousePos.X())),
+        static_cast<int>(std::rint(ratio * mousePos.Y())));
+  }
+
+  std::vector<Ogre::Item *> ogreItems;
+  std::vector<math::Vector3d> points;
+  if (!this->selectionBuffer->ExecuteQuery(pixels, ogreItems, points))
+    return result;
 
-  if (ogreItem)
+  // many positions usually hit the same few items
+  std::map<Ogre::Item *, VisualPtr> visuals;
+  for (unsigned int i = 0; i < ogreItems.size(); ++i)
   {
+    Ogre::Item *ogreItem = ogreItems[i];
+    if (!ogreItem)
+      continue;
+
+    auto it = visuals.find(ogreItem);
+    if (it != visuals.end())
+    {
+      result[i] = it->second;
+      continue;
+    }
+
+    VisualPtr visual;
     if (!ogreItem->getUserObjectBindings().getUserAny().isEmpty() &&
         ogreItem->getUserObjectBindings().getUserAny().getType() ==
         typeid(unsigned int))
     {
       try
       {
-        result = this->scene->VisualById(Ogre::any_cast<unsigned int>(
+        visual = this->scene->VisualById(Ogre::any_cast<unsigned int>(
               ogreItem->getUserObjectBindings().getUserAny()));
       }
       catch(Ogre::Exception &e)
@@ -282,6 +314,8 @@ VisualPtr Ogre2Camera::VisualAt(const ignition::math::Vector2i &_mousePos)
         ignerr << "Ogre Error:" << e.getFullDescription() << "\n";
       }
     }
+    visuals[ogreItem] = visual;
+    result[i] = visual;
   }
 
   return result;
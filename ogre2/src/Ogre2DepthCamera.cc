@@ -33,8 +33,10 @@
 #endif
 
 #include <math.h>
+#include <array>
 #include <ignition/math/Helpers.hh>
 
+#include "ignition/rendering/PixelCopy.hh"
 #include "ignition/rendering/RenderTypes.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
 #include "ignition/rendering/ogre2/Ogre2DepthCamera.hh"
@@ -140,6 +142,12 @@ class ignition::rendering::Ogre2DepthCameraPrivate
               unsigned int, unsigned int, unsigned int,
               const std::string &)> newDepthFrame;
 
+  /// \brief Event used to signal a view of the interleaved depth and
+  /// point cloud data
+  public: ignition::common::EventT<void(const float *,
+              unsigned int, unsigned int, unsigned int, unsigned int,
+              const std::string &)> newDepthFrameView;
+
   /// \brief standard deviation of particle noise
   public: double particleStddev = 0.01;
 
@@ -154,8 +162,21 @@ class ignition::rendering::Ogre2DepthCameraPrivate
   /// \brief Name of sky box material
   public: const std::string kSkyboxMaterialName = "SkyBox";
 
-  /// \brief Name of shadow compositor node
-  public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
+  /// \brief True to read back depth data from the GPU asynchronously
+  public: bool asyncReadback = false;
+
+  /// \brief Async texture tickets used to download the depth texture
+  /// without stalling the CPU. The frame just rendered is downloaded into
+  /// one ticket while the previous frame is read from the other.
+  public: std::array<Ogre::AsyncTextureTicket *, 2u> readbackTickets{
+      {nullptr, nullptr}};
+
+  /// \brief Flags indicating which tickets hold a download that has not
+  /// been delivered to subscribers yet
+  public: std::array<bool, 2u> readbackPending{{false, false}};
+
+  /// \brief Index of the ticket to use for the next download
+  public: unsigned int readbackTicketIdx = 0u;
 };
 
 using namespace ignition;
@@ -303,6 +324,8 @@ void Ogre2DepthCamera::Destroy()
   if (!this->ogreCamera)
     return;
 
+  this->DestroyReadbackTickets();
+
   auto engine = Ogre2RenderEngine::Instance();
   auto ogreRoot = engine->OgreRoot();
   Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
@@ -703,7 +726,7 @@ void Ogre2DepthCamera::CreateDepthTexture()
         Ogre::CompositorPassSceneDef *passScene =
             static_cast<Ogre::CompositorPassSceneDef *>(
             colorTargetDef->addPass(Ogre::PASS_SCENE));
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mVisibilityMask = IGN_VISIBILITY_ALL;
         passScene->mIncludeOverlays = false;
         passScene->mFirstRQ = 0u;
@@ -742,9 +765,7 @@ void Ogre2DepthCamera::CreateDepthTexture()
             static_cast<Ogre::CompositorPassSceneDef *>(
             colorTargetDef->addPass(Ogre::PASS_SCENE));
         passScene->mVisibilityMask = IGN_VISIBILITY_ALL;
-        // todo(anyone) PbsMaterialsShadowNode is hardcoded.
-        // Although this may be just fine
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mFirstRQ = 2u;
       }
     }
@@ -886,6 +907,9 @@ void Ogre2DepthCamera::CreateDepthTexture()
            << " for " << this->Name();
   }
 
+  // tickets are sized after the depth texture so they need to be recreated
+  this->DestroyReadbackTickets();
+
   Ogre::TextureGpuManager *textureMgr =
     ogreRoot->getRenderSystem()->getTextureGpuManager();
   // create render texture - these textures pack the range data
@@ -1043,6 +1067,54 @@ void Ogre2DepthCamera::PreRender()
 
 //////////////////////////////////////////////////
 void Ogre2DepthCamera::PostRender()
+{
+  if (!this->dataPtr->asyncReadback)
+  {
+    // blocks until the gpu finishes rendering the depth texture
+    Ogre::Image2 image;
+    image.convertFromTexture(this->dataPtr->ogreDepthTexture[1], 0u, 0u);
+    this->ProcessDepthData(image.getData(0));
+    return;
+  }
+
+  auto engine = Ogre2RenderEngine::Instance();
+  Ogre::TextureGpuManager *textureMgr =
+      engine->OgreRoot()->getRenderSystem()->getTextureGpuManager();
+
+  const unsigned int ticketCount =
+      static_cast<unsigned int>(this->dataPtr->readbackTickets.size());
+  const unsigned int idx = this->dataPtr->readbackTicketIdx;
+  const unsigned int prevIdx = (idx + ticketCount - 1u) % ticketCount;
+  this->dataPtr->readbackTicketIdx = (idx + 1u) % ticketCount;
+
+  // queue a download of the frame that was just rendered. The copy is
+  // recorded after the render commands and a fence is placed after it so
+  // this does not wait for the gpu
+  Ogre::AsyncTextureTicket *&ticket = this->dataPtr->readbackTickets[idx];
+  if (!ticket)
+  {
+    ticket = textureMgr->createAsyncTextureTicket(
+        this->ImageWidth(), this->ImageHeight(), 1u,
+        Ogre::TextureTypes::Type2D, Ogre::PFG_RGBA32_FLOAT);
+  }
+  ticket->download(this->dataPtr->ogreDepthTexture[1], 0u, true);
+  this->dataPtr->readbackPending[idx] = true;
+
+  // deliver the previous frame. The gpu has had a whole update to copy it
+  // so mapping the ticket only stalls if the gpu is more than a frame behind
+  if (this->dataPtr->readbackPending[prevIdx])
+  {
+    Ogre::AsyncTextureTicket *prevTicket =
+        this->dataPtr->readbackTickets[prevIdx];
+    Ogre::TextureBox box = prevTicket->map(0u);
+    this->ProcessDepthData(box);
+    prevTicket->unmap();
+    this->dataPtr->readbackPending[prevIdx] = false;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCamera::ProcessDepthData(const Ogre::TextureBox &_box)
 {
   unsigned int width = this->ImageWidth();
   unsigned int height = this->ImageHeight();
@@ -1053,10 +1125,6 @@ void Ogre2DepthCamera::PostRender()
   unsigned int channelCount = PixelUtil::ChannelCount(format);
   unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
 
-  Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->ogreDepthTexture[1], 0u, 0u);
-  Ogre::TextureBox box = image.getData(0);
-  float *depthBufferTmp = static_cast<float *>(box.data);
   if (!this->dataPtr->depthBuffer)
   {
     this->dataPtr->depthBuffer = new float[len * channelCount];
@@ -1064,39 +1132,41 @@ void Ogre2DepthCamera::PostRender()
 
   // copy data row by row. The texture box may not be a contiguous region of
   // a texture
-  for (unsigned int i = 0; i < height; ++i)
-  {
-    unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = i * width * channelCount;
-    memcpy(&this->dataPtr->depthBuffer[rowIdx], &depthBufferTmp[rawDataRowIdx],
-        width * channelCount * bytesPerChannel);
-  }
+  size_t rowBytes = width * channelCount * bytesPerChannel;
+  copyPixelRows(_box.data, _box.bytesPerRow, this->dataPtr->depthBuffer,
+      rowBytes, rowBytes, height);
 
-  if (!this->dataPtr->depthImage)
+  // view subscribers read the depth and point cloud data directly from the
+  // depth buffer so no extra copies are needed
+  if (this->dataPtr->newDepthFrameView.ConnectionCount() > 0u)
   {
-    this->dataPtr->depthImage = new float[len];
-  }
-  if (!this->dataPtr->pointCloudImage)
-  {
-    this->dataPtr->pointCloudImage = new float[len * channelCount];
+    this->dataPtr->newDepthFrameView(
+        this->dataPtr->depthBuffer, width, height, channelCount,
+        width * channelCount, "PF_FLOAT32_RGBA");
   }
 
-  // fill depth data
-  for (unsigned int i = 0; i < height; ++i)
+  // depth data
+  if (this->dataPtr->newDepthFrame.ConnectionCount() > 0u)
   {
-    unsigned int step = i*width*channelCount;
-    for (unsigned int j = 0; j < width; ++j)
+    if (!this->dataPtr->depthImage)
     {
-      float x = this->dataPtr->depthBuffer[step + j*channelCount];
-      this->dataPtr->depthImage[i*width + j] = x;
+      this->dataPtr->depthImage = new float[len];
     }
+
+    // fill depth data, which is stored in the first channel
+    copyChannel(this->dataPtr->depthBuffer, rowBytes, channelCount, 0u,
+        this->dataPtr->depthImage, width, height);
+    this->dataPtr->newDepthFrame(
+          this->dataPtr->depthImage, width, height, 1, "FLOAT32");
   }
-  this->dataPtr->newDepthFrame(
-        this->dataPtr->depthImage, width, height, 1, "FLOAT32");
 
   // point cloud data
   if (this->dataPtr->newRgbPointCloud.ConnectionCount() > 0u)
   {
+    if (!this->dataPtr->pointCloudImage)
+    {
+      this->dataPtr->pointCloudImage = new float[len * channelCount];
+    }
     memcpy(this->dataPtr->pointCloudImage,
       this->dataPtr->depthBuffer, len * channelCount * sizeof(float));
     this->dataPtr->newRgbPointCloud(
@@ -1147,6 +1217,54 @@ void Ogre2DepthCamera::PostRender()
   // }
 }
 
+//////////////////////////////////////////////////
+ignition::common::ConnectionPtr Ogre2DepthCamera::ConnectNewDepthFrameView(
+    std::function<void(const float *, unsigned int, unsigned int,
+      unsigned int, unsigned int, const std::string &)> _subscriber)
+{
+  return this->dataPtr->newDepthFrameView.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCamera::SetAsyncReadback(bool _async)
+{
+  if (this->dataPtr->asyncReadback == _async)
+    return;
+
+  this->dataPtr->asyncReadback = _async;
+
+  // a frame still in flight is discarded when switching back to
+  // synchronous readback
+  if (!_async)
+    this->DestroyReadbackTickets();
+}
+
+//////////////////////////////////////////////////
+bool Ogre2DepthCamera::AsyncReadback() const
+{
+  return this->dataPtr->asyncReadback;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DepthCamera::DestroyReadbackTickets()
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  Ogre::TextureGpuManager *textureMgr =
+      engine->OgreRoot()->getRenderSystem()->getTextureGpuManager();
+
+  for (size_t i = 0u; i < this->dataPtr->readbackTickets.size(); ++i)
+  {
+    if (this->dataPtr->readbackTickets[i])
+    {
+      textureMgr->destroyAsyncTextureTicket(
+          this->dataPtr->readbackTickets[i]);
+      this->dataPtr->readbackTickets[i] = nullptr;
+    }
+    this->dataPtr->readbackPending[i] = false;
+  }
+  this->dataPtr->readbackTicketIdx = 0u;
+}
+
 //////////////////////////////////////////////////
 const float *Ogre2DepthCamera::DepthData() const
 {
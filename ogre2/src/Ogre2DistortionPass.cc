@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include <ignition/common/Console.hh>
+
+#include "ignition/rendering/DistortionMap.hh"
+#include "ignition/rendering/RenderPassSystem.hh"
+#include "ignition/rendering/ogre2/Ogre2DistortionPass.hh"
+#include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
+
+#ifdef _MSC_VER
+  #pragma warning(push, 0)
+#endif
+#include <Compositor/OgreCompositorManager2.h>
+#include <Compositor/OgreCompositorNodeDef.h>
+#include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
+#include <OgreCamera.h>
+#include <OgreMaterial.h>
+#include <OgreMaterialManager.h>
+#include <OgrePass.h>
+#include <OgrePixelFormatGpuUtils.h>
+#include <OgreRoot.h>
+#include <OgreStagingTexture.h>
+#include <OgreTechnique.h>
+#include <OgreTextureGpuManager.h>
+#include <OgreVector3.h>
+#ifdef _MSC_VER
+  #pragma warning(pop)
+#endif
+
+/// \brief Private data for the Ogre2DistortionPass class
+class ignition::rendering::Ogre2DistortionPassPrivate
+{
+  /// brief Pointer to the distortion ogre material
+  public: Ogre::Material *distortionMat = nullptr;
+
+  /// \brief Distortion map, shared with the passes of identical cameras
+  public: std::shared_ptr<const DistortionMap> distortionMap;
+
+  /// \brief Name of the distortion map texture, empty if this pass does not
+  /// use one
+  public: std::string textureName;
+};
+
+using namespace ignition;
+using namespace rendering;
+
+/// \brief Number of distortion passes using each distortion map texture,
+/// by texture name
+static std::map<std::string, unsigned int> gTextureUseCount;
+
+//////////////////////////////////////////////////
+/// \brief Get the texture of a distortion map, creating it if no other
+/// pass uses it yet
+/// \param[in] _name Name of the texture
+/// \param[in] _map Distortion map
+/// \return The texture
+static Ogre::TextureGpu *acquireDistortionTexture(const std::string &_name,
+    const DistortionMap &_map)
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  Ogre::TextureGpuManager *textureMgr =
+      engine->OgreRoot()->getRenderSystem()->getTextureGpuManager();
+
+  // textures are destroyed with the engine, so the use count of a missing
+  // texture is stale
+  Ogre::TextureGpu *texture = textureMgr->findTextureNoThrow(_name);
+  if (texture)
+  {
+    ++gTextureUseCount[_name];
+    return texture;
+  }
+  gTextureUseCount[_name] = 1u;
+
+  texture = textureMgr->createOrRetrieveTexture(
+      _name,
+      Ogre::GpuPageOutStrategy::SaveToSystemRam,
+      Ogre::TextureFlags::ManualTexture,
+      Ogre::TextureTypes::Type2D,
+      Ogre::BLANKSTRING,
+      0u);
+  texture->setTextureType(Ogre::TextureTypes::Type2D);
+  texture->setResolution(_map.Size(), _map.Size());
+  texture->setNumMipmaps(1u);
+  texture->setPixelFormat(Ogre::PFG_RG32_FLOAT);
+
+  const Ogre::uint32 rowAlignment = 1u;
+  const size_t dataSize = Ogre::PixelFormatGpuUtils::getSizeBytes(
+      texture->getWidth(), texture->getHeight(), texture->getDepth(),
+      texture->getNumSlices(), texture->getPixelFormat(), rowAlignment);
+  const size_t bytesPerRow = texture->_getSysRamCopyBytesPerRow(0);
+  const size_t mapBytesPerRow = _map.Size() * 2u * sizeof(float);
+  Ogre::uint8 *pDest = reinterpret_cast<Ogre::uint8 *>(
+      OGRE_MALLOC_SIMD(dataSize, Ogre::MEMCATEGORY_RESOURCE));
+  const Ogre::uint8 *pSrc = reinterpret_cast<const Ogre::uint8 *>(
+      _map.Data());
+  for (unsigned int row = 0u; row < _map.Size(); ++row)
+  {
+    std::memcpy(pDest + row * bytesPerRow, pSrc + row * mapBytesPerRow,
+        mapBytesPerRow);
+  }
+
+  texture->_transitionTo(Ogre::GpuResidency::Resident, pDest);
+  texture->_setNextResidencyStatus(Ogre::GpuResidency::Resident);
+  // We have to upload the data via a StagingTexture, which acts as an
+  // intermediate stash memory that is both visible to CPU and GPU.
+  Ogre::StagingTexture *stagingTexture = textureMgr->getStagingTexture(
+      texture->getWidth(), texture->getHeight(), texture->getDepth(),
+      texture->getNumSlices(), texture->getPixelFormat());
+  stagingTexture->startMapRegion();
+  Ogre::TextureBox texBox = stagingTexture->mapRegion(
+      texture->getWidth(), texture->getHeight(), texture->getDepth(),
+      texture->getNumSlices(), texture->getPixelFormat());
+  texBox.copyFrom(pDest, texture->getWidth(), texture->getHeight(),
+      bytesPerRow);
+  stagingTexture->stopMapRegion();
+  stagingTexture->upload(texBox, texture, 0, 0, 0, true);
+  // Tell the TextureGpuManager we're done with this StagingTexture.
+  // Otherwise it will leak.
+  textureMgr->removeStagingTexture(stagingTexture);
+  // The texture owns pDest since its paging strategy is SaveToSystemRam
+  texture->notifyDataIsReady();
+  return texture;
+}
+
+//////////////////////////////////////////////////
+/// \brief Release a distortion map texture, destroying it when the last
+/// pass using it releases it
+/// \param[in] _name Name of the texture
+static void releaseDistortionTexture(const std::string &_name)
+{
+  auto it = gTextureUseCount.find(_name);
+  if (it == gTextureUseCount.end())
+    return;
+  if (--it->second > 0u)
+    return;
+  gTextureUseCount.erase(it);
+
+  // the texture is already gone if the engine was unloaded
+  auto ogreRoot = Ogre2RenderEngine::Instance()->OgreRoot();
+  if (!ogreRoot || !ogreRoot->getRenderSystem())
+    return;
+  Ogre::TextureGpuManager *textureMgr =
+      ogreRoot->getRenderSystem()->getTextureGpuManager();
+  Ogre::TextureGpu *texture = textureMgr->findTextureNoThrow(_name);
+  if (texture)
+    textureMgr->destroyTexture(texture);
+}
+
+//////////////////////////////////////////////////
+Ogre2DistortionPass::Ogre2DistortionPass()
+  : dataPtr(std::make_unique<Ogre2DistortionPassPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+Ogre2DistortionPass::~Ogre2DistortionPass()
+{
+  this->Destroy();
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionPass::Destroy()
+{
+  if (!this->dataPtr->textureName.empty())
+  {
+    releaseDistortionTexture(this->dataPtr->textureName);
+    this->dataPtr->textureName.clear();
+  }
+  this->dataPtr->distortionMap.reset();
+}
+
+//////////////////////////////////////////////////
+void Ogre2DistortionPass::CreateRenderPass()
+{
+  static int distortionNodeCounter = 0;
+
+  // the node is created once, the render target calls this every time the
+  // render pass chain changes
+  if (!this->ogreCompositorNodeDefName.empty())
+    return;
+
+  Ogre::Camera *ogreCamera = this->OgreCamera();
+  unsigned int imageWidth = this->ImageWidth();
+  unsigned int imageHeight = this->ImageHeight();
+  if (!ogreCamera || imageWidth == 0u || imageHeight == 0u)
+  {
+    ignerr << "No camera set for applying Distortion Pass" << std::endl;
+    return;
+  }
+
+  // If no distortion is required, immediately return.
+  if (ignition::math::equal(this->k1, 0.0) &&
+      ignition::math::equal(this->k2, 0.0) &&
+      ignition::math::equal(this->k3, 0.0) &&
+      ignition::math::equal(this->p1, 0.0) &&
+      ignition::math::equal(this->p2, 0.0))
+  {
+    return;
+  }
+
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+
+  // seems to work best with a square distortion map texture
+  unsigned int texSize = std::max(imageWidth, imageHeight);
+  // calculate focal length from largest fov
+  const double fov = imageHeight > imageWidth ?
+      ogreCamera->getFOVy().valueRadians() :
+      (ogreCamera->getFOVy().valueRadians() *
+      ogreCamera->getAspectRatio());
+  const double focalLength = texSize / (2 * std::tan(fov / 2));
+
+  // cameras with the same lens share the map and its texture
+  this->dataPtr->distortionMap = DistortionMap::Shared(texSize, focalLength,
+      this->lensCenter, this->k1, this->k2, this->k3, this->p1, this->p2,
+      engine->DistortionCachePath());
+  std::string texName = "DistortionMap_" +
+      this->dataPtr->distortionMap->Key();
+  Ogre::TextureGpu *texture =
+      acquireDistortionTexture(texName, *this->dataPtr->distortionMap);
+  this->dataPtr->textureName = texName;
+
+  // The Distortion material is defined in script (distortion.material).
+  // clone the material
+  std::string matName = "Distortion";
+  Ogre::MaterialPtr ogreMat =
+      Ogre::MaterialManager::getSingleton().getByName(matName);
+  if (!ogreMat)
+  {
+    ignerr << "Distortion material not found: '" << matName << "'"
+           << std::endl;
+    return;
+  }
+  if (!ogreMat->isLoaded())
+    ogreMat->load();
+  std::string materialName = matName + "_" +
+      std::to_string(distortionNodeCounter);
+  this->dataPtr->distortionMat = ogreMat->clone(materialName).get();
+
+  // These calls are setting parameters that are declared in two places:
+  // 1. media/materials/scripts/distortion.material, in
+  //    fragment_program DistortionFS
+  // 2. media/materials/programs/GLSL/distortion_fs.glsl
+  Ogre::Pass *pass = this->dataPtr->distortionMat->getTechnique(0)->getPass(0);
+  pass->getTextureUnitState(1)->setTexture(texture);
+  math::Vector2d scale = this->dataPtr->distortionMap->CropScale();
+  Ogre::GpuProgramParametersSharedPtr psParams =
+      pass->getFragmentProgramParameters();
+  psParams->setNamedConstant("scale",
+      Ogre::Vector3(1.0 / scale.X(), 1.0 / scale.Y(), 1.0));
+
+  // create the compostior node definition
+
+  // The compositor node definition is equivalent to the following
+  // ogre compositor script:
+  // compositor_node DistortionNode
+  // {
+  //   in 0 rt_input
+  //   in 1 rt_output
+  //
+  //   target rt_output
+  //   {
+  //     pass render_quad
+  //     {
+  //       material Distortion // Use copy instead of original
+  //       input 0 rt_input
+  //     }
+  //   }
+  //   out 0 rt_output
+  //   out 1 rt_input
+  // }
+  std::string nodeDefName = "DistortionNode_"
+      + std::to_string(distortionNodeCounter);
+  distortionNodeCounter++;
+  if (ogreCompMgr->hasNodeDefinition(nodeDefName))
+    return;
+  this->ogreCompositorNodeDefName = nodeDefName;
+
+  Ogre::CompositorNodeDef *nodeDef =
+      ogreCompMgr->addNodeDefinition(nodeDefName);
+
+  // Input texture
+  nodeDef->addTextureSourceName("rt_input", 0,
+      Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+  nodeDef->addTextureSourceName("rt_output", 1,
+      Ogre::TextureDefinitionBase::TEXTURE_INPUT);
+
+  // rt_input target
+  nodeDef->setNumTargetPass(1);
+  Ogre::CompositorTargetDef *inputTargetDef =
+      nodeDef->addTargetPass("rt_output");
+  inputTargetDef->setNumPasses(1);
+  {
+    // quad pass
+    Ogre::CompositorPassQuadDef *passQuad =
+        static_cast<Ogre::CompositorPassQuadDef *>(
+        inputTargetDef->addPass(Ogre::PASS_QUAD));
+    passQuad->mMaterialName = materialName;
+    passQuad->addQuadTextureSource(0, "rt_input");
+  }
+  nodeDef->mapOutputChannel(0, "rt_output");
+  nodeDef->mapOutputChannel(1, "rt_input");
+}
+
+IGN_RENDERING_REGISTER_RENDER_PASS(Ogre2DistortionPass, DistortionPass)
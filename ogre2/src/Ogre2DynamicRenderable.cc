@@ -25,6 +25,10 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 #include "ignition/common/Console.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
 #include "ignition/rendering/ogre2/Ogre2DynamicRenderable.hh"
@@ -54,9 +58,75 @@ class ignition::rendering::Ogre2DynamicRenderablePrivate
   /// \brief List of vertices for the mesh
   public: std::vector<ignition::math::Vector3d> vertices;
 
+  /// \brief Point positions given to SetPoints, x y z for each point.
+  /// Used instead of vertices when usePositions is true
+  public: std::vector<float> positions;
+
+  /// \brief True if the points are stored in positions
+  public: bool usePositions = false;
+
+  /// \brief Move the points stored in positions to vertices, so they can
+  /// be edited one by one
+  public: void PositionsToVertices();
+
+  /// \brief Check if the operation type is a triangle type
+  /// \return True for triangle lists, strips and fans
+  public: bool Triangles() const;
+
+  /// \brief Extend the range of points changed since the last update
+  /// \param[in] _begin Index of the first changed point
+  /// \param[in] _end Index past the last changed point
+  public: void MarkDirty(size_t _begin, size_t _end);
+
+  /// \brief Write the changed points to the next region of the buffer
+  /// and grow the bounds by the changed points. The bounds are only
+  /// recomputed from all the points after points were removed or replaced,
+  /// so they may be larger than needed when points move inwards.
+  /// Used in streaming mode.
+  /// \param[in] _vertexCount Number of points
+  /// \return Bounding box of the points
+  public: Ogre::Aabb StreamVertices(unsigned int _vertexCount);
+
+  /// \brief Get the position of a point
+  /// \param[in] _index Index of the point
+  /// \return Position of the point
+  public: Ogre::Vector3 PointPosition(size_t _index) const;
+
   /// \brief Used to indicate if the lines require an update
   public: bool dirty = false;
 
+  /// \brief True if streaming mode is enabled
+  public: bool streaming = false;
+
+  /// \brief Range of points changed since the last update, as
+  /// [begin, end). Empty when begin >= end.
+  public: std::pair<size_t, size_t> dirtyRange{0u, 0u};
+
+  /// \brief Range of points not yet written to each region of the
+  /// persistent mapped vertex buffer, indexed by region. Only used in
+  /// streaming mode.
+  public: std::vector<std::pair<size_t, size_t>> regionDirtyRanges;
+
+  /// \brief Get the region of the vertex buffer handed out by its last
+  /// map(), which is the region drawn. Each map() moves the buffer to its
+  /// next region, independently of the frame count of the vao manager, so
+  /// the region is read from the buffer itself.
+  /// \return Index of the region
+  public: size_t BufferRegion() const;
+
+  /// \brief Minimum corner of the bounds of the streamed points
+  public: Ogre::Vector3 streamMin;
+
+  /// \brief Maximum corner of the bounds of the streamed points
+  public: Ogre::Vector3 streamMax;
+
+  /// \brief Number of points covered by streamMin and streamMax
+  public: size_t streamBoundsCount = 0u;
+
+  /// \brief True if the streamed bounds must be recomputed from all the
+  /// points, e.g. after points were removed
+  public: bool streamBoundsReset = true;
+
   /// \brief Render operation type
   public: Ogre::OperationType operationType;
 
@@ -96,6 +166,167 @@ class ignition::rendering::Ogre2DynamicRenderablePrivate
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::PositionsToVertices()
+{
+  if (!this->usePositions)
+    return;
+
+  this->vertices.resize(this->positions.size() / 3u);
+  for (unsigned int i = 0; i < this->vertices.size(); ++i)
+  {
+    this->vertices[i].Set(this->positions[i * 3],
+        this->positions[i * 3 + 1], this->positions[i * 3 + 2]);
+  }
+  this->positions.clear();
+  this->usePositions = false;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2DynamicRenderablePrivate::Triangles() const
+{
+  return this->operationType == Ogre::OperationType::OT_TRIANGLE_LIST ||
+      this->operationType == Ogre::OperationType::OT_TRIANGLE_STRIP ||
+      this->operationType == Ogre::OperationType::OT_TRIANGLE_FAN;
+}
+
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderablePrivate::MarkDirty(size_t _begin, size_t _end)
+{
+  if (this->dirtyRange.first >= this->dirtyRange.second)
+  {
+    this->dirtyRange = {_begin, _end};
+  }
+  else
+  {
+    this->dirtyRange.first = std::min(this->dirtyRange.first, _begin);
+    this->dirtyRange.second = std::max(this->dirtyRange.second, _end);
+  }
+  this->dirty = true;
+}
+
+//////////////////////////////////////////////////
+Ogre::Aabb Ogre2DynamicRenderablePrivate::StreamVertices(
+    unsigned int _vertexCount)
+{
+  // points to grow the bounds by
+  std::pair<size_t, size_t> changed = this->dirtyRange;
+
+  // every region of the buffer misses the points changed since the last
+  // update, in addition to what it already missed
+  if (this->dirtyRange.first < this->dirtyRange.second)
+  {
+    for (auto &range : this->regionDirtyRanges)
+    {
+      if (range.first >= range.second)
+      {
+        range = this->dirtyRange;
+      }
+      else
+      {
+        range.first = std::min(range.first, this->dirtyRange.first);
+        range.second = std::max(range.second, this->dirtyRange.second);
+      }
+    }
+  }
+  this->dirtyRange = {0u, 0u};
+
+  // the persistent mapped buffer has one region per frame in flight and
+  // every map() moves to the next region, so only bring that region up to
+  // date. When it has nothing to write, no change was made since the
+  // region drawn now was mapped, so that region is kept.
+  size_t nextRegion = (this->BufferRegion() + 1u) %
+      this->regionDirtyRanges.size();
+  std::pair<size_t, size_t> &range = this->regionDirtyRanges[nextRegion];
+  size_t begin = range.first;
+  size_t end = std::min(range.second, static_cast<size_t>(_vertexCount));
+
+  if (begin < end)
+  {
+    range = {0u, 0u};
+    float * RESTRICT_ALIAS vertices =
+        reinterpret_cast<float * RESTRICT_ALIAS>(
+        this->vertexBuffer->map(begin, end - begin));
+
+    // write whole vertices, including the unused normals, so the writes to
+    // the write combined memory stay sequential
+    for (size_t i = begin; i < end; ++i)
+    {
+      size_t idx = (i - begin) * 6;
+      if (this->usePositions)
+      {
+        const float *p = &this->positions[i * 3];
+        vertices[idx] = p[0];
+        vertices[idx+1] = p[1];
+        vertices[idx+2] = p[2];
+      }
+      else
+      {
+        const math::Vector3d &v = this->vertices[i];
+        vertices[idx] = static_cast<float>(v.X());
+        vertices[idx+1] = static_cast<float>(v.Y());
+        vertices[idx+2] = static_cast<float>(v.Z());
+      }
+      vertices[idx+3] = 0;
+      vertices[idx+4] = 0;
+      vertices[idx+5] = 0;
+    }
+
+    this->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+  }
+
+  // only draw the points in use
+  this->vao->setPrimitiveRange(0, _vertexCount);
+
+  if (_vertexCount == 0)
+  {
+    this->streamBoundsReset = true;
+    return Ogre::Aabb();
+  }
+
+  // grow the bounds by the changed points. Recompute them from all the
+  // points when points were removed since the bounds can only grow.
+  size_t first = changed.first;
+  size_t last = std::min(changed.second, static_cast<size_t>(_vertexCount));
+  if (this->streamBoundsReset || _vertexCount < this->streamBoundsCount)
+  {
+    this->streamMin = Ogre::Vector3(std::numeric_limits<float>::max());
+    this->streamMax = Ogre::Vector3(-std::numeric_limits<float>::max());
+    first = 0u;
+    last = _vertexCount;
+  }
+  for (size_t i = first; i < last; ++i)
+  {
+    Ogre::Vector3 v = this->PointPosition(i);
+    this->streamMin.makeFloor(v);
+    this->streamMax.makeCeil(v);
+  }
+  this->streamBoundsCount = _vertexCount;
+  this->streamBoundsReset = false;
+
+  return Ogre::Aabb::newFromExtents(this->streamMin, this->streamMax);
+}
+
+//////////////////////////////////////////////////
+size_t Ogre2DynamicRenderablePrivate::BufferRegion() const
+{
+  return (this->vertexBuffer->_getFinalBufferStart() -
+      this->vertexBuffer->_getInternalBufferStart()) /
+      this->vertexBuffer->getNumElements();
+}
+
+//////////////////////////////////////////////////
+Ogre::Vector3 Ogre2DynamicRenderablePrivate::PointPosition(
+    size_t _index) const
+{
+  if (this->usePositions)
+  {
+    const float *p = &this->positions[_index * 3];
+    return Ogre::Vector3(p[0], p[1], p[2]);
+  }
+  return Ogre2Conversions::Convert(this->vertices[_index]);
+}
+
 //////////////////////////////////////////////////
 Ogre2DynamicRenderable::Ogre2DynamicRenderable(
     ScenePtr _scene)
@@ -177,6 +408,25 @@ void Ogre2DynamicRenderable::DestroyBuffer()
   this->dataPtr->vbuffer = nullptr;
 }
 
+//////////////////////////////////////////////////
+void Ogre2DynamicRenderable::SetStreaming(bool _streaming)
+{
+  if (this->dataPtr->streaming == _streaming)
+    return;
+
+  // upload everything on the next update, the full update also draws the
+  // whole buffer again
+  this->dataPtr->streaming = _streaming;
+  this->dataPtr->streamBoundsReset = true;
+  this->dataPtr->MarkDirty(0u, this->PointCount());
+}
+
+//////////////////////////////////////////////////
+bool Ogre2DynamicRenderable::Streaming() const
+{
+  return this->dataPtr->streaming;
+}
+
 //////////////////////////////////////////////////
 Ogre::MovableObject *Ogre2DynamicRenderable::OgreObject() const
 {
@@ -222,10 +472,14 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   if (!vaoManager)
     return;
 
+  // triangle normals depend on the neighbouring vertices so triangles are
+  // always fully uploaded
+  bool streaming = this->dataPtr->streaming && !this->dataPtr->Triangles();
+
   // Prepare vertex buffer
   unsigned int newVertCapacity = this->dataPtr->vertexBufferCapacity;
 
-  unsigned int vertexCount = this->dataPtr->vertices.size();
+  unsigned int vertexCount = this->PointCount();
   if ((vertexCount > this->dataPtr->vertexBufferCapacity) ||
       (!this->dataPtr->vertexBufferCapacity))
   {
@@ -240,9 +494,11 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     while (newVertCapacity < vertexCount)
       newVertCapacity <<= 1;
   }
-  else if (vertexCount < this->dataPtr->vertexBufferCapacity>>1)
+  else if (!streaming &&
+      vertexCount < this->dataPtr->vertexBufferCapacity>>1)
   {
-    // Make capacity the previous power of two
+    // Make capacity the previous power of two. In streaming mode the buffer
+    // is kept to avoid reallocating it when the point count goes back up.
     unsigned int newCapacity = newVertCapacity >>1;
     while (vertexCount < newCapacity)
     {
@@ -252,8 +508,10 @@ void Ogre2DynamicRenderable::UpdateBuffer()
   }
 
   // recreate vao if needed
+  bool recreated = false;
   if (newVertCapacity != this->dataPtr->vertexBufferCapacity)
   {
+    recreated = true;
     this->dataPtr->vertexBufferCapacity = newVertCapacity;
 
     this->DestroyBuffer();
@@ -289,58 +547,111 @@ void Ogre2DynamicRenderable::UpdateBuffer()
     this->dataPtr->subMesh->mVao[Ogre::VpNormal].push_back(this->dataPtr->vao);
     // Use the same geometry for shadow casting.
     this->dataPtr->subMesh->mVao[Ogre::VpShadow].push_back(this->dataPtr->vao);
+
+    // none of the regions of the new buffer hold any point yet
+    this->dataPtr->regionDirtyRanges.assign(
+        vaoManager->getDynamicBufferMultiplier(),
+        {0u, std::numeric_limits<size_t>::max()});
   }
 
-  // map buffer and update the geometry
   Ogre::Aabb bbox;
-  float * RESTRICT_ALIAS vertices = reinterpret_cast<float * RESTRICT_ALIAS>(
-      this->dataPtr->vertexBuffer->map(
-      0, this->dataPtr->vertexBuffer->getNumElements()));
-
-  // fill vertices
-  for (unsigned int i = 0; i < vertexCount; ++i)
+  if (streaming)
   {
-    unsigned int idx = i*6;
-    Ogre::Vector3 v = Ogre2Conversions::Convert(this->dataPtr->vertices[i]);
-    vertices[idx] = v.x;
-    vertices[idx+1] = v.y;
-    vertices[idx+2] = v.z;
-
-    bbox.merge(v);
+    bbox = this->dataPtr->StreamVertices(vertexCount);
   }
-
-  // fill the rest of the buffer with the position of the last vertex to avoid
-  // the geometry connecting back to 0, 0, 0
-  if (vertexCount > 0 && vertexCount < this->dataPtr->vertexBufferCapacity)
+  else
   {
-    math::Vector3d lastVertex = this->dataPtr->vertices[vertexCount-1];
-    for (unsigned int i = vertexCount; i < this->dataPtr->vertexBufferCapacity;
-        ++i)
+    // the region written below is complete but the others are not
+    this->dataPtr->regionDirtyRanges.assign(
+        vaoManager->getDynamicBufferMultiplier(),
+        {0u, std::numeric_limits<size_t>::max()});
+    this->dataPtr->dirtyRange = {0u, 0u};
+    this->dataPtr->streamBoundsReset = true;
+    this->dataPtr->vao->setPrimitiveRange(0,
+        this->dataPtr->vertexBufferCapacity);
+
+    // map buffer and update the geometry
+    float * RESTRICT_ALIAS vertices =
+        reinterpret_cast<float * RESTRICT_ALIAS>(
+        this->dataPtr->vertexBuffer->map(
+        0, this->dataPtr->vertexBuffer->getNumElements()));
+    this->dataPtr->regionDirtyRanges[this->dataPtr->BufferRegion()] =
+        {0u, 0u};
+
+    // fill vertices
+    if (this->dataPtr->usePositions)
+    {
+      // copy the float positions as they are and track the bounds per axis
+      const float *positions = this->dataPtr->positions.data();
+      Ogre::Vector3 minPos(std::numeric_limits<float>::max());
+      Ogre::Vector3 maxPos(-std::numeric_limits<float>::max());
+      for (unsigned int i = 0; i < vertexCount; ++i)
+      {
+        unsigned int idx = i*6;
+        const float *p = positions + i*3;
+        vertices[idx] = p[0];
+        vertices[idx+1] = p[1];
+        vertices[idx+2] = p[2];
+
+        minPos.makeFloor(Ogre::Vector3(p[0], p[1], p[2]));
+        maxPos.makeCeil(Ogre::Vector3(p[0], p[1], p[2]));
+      }
+      if (vertexCount > 0)
+        bbox = Ogre::Aabb::newFromExtents(minPos, maxPos);
+    }
+    else
     {
-      unsigned int idx = i * 6;
-      vertices[idx] = lastVertex.X();
-      vertices[idx+1] = lastVertex.Y();
-      vertices[idx+2] = lastVertex.Z();
+      for (unsigned int i = 0; i < vertexCount; ++i)
+      {
+        unsigned int idx = i*6;
+        Ogre::Vector3 v =
+            Ogre2Conversions::Convert(this->dataPtr->vertices[i]);
+        vertices[idx] = v.x;
+        vertices[idx+1] = v.y;
+        vertices[idx+2] = v.z;
+
+        bbox.merge(v);
+      }
+    }
 
-      vertices[idx+3] = 0;
-      vertices[idx+4] = 0;
-      vertices[idx+5] = 1;
+    // fill the rest of the buffer with the position of the last vertex to
+    // avoid the geometry connecting back to 0, 0, 0
+    if (vertexCount > 0 && vertexCount < this->dataPtr->vertexBufferCapacity)
+    {
+      math::Vector3d lastVertex = this->Point(vertexCount-1);
+      for (unsigned int i = vertexCount;
+          i < this->dataPtr->vertexBufferCapacity; ++i)
+      {
+        unsigned int idx = i * 6;
+        vertices[idx] = lastVertex.X();
+        vertices[idx+1] = lastVertex.Y();
+        vertices[idx+2] = lastVertex.Z();
+
+        vertices[idx+3] = 0;
+        vertices[idx+4] = 0;
+        vertices[idx+5] = 1;
+      }
     }
-  }
 
-  // fill normals
-  this->GenerateNormals(this->dataPtr->operationType, this->dataPtr->vertices,
-      vertices);
+    // fill normals
+    this->GenerateNormals(this->dataPtr->operationType,
+        this->dataPtr->vertices, vertices);
 
-  // unmap buffer
-  this->dataPtr->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+    // unmap buffer
+    this->dataPtr->vertexBuffer->unmap(Ogre::UO_KEEP_PERSISTENT);
+  }
 
   // Set the bounds to get frustum culling and LOD to work correctly.
   Ogre::Mesh *mesh = this->dataPtr->subMesh->mParent;
   mesh->_setBounds(bbox, true);
 
   // update item aabb
-  if (this->dataPtr->ogreItem)
+  if (this->dataPtr->ogreItem && streaming && !recreated)
+  {
+    // the vao is still valid so the item only needs the new bounds
+    this->dataPtr->ogreItem->setLocalAabb(bbox);
+  }
+  else if (this->dataPtr->ogreItem)
   {
     bool castShadows = this->dataPtr->ogreItem->getCastShadows();
     auto lowLevelMat = this->dataPtr->ogreItem->getSubItem(0)->getMaterial();
@@ -445,6 +756,7 @@ MarkerType Ogre2DynamicRenderable::OperationType() const
 void Ogre2DynamicRenderable::AddPoint(const ignition::math::Vector3d &_pt,
                                       const ignition::math::Color &_color)
 {
+  this->dataPtr->PositionsToVertices();
   this->dataPtr->vertices.push_back(_pt);
 
   // todo(anyone)
@@ -453,7 +765,8 @@ void Ogre2DynamicRenderable::AddPoint(const ignition::math::Vector3d &_pt,
   // https://forums.ogre3d.org/viewtopic.php?t=93627#p539276
   this->dataPtr->colors.push_back(_color);
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(this->dataPtr->vertices.size() - 1u,
+      this->dataPtr->vertices.size());
 }
 
 /////////////////////////////////////////////////
@@ -467,6 +780,7 @@ void Ogre2DynamicRenderable::AddPoint(double _x, double _y, double _z,
 void Ogre2DynamicRenderable::SetPoint(unsigned int _index,
                                       const ignition::math::Vector3d &_value)
 {
+  this->dataPtr->PositionsToVertices();
   if (_index >= this->dataPtr->vertices.size())
   {
     ignerr << "Point index[" << _index << "] is out of bounds[0-"
@@ -476,7 +790,74 @@ void Ogre2DynamicRenderable::SetPoint(unsigned int _index,
 
   this->dataPtr->vertices[_index] = _value;
 
-  this->dataPtr->dirty = true;
+  this->dataPtr->MarkDirty(_index, _index + 1u);
+}
+
+/////////////////////////////////////////////////
+void Ogre2DynamicRenderable::SetPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->positions.assign(_positions, _positions + _count * 3u);
+  this->dataPtr->vertices.clear();
+  this->dataPtr->usePositions = true;
+
+  // triangle normals are generated from the double precision vertices
+  if (this->dataPtr->Triangles())
+    this->dataPtr->PositionsToVertices();
+
+  // keep one color per point, only reallocating when the count changes
+  if (_colors)
+    this->dataPtr->colors.assign(_colors, _colors + _count);
+  else
+    this->dataPtr->colors.resize(_count, ignition::math::Color::White);
+
+  // all the points are replaced so the streamed bounds start over
+  this->dataPtr->streamBoundsReset = true;
+  this->dataPtr->MarkDirty(0u, _count);
+}
+
+/////////////////////////////////////////////////
+void Ogre2DynamicRenderable::AppendPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  if (_count == 0u)
+    return;
+
+  unsigned int pointCount = this->PointCount();
+  if (pointCount == 0u)
+  {
+    this->SetPoints(_positions, _colors, _count);
+    return;
+  }
+
+  if (this->dataPtr->usePositions)
+  {
+    this->dataPtr->positions.insert(this->dataPtr->positions.end(),
+        _positions, _positions + _count * 3u);
+  }
+  else
+  {
+    this->dataPtr->vertices.reserve(pointCount + _count);
+    for (unsigned int i = 0; i < _count; ++i)
+    {
+      const float *p = _positions + i * 3u;
+      this->dataPtr->vertices.push_back(
+          ignition::math::Vector3d(p[0], p[1], p[2]));
+    }
+  }
+
+  if (_colors)
+  {
+    this->dataPtr->colors.insert(this->dataPtr->colors.end(), _colors,
+        _colors + _count);
+  }
+  else
+  {
+    this->dataPtr->colors.resize(this->dataPtr->colors.size() + _count,
+        ignition::math::Color::White);
+  }
+
+  this->dataPtr->MarkDirty(pointCount, pointCount + _count);
 }
 
 /////////////////////////////////////////////////
@@ -504,33 +885,46 @@ void Ogre2DynamicRenderable::SetColor(unsigned int _index,
 ignition::math::Vector3d Ogre2DynamicRenderable::Point(
     const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->vertices.size())
+  if (_index >= this->PointCount())
   {
     ignerr << "Point index[" << _index << "] is out of bounds[0-"
-           << this->dataPtr->vertices.size()-1 << "]\n";
+           << this->PointCount()-1 << "]\n";
 
     return ignition::math::Vector3d(ignition::math::INF_D,
                                     ignition::math::INF_D,
                                     ignition::math::INF_D);
   }
 
+  if (this->dataPtr->usePositions)
+  {
+    const float *p = &this->dataPtr->positions[_index * 3];
+    return ignition::math::Vector3d(p[0], p[1], p[2]);
+  }
+
   return this->dataPtr->vertices[_index];
 }
 
 /////////////////////////////////////////////////
 unsigned int Ogre2DynamicRenderable::PointCount() const
 {
+  if (this->dataPtr->usePositions)
+    return this->dataPtr->positions.size() / 3u;
+
   return this->dataPtr->vertices.size();
 }
 
 /////////////////////////////////////////////////
 void Ogre2DynamicRenderable::Clear()
 {
-  if (this->dataPtr->vertices.empty() && this->dataPtr->colors.empty())
+  if (this->dataPtr->vertices.empty() && this->dataPtr->positions.empty() &&
+      this->dataPtr->colors.empty())
     return;
 
   this->dataPtr->vertices.clear();
+  this->dataPtr->positions.clear();
+  this->dataPtr->usePositions = false;
   this->dataPtr->colors.clear();
+  this->dataPtr->streamBoundsReset = true;
   this->dataPtr->dirty = true;
 }
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+#include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/ogre2/Ogre2Marker.hh"
+#include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "ignition/rendering/ogre2/Ogre2Scene.hh"
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <OgreItem.h>
+#include <OgreSubItem.h>
+#include <OgreSubMesh2.h>
+#include <Vao/OgreAsyncTicket.h>
+#include <Vao/OgreVertexArrayObject.h>
+#include <Vao/OgreVertexBufferPacked.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+using namespace ignition;
+using namespace rendering;
+
+class Ogre2DynamicRenderableTest : public testing::Test
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+
+  /// \brief Get the number of vertices drawn for a marker
+  /// \param[in] _marker Marker to check
+  /// \return Number of vertices in the primitive range of the marker vao
+  public: size_t DrawnVertexCount(MarkerPtr _marker)
+  {
+    auto ogreMarker = std::dynamic_pointer_cast<Ogre2Marker>(_marker);
+    Ogre::Item *item = dynamic_cast<Ogre::Item *>(ogreMarker->OgreObject());
+    if (!item)
+      return 0u;
+    return item->getSubItem(0)->getSubMesh()->mVao[Ogre::VpNormal][0]->
+        getPrimitiveCount();
+  }
+
+  /// \brief Read back the positions of the vertices drawn for a marker
+  /// \param[in] _marker Marker to read
+  /// \return Positions in the region of the vertex buffer that is drawn
+  public: std::vector<Ogre::Vector3> DrawnVertices(MarkerPtr _marker)
+  {
+    std::vector<Ogre::Vector3> result;
+    size_t count = this->DrawnVertexCount(_marker);
+    if (count == 0u)
+      return result;
+
+    auto ogreMarker = std::dynamic_pointer_cast<Ogre2Marker>(_marker);
+    Ogre::Item *item = dynamic_cast<Ogre::Item *>(ogreMarker->OgreObject());
+    Ogre::VertexBufferPacked *buffer = item->getSubItem(0)->getSubMesh()->
+        mVao[Ogre::VpNormal][0]->getVertexBuffers()[0];
+
+    // the read back copies the region of the buffer that is drawn
+    Ogre::AsyncTicketPtr ticket = buffer->readRequest(0u, count);
+    const float *data = reinterpret_cast<const float *>(ticket->map());
+    for (size_t i = 0u; i < count; ++i)
+    {
+      const float *v = data + i * 6u;
+      result.push_back(Ogre::Vector3(v[0], v[1], v[2]));
+    }
+    ticket->unmap();
+    return result;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2DynamicRenderableTest, Streaming)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32);
+  camera->SetImageHeight(32);
+  root->AddChild(camera);
+
+  VisualPtr visual = scene->CreateVisual();
+  root->AddChild(visual);
+  MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_LINE_STRIP);
+  visual->AddGeometry(marker);
+
+  // add and move points over more frames than the vertex buffer has
+  // regions, so the regions wrap around with pending dirty ranges
+  const unsigned int frames = 10u;
+  for (unsigned int i = 0u; i < frames; ++i)
+  {
+    marker->AddPoint(math::Vector3d(i, 0, 0), math::Color::White);
+    marker->SetPoint(0u, math::Vector3d(0, 0, i));
+    camera->Update();
+
+    EXPECT_EQ(i + 1u, this->DrawnVertexCount(marker)) << "frame " << i;
+    Ogre::Aabb aabb = marker->OgreObject()->getLocalAabb();
+    EXPECT_EQ(Ogre::Vector3(0, 0, 0), aabb.getMinimum()) << "frame " << i;
+    EXPECT_EQ(Ogre::Vector3(i, 0, i), aabb.getMaximum()) << "frame " << i;
+  }
+
+  // fewer points are drawn and bounded after points are removed, while the
+  // vertex buffer keeps its capacity
+  marker->ClearPoints();
+  marker->AddPoint(math::Vector3d(1, 1, 1), math::Color::White);
+  marker->AddPoint(math::Vector3d(2, 2, 2), math::Color::White);
+  camera->Update();
+  EXPECT_EQ(2u, this->DrawnVertexCount(marker));
+  Ogre::Aabb aabb = marker->OgreObject()->getLocalAabb();
+  EXPECT_EQ(Ogre::Vector3(1, 1, 1), aabb.getMinimum());
+  EXPECT_EQ(Ogre::Vector3(2, 2, 2), aabb.getMaximum());
+
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2DynamicRenderableTest, StreamingContents)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32);
+  camera->SetImageHeight(32);
+  root->AddChild(camera);
+
+  VisualPtr visual = scene->CreateVisual();
+  root->AddChild(visual);
+  MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_LINE_STRIP);
+  visual->AddGeometry(marker);
+
+  std::vector<Ogre::Vector3> expected;
+  for (unsigned int i = 0u; i < 8u; ++i)
+  {
+    expected.push_back(Ogre::Vector3(i, 0, 0));
+    marker->AddPoint(math::Vector3d(i, 0, 0), math::Color::White);
+  }
+  camera->Update();
+  EXPECT_EQ(expected, this->DrawnVertices(marker));
+
+  // mix single point edits, appended points and frames without any change
+  // so the buffer regions are mapped in some frames and skipped in others
+  for (unsigned int i = 1u; i < 16u; ++i)
+  {
+    switch (i % 4u)
+    {
+      case 0u:
+      {
+        unsigned int index = i % expected.size();
+        expected[index] = Ogre::Vector3(i, i, i);
+        marker->SetPoint(index, math::Vector3d(i, i, i));
+        break;
+      }
+      case 1u:
+      {
+        expected.push_back(Ogre::Vector3(0, i, 0));
+        marker->AddPoint(math::Vector3d(0, i, 0), math::Color::White);
+        break;
+      }
+      case 2u:
+        // nothing changes
+        break;
+      default:
+        // nothing changes for several frames
+        camera->Update();
+        camera->Update();
+        break;
+    }
+    camera->Update();
+
+    EXPECT_EQ(expected.size(), this->DrawnVertexCount(marker))
+        << "frame " << i;
+    EXPECT_EQ(expected, this->DrawnVertices(marker)) << "frame " << i;
+  }
+
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
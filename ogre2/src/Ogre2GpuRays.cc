@@ -15,6 +15,14 @@
  *
 */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -24,6 +32,7 @@
 #include "ignition/rendering/ogre2/Ogre2Camera.hh"
 #include "ignition/rendering/ogre2/Ogre2GpuRays.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "ignition/rendering/PixelCopy.hh"
 #include "ignition/rendering/RenderTypes.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
 #include "ignition/rendering/ogre2/Ogre2ParticleEmitter.hh"
@@ -116,9 +125,6 @@ class ignition::rendering::Ogre2GpuRaysPrivate
                unsigned int, unsigned int, unsigned int,
                const std::string &)> newGpuRaysFrame;
 
-  /// \brief Raw buffer of gpu rays data.
-  public: float *gpuRaysBuffer = nullptr;
-
   /// \brief Outgoing gpu rays data, used by newGpuRaysFrame event.
   public: float *gpuRaysScan = nullptr;
 
@@ -171,6 +177,14 @@ class ignition::rendering::Ogre2GpuRaysPrivate
   /// \brief Image height of first pass.
   public: unsigned int h1st = 0u;
 
+  /// \brief Image width of each cubemap face in the first pass. Equal to
+  /// w1st unless adaptive cubemap resolution is enabled.
+  public: unsigned int w1stFace[6];
+
+  /// \brief Image height of each cubemap face in the first pass. Equal to
+  /// h1st unless adaptive cubemap resolution is enabled.
+  public: unsigned int h1stFace[6];
+
   /// \brief Image width of second pass.
   public: unsigned int w2nd = 0u;
 
@@ -196,6 +210,26 @@ class ignition::rendering::Ogre2GpuRaysPrivate
 
   /// \brief Min allowed angle in radians;
   public: const math::Angle kMinAllowedAngle = 1e-4;
+
+  /// \brief Sensor that renders the cubemap sampled by this sensor, see
+  /// GpuRays::SetCubemapSource
+  public: std::weak_ptr<Ogre2GpuRays> sharedCubemapSource;
+
+  /// \brief True if the cubemap is rendered by sharedCubemapSource
+  public: bool sharingCubemap = false;
+
+  /// \brief Rotation from this sensor to the sensor rendering the cubemap
+  public: math::Quaterniond cubemapRotation = math::Quaterniond::Identity;
+
+  /// \brief Scene frame in which the cubemap was last rendered
+  public: uint64_t cubemapFrame = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Incremented every time the cubemap textures are destroyed
+  public: unsigned int cubemapVersion = 0u;
+
+  /// \brief Value of cubemapVersion of sharedCubemapSource when its
+  /// cubemap textures were bound to the 2nd pass material
+  public: unsigned int sharedCubemapVersion = 0u;
 };
 
 using namespace ignition;
@@ -361,7 +395,10 @@ Ogre2GpuRays::Ogre2GpuRays()
   {
     this->dataPtr->cubeCam[i] = nullptr;
     this->dataPtr->ogreCompositorWorkspace1st[i] = nullptr;
+    this->dataPtr->firstPassTextures[i] = nullptr;
     this->dataPtr->laserRetroMaterialSwitcher[i] = nullptr;
+    this->dataPtr->w1stFace[i] = 0u;
+    this->dataPtr->h1stFace[i] = 0u;
   }
 }
 
@@ -386,12 +423,6 @@ void Ogre2GpuRays::Init()
 //////////////////////////////////////////////////
 void Ogre2GpuRays::Destroy()
 {
-  if (this->dataPtr->gpuRaysBuffer)
-  {
-    delete [] this->dataPtr->gpuRaysBuffer;
-    this->dataPtr->gpuRaysBuffer = nullptr;
-  }
-
   if (this->dataPtr->gpuRaysScan)
   {
     delete [] this->dataPtr->gpuRaysScan;
@@ -425,6 +456,12 @@ void Ogre2GpuRays::Destroy()
       this->dataPtr->ogreCompositorWorkspace1st[i] = nullptr;
     }
   }
+  this->dataPtr->cubeFaceIdx.clear();
+  ++this->dataPtr->cubemapVersion;
+  this->dataPtr->sharingCubemap = false;
+  this->dataPtr->sharedCubemapSource.reset();
+  this->dataPtr->cubemapFrame = std::numeric_limits<uint64_t>::max();
+
   if (this->dataPtr->matFirstPass)
   {
     Ogre::MaterialManager::getSingleton().remove(
@@ -606,6 +643,163 @@ math::Vector2d Ogre2GpuRays::SampleCubemap(const math::Vector3d &_v,
   return uv * ma + 0.5;
 }
 
+/////////////////////////////////////////////////////////
+/// \brief Project a direction onto a face of a Y up cubemap
+/// \param[in] _v Direction to project
+/// \param[in] _faceIndex Index of the cubemap face, see SampleCubemap
+/// \param[out] _uv Texture coordinates of the direction on the face
+/// \return False if the direction points away from the face
+static bool projectToCubemapFace(const math::Vector3d &_v,
+    unsigned int _faceIndex, math::Vector2d &_uv)
+{
+  double ma = 0.0;
+  switch (_faceIndex)
+  {
+    case 0:
+      ma = _v.X();
+      _uv.Set(-_v.Z(), -_v.Y());
+      break;
+    case 1:
+      ma = -_v.X();
+      _uv.Set(_v.Z(), -_v.Y());
+      break;
+    case 2:
+      ma = _v.Y();
+      _uv.Set(_v.X(), _v.Z());
+      break;
+    case 3:
+      ma = -_v.Y();
+      _uv.Set(_v.X(), -_v.Z());
+      break;
+    case 4:
+      ma = _v.Z();
+      _uv.Set(_v.X(), -_v.Y());
+      break;
+    default:
+      ma = -_v.Z();
+      _uv.Set(-_v.X(), -_v.Y());
+      break;
+  }
+  if (ma <= 0.0)
+    return false;
+
+  _uv = _uv * (0.5 / ma) + 0.5;
+  return true;
+}
+
+/////////////////////////////////////////////////////////
+/// \brief Sample rays that lie on the edge between two cubemap faces from
+/// the face that holds more rays, so that faces holding only a few edge
+/// rays, e.g. due to rounding errors, do not need to be rendered.
+/// \param[in] _dirs Direction of each ray
+/// \param[in, out] _faces Cubemap face index of each ray
+static void assignCubemapEdgeRays(const std::vector<math::Vector3d> &_dirs,
+    std::vector<unsigned int> &_faces)
+{
+  // rays that are this close to a face, in texture coordinates, are
+  // sampled from the edge of that face
+  const double kEdgeTolerance = 1e-4;
+
+  std::array<unsigned int, 6> counts;
+  counts.fill(0u);
+  for (auto face : _faces)
+    counts[face]++;
+
+  for (size_t i = 0u; i < _dirs.size(); ++i)
+  {
+    unsigned int best = _faces[i];
+    for (unsigned int face = 0u; face < 6u; ++face)
+    {
+      math::Vector2d uv;
+      if (counts[face] <= counts[best] ||
+          !projectToCubemapFace(_dirs[i], face, uv))
+        continue;
+
+      if (uv.X() >= -kEdgeTolerance && uv.X() <= 1.0 + kEdgeTolerance &&
+          uv.Y() >= -kEdgeTolerance && uv.Y() <= 1.0 + kEdgeTolerance)
+        best = face;
+    }
+    _faces[i] = best;
+  }
+}
+
+/////////////////////////////////////////////////////////
+/// \brief Compute the resolution of each cubemap face so that neighboring
+/// rays sampled from the face are about one texel apart.
+/// \param[in] _uvs Texture coordinates of each ray, row major
+/// \param[in] _faces Cubemap face index of each ray
+/// \param[in] _width Number of rays per row
+/// \param[out] _faceWidth Texture width of each face
+/// \param[out] _faceHeight Texture height of each face
+static void computeCubemapFaceSizes(const std::vector<math::Vector2d> &_uvs,
+    const std::vector<unsigned int> &_faces, unsigned int _width,
+    unsigned int *_faceWidth, unsigned int *_faceHeight)
+{
+  // Faces holding few rays still need a few texels per ray for the range
+  // values to be accurate
+  const unsigned int kMinSize = 32u;
+  const unsigned int kMaxSize = 1024u;
+
+  // smallest spacing between neighboring rays on each face, along u and v
+  std::array<double, 6> minDu;
+  std::array<double, 6> minDv;
+  minDu.fill(std::numeric_limits<double>::infinity());
+  minDv.fill(std::numeric_limits<double>::infinity());
+
+  auto addSpacing = [&](size_t _a, size_t _b)
+  {
+    unsigned int face = _faces[_a];
+    if (face != _faces[_b])
+      return;
+
+    // each pair of rays only constrains the axis they are separated along
+    double du = std::abs(_uvs[_a].X() - _uvs[_b].X());
+    double dv = std::abs(_uvs[_a].Y() - _uvs[_b].Y());
+    if (du >= dv && du > 0.0)
+      minDu[face] = std::min(minDu[face], du);
+    else if (dv > du)
+      minDv[face] = std::min(minDv[face], dv);
+  };
+
+  for (size_t i = 0u; i < _uvs.size(); ++i)
+  {
+    if ((i + 1u) % _width != 0u)
+      addSpacing(i, i + 1u);
+    if (i + _width < _uvs.size())
+      addSpacing(i, i + _width);
+  }
+
+  auto size = [&](double _spacing)
+  {
+    if (std::isinf(_spacing))
+      return kMinSize;
+    double texels = std::ceil(1.0 / _spacing);
+    return static_cast<unsigned int>(std::clamp(texels,
+        static_cast<double>(kMinSize), static_cast<double>(kMaxSize)));
+  };
+
+  for (unsigned int face = 0u; face < 6u; ++face)
+  {
+    _faceWidth[face] = size(minDu[face]);
+    _faceHeight[face] = size(minDv[face]);
+  }
+}
+
+/////////////////////////////////////////////////////////
+/// \brief Rotate a direction given in the frame of a Y up cubemap
+/// \param[in] _rot Rotation in the frame of the sensor, i.e. X forward and
+/// Z up
+/// \param[in] _v Direction in the frame of the cubemap
+/// \return Rotated direction in the frame of the cubemap
+static math::Vector3d rotateCubemapDirection(const math::Quaterniond &_rot,
+    const math::Vector3d &_v)
+{
+  // the cubemap looks along the sensor's X axis, with Y up and X to the
+  // right of the sensor
+  math::Vector3d v = _rot * math::Vector3d(_v.Z(), -_v.X(), _v.Y());
+  return math::Vector3d(-v.Y(), v.Z(), v.X());
+}
+
 /////////////////////////////////////////////////////////
 void Ogre2GpuRays::CreateSampleTexture()
 {
@@ -666,8 +860,15 @@ void Ogre2GpuRays::CreateSampleTexture()
   float *pDest = reinterpret_cast<float*>(
     OGRE_MALLOC_SIMD(dataSize, Ogre::MEMCATEGORY_RESOURCE));
 
+  // compute the direction of each ray and the cubemap face it is sampled
+  // from
+  size_t rayCount = static_cast<size_t>(this->dataPtr->w2nd) *
+      this->dataPtr->h2nd;
+  std::vector<math::Vector3d> dirs(rayCount);
+  std::vector<unsigned int> faces(rayCount);
+  std::vector<math::Vector2d> uvs(rayCount);
   double v = vmin;
-  int index = 0;
+  size_t rayIdx = 0u;
   for (unsigned int i = 0; i < this->dataPtr->h2nd; ++i)
   {
     double h = min;
@@ -678,24 +879,54 @@ void Ogre2GpuRays::CreateSampleTexture()
       ray.Normalize();
       math::Quaterniond pitch(math::Vector3d(1, 0, 0), -v);
       math::Quaterniond yaw(math::Vector3d(0, 1, 0), -h);
-      math::Vector3d dir = yaw * pitch * ray;
-      unsigned int faceIdx;
-      math::Vector2d uv = this->SampleCubemap(dir, faceIdx);
-      this->dataPtr->cubeFaceIdx.insert(faceIdx);
-      // igndbg << "p(" << pitch << ") y(" << yaw << "): " << dir << " | "
-      //       << uv << " | " << faceIdx << std::endl;
-      // u
-      pDest[index++] = uv.X();
-      // v
-      pDest[index++] = uv.Y();
-      // face
-      pDest[index++] = faceIdx;
-      // unused
-      pDest[index++] = 1.0;
+      dirs[rayIdx] = yaw * pitch * ray;
+      // sample the cubemap of the source in its own frame
+      if (this->dataPtr->sharingCubemap)
+      {
+        dirs[rayIdx] = rotateCubemapDirection(this->dataPtr->cubemapRotation,
+            dirs[rayIdx]);
+      }
+      uvs[rayIdx] = this->SampleCubemap(dirs[rayIdx], faces[rayIdx]);
+      ++rayIdx;
       h += hStep;
     }
     v += vStep;
   }
+
+  if (this->adaptiveCubemapResolution)
+  {
+    assignCubemapEdgeRays(dirs, faces);
+    for (size_t i = 0u; i < rayCount; ++i)
+    {
+      projectToCubemapFace(dirs[i], faces[i], uvs[i]);
+      uvs[i].X(std::clamp(uvs[i].X(), 0.0, 1.0));
+      uvs[i].Y(std::clamp(uvs[i].Y(), 0.0, 1.0));
+    }
+    computeCubemapFaceSizes(uvs, faces, this->dataPtr->w2nd,
+        this->dataPtr->w1stFace, this->dataPtr->h1stFace);
+  }
+  else
+  {
+    for (unsigned int i = 0u; i < 6u; ++i)
+    {
+      this->dataPtr->w1stFace[i] = this->dataPtr->w1st;
+      this->dataPtr->h1stFace[i] = this->dataPtr->h1st;
+    }
+  }
+
+  int index = 0;
+  for (size_t i = 0u; i < rayCount; ++i)
+  {
+    this->dataPtr->cubeFaceIdx.insert(faces[i]);
+    // u
+    pDest[index++] = uvs[i].X();
+    // v
+    pDest[index++] = uvs[i].Y();
+    // face
+    pDest[index++] = faces[i];
+    // unused
+    pDest[index++] = 1.0;
+  }
   this->dataPtr->cubeUVTexture->_transitionTo(
     Ogre::GpuResidency::Resident,
     reinterpret_cast<Ogre::uint8*>(pDest) );
@@ -982,89 +1213,96 @@ void Ogre2GpuRays::Setup1stPass()
   }
 
   // create cubemap cameras and render to texture using 1st pass compositor
-  Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
   for (auto i : this->dataPtr->cubeFaceIdx)
+    this->CreateCubemapFace(i);
+}
+
+/////////////////////////////////////////////////////////
+void Ogre2GpuRays::CreateCubemapFace(unsigned int _faceIndex)
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+  Ogre::CompositorManager2 *ogreCompMgr = ogreRoot->getCompositorManager2();
+  Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
+
+  Ogre::Camera *cam = ogreSceneManager->createCamera(
+      this->Name() + "_env" + std::to_string(_faceIndex));
+  this->dataPtr->cubeCam[_faceIndex] = cam;
+  cam->detachFromParent();
+  this->ogreNode->attachObject(cam);
+  cam->setFOVy(Ogre::Degree(90));
+  cam->setAspectRatio(1);
+  cam->setNearClipDistance(this->dataPtr->nearClipCube);
+  cam->setFarClipDistance(this->FarClipPlane());
+  cam->setFixedYawAxis(false);
+  cam->yaw(Ogre::Degree(-90));
+  cam->roll(Ogre::Degree(-90));
+
+  // orient camera to create cubemap
+  if (_faceIndex == 0)
+    cam->yaw(Ogre::Degree(-90));
+  else if (_faceIndex == 1)
+    cam->yaw(Ogre::Degree(90));
+  else if (_faceIndex == 2)
+    cam->pitch(Ogre::Degree(90));
+  else if (_faceIndex == 3)
+    cam->pitch(Ogre::Degree(-90));
+  else if (_faceIndex == 5)
+    cam->yaw(Ogre::Degree(180));
+
+  // create render texture - these textures pack the range data
+  // that will be used in the 2nd pass
+  Ogre::TextureGpuManager *textureMgr =
+    ogreRoot->getRenderSystem()->getTextureGpuManager();
+  std::stringstream texName;
+  texName << this->Name() << "_first_pass_" << _faceIndex;
+  Ogre::TextureGpu *texture =
+    textureMgr->createOrRetrieveTexture(
+      texName.str(),
+      Ogre::GpuPageOutStrategy::SaveToSystemRam,
+      Ogre::TextureFlags::RenderToTexture,
+      Ogre::TextureTypes::Type2D);
+  this->dataPtr->firstPassTextures[_faceIndex] = texture;
+
+  texture->setResolution(
+    this->dataPtr->w1stFace[_faceIndex], this->dataPtr->h1stFace[_faceIndex]);
+  texture->setNumMipmaps(1u);
+  texture->setPixelFormat(Ogre::PFG_RG32_FLOAT);
+
+  texture->scheduleTransitionTo(Ogre::GpuResidency::Resident);
+
+  // create compositor workspace
+  Ogre::CompositorWorkspace *workspace =
+      ogreCompMgr->addWorkspace(
+        this->scene->OgreSceneManager(),
+        texture,
+        cam,
+        this->dataPtr->ogreCompositorWorkspaceDef1st,
+        false);
+  this->dataPtr->ogreCompositorWorkspace1st[_faceIndex] = workspace;
+
+  Ogre::CompositorNode *node = workspace->getNodeSequence()[0];
+  auto channelsTex = node->getLocalTextures();
+
+  for (auto c : channelsTex)
   {
-    this->dataPtr->cubeCam[i] = ogreSceneManager->createCamera(
-        this->Name() + "_env" + std::to_string(i));
-    this->dataPtr->cubeCam[i]->detachFromParent();
-    this->ogreNode->attachObject(this->dataPtr->cubeCam[i]);
-    this->dataPtr->cubeCam[i]->setFOVy(Ogre::Degree(90));
-    this->dataPtr->cubeCam[i]->setAspectRatio(1);
-    this->dataPtr->cubeCam[i]->setNearClipDistance(this->dataPtr->nearClipCube);
-    this->dataPtr->cubeCam[i]->setFarClipDistance(this->FarClipPlane());
-    this->dataPtr->cubeCam[i]->setFixedYawAxis(false);
-    this->dataPtr->cubeCam[i]->yaw(Ogre::Degree(-90));
-    this->dataPtr->cubeCam[i]->roll(Ogre::Degree(-90));
-
-    // orient camera to create cubemap
-    if (i == 0)
-      this->dataPtr->cubeCam[i]->yaw(Ogre::Degree(-90));
-    else if (i == 1)
-      this->dataPtr->cubeCam[i]->yaw(Ogre::Degree(90));
-    else if (i == 2)
-      this->dataPtr->cubeCam[i]->pitch(Ogre::Degree(90));
-    else if (i == 3)
-      this->dataPtr->cubeCam[i]->pitch(Ogre::Degree(-90));
-    else if (i == 5)
-      this->dataPtr->cubeCam[i]->yaw(Ogre::Degree(180));
-
-    // create render texture - these textures pack the range data
-    // that will be used in the 2nd pass
-    Ogre::TextureGpuManager *textureMgr =
-      ogreRoot->getRenderSystem()->getTextureGpuManager();
-    std::stringstream texName;
-    texName << this->Name() << "_first_pass_" << i;
-    this->dataPtr->firstPassTextures[i] =
-      textureMgr->createOrRetrieveTexture(
-        texName.str(),
-        Ogre::GpuPageOutStrategy::SaveToSystemRam,
-        Ogre::TextureFlags::RenderToTexture,
-        Ogre::TextureTypes::Type2D);
-
-    this->dataPtr->firstPassTextures[i]->setResolution(
-      this->dataPtr->w1st, this->dataPtr->h1st);
-    this->dataPtr->firstPassTextures[i]->setNumMipmaps(1u);
-    this->dataPtr->firstPassTextures[i]->setPixelFormat(
-      Ogre::PFG_RG32_FLOAT);
-
-    this->dataPtr->firstPassTextures[i]->scheduleTransitionTo(
-      Ogre::GpuResidency::Resident);
-
-    // create compositor workspace
-    this->dataPtr->ogreCompositorWorkspace1st[i] =
-        ogreCompMgr->addWorkspace(
-          this->scene->OgreSceneManager(),
-          this->dataPtr->firstPassTextures[i],
-          this->dataPtr->cubeCam[i],
-          wsDefName,
-          false);
-
-    Ogre::CompositorNode *node =
-        this->dataPtr->ogreCompositorWorkspace1st[i]->getNodeSequence()[0];
-    auto channelsTex = node->getLocalTextures();
-
-    for (auto c : channelsTex)
+    if (c->getPixelFormat() == Ogre::PFG_R16_UNORM)
     {
-      if (c->getPixelFormat() == Ogre::PFG_R16_UNORM)
-      {
-        // add laser retro material switcher to render target listener
-        // so we can switch to use laser retro material when the camera is being
-        // updated
-        this->dataPtr->laserRetroMaterialSwitcher[i].reset(
-            new Ogre2LaserRetroMaterialSwitcher(this->scene));
-        this->dataPtr->cubeCam[i]->addListener(
-            this->dataPtr->laserRetroMaterialSwitcher[i].get());
-
-        // add particle noise / scatter effects listener so we can set the
-        // amount of noise based on size of emitter
-        this->dataPtr->particleNoiseListener[i].reset(
-            new Ogre2ParticleNoiseListener(this->scene,
-            this->dataPtr->matFirstPass));
-        this->dataPtr->cubeCam[i]->addListener(
-          this->dataPtr->particleNoiseListener[i].get());
-        break;
-      }
+      // add laser retro material switcher to render target listener
+      // so we can switch to use laser retro material when the camera is being
+      // updated
+      this->dataPtr->laserRetroMaterialSwitcher[_faceIndex].reset(
+          new Ogre2LaserRetroMaterialSwitcher(this->scene));
+      cam->addListener(
+          this->dataPtr->laserRetroMaterialSwitcher[_faceIndex].get());
+
+      // add particle noise / scatter effects listener so we can set the
+      // amount of noise based on size of emitter
+      this->dataPtr->particleNoiseListener[_faceIndex].reset(
+          new Ogre2ParticleNoiseListener(this->scene,
+          this->dataPtr->matFirstPass));
+      cam->addListener(this->dataPtr->particleNoiseListener[_faceIndex].get());
+      break;
     }
   }
 }
@@ -1113,6 +1351,7 @@ void Ogre2GpuRays::Setup2ndPass()
 
   // connect all cubemap textures to the corresponding texture unit states
   // defined in the GpuRaysScan2nd material
+  Ogre2GpuRays *cubemapOwner = this->CubemapOwner();
   Ogre::TextureUnitState *texUnit = nullptr;
   for (auto i : this->dataPtr->cubeFaceIdx)
   {
@@ -1120,7 +1359,7 @@ void Ogre2GpuRays::Setup2ndPass()
     // gpu_rays.material script
     unsigned int texIndex = 1 + i;
     texUnit = pass->getTextureUnitState(texIndex);
-    texUnit->setTexture(this->dataPtr->firstPassTextures[i]);
+    texUnit->setTexture(cubemapOwner->dataPtr->firstPassTextures[i]);
   }
 
   // create 2nd pass compositor
@@ -1210,14 +1449,124 @@ void Ogre2GpuRays::CreateGpuRaysTextures()
   this->dataPtr->nearClipCube = boxSize * 0.5;
 
   this->ConfigureCamera();
+  this->dataPtr->sharingCubemap = this->SetupCubemapSource();
   this->CreateSampleTexture();
-  this->Setup1stPass();
+
+  if (this->dataPtr->sharingCubemap)
+  {
+    // make sure the source renders all the faces sampled by this sensor.
+    // The source has no rays on the faces it did not create, so they are
+    // rendered at its overall resolution.
+    auto source = this->dataPtr->sharedCubemapSource.lock();
+    for (auto i : this->dataPtr->cubeFaceIdx)
+    {
+      if (source->dataPtr->cubeFaceIdx.count(i) > 0u)
+        continue;
+      source->dataPtr->w1stFace[i] = source->dataPtr->w1st;
+      source->dataPtr->h1stFace[i] = source->dataPtr->h1st;
+      source->CreateCubemapFace(i);
+      source->dataPtr->cubeFaceIdx.insert(i);
+    }
+    this->dataPtr->sharedCubemapVersion = source->dataPtr->cubemapVersion;
+  }
+  else
+  {
+    this->Setup1stPass();
+  }
   this->Setup2ndPass();
 }
 
 /////////////////////////////////////////////////
-void Ogre2GpuRays::UpdateRenderTarget1stPass()
+bool Ogre2GpuRays::SetupCubemapSource()
+{
+  this->dataPtr->sharedCubemapSource.reset();
+  this->dataPtr->cubemapRotation = math::Quaterniond::Identity;
+
+  GpuRaysPtr sourceBase = this->CubemapSource();
+  if (!sourceBase)
+    return false;
+
+  std::shared_ptr<Ogre2GpuRays> source =
+      std::dynamic_pointer_cast<Ogre2GpuRays>(sourceBase);
+  if (!source || source.get() == this || source->scene != this->scene)
+  {
+    ignerr << "Unable to sample the cubemap of [" << sourceBase->Name()
+           << "] from GpuRays [" << this->Name() << "]. The source must be "
+           << "another GpuRays sensor in the same scene." << std::endl;
+    return false;
+  }
+
+  if (source->CubemapSource())
+  {
+    ignerr << "Unable to sample the cubemap of [" << source->Name()
+           << "] from GpuRays [" << this->Name() << "]. The source samples "
+           << "the cubemap of another sensor." << std::endl;
+    return false;
+  }
+
+  // ranges are clipped and clamped when the cubemap is rendered
+  if (!math::equal(source->NearClipPlane(), this->NearClipPlane()) ||
+      !math::equal(source->FarClipPlane(), this->FarClipPlane()) ||
+      source->dataMinVal != this->dataMinVal ||
+      source->dataMaxVal != this->dataMaxVal)
+  {
+    ignerr << "Unable to sample the cubemap of [" << source->Name()
+           << "] from GpuRays [" << this->Name() << "]. Both sensors must "
+           << "have the same clip planes and clamping." << std::endl;
+    return false;
+  }
+
+  const double kPositionTolerance = 1e-3;
+  if (source->WorldPosition().Distance(this->WorldPosition()) >
+      kPositionTolerance)
+  {
+    ignerr << "Unable to sample the cubemap of [" << source->Name()
+           << "] from GpuRays [" << this->Name() << "]. Both sensors must "
+           << "be at the same position." << std::endl;
+    return false;
+  }
+
+  if (!source->dataPtr->cubeUVTexture)
+    source->CreateGpuRaysTextures();
+
+  if (source->dataPtr->w1st < this->dataPtr->w1st)
+  {
+    ignwarn << "The cubemap of [" << source->Name() << "] has a lower "
+            << "resolution than needed by GpuRays [" << this->Name()
+            << "]. Ranges may be less accurate." << std::endl;
+  }
+
+  this->dataPtr->cubemapRotation =
+      source->WorldRotation().Inverse() * this->WorldRotation();
+  this->dataPtr->sharedCubemapSource = source;
+  return true;
+}
+
+/////////////////////////////////////////////////
+Ogre2GpuRays *Ogre2GpuRays::CubemapOwner()
+{
+  if (!this->dataPtr->sharingCubemap)
+    return this;
+
+  // the textures bound to the 2nd pass material are gone if the source
+  // destroyed its cubemap
+  auto source = this->dataPtr->sharedCubemapSource.lock();
+  if (!source || !source->dataPtr->cubeUVTexture ||
+      source->dataPtr->cubemapVersion != this->dataPtr->sharedCubemapVersion)
+    return nullptr;
+
+  return source.get();
+}
+
+/////////////////////////////////////////////////
+bool Ogre2GpuRays::UpdateRenderTarget1stPass()
 {
+  // sensors sharing this cubemap sample it during the same frame
+  uint64_t frame = this->scene->FrameCount();
+  if (this->dataPtr->cubemapFrame == frame)
+    return false;
+  this->dataPtr->cubemapFrame = frame;
+
   Ogre::vector<Ogre::TextureGpu *>::type swappedTargets;
   swappedTargets.reserve(2u);
 
@@ -1238,6 +1587,7 @@ void Ogre2GpuRays::UpdateRenderTarget1stPass()
 
     this->dataPtr->ogreCompositorWorkspace1st[i]->setEnabled(false);
   }
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -1256,6 +1606,11 @@ void Ogre2GpuRays::UpdateRenderTarget2ndPass()
 //////////////////////////////////////////////////
 void Ogre2GpuRays::Render()
 {
+  // the cubemap source was destroyed since PreRender
+  Ogre2GpuRays *cubemapOwner = this->CubemapOwner();
+  if (!cubemapOwner)
+    return;
+
   this->scene->StartRendering(nullptr);
 
   auto engine = Ogre2RenderEngine::Instance();
@@ -1279,7 +1634,7 @@ void Ogre2GpuRays::Render()
 
   hlmsCustomizations.minDistanceClip =
       static_cast<float>(this->NearClipPlane());
-  this->UpdateRenderTarget1stPass();
+  bool rendered1stPass = cubemapOwner->UpdateRenderTarget1stPass();
   this->UpdateRenderTarget2ndPass();
   hlmsCustomizations.minDistanceClip = -1;
 
@@ -1290,12 +1645,22 @@ void Ogre2GpuRays::Render()
   hlmsPbs->setListener(engine->HlmsPbsTerraShadows());
 #endif
 
-  this->scene->FlushGpuCommandsAndStartNewFrame(6u, false);
+  this->scene->FlushGpuCommandsAndStartNewFrame(rendered1stPass ? 6u : 1u,
+      false);
 }
 
 //////////////////////////////////////////////////
 void Ogre2GpuRays::PreRender()
 {
+  if (this->dataPtr->cubeUVTexture && !this->CubemapOwner())
+  {
+    ignwarn << "The cubemap sampled by GpuRays [" << this->Name()
+            << "] was destroyed. Rendering a cubemap of its own."
+            << std::endl;
+    this->SetCubemapSource(nullptr);
+    this->Destroy();
+  }
+
   if (!this->dataPtr->cubeUVTexture)
     this->CreateGpuRaysTextures();
 }
@@ -1306,32 +1671,12 @@ void Ogre2GpuRays::PostRender()
   unsigned int width = this->dataPtr->w2nd;
   unsigned int height = this->dataPtr->h2nd;
 
-  PixelFormat format = PF_FLOAT32_RGBA;
-  unsigned int rawChannelCount = PixelUtil::ChannelCount(format);
-  unsigned int bytesPerChannel = PixelUtil::BytesPerChannel(format);
-  int rawLen = width * height * rawChannelCount;
-
-  if (!this->dataPtr->gpuRaysBuffer)
-  {
-    this->dataPtr->gpuRaysBuffer = new float[rawLen];
-  }
-
   // blit data from gpu to cpu
   Ogre::Image2 image;
   image.convertFromTexture(this->dataPtr->secondPassTexture, 0u, 0u);
   Ogre::TextureBox box = image.getData(0u);
   float *bufferTmp = static_cast<float *>(box.data);
 
-  // copy data row by row. The texture box may not be a contiguous region of
-  // a texture
-  for (unsigned int i = 0; i < height; ++i)
-  {
-    unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-    unsigned int rowIdx = i * width * rawChannelCount;
-    memcpy(&this->dataPtr->gpuRaysBuffer[rowIdx], &bufferTmp[rawDataRowIdx],
-        width * rawChannelCount * bytesPerChannel);
-  }
-
   // Metal does not support RGB32_FLOAT so the internal texture format is
   // RGBA32_FLOAT. For backward compatibility, output data is kept in RGB
   // format instead of RGBA
@@ -1341,26 +1686,11 @@ void Ogre2GpuRays::PostRender()
     this->dataPtr->gpuRaysScan = new float[outputLen];
   }
 
-  // copy data from RGBA buffer to RGB buffer
-  for (unsigned int row = 0; row < height; ++row)
-  {
-    // the texture box step size could be larger than our image buffer step
-    // size
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * this->Channels()) +
-          column * this->Channels();
-      unsigned int rawIdx = (row * width * rawChannelCount) +
-          column * rawChannelCount;
-
-      this->dataPtr->gpuRaysScan[idx] =
-          this->dataPtr->gpuRaysBuffer[rawIdx];
-      this->dataPtr->gpuRaysScan[idx + 1] =
-          this->dataPtr->gpuRaysBuffer[rawIdx + 1];
-      this->dataPtr->gpuRaysScan[idx + 2] =
-          this->dataPtr->gpuRaysBuffer[rawIdx + 2];
-    }
-  }
+  // copy data from the RGBA texture box to the RGB buffer. The texture box
+  // may not be a contiguous region of a texture so padding at the end of
+  // each row is skipped
+  copyRgbaToRgb(bufferTmp, box.bytesPerRow, this->dataPtr->gpuRaysScan,
+      width, height);
 
   this->dataPtr->newGpuRaysFrame(this->dataPtr->gpuRaysScan,
       width, height, this->Channels(), "PF_FLOAT32_RGB");
@@ -15,7 +15,12 @@
  *
 */
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
@@ -67,6 +72,52 @@ class ignition::rendering::Ogre2HeightmapPrivate
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+/// \brief Get the number of chunks the rows of a heightmap are split into
+/// to be processed in parallel
+/// \param[in] _rows Number of rows
+/// \param[in] _rowSize Number of values in each row
+/// \return Number of chunks, 1 if the heightmap is too small to be worth
+/// processing in parallel
+static unsigned int rowChunkCount(unsigned int _rows, unsigned int _rowSize)
+{
+  unsigned int threadCount =
+      std::min(std::thread::hardware_concurrency(), _rows);
+  if (threadCount <= 1u || static_cast<size_t>(_rows) * _rowSize < 65536u)
+    return 1u;
+  return threadCount;
+}
+
+//////////////////////////////////////////////////
+/// \brief Split rows into contiguous chunks and process each chunk on its
+/// own thread. A single chunk is processed on the calling thread.
+/// \param[in] _rows Number of rows
+/// \param[in] _chunkCount Number of chunks
+/// \param[in] _func Function called with the chunk index, the first row of
+/// the chunk and one past its last row
+static void forEachRowChunk(unsigned int _rows, unsigned int _chunkCount,
+    const std::function<void(unsigned int, unsigned int, unsigned int)>
+    &_func)
+{
+  if (_chunkCount <= 1u)
+  {
+    _func(0u, 0u, _rows);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int c = 0u; c < _chunkCount; ++c)
+  {
+    unsigned int begin = static_cast<unsigned int>(
+        static_cast<size_t>(_rows) * c / _chunkCount);
+    unsigned int end = static_cast<unsigned int>(
+        static_cast<size_t>(_rows) * (c + 1u) / _chunkCount);
+    threads.emplace_back(_func, c, begin, end);
+  }
+  for (auto &thread : threads)
+    thread.join();
+}
+
 //////////////////////////////////////////////////
 Ogre2Heightmap::Ogre2Heightmap(const HeightmapDescriptor &_desc)
     : BaseHeightmap(_desc), dataPtr(std::make_unique<Ogre2HeightmapPrivate>())
@@ -148,7 +199,7 @@ void Ogre2Heightmap::Init()
   std::vector<float> lookup;
   this->descriptor.Data()->FillHeightMap(this->descriptor.Sampling(),
       srcWidth, this->descriptor.Size(), scale, flipY, lookup);
-  this->dataPtr->heights.reserve(newWidth * newWidth);
+  this->dataPtr->heights.resize(static_cast<size_t>(newWidth) * newWidth);
 
   // Terra is optimized to work with UNORM heightmaps, therefore it assumes
   // lowest height is 0.
@@ -158,36 +209,62 @@ void Ogre2Heightmap::Init()
   // Obtain min and max elevation and bring everything to range [0; 1]
   // Terra should support non-normalized ranges but there are a couple
   // bugs preventing that, so it's just easier to normalize the data
-  float minElevation = 0.0;
-  float maxElevation = 0.0;
-
-  for (unsigned int y = 0; y < newWidth; ++y)
+  //
+  // Large heightmaps are split into chunks of rows that are copied and
+  // reduced in parallel, then normalized in parallel
+  float *heights = this->dataPtr->heights.data();
+  const unsigned int chunkCount = rowChunkCount(newWidth, newWidth);
+  std::vector<float> chunkMin(chunkCount, 0.0f);
+  std::vector<float> chunkMax(chunkCount, 0.0f);
+  forEachRowChunk(newWidth, chunkCount,
+      [&](unsigned int _chunk, unsigned int _begin, unsigned int _end)
   {
-    for (unsigned int x = 0; x < newWidth; ++x)
+    float minVal = 0.0f;
+    float maxVal = 0.0f;
+    for (unsigned int y = _begin; y < _end; ++y)
     {
-      const size_t index = y * srcWidth + x;
-      float heightVal = lookup[index];
-
-      // Sanity check in case we get NaNs from ign-common, this prevents a crash
-      // in Ogre
-      if (!std::isfinite(heightVal))
-        heightVal = minElevation;
-
-      minElevation = std::min(minElevation, heightVal);
-      maxElevation = std::max(maxElevation, heightVal);
-      this->dataPtr->heights.push_back(heightVal);
+      const float *src = lookup.data() + static_cast<size_t>(y) * srcWidth;
+      float *dst = heights + static_cast<size_t>(y) * newWidth;
+      for (unsigned int x = 0; x < newWidth; ++x)
+      {
+        const float heightVal = src[x];
+        dst[x] = heightVal;
+        if (std::isfinite(heightVal))
+        {
+          minVal = std::min(minVal, heightVal);
+          maxVal = std::max(maxVal, heightVal);
+        }
+      }
     }
-  }
+    chunkMin[_chunk] = minVal;
+    chunkMax[_chunk] = maxVal;
+  });
+
+  const float minElevation =
+      *std::min_element(chunkMin.begin(), chunkMin.end());
+  const float maxElevation =
+      *std::max_element(chunkMax.begin(), chunkMax.end());
 
   // min and max elevations collected. Now normalize
   const float heightDiff = maxElevation - minElevation;
   const float invHeightDiff =
       fabsf( heightDiff ) < 1e-6f ? 1.0f : (1.0f / heightDiff);
-  for (float &heightVal : this->dataPtr->heights)
+  forEachRowChunk(newWidth, chunkCount,
+      [&](unsigned int, unsigned int _begin, unsigned int _end)
   {
-    heightVal = (heightVal - minElevation) * invHeightDiff;
-    assert( heightVal >= 0 );
-  }
+    float *it = heights + static_cast<size_t>(_begin) * newWidth;
+    float *end = heights + static_cast<size_t>(_end) * newWidth;
+    for (; it != end; ++it)
+    {
+      // Sanity check in case we get NaNs from ign-common, this prevents a
+      // crash in Ogre. They end up at the min elevation
+      if (!std::isfinite(*it))
+        *it = 0.0f;
+      else
+        *it = (*it - minElevation) * invHeightDiff;
+      assert(*it >= 0);
+    }
+  });
 
   this->dataPtr->dataSize = newWidth;
 
@@ -234,6 +311,10 @@ void Ogre2Heightmap::Init()
   // Does not cast shadows because it uses a raymarching implementation
   // instead of shadow maps. It does receive shadows from shadow maps though
   this->dataPtr->terra->setCastShadows(false);
+  // Large heightmaps can be uploaded a few rows per frame, see PreRender.
+  // The heights are kept alive by dataPtr until the upload is done
+  this->dataPtr->terra->setHeightMapUploadRows(
+      Ogre2RenderEngine::Instance()->HeightmapUploadRows());
   this->dataPtr->terra->load(
         image,
         Ogre2Conversions::Convert(center),
@@ -383,6 +464,9 @@ void Ogre2Heightmap::Init()
 //////////////////////////////////////////////////
 void Ogre2Heightmap::PreRender()
 {
+  // Upload the next rows of a heightmap that is streamed to the GPU
+  if (this->dataPtr->terra)
+    this->dataPtr->terra->streamHeightMap();
 }
 
 ///////////////////////////////////////////////////
@@ -61,9 +61,23 @@ class ignition::rendering::Ogre2LidarVisualPrivate
   /// \brief Lidar Ray DynamicLines Object to display
   public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> rayLines;
 
-  /// \brief Lidar Points DynamicLines Object to display
+  /// \brief Lidar Points DynamicLines Object to display. All the points
+  /// of a scan are in a single renderable.
   public: std::vector<std::shared_ptr<Ogre2DynamicRenderable>> points;
 
+  /// \brief Direction of each ray, rotated by the offset, x y z per ray.
+  /// Used when LidarVisualType = LVT_POINTS.
+  public: std::vector<float> rayDirections;
+
+  /// \brief Ray parameters the ray directions were computed with: min and
+  /// step of the horizontal and vertical angles, followed by the offset
+  /// rotation
+  public: std::vector<double> rayDirectionsKey;
+
+  /// \brief Positions of the points of a scan, x y z per point.
+  /// Used when LidarVisualType = LVT_POINTS.
+  public: std::vector<float> pointPositions;
+
   /// \brief Lidar visual type
   public: LidarVisualType lidarVisType =
             LidarVisualType::LVT_TRIANGLE_STRIPS;
@@ -219,8 +233,11 @@ void Ogre2LidarVisual::Update()
 
   bool clearVisuals = false;
 
+  // points that are not displayed are left out of the point cloud, so there
+  // is no need to recreate it
   if (this->lidarVisualType != this->dataPtr->lidarVisType
-        || !this->displayNonHitting)
+        || (!this->displayNonHitting &&
+        this->lidarVisualType != LidarVisualType::LVT_POINTS))
   {
     clearVisuals = true;
   }
@@ -265,11 +282,15 @@ void Ogre2LidarVisual::Update()
     return;
   }
 
+  if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS)
+    this->UpdatePointCloud();
+
   // Process each point from received data
   // Every line segment, and every triangle is saved separately,
   // as a pointer to a DynamicLine
   // This initializes and updates only the selected DynamicLine variables
-  for (unsigned int j = 0; j < this->verticalCount; ++j)
+  for (unsigned int j = 0; j < this->verticalCount &&
+      this->dataPtr->lidarVisType != LidarVisualType::LVT_POINTS; ++j)
   {
     horizontalAngle = this->minHorizontalAngle;
 
@@ -283,6 +304,7 @@ void Ogre2LidarVisual::Update()
                                     new Ogre2DynamicRenderable(this->Scene()));
 
         renderable->SetOperationType(MT_LINE_LIST);
+        renderable->SetStreaming(true);
         MaterialPtr mat = this->Scene()->Material("Lidar/BlueRay");
         renderable->SetMaterial(mat, false);
 
@@ -329,26 +351,6 @@ void Ogre2LidarVisual::Update()
       }
     }
 
-    else if (this->dataPtr->lidarVisType ==
-                  LidarVisualType::LVT_POINTS)
-    {
-      if (j+1 > this->dataPtr->points.size())
-      {
-        std::shared_ptr<Ogre2DynamicRenderable> renderable =
-                        std::shared_ptr<Ogre2DynamicRenderable>(
-                                    new Ogre2DynamicRenderable(this->Scene()));
-
-        renderable->SetOperationType(MT_POINTS);
-
-        // use low level programmable material so we can customize point size
-        Ogre::Item *item = dynamic_cast<Ogre::Item *>(renderable->OgreObject());
-        item->setCastShadows(false);
-        item->getSubItem(0)->setMaterial(this->dataPtr->pointsMat);
-
-        this->ogreNode->attachObject(renderable->OgreObject());
-        this->dataPtr->points.push_back(renderable);
-      }
-    }
 
     if (this->dataPtr->lidarVisType == LidarVisualType::LVT_TRIANGLE_STRIPS)
     {
@@ -441,25 +443,6 @@ void Ogre2LidarVisual::Update()
         }
       }
 
-      // For POINTS Lidar Visual to be displayed
-      else if (this->dataPtr->lidarVisType ==
-                LidarVisualType::LVT_POINTS)
-      {
-        if (i >= this->dataPtr->points[j]->PointCount())
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->AddPoint(inf ? noHitPt: pt);
-          }
-        }
-        else
-        {
-          if (this->displayNonHitting || !inf)
-          {
-            this->dataPtr->points[j]->SetPoint(i, inf ? noHitPt: pt);
-          }
-        }
-      }
       horizontalAngle += this->horizontalAngleStep;
     }
 
@@ -476,10 +459,6 @@ void Ogre2LidarVisual::Update()
         this->dataPtr->deadZoneRayFans[j]->Update();
       }
     }
-    else if (this->dataPtr->lidarVisType == LidarVisualType::LVT_POINTS)
-    {
-      this->dataPtr->points[j]->Update();
-    }
     verticalAngle += this->verticalAngleStep;
   }
 
@@ -505,6 +484,92 @@ void Ogre2LidarVisual::Update()
   this->SetVisible(this->dataPtr->visible);
 }
 
+//////////////////////////////////////////////////
+void Ogre2LidarVisual::UpdatePointCloud()
+{
+  if (this->dataPtr->points.empty())
+  {
+    std::shared_ptr<Ogre2DynamicRenderable> renderable =
+        std::make_shared<Ogre2DynamicRenderable>(this->Scene());
+    renderable->SetOperationType(MT_POINTS);
+    renderable->SetStreaming(true);
+
+    // use low level programmable material so we can customize point size
+    Ogre::Item *item = dynamic_cast<Ogre::Item *>(renderable->OgreObject());
+    item->setCastShadows(false);
+    item->getSubItem(0)->setMaterial(this->dataPtr->pointsMat);
+
+    this->ogreNode->attachObject(renderable->OgreObject());
+    this->dataPtr->points.push_back(renderable);
+  }
+
+  // the ray directions only change with the lidar parameters, so compute
+  // them once instead of building a quaternion per point on every scan
+  const math::Quaterniond &rot = this->offset.Rot();
+  std::vector<double> key = {
+      this->minHorizontalAngle, this->horizontalAngleStep,
+      this->minVerticalAngle, this->verticalAngleStep,
+      static_cast<double>(this->horizontalCount),
+      static_cast<double>(this->verticalCount),
+      rot.W(), rot.X(), rot.Y(), rot.Z()};
+  std::vector<float> &dirs = this->dataPtr->rayDirections;
+  if (key != this->dataPtr->rayDirectionsKey)
+  {
+    this->dataPtr->rayDirectionsKey = key;
+    dirs.resize(this->verticalCount * this->horizontalCount * 3u);
+    float *dir = dirs.data();
+    for (unsigned int j = 0; j < this->verticalCount; ++j)
+    {
+      double verticalAngle =
+          this->minVerticalAngle + j * this->verticalAngleStep;
+      for (unsigned int i = 0; i < this->horizontalCount; ++i)
+      {
+        double horizontalAngle =
+            this->minHorizontalAngle + i * this->horizontalAngleStep;
+        math::Quaterniond ray(
+            math::Vector3d(0.0, -verticalAngle, horizontalAngle));
+        math::Vector3d axis = rot * ray * math::Vector3d::UnitX;
+        dir[0] = static_cast<float>(axis.X());
+        dir[1] = static_cast<float>(axis.Y());
+        dir[2] = static_cast<float>(axis.Z());
+        dir += 3;
+      }
+    }
+  }
+
+  // compute the positions of the whole scan in float, leaving out the rays
+  // that did not hit anything if they are not displayed
+  const float maxRange = static_cast<float>(this->maxRange);
+  const float origin[3] = {
+      static_cast<float>(this->offset.Pos().X()),
+      static_cast<float>(this->offset.Pos().Y()),
+      static_cast<float>(this->offset.Pos().Z())};
+  const std::vector<double> &ranges = this->dataPtr->lidarPoints;
+  std::vector<float> &positions = this->dataPtr->pointPositions;
+  positions.resize(ranges.size() * 3u);
+  float *pos = positions.data();
+  unsigned int count = 0u;
+  for (unsigned int k = 0; k < ranges.size(); ++k)
+  {
+    double r = ranges[k];
+    bool inf = (std::isinf(r) || r >= this->maxRange);
+    if (inf && !this->displayNonHitting)
+      continue;
+
+    float range = inf ? maxRange : static_cast<float>(r);
+    const float *dir = &dirs[k * 3u];
+    pos[0] = dir[0] * range + origin[0];
+    pos[1] = dir[1] * range + origin[1];
+    pos[2] = dir[2] * range + origin[2];
+    pos += 3;
+    ++count;
+  }
+
+  // upload the scan in one go
+  this->dataPtr->points[0]->SetPoints(positions.data(), nullptr, count);
+  this->dataPtr->points[0]->Update();
+}
+
 //////////////////////////////////////////////////
 unsigned int Ogre2LidarVisual::PointCount() const
 {
@@ -165,6 +165,11 @@ Ogre::Light *Ogre2Light::Light() const
 void Ogre2Light::Destroy()
 {
   BaseLight::Destroy();
+
+  // the scene may now need fewer shadow maps
+  if (this->ogreLight->getCastShadows())
+    this->scene->SetShadowsDirty(true);
+
   Ogre::SceneManager *ogreSceneManager = this->scene->OgreSceneManager();
   ogreSceneManager->destroySceneNode(this->ogreLight->getParentSceneNode());
   ogreSceneManager->destroyLight(this->ogreLight);
@@ -204,6 +204,8 @@ void Ogre2Marker::Create()
   this->markerType = MT_NONE;
   this->dataPtr->dynamicRenderable.reset(new Ogre2DynamicRenderable(
       this->scene));
+  // markers are often updated every frame, one point at a time
+  this->dataPtr->dynamicRenderable->SetStreaming(true);
   if (!this->dataPtr->geom)
   {
     this->dataPtr->geom =
@@ -307,6 +309,21 @@ void Ogre2Marker::AddPoint(const ignition::math::Vector3d &_pt,
   this->dataPtr->dynamicRenderable->AddPoint(_pt, _color);
 }
 
+//////////////////////////////////////////////////
+void Ogre2Marker::SetPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->dynamicRenderable->SetPoints(_positions, _colors, _count);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Marker::AppendPoints(const float *_positions,
+    const ignition::math::Color *_colors, unsigned int _count)
+{
+  this->dataPtr->dynamicRenderable->AppendPoints(_positions, _colors,
+      _count);
+}
+
 //////////////////////////////////////////////////
 void Ogre2Marker::ClearPoints()
 {
@@ -15,6 +15,8 @@
  *
  */
 
+#include <array>
+
 // Note this include is placed in the src file because
 // otherwise ogre produces compile errors
 #ifdef _MSC_VER
@@ -48,7 +50,6 @@
 #include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "ignition/rendering/ogre2/Ogre2Scene.hh"
 
-
 /// \brief Private data for the Ogre2Material class
 class ignition::rendering::Ogre2MaterialPrivate
 {
@@ -67,11 +68,39 @@ class ignition::rendering::Ogre2MaterialPrivate
 
   /// \brief Parameters to be bound to the fragment shader
   public: ShaderParamsPtr fragmentShaderParams;
+
+  /// \brief Name of the Ogre texture used by each PBS texture unit. Each
+  /// one holds a use count in the render engine.
+  public: std::array<std::string, Ogre::NUM_PBSM_TEXTURE_TYPES> textureRefs;
+
+  /// \brief Update the texture used by a texture unit and the use counts
+  /// of the previous and new textures
+  /// \param[in] _type Texture unit
+  /// \param[in] _name Name of the Ogre texture, empty if none
+  public: void SetTextureRef(Ogre::PbsTextureTypes _type,
+              const std::string &_name);
 };
 
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+void Ogre2MaterialPrivate::SetTextureRef(Ogre::PbsTextureTypes _type,
+    const std::string &_name)
+{
+  std::string &texName = this->textureRefs[_type];
+  if (texName == _name)
+    return;
+
+  // textures are only unloaded in Destroy(), after the datablocks of the
+  // material are gone, since the unlit datablock may still point to them
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  engine->AcquireTexture(_name);
+  if (!texName.empty())
+    engine->ReleaseTexture(texName);
+  texName = _name;
+}
+
 //////////////////////////////////////////////////
 Ogre2Material::Ogre2Material()
   : dataPtr(std::make_unique<Ogre2MaterialPrivate>())
@@ -124,70 +153,33 @@ void Ogre2Material::Destroy()
 
   Ogre::TextureGpuManager::BudgetEntryVec budget;
   textureManager->setWorkerThreadMinimumBudget( budget );
-  Ogre::HlmsManager *hlmsManager = root->getHlmsManager();
 
-  Ogre::TextureGpu* textureToRemove = nullptr;
-  bool textureIsUse = false;
-  // Check each material from each Hlms (except low level) to see if their
-  // material is currently in use. If it's not, then its textures may be
-  // not either
-  for (size_t i = Ogre::HLMS_PBS; i < Ogre::HLMS_MAX; ++i)
+  // Release the textures used by this material. A texture that is no longer
+  // used by any material is unloaded by the scene, unless another datablock
+  // still uses it. The scene looks for other datablocks once per batch of
+  // released textures.
+  Ogre2ScenePtr s = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  for (size_t texUnit = 0; texUnit < Ogre::NUM_PBSM_TEXTURE_TYPES; ++texUnit)
   {
-    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
-
-    if(hlms)
-    {
-      const Ogre::Hlms::HlmsDatablockMap &datablocks = hlms->getDatablockMap();
+    std::string &texName = this->dataPtr->textureRefs[texUnit];
+    if (texName.empty())
+      continue;
 
-      Ogre::Hlms::HlmsDatablockMap::const_iterator itor = datablocks.begin();
-      Ogre::Hlms::HlmsDatablockMap::const_iterator end  = datablocks.end();
+    unsigned int useCount = engine->ReleaseTexture(texName);
+    std::string name = texName;
+    texName.clear();
+    if (useCount > 0u || !textureManager->findTextureNoThrow(name))
+      continue;
 
-      while (itor != end)
-      {
-        if (i == Ogre::HLMS_PBS)
-        {
-          Ogre::HlmsPbsDatablock *derivedDatablock =
-            static_cast<Ogre::HlmsPbsDatablock*>(itor->second.datablock);
-          for (size_t texUnit = 0; texUnit < Ogre::NUM_PBSM_TEXTURE_TYPES;
-            ++texUnit)
-          {
-            // Check each texture from the material
-            Ogre::TextureGpu *tex = derivedDatablock->getTexture(texUnit);
-            if (tex)
-            {
-              // If getLinkedRenderables is empty, then the material is
-              // not in use, and thus so is potentially the texture
-              if (!itor->second.datablock->getLinkedRenderables().empty())
-              {
-                if (tex->getNameStr() == this->textureName)
-                {
-                  textureIsUse = true;
-                }
-              }
-              else
-              {
-                if (tex->getNameStr() == this->textureName)
-                {
-                  textureToRemove = tex;
-                }
-              }
-            }
-          }
-        }
-        ++itor;
-      }
+    if (texUnit == Ogre::PBSM_DIFFUSE)
+    {
+      s->ClearMaterialsCache(this->textureName);
+      this->Scene()->UnregisterMaterial(this->name);
     }
+    s->QueueTextureUnload(name);
   }
 
-  if (textureToRemove && !textureIsUse)
-  {
-    Ogre2ScenePtr s = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
-    s->ClearMaterialsCache(this->textureName);
-    this->Scene()->UnregisterMaterial(this->name);
-    textureManager->destroyTexture(textureToRemove);
-  }
-
-  Ogre2ScenePtr s = std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
   Ogre::SceneManager *sceneManager = s->OgreSceneManager();
   sceneManager->shrinkToFitMemoryPools();
 
@@ -358,6 +350,7 @@ void Ogre2Material::ClearTexture()
 {
   this->textureName = "";
   this->ogreDatablock->setTexture(Ogre::PBSM_DIFFUSE, this->textureName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_DIFFUSE, "");
 }
 
 //////////////////////////////////////////////////
@@ -390,6 +383,7 @@ void Ogre2Material::ClearNormalMap()
 {
   this->normalMapName = "";
   this->ogreDatablock->setTexture(Ogre::PBSM_NORMAL, this->normalMapName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_NORMAL, "");
 }
 
 //////////////////////////////////////////////////
@@ -422,6 +416,7 @@ void Ogre2Material::ClearRoughnessMap()
 {
   this->roughnessMapName = "";
   this->ogreDatablock->setTexture(Ogre::PBSM_ROUGHNESS, this->roughnessMapName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_ROUGHNESS, "");
 }
 
 //////////////////////////////////////////////////
@@ -454,6 +449,7 @@ void Ogre2Material::ClearMetalnessMap()
 {
   this->metalnessMapName = "";
   this->ogreDatablock->setTexture(Ogre::PBSM_METALLIC, this->metalnessMapName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_METALLIC, "");
 }
 
 //////////////////////////////////////////////////
@@ -487,6 +483,7 @@ void Ogre2Material::ClearEnvironmentMap()
   this->environmentMapName = "";
   this->ogreDatablock->setTexture(
     Ogre::PBSM_REFLECTION, this->environmentMapName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_REFLECTION, "");
 }
 
 //////////////////////////////////////////////////
@@ -519,6 +516,7 @@ void Ogre2Material::ClearEmissiveMap()
 {
   this->emissiveMapName = "";
   this->ogreDatablock->setTexture(Ogre::PBSM_EMISSIVE, this->emissiveMapName);
+  this->dataPtr->SetTextureRef(Ogre::PBSM_EMISSIVE, "");
 }
 
 //////////////////////////////////////////////////
@@ -574,7 +572,10 @@ void Ogre2Material::ClearLightMap()
 
   // in ogre 2.2, we swtiched to use the emissive map slot for light map
   if (this->ogreDatablock->getUseEmissiveAsLightmap())
+  {
     this->ogreDatablock->setTexture(Ogre::PBSM_EMISSIVE, this->lightMapName);
+    this->dataPtr->SetTextureRef(Ogre::PBSM_EMISSIVE, "");
+  }
   this->ogreDatablock->setUseEmissiveAsLightmap(false);
 }
 
@@ -606,6 +607,12 @@ float Ogre2Material::Metalness() const
 void Ogre2Material::PreRender()
 {
   this->UpdateShaderParams();
+
+  // shader params can be changed through the pointers returned by
+  // VertexShaderParams and FragmentShaderParams at any time, so keep
+  // checking them every frame
+  if (this->dataPtr->vertexShaderParams || this->dataPtr->fragmentShaderParams)
+    this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -906,6 +913,7 @@ void Ogre2Material::SetTextureMapImpl(const std::string &_texture,
   samplerBlockRef.mW = Ogre::TAM_WRAP;
 
   this->ogreDatablock->setTexture(_type, baseName, &samplerBlockRef);
+  this->dataPtr->SetTextureRef(_type, baseName);
   auto tex = textureMgr->findTextureNoThrow(baseName);
 
   if (tex)
@@ -1123,6 +1131,7 @@ void Ogre2Material::SetVertexShader(const std::string &_path)
 
   this->dataPtr->vertexShaderPath = _path;
   this->dataPtr->vertexShaderParams.reset(new ShaderParams);
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -1173,6 +1182,7 @@ void Ogre2Material::SetFragmentShader(const std::string &_path)
   mat->load();
   this->dataPtr->fragmentShaderPath = _path;
   this->dataPtr->fragmentShaderParams.reset(new ShaderParams);
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -96,6 +96,7 @@ void Ogre2MaterialSwitcher::cameraPreRenderScene(
     Ogre::Item *item = static_cast<Ogre::Item *>(object);
 
     this->colorDict[this->currentColor.AsRGBA()] = item->getName();
+    this->colorItemDict[this->currentColor.AsRGBA()] = item;
 
     for (unsigned int i = 0; i < item->getNumSubItems(); ++i)
     {
@@ -181,6 +182,18 @@ std::string Ogre2MaterialSwitcher::EntityName(
     return std::string();
 }
 
+/////////////////////////////////////////////////
+Ogre::Item *Ogre2MaterialSwitcher::EntityItem(
+    const ignition::math::Color &_color) const
+{
+  auto iter = this->colorItemDict.find(_color.AsRGBA());
+
+  if (iter != this->colorItemDict.end())
+    return iter->second;
+  else
+    return nullptr;
+}
+
 /////////////////////////////////////////////////
 void Ogre2MaterialSwitcher::NextColor()
 {
@@ -195,4 +208,5 @@ void Ogre2MaterialSwitcher::Reset()
   this->currentColor = ignition::math::Color(
       0.0, 0.0, 0.0);
   this->colorDict.clear();
+  this->colorItemDict.clear();
 }
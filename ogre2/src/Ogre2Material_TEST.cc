@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/ogre2/Ogre2Material.hh"
+#include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "ignition/rendering/ogre2/Ogre2Scene.hh"
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <Hlms/Pbs/OgreHlmsPbs.h>
+#include <Hlms/Pbs/OgreHlmsPbsDatablock.h>
+#include <OgreHlmsManager.h>
+#include <OgreRoot.h>
+#include <OgreTextureGpuManager.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+using namespace ignition;
+using namespace rendering;
+
+class Ogre2MaterialTest : public testing::Test
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+
+  /// \brief Get an ogre texture by name
+  /// \param[in] _name Name of the ogre texture
+  /// \return The texture or null if it is not loaded
+  public: Ogre::TextureGpu *OgreTexture(const std::string &_name)
+  {
+    Ogre::TextureGpuManager *textureManager =
+        Ogre2RenderEngine::Instance()->OgreRoot()->getRenderSystem()->
+        getTextureGpuManager();
+    return textureManager->findTextureNoThrow(_name);
+  }
+
+  /// \brief Path to the test textures
+  public: const std::string TEST_MEDIA_PATH =
+        common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+        "test", "media", "materials", "textures");
+};
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2MaterialTest, SharedTexture)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  Ogre2RenderEngine *ogre2Engine = Ogre2RenderEngine::Instance();
+  const std::string textureName = "texture.png";
+  const std::string texturePath =
+      common::joinPaths(TEST_MEDIA_PATH, textureName);
+  EXPECT_EQ(0u, ogre2Engine->TextureUseCount(textureName));
+
+  // two materials sharing the same texture
+  MaterialPtr material1 = scene->CreateMaterial();
+  ASSERT_NE(nullptr, material1);
+  material1->SetTexture(texturePath);
+  EXPECT_EQ(1u, ogre2Engine->TextureUseCount(textureName));
+
+  MaterialPtr material2 = scene->CreateMaterial();
+  ASSERT_NE(nullptr, material2);
+  material2->SetTexture(texturePath);
+  EXPECT_EQ(2u, ogre2Engine->TextureUseCount(textureName));
+  Ogre::TextureGpu *texture = this->OgreTexture(textureName);
+  ASSERT_NE(nullptr, texture);
+
+  // removing the texture from one material releases it
+  material2->ClearTexture();
+  EXPECT_EQ(1u, ogre2Engine->TextureUseCount(textureName));
+  material2->SetTexture(texturePath);
+  EXPECT_EQ(2u, ogre2Engine->TextureUseCount(textureName));
+
+  // the texture survives destroying one of the materials
+  scene->DestroyMaterial(material1);
+  EXPECT_EQ(1u, ogre2Engine->TextureUseCount(textureName));
+  EXPECT_EQ(texture, this->OgreTexture(textureName));
+
+  // a datablock not created by a material also uses the texture
+  Ogre::HlmsManager *hlmsManager =
+      ogre2Engine->OgreRoot()->getHlmsManager();
+  Ogre::HlmsPbs *hlmsPbs =
+      static_cast<Ogre::HlmsPbs *>(hlmsManager->getHlms(Ogre::HLMS_PBS));
+  const std::string datablockName = "Ogre2MaterialTest_datablock";
+  Ogre::HlmsPbsDatablock *datablock =
+      static_cast<Ogre::HlmsPbsDatablock *>(hlmsPbs->createDatablock(
+      datablockName, datablockName, Ogre::HlmsMacroblock(),
+      Ogre::HlmsBlendblock(), Ogre::HlmsParamVec()));
+  datablock->setTexture(Ogre::PBSM_DIFFUSE, texture);
+
+  // the texture is kept while the datablock uses it, also after the scene
+  // looked for unused textures at the start of the next frame
+  scene->DestroyMaterial(material2);
+  EXPECT_EQ(0u, ogre2Engine->TextureUseCount(textureName));
+  EXPECT_EQ(texture, this->OgreTexture(textureName));
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  scene->RootVisual()->AddChild(camera);
+  camera->Update();
+  EXPECT_EQ(texture, this->OgreTexture(textureName));
+
+  hlmsPbs->destroyDatablock(datablockName);
+
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2MaterialTest, UnloadTexture)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  scene->RootVisual()->AddChild(camera);
+
+  const std::string textureName = "gray_texture.png";
+  MaterialPtr material = scene->CreateMaterial();
+  ASSERT_NE(nullptr, material);
+  material->SetTexture(common::joinPaths(TEST_MEDIA_PATH, textureName));
+  EXPECT_NE(nullptr, this->OgreTexture(textureName));
+
+  // textures no longer used by any material are unloaded in one batch at
+  // the start of the next frame
+  scene->DestroyMaterial(material);
+  EXPECT_NE(nullptr, this->OgreTexture(textureName));
+  camera->Update();
+  EXPECT_EQ(nullptr, this->OgreTexture(textureName));
+
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
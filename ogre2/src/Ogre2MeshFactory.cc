@@ -16,9 +16,20 @@
  */
 
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <random>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Material.hh>
 #include <ignition/common/MeshManager.hh>
 #include <ignition/common/Skeleton.hh>
@@ -27,6 +38,7 @@
 
 #include <ignition/math/Matrix4.hh>
 
+#include "ignition/rendering/detail/Hash.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
 #include "ignition/rendering/ogre2/Ogre2Mesh.hh"
 #include "ignition/rendering/ogre2/Ogre2MeshFactory.hh"
@@ -44,8 +56,11 @@
 #include <OgreMesh2.h>
 #include <OgreMeshManager.h>
 #include <OgreMeshManager2.h>
+#include <OgreMeshSerializer.h>
 #include <OgreOldBone.h>
 #include <OgreOldSkeletonManager.h>
+#include <OgreRenderSystem.h>
+#include <OgreRoot.h>
 #include <OgreSceneManager.h>
 #include <OgreSkeleton.h>
 #include <OgreSubItem.h>
@@ -61,16 +76,330 @@ class ignition::rendering::Ogre2MeshFactoryPrivate
   /// \brief Vector with the template materials, we keep the pointer to be
   /// able to remove it when nobody is using it.
   public: std::vector<MaterialPtr> materialCache;
+
+  /// \brief Triangle hierarchies of the meshes created by this factory,
+  /// indexed by ogre mesh name
+  public: std::map<std::string, std::shared_ptr<MeshBvh>> triangleBvhs;
+
+  /// \brief Mesh cache file to write each mesh to once it is converted to
+  /// an ogre v2 mesh, indexed by ogre mesh name
+  public: std::map<std::string, std::string> meshCacheFiles;
+
+  /// \brief Create the material of a submesh
+  /// \param[in] _scene Scene to create the material in
+  /// \param[in] _material Material of the submesh, null to use the
+  /// default material
+  /// \return The material
+  public: MaterialPtr CreateSubMeshMaterial(Ogre2ScenePtr _scene,
+      const common::MaterialPtr &_material);
+
+  /// \brief Load a converted mesh from the mesh cache
+  /// \param[in] _scene Scene to create the submesh materials in
+  /// \param[in] _desc Mesh descriptor
+  /// \param[in] _name Name of the ogre mesh to create
+  /// \param[in] _file Mesh cache file
+  /// \return True if the mesh was loaded
+  public: bool LoadCachedMesh(Ogre2ScenePtr _scene,
+      const MeshDescriptor &_desc, const std::string &_name,
+      const std::string &_file);
+
+  /// \brief Write a converted mesh to the mesh cache if it was loaded
+  /// from a mesh file that is not cached yet
+  /// \param[in] _name Name of the ogre mesh
+  /// \param[in] _mesh Converted ogre mesh
+  public: void SaveCachedMesh(const std::string &_name,
+      const Ogre::Mesh *_mesh);
+};
+
+/// \brief Locked vertex and index buffers of an ogre submesh, to be filled
+/// with the data of a common submesh by a worker thread
+struct Ogre2SubMeshBuffers
+{
+  /// \brief Submesh to copy the data from
+  std::shared_ptr<ignition::common::SubMesh> subMesh;
+
+  /// \brief Ogre vertex buffer
+  Ogre::v1::HardwareVertexBufferSharedPtr vertexBuffer;
+
+  /// \brief Ogre index buffer
+  Ogre::v1::HardwareIndexBufferSharedPtr indexBuffer;
+
+  /// \brief Locked vertex buffer memory
+  float *vertices = nullptr;
+
+  /// \brief Locked index buffer memory
+  uint32_t *indices = nullptr;
 };
 
 /// \brief Private data for the Ogre2SubMeshStoreFactory class
 class ignition::rendering::Ogre2SubMeshStoreFactoryPrivate
 {
+  /// \brief Materials to assign to the submeshes without copying them, by
+  /// submesh index
+  public: std::vector<MaterialPtr> materials;
 };
 
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+/// \brief Interleave the vertices and copy the indices of a submesh into
+/// its locked buffers, in the layout of the vertex declaration created in
+/// Ogre2MeshFactory::LoadImpl. It does not call into Ogre so it can run on
+/// any thread.
+/// \param[in] _buffers Submesh and buffers to fill
+/// \param[in] _center True to recenter the vertices
+static void fillSubMeshBuffers(const Ogre2SubMeshBuffers &_buffers,
+    bool _center)
+{
+  // Copy the original submesh if it needs to be recentered. We don't want
+  // to change the original.
+  const common::SubMesh *subMesh = _buffers.subMesh.get();
+  std::unique_ptr<common::SubMesh> centered;
+  if (_center)
+  {
+    centered = std::make_unique<common::SubMesh>(*subMesh);
+    centered->Center(math::Vector3d::Zero);
+    subMesh = centered.get();
+  }
+
+  bool normals = subMesh->NormalCount() > 0;
+  std::vector<unsigned int> texCoordSets;
+  for (unsigned int k = 0u; k < subMesh->TexCoordSetCount(); ++k)
+  {
+    if (subMesh->TexCoordCountBySet(k) > 0u)
+      texCoordSets.push_back(k);
+  }
+
+  // Add all the vertices
+  float *vertices = _buffers.vertices;
+  for (unsigned int j = 0; j < subMesh->VertexCount(); ++j)
+  {
+    const math::Vector3d &v = subMesh->Vertex(j);
+    *vertices++ = v.X();
+    *vertices++ = v.Y();
+    *vertices++ = v.Z();
+
+    // Add all normals
+    if (normals)
+    {
+      const math::Vector3d &n = subMesh->Normal(j);
+      *vertices++ = n.X();
+      *vertices++ = n.Y();
+      *vertices++ = n.Z();
+    }
+
+    // Add all texture coordinate sets
+    for (auto k : texCoordSets)
+    {
+      const math::Vector2d &uv = subMesh->TexCoordBySet(j, k);
+      *vertices++ = uv.X();
+      *vertices++ = uv.Y();
+    }
+  }
+
+  // Add all the indices
+  uint32_t *indices = _buffers.indices;
+  for (unsigned int j = 0; j < subMesh->IndexCount(); ++j)
+    *indices++ = static_cast<uint32_t>(subMesh->Index(j));
+}
+
+//////////////////////////////////////////////////
+/// \brief Fill the buffers of several submeshes using worker threads
+/// \param[in] _buffers Submeshes and buffers to fill
+/// \param[in] _center True to recenter the vertices
+static void fillSubMeshBuffers(const std::vector<Ogre2SubMeshBuffers> &_buffers,
+    bool _center)
+{
+  // only spread the work when there is enough of it to pay for the threads
+  size_t vertexCount = 0u;
+  for (const auto &b : _buffers)
+    vertexCount += b.subMesh->VertexCount();
+
+  unsigned int threadCount = std::min(
+      static_cast<size_t>(std::thread::hardware_concurrency()),
+      _buffers.size());
+  if (threadCount <= 1u || vertexCount < 10000u)
+  {
+    for (const auto &b : _buffers)
+      fillSubMeshBuffers(b, _center);
+    return;
+  }
+
+  // submeshes are handed out one at a time so a few large submeshes do not
+  // end up on the same thread
+  std::atomic<size_t> next(0u);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0u; t < threadCount; ++t)
+  {
+    threads.emplace_back([&]()
+    {
+      for (size_t i = next++; i < _buffers.size(); i = next++)
+        fillSubMeshBuffers(_buffers[i], _center);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the mesh cache file of a mesh. Entries are keyed by the
+/// path and content of the mesh file, the way the mesh is loaded and the
+/// Ogre version, so a changed mesh file gets a new entry.
+/// \param[in] _desc Mesh descriptor
+/// \param[in] _cachePath Mesh cache directory
+/// \return Path of the cache file, empty if the mesh cannot be cached
+static std::string meshCacheFile(const MeshDescriptor &_desc,
+    const std::string &_cachePath)
+{
+  // skeletons are rebuilt from the common mesh so skinned meshes are not
+  // cached, and meshes created in code have no file to key the entry with
+  if (_cachePath.empty() || !_desc.mesh || _desc.mesh->HasSkeleton() ||
+      !common::isFile(_desc.meshName))
+  {
+    return std::string();
+  }
+
+  uint64_t hash = detail::fnv1a(_desc.meshName);
+
+  // the file was just parsed by the common mesh manager, so reading it
+  // again is served from the page cache
+  std::ifstream file(_desc.meshName, std::ios::binary);
+  if (!file)
+    return std::string();
+  char buffer[65536];
+  while (file)
+  {
+    file.read(buffer, sizeof(buffer));
+    hash = detail::fnv1a(buffer, static_cast<size_t>(file.gcount()), hash);
+  }
+
+  hash = detail::fnv1a(_desc.subMeshName, hash);
+  hash = detail::fnv1a(_desc.centerSubMesh ? "CENTERED" : "ORIGINAL", hash);
+  hash = detail::fnv1a(std::to_string(OGRE_VERSION), hash);
+
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash << ".mesh";
+  return common::joinPaths(_cachePath, ss.str());
+}
+
+//////////////////////////////////////////////////
+MaterialPtr Ogre2MeshFactoryPrivate::CreateSubMeshMaterial(
+    Ogre2ScenePtr _scene, const common::MaterialPtr &_material)
+{
+  MaterialPtr mat = _scene->CreateMaterial();
+  if (_material)
+  {
+    mat->CopyFrom(*_material);
+    this->materialCache.push_back(mat);
+  }
+  else
+  {
+    MaterialPtr defaultMat = _scene->Material("Default/White");
+    if (defaultMat != nullptr)
+      mat->CopyFrom(defaultMat);
+  }
+  return mat;
+}
+
+//////////////////////////////////////////////////
+bool Ogre2MeshFactoryPrivate::LoadCachedMesh(Ogre2ScenePtr _scene,
+    const MeshDescriptor &_desc, const std::string &_name,
+    const std::string &_file)
+{
+  if (!common::isFile(_file))
+    return false;
+
+  Ogre::MeshPtr mesh;
+  try
+  {
+    mesh = Ogre::MeshManager::getSingleton().createManual(
+        _name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    std::ifstream *ifs = OGRE_NEW_T(std::ifstream, Ogre::MEMCATEGORY_GENERAL)(
+        _file.c_str(), std::ios::binary);
+    Ogre::DataStreamPtr stream(
+        OGRE_NEW Ogre::FileStreamDataStream(_file, ifs, true));
+    Ogre::MeshSerializer serializer(
+        Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+    serializer.importMesh(stream, mesh.get());
+
+    if (!mesh->hasValidShadowMappingVaos())
+      mesh->prepareForShadowMapping(false);
+  }
+  catch(Ogre::Exception &e)
+  {
+    ignwarn << "Unable to load cached mesh [" << _file << "]: "
+            << e.getDescription() << std::endl;
+    if (mesh)
+      Ogre::MeshManager::getSingleton().remove(_name);
+    return false;
+  }
+
+  // the materials are not cached, create them the way LoadImpl does
+  std::vector<std::shared_ptr<common::SubMesh>> subMeshes;
+  for (unsigned int i = 0; i < _desc.mesh->SubMeshCount(); ++i)
+  {
+    auto s = _desc.mesh->SubMeshByIndex(i).lock();
+    if (!s || (!_desc.subMeshName.empty() && s->Name() != _desc.subMeshName))
+      continue;
+    subMeshes.push_back(s);
+  }
+
+  if (subMeshes.size() != mesh->getNumSubMeshes())
+  {
+    ignwarn << "Cached mesh [" << _file << "] does not match mesh ["
+            << _desc.meshName << "], it will be reloaded" << std::endl;
+    Ogre::MeshManager::getSingleton().remove(_name);
+    return false;
+  }
+
+  for (unsigned int i = 0; i < subMeshes.size(); ++i)
+  {
+    MaterialPtr mat = this->CreateSubMeshMaterial(_scene,
+        _desc.mesh->MaterialByIndex(subMeshes[i]->MaterialIndex()));
+    mesh->getSubMesh(i)->setMaterialName(mat->Name());
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Ogre2MeshFactoryPrivate::SaveCachedMesh(const std::string &_name,
+    const Ogre::Mesh *_mesh)
+{
+  auto it = this->meshCacheFiles.find(_name);
+  if (it == this->meshCacheFiles.end())
+    return;
+
+  std::string file = it->second;
+  this->meshCacheFiles.erase(it);
+
+  // write to a temporary file first so that other processes sharing the
+  // cache never read a partially written entry
+  std::string tmpFile = file + "." + std::to_string(std::random_device()());
+  try
+  {
+    std::string dir = common::parentPath(file);
+    if (!common::exists(dir))
+      common::createDirectories(dir);
+
+    Ogre::MeshSerializer serializer(
+        Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+    serializer.exportMesh(_mesh, tmpFile);
+  }
+  catch(Ogre::Exception &e)
+  {
+    ignwarn << "Unable to write cached mesh [" << file << "]: "
+            << e.getDescription() << std::endl;
+    common::removeFile(tmpFile);
+    return;
+  }
+
+  if (std::rename(tmpFile.c_str(), file.c_str()) != 0)
+    common::removeFile(tmpFile);
+}
+
 //////////////////////////////////////////////////
 Ogre2MeshFactory::Ogre2MeshFactory(Ogre2ScenePtr _scene) :
   scene(_scene), dataPtr(std::make_unique<Ogre2MeshFactoryPrivate>())
@@ -89,6 +418,8 @@ void Ogre2MeshFactory::Clear()
     Ogre::MeshManager::getSingleton().remove(m);
 
   this->ogreMeshes.clear();
+  this->dataPtr->triangleBvhs.clear();
+  this->dataPtr->meshCacheFiles.clear();
 }
 
 //////////////////////////////////////////////////
@@ -112,6 +443,13 @@ void Ogre2MeshFactory::ClearMaterialsCache(const std::string &_name)
 
 //////////////////////////////////////////////////
 Ogre2MeshPtr Ogre2MeshFactory::Create(const MeshDescriptor &_desc)
+{
+  return this->Create(_desc, {});
+}
+
+//////////////////////////////////////////////////
+Ogre2MeshPtr Ogre2MeshFactory::Create(const MeshDescriptor &_desc,
+    const std::vector<MaterialPtr> &_materials)
 {
   // create ogre entity
   Ogre2MeshPtr mesh(new Ogre2Mesh);
@@ -128,7 +466,8 @@ Ogre2MeshPtr Ogre2MeshFactory::Create(const MeshDescriptor &_desc)
   }
 
   // create sub-mesh store
-  Ogre2SubMeshStoreFactory subMeshFactory(this->scene, mesh->ogreItem);
+  Ogre2SubMeshStoreFactory subMeshFactory(this->scene, mesh->ogreItem,
+      _materials);
   mesh->subMeshes = subMeshFactory.Create();
   for (unsigned int i = 0; i < mesh->subMeshes->Size(); i++)
   {
@@ -150,6 +489,11 @@ Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
   std::string name = this->MeshName(_desc);
   Ogre::SceneManager *sceneManager = this->scene->OgreSceneManager();
 
+  // build the triangle hierarchy while the mesh is known to be alive, the
+  // descriptor only points to a mesh that may be freed later on
+  if (_desc.mesh && !this->dataPtr->triangleBvhs.count(name))
+    this->dataPtr->triangleBvhs[name] = std::make_shared<MeshBvh>(_desc);
+
   // check if a v2 mesh already exists
   Ogre::MeshPtr mesh =
       Ogre::MeshManager::getSingleton().getByName(name);
@@ -167,6 +511,7 @@ Ogre::Item *Ogre2MeshFactory::OgreItem(const MeshDescriptor &_desc)
         name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
     mesh->importV1(v1Mesh.get(), false, true, true);
     this->ogreMeshes.push_back(name);
+    this->dataPtr->SaveCachedMesh(name, mesh.get());
   }
 
   return sceneManager->createItem(mesh, Ogre::SCENE_DYNAMIC);
@@ -204,6 +549,22 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
 
   Ogre2RenderEngine::Instance()->AddResourcePath(_desc.mesh->Path());
 
+  // load the converted mesh from the mesh cache if it is there, otherwise
+  // remember to store it once it is converted
+  std::string cacheFile = meshCacheFile(_desc,
+      Ogre2RenderEngine::Instance()->MeshCachePath());
+  if (!cacheFile.empty())
+  {
+    std::string cachedName = this->MeshName(_desc);
+    if (this->dataPtr->LoadCachedMesh(this->scene, _desc, cachedName,
+        cacheFile))
+    {
+      this->ogreMeshes.push_back(cachedName);
+      return true;
+    }
+    this->dataPtr->meshCacheFiles[cachedName] = cacheFile;
+  }
+
   try
   {
     name = this->MeshName(_desc);
@@ -293,6 +654,24 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
       ogreMesh->setSkeletonName(_desc.mesh->Name() + "_skeleton");
     }
 
+    // bone handle of each skeleton node, looked up once for all the node
+    // assignments
+    std::vector<uint16_t> boneHandles;
+    if (_desc.mesh->HasSkeleton())
+    {
+      common::SkeletonPtr skel = _desc.mesh->MeshSkeleton();
+      boneHandles.resize(skel->NodeCount());
+      for (unsigned int i = 0; i < skel->NodeCount(); ++i)
+      {
+        boneHandles[i] = ogreSkeleton->getBone(
+            skel->NodeByHandle(i)->Name())->getHandle();
+      }
+    }
+
+    // Ogre objects are created here on the render thread, while the vertex
+    // and index data is copied into the locked buffers by worker threads
+    // once all the submeshes are created
+    std::vector<Ogre2SubMeshBuffers> subMeshBuffers;
     for (unsigned int i = 0; i < _desc.mesh->SubMeshCount(); i++)
     {
       // if submesh is specified then load only that particular submesh
@@ -306,20 +685,14 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
       Ogre::v1::SubMesh *ogreSubMesh;
       Ogre::v1::VertexData *vertexData;
       Ogre::v1::VertexDeclaration* vertexDecl;
-      Ogre::v1::HardwareVertexBufferSharedPtr vBuf;
-      Ogre::v1::HardwareIndexBufferSharedPtr iBuf;
-      float *vertices;
-      uint32_t *indices;
+      Ogre2SubMeshBuffers buffers;
+      buffers.subMesh = s;
 
       size_t currOffset = 0;
 
-      // Copy the original submesh. We may need to modify the vertices, and
-      // we don't want to change the original.
-      common::SubMesh subMesh(*s.get());
-
-      // Recenter the vertices if requested.
-      if (_desc.centerSubMesh)
-        subMesh.Center(math::Vector3d::Zero);
+      // Recentering the vertices, if requested, is done while filling the
+      // buffers, it does not change anything else
+      const common::SubMesh &subMesh = *s.get();
 
       ogreSubMesh = ogreMesh->createSubMesh(subMesh.Name());
       ogreSubMesh->useSharedVertices = false;
@@ -394,59 +767,30 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
       // allocate the vertex buffer
       vertexData->vertexCount = subMesh.VertexCount();
 
-      vBuf = Ogre::v1::HardwareBufferManager::getSingleton().createVertexBuffer(
+      buffers.vertexBuffer =
+          Ogre::v1::HardwareBufferManager::getSingleton().createVertexBuffer(
                  vertexDecl->getVertexSize(0),
                  vertexData->vertexCount,
                  Ogre::v1::HardwareBuffer::HBU_STATIC,
                  true);
 
-      vertexData->vertexBufferBinding->setBinding(0, vBuf);
-      vertices = static_cast<float*>(vBuf->lock(
+      vertexData->vertexBufferBinding->setBinding(0, buffers.vertexBuffer);
+      buffers.vertices = static_cast<float*>(buffers.vertexBuffer->lock(
                       Ogre::v1::HardwareBuffer::HBL_DISCARD));
 
       if (_desc.mesh->HasSkeleton())
       {
-        common::SkeletonPtr skel = _desc.mesh->MeshSkeleton();
         for (unsigned int j = 0; j < subMesh.NodeAssignmentsCount(); j++)
         {
           common::NodeAssignment na = subMesh.NodeAssignmentByIndex(j);
           Ogre::v1::VertexBoneAssignment vba;
           vba.vertexIndex = na.vertexIndex;
-          vba.boneIndex = ogreSkeleton->getBone(skel->NodeByHandle(
-                              na.nodeIndex)->Name())->getHandle();
+          vba.boneIndex = boneHandles[na.nodeIndex];
           vba.weight = na.weight;
           ogreSubMesh->addBoneAssignment(vba);
         }
       }
 
-      // Add all the vertices
-      for (unsigned int j = 0; j < subMesh.VertexCount(); ++j)
-      {
-        *vertices++ = subMesh.Vertex(j).X();
-        *vertices++ = subMesh.Vertex(j).Y();
-        *vertices++ = subMesh.Vertex(j).Z();
-
-        // Add all normals
-        if (subMesh.NormalCount() > 0)
-        {
-          *vertices++ = subMesh.Normal(j).X();
-          *vertices++ = subMesh.Normal(j).Y();
-          *vertices++ = subMesh.Normal(j).Z();
-        }
-
-        // Add all texture coordinate sets
-        for (unsigned int k = 0u; k < subMesh.TexCoordSetCount(); ++k)
-        {
-          if (subMesh.TexCoordCountBySet(k) > 0u)
-          {
-            *vertices++ = subMesh.TexCoordBySet(j, k).X();
-            *vertices++ = subMesh.TexCoordBySet(j, k).Y();
-          }
-        }
-      }
-
-      vBuf->unlock();
-
       // Add all the indices
       // allocate index buffer
       ogreSubMesh->indexData[Ogre::VpNormal]->indexCount = subMesh.IndexCount();
@@ -458,34 +802,24 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
             Ogre::v1::HardwareBuffer::HBU_STATIC,
             true);
 
-      iBuf = ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer;
-      indices = static_cast<uint32_t*>(
-          iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
-
-
-      for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
-        *indices++ = static_cast<uint32_t>(subMesh.Index(j));
+      buffers.indexBuffer = ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer;
+      buffers.indices = static_cast<uint32_t*>(
+          buffers.indexBuffer->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
+      subMeshBuffers.push_back(buffers);
 
-      iBuf->unlock();
-
-      common::MaterialPtr material;
-      material = _desc.mesh->MaterialByIndex(subMesh.MaterialIndex());
-
-      MaterialPtr mat = this->scene->CreateMaterial();
-      if (material)
-      {
-        mat->CopyFrom(*material);
-        this->dataPtr->materialCache.push_back(mat);
-      }
-      else
-      {
-        MaterialPtr defaultMat = this->scene->Material("Default/White");
-        if (defaultMat != nullptr)
-          mat->CopyFrom(defaultMat);
-      }
+      MaterialPtr mat = this->dataPtr->CreateSubMeshMaterial(this->scene,
+          _desc.mesh->MaterialByIndex(subMesh.MaterialIndex()));
       ogreSubMesh->setMaterialName(mat->Name());
     }
 
+    // copy the vertex and index data and release the buffers
+    fillSubMeshBuffers(subMeshBuffers, _desc.centerSubMesh);
+    for (auto &buffers : subMeshBuffers)
+    {
+      buffers.vertexBuffer->unlock();
+      buffers.indexBuffer->unlock();
+    }
+
     math::Vector3d max = _desc.mesh->Max();
     math::Vector3d min = _desc.mesh->Min();
 
@@ -538,6 +872,16 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
   return true;
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<MeshBvh> Ogre2MeshFactory::TriangleBvh(
+    const std::string &_name)
+{
+  auto bvhIt = this->dataPtr->triangleBvhs.find(_name);
+  if (bvhIt == this->dataPtr->triangleBvhs.end())
+    return nullptr;
+  return bvhIt->second;
+}
+
 //////////////////////////////////////////////////
 std::string Ogre2MeshFactory::MeshName(const MeshDescriptor &_desc)
 {
@@ -582,6 +926,14 @@ Ogre2SubMeshStoreFactory::Ogre2SubMeshStoreFactory(Ogre2ScenePtr _scene,
   this->CreateNameList();
 }
 
+//////////////////////////////////////////////////
+Ogre2SubMeshStoreFactory::Ogre2SubMeshStoreFactory(Ogre2ScenePtr _scene,
+    Ogre::Item *_item, const std::vector<MaterialPtr> &_materials) :
+  Ogre2SubMeshStoreFactory(_scene, _item)
+{
+  this->dataPtr->materials = _materials;
+}
+
 //////////////////////////////////////////////////
 Ogre2SubMeshStoreFactory::~Ogre2SubMeshStoreFactory()
 {
@@ -613,17 +965,30 @@ Ogre2SubMeshPtr Ogre2SubMeshStoreFactory::CreateSubMesh(unsigned int _index)
   subMesh->ogreSubItem = this->ogreItem->getSubItem(_index);
 
   MaterialPtr mat;
-  Ogre::HlmsDatablock *ogreDatablock = subMesh->ogreSubItem->getDatablock();
-  if (ogreDatablock)
-  {
-    std::string matName = subMesh->ogreSubItem->getSubMesh()->getMaterialName();
-    mat = this->scene->Material(matName);
-  }
+  if (_index < this->dataPtr->materials.size())
+    mat = this->dataPtr->materials[_index];
 
   if (mat)
   {
-    // assign material to submesh who will make a copy of this material
-    subMesh->SetMaterial(mat);
+    // share the given material instead of copying the default one first
+    subMesh->SetMaterial(mat, false);
+  }
+  else
+  {
+    Ogre::HlmsDatablock *ogreDatablock =
+        subMesh->ogreSubItem->getDatablock();
+    if (ogreDatablock)
+    {
+      std::string matName =
+          subMesh->ogreSubItem->getSubMesh()->getMaterialName();
+      mat = this->scene->Material(matName);
+    }
+
+    if (mat)
+    {
+      // assign material to submesh who will make a copy of this material
+      subMesh->SetMaterial(mat);
+    }
   }
 
   subMesh->Load();
@@ -259,6 +259,7 @@ void Ogre2Node::SetInheritScale(bool _inherit)
     return;
 
   this->ogreNode->setInheritScale(_inherit);
+  this->LocalTransformChanged(true);
 }
 
 //////////////////////////////////////////////////
@@ -15,13 +15,19 @@
  *
  */
 
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
 #include <ignition/common/SubMesh.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Matrix4.hh>
 
+#include "ignition/rendering/Bvh.hh"
 #include "ignition/rendering/ogre2/Ogre2Camera.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
+#include "ignition/rendering/ogre2/Ogre2MeshFactory.hh"
 #include "ignition/rendering/ogre2/Ogre2RayQuery.hh"
 #include "ignition/rendering/ogre2/Ogre2Scene.hh"
 #include "ignition/rendering/ogre2/Ogre2SelectionBuffer.hh"
@@ -95,6 +101,9 @@ RayQueryResult Ogre2RayQuery::ClosestPoint()
 {
   RayQueryResult result;
 
+  if (this->mode == RQM_BVH)
+    return this->ClosestPointsByBvh({this->origin}, {this->direction})[0];
+
 #ifdef __APPLE__
   return this->ClosestPointByIntersection();
 #else
@@ -120,6 +129,89 @@ RayQueryResult Ogre2RayQuery::ClosestPoint()
 #endif
 }
 
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> Ogre2RayQuery::ClosestPoints(
+    const CameraPtr &_camera, const std::vector<math::Vector2d> &_coords)
+{
+  Ogre2CameraPtr camera = std::dynamic_pointer_cast<Ogre2Camera>(_camera);
+  if (this->mode == RQM_BVH && camera)
+  {
+    std::vector<math::Vector3d> origins;
+    std::vector<math::Vector3d> directions;
+    origins.reserve(_coords.size());
+    directions.reserve(_coords.size());
+    for (const auto &coord : _coords)
+    {
+      Ogre::Ray ray = camera->ogreCamera->getCameraToViewportRay(
+          (coord.X() + 1.0) / 2.0, (coord.Y() - 1.0) / -2.0);
+      origins.push_back(Ogre2Conversions::Convert(ray.getOrigin()));
+      directions.push_back(Ogre2Conversions::Convert(ray.getDirection()));
+    }
+    return this->ClosestPointsByBvh(origins, directions);
+  }
+
+#ifdef __APPLE__
+  return BaseRayQuery::ClosestPoints(_camera, _coords);
+#else
+  if (!camera || !camera->Parent() ||
+      std::this_thread::get_id() != this->dataPtr->threadId)
+  {
+    // same fallback as ClosestPoint, one ray at a time
+    return BaseRayQuery::ClosestPoints(_camera, _coords);
+  }
+
+  // see ClosestPoint
+  if (!camera->SelectionBuffer())
+    camera->VisualAt(math::Vector2i(0, 0));
+
+  camera->SelectionBuffer()->SetDimensions(
+      camera->ImageWidth(), camera->ImageHeight());
+
+  // same conversion to image pos as SetFromCamera
+  std::vector<math::Vector2i> pixels;
+  pixels.reserve(_coords.size());
+  for (const auto &coord : _coords)
+  {
+    math::Vector2d screenPos((coord.X() + 1.0) / 2.0,
+        (coord.Y() - 1.0) / -2.0);
+    pixels.emplace_back(
+        static_cast<int>(screenPos.X() * camera->ImageWidth()),
+        static_cast<int>(screenPos.Y() * camera->ImageHeight()));
+  }
+
+  std::vector<RayQueryResult> results(_coords.size());
+  for (auto &result : results)
+    result.distance = -1;
+
+  std::vector<Ogre::Item *> ogreItems;
+  std::vector<math::Vector3d> points;
+  if (!camera->SelectionBuffer()->ExecuteQuery(pixels, ogreItems, points))
+    return results;
+
+  math::Vector3d cameraPos = camera->WorldPosition();
+  double nearClip = camera->NearClipPlane();
+  for (unsigned int i = 0; i < ogreItems.size(); ++i)
+  {
+    Ogre::Item *ogreItem = ogreItems[i];
+    if (!ogreItem)
+      continue;
+
+    auto userAny = ogreItem->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
+
+    double distance = cameraPos.Distance(points[i]) - nearClip;
+    if (!std::isinf(distance))
+    {
+      results[i].distance = distance;
+      results[i].point = points[i];
+      results[i].objectId = Ogre::any_cast<unsigned int>(userAny);
+    }
+  }
+  return results;
+#endif
+}
+
 //////////////////////////////////////////////////
 RayQueryResult Ogre2RayQuery::ClosestPointBySelectionBuffer()
 {
@@ -260,3 +352,108 @@ RayQueryResult Ogre2RayQuery::ClosestPointByIntersection()
 
   return result;
 }
+
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> Ogre2RayQuery::ClosestPointsAlongRays(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions)
+{
+  if (this->mode != RQM_BVH || _origins.size() != _directions.size())
+    return BaseRayQuery::ClosestPointsAlongRays(_origins, _directions);
+
+  return this->ClosestPointsByBvh(_origins, _directions);
+}
+
+//////////////////////////////////////////////////
+std::vector<RayQueryResult> Ogre2RayQuery::ClosestPointsByBvh(
+    const std::vector<math::Vector3d> &_origins,
+    const std::vector<math::Vector3d> &_directions)
+{
+  std::vector<RayQueryResult> results(_origins.size());
+  Ogre2ScenePtr ogreScene =
+      std::dynamic_pointer_cast<Ogre2Scene>(this->Scene());
+  if (!ogreScene || !ogreScene->meshFactory)
+    return results;
+
+  /// \brief Item that rays are tested against
+  struct Candidate
+  {
+    /// \brief Triangles of the item mesh
+    std::shared_ptr<MeshBvh> bvh;
+
+    /// \brief Transform from world to item mesh frame
+    math::Matrix4d worldToLocal;
+
+    /// \brief Id of the visual that owns the item
+    unsigned int objectId;
+  };
+
+  // gather the visible items created by the mesh factory, the scene
+  // hierarchy changes from one call to the next so it is rebuilt every time
+  std::vector<Candidate> candidates;
+  std::vector<math::AxisAlignedBox> boxes;
+  auto itemIt = ogreScene->OgreSceneManager()->getMovableObjectIterator(
+      Ogre::ItemFactory::FACTORY_TYPE_NAME);
+  while (itemIt.hasMoreElements())
+  {
+    Ogre::Item *ogreItem = static_cast<Ogre::Item *>(itemIt.getNext());
+    if (!ogreItem->isAttached() || !ogreItem->getVisible())
+      continue;
+
+    auto userAny = ogreItem->getUserObjectBindings().getUserAny();
+    if (userAny.isEmpty() || userAny.getType() != typeid(unsigned int))
+      continue;
+
+    std::shared_ptr<MeshBvh> bvh =
+        ogreScene->meshFactory->TriangleBvh(ogreItem->getMesh()->getName());
+    if (!bvh || bvh->TriangleCount() == 0u)
+      continue;
+
+    Ogre::Aabb aabb = ogreItem->getWorldAabbUpdated();
+    boxes.push_back(math::AxisAlignedBox(
+        Ogre2Conversions::Convert(aabb.getMinimum()),
+        Ogre2Conversions::Convert(aabb.getMaximum())));
+
+    Candidate candidate;
+    candidate.bvh = bvh;
+    candidate.worldToLocal = Ogre2Conversions::Convert(
+        ogreItem->getParentNode()->_getFullTransformUpdated()).Inverse();
+    candidate.objectId = Ogre::any_cast<unsigned int>(userAny);
+    candidates.push_back(candidate);
+  }
+
+  if (candidates.empty())
+    return results;
+
+  Bvh sceneBvh;
+  sceneBvh.Build(boxes);
+
+  for (unsigned int i = 0; i < _origins.size(); ++i)
+  {
+    const math::Vector3d &origin = _origins[i];
+    const math::Vector3d &dir = _directions[i];
+
+    // the transform is affine so distances along the ray are the same in
+    // the world and mesh frames
+    double distance;
+    unsigned int index;
+    bool hit = sceneBvh.Intersect(origin, dir,
+        [&](unsigned int _candidate, double &_t)
+        {
+          const Candidate &c = candidates[_candidate];
+          math::Vector3d localOrigin = c.worldToLocal * origin;
+          math::Vector3d localDir =
+              c.worldToLocal * (origin + dir) - localOrigin;
+          return c.bvh->Intersect(localOrigin, localDir, _t);
+        }, distance, index);
+
+    if (hit)
+    {
+      results[i].distance = distance;
+      results[i].point = origin + dir * distance;
+      results[i].objectId = candidates[index].objectId;
+    }
+  }
+
+  return results;
+}
@@ -28,20 +28,33 @@
   // pulled in by anybody (e.g., Boost).
   #include <Winsock2.h>
 #endif
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
 
 #include <ignition/plugin/Register.hh>
 
+#include "ignition/rendering/config.hh"
 #include "ignition/rendering/GraphicsAPI.hh"
 #include "ignition/rendering/RenderEngineManager.hh"
+#include "ignition/rendering/detail/Hash.hh"
 #include "ignition/rendering/ogre2/Ogre2Includes.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderTypes.hh"
 #include "ignition/rendering/ogre2/Ogre2Scene.hh"
 #include "ignition/rendering/ogre2/Ogre2Storage.hh"
 
+#include <OgreHlmsDiskCache.h>
+
 #include "Terra/Hlms/OgreHlmsTerra.h"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
 #include "Terra/TerraWorkspaceListener.h"
@@ -68,11 +81,126 @@ class ignition::rendering::Ogre2RenderEnginePrivate
   /// \brief Listener that needs to be in every workspace
   /// that wants terrain to cast shadows from spot and point lights
   public: std::unique_ptr<Ogre::TerraWorkspaceListener> terraWorkspaceListener;
+
+  /// \brief Number of materials using each Ogre texture, by texture name
+  public: std::unordered_map<std::string, unsigned int> textureUseCount;
+
+  /// \brief Directory in which converted meshes are cached, empty if the
+  /// mesh cache is disabled
+  public: std::string meshCachePath;
+
+  /// \brief Directory in which lens distortion maps are cached, empty if
+  /// the distortion map cache is disabled
+  public: std::string distortionCachePath;
+
+  /// \brief Number of heightmap rows uploaded to the GPU each frame, 0 to
+  /// upload heightmaps at once
+  public: unsigned int heightmapUploadRows{0u};
+
+  /// \brief Directory in which generated shaders and compiled shader
+  /// microcode are cached, empty if the shader cache is disabled
+  public: std::string hlmsCachePath;
 };
 
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+/// \brief Get the directory in which the hlms caches of a render system are
+/// stored. Shaders generated and compiled for one library version, GPU or
+/// driver are not valid for another one, so each of them gets its own
+/// directory.
+/// \param[in] _cachePath Hlms cache directory
+/// \param[in] _renderSystem Render system compiling the shaders
+/// \return Path of the cache directory of the render system
+static std::string hlmsCacheDir(const std::string &_cachePath,
+    const Ogre::RenderSystem *_renderSystem)
+{
+  std::string key = std::string(IGNITION_RENDERING_VERSION_FULL) + ";" +
+      std::to_string(OGRE_VERSION) + ";" + _renderSystem->getName();
+  const Ogre::RenderSystemCapabilities *caps =
+      _renderSystem->getCapabilities();
+  if (caps)
+  {
+    key += ";" + Ogre::RenderSystemCapabilities::vendorToString(
+        caps->getVendor());
+    key += ";" + caps->getDeviceName();
+    key += ";" + caps->getDriverVersion().toString();
+  }
+
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << detail::fnv1a(key);
+  return common::joinPaths(_cachePath, ss.str());
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a file of the hlms cache
+/// \param[in] _file Path of the file
+/// \param[in] _load Function loading the cache from the file's data
+/// \return True if the file exists and was loaded
+static bool readHlmsCacheFile(const std::string &_file,
+    const std::function<void(Ogre::DataStreamPtr &)> &_load)
+{
+  if (!common::isFile(_file))
+    return false;
+
+  try
+  {
+    std::ifstream *file = OGRE_NEW_T(std::ifstream,
+        Ogre::MEMCATEGORY_GENERAL)(_file.c_str(), std::ios::binary);
+    Ogre::DataStreamPtr stream(
+        OGRE_NEW Ogre::FileStreamDataStream(_file, file, true));
+    _load(stream);
+  }
+  catch (Ogre::Exception &e)
+  {
+    ignwarn << "Unable to load shader cache [" << _file << "]: "
+            << e.getDescription() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a file of the hlms cache. The data is written to a
+/// temporary file first so that other processes sharing the cache never
+/// read a partially written file. On Windows, where std::rename does not
+/// replace an existing file, the old file is removed first, so another
+/// process may briefly find no file and generate its shaders itself.
+/// \param[in] _file Path of the file
+/// \param[in] _save Function saving the cache to the file's data
+static void writeHlmsCacheFile(const std::string &_file,
+    const std::function<void(Ogre::DataStreamPtr &)> &_save)
+{
+  std::string tmpFile = _file + "." + std::to_string(std::random_device()());
+  try
+  {
+    std::fstream *file = OGRE_NEW_T(std::fstream, Ogre::MEMCATEGORY_GENERAL)(
+        tmpFile.c_str(), std::ios::out | std::ios::binary);
+    Ogre::DataStreamPtr stream(
+        OGRE_NEW Ogre::FileStreamDataStream(tmpFile, file, true));
+    _save(stream);
+    stream->close();
+  }
+  catch (Ogre::Exception &e)
+  {
+    ignwarn << "Unable to write shader cache [" << _file << "]: "
+            << e.getDescription() << std::endl;
+    common::removeFile(tmpFile);
+    return;
+  }
+
+  if (std::rename(tmpFile.c_str(), _file.c_str()) != 0)
+  {
+    // the target exists on platforms where rename does not replace it
+    if (!common::exists(_file) || !common::removeFile(_file) ||
+        std::rename(tmpFile.c_str(), _file.c_str()) != 0)
+    {
+      common::removeFile(tmpFile);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 Ogre2RenderEnginePlugin::Ogre2RenderEnginePlugin()
 {
@@ -131,9 +259,12 @@ void Ogre2RenderEngine::Destroy()
   this->ogreOverlaySystem = nullptr;
 
   this->dataPtr->hlmsPbsTerraShadows.reset();
+  this->dataPtr->textureUseCount.clear();
 
   if (this->ogreRoot)
   {
+    this->SaveHlmsCache();
+
     // Clean up any textures that may still be in flight.
     Ogre::TextureGpuManager *mgr =
     this->ogreRoot->getRenderSystem()->getTextureGpuManager();
@@ -306,6 +437,22 @@ bool Ogre2RenderEngine::LoadImpl(
   if (it != _params.end())
     std::istringstream(it->second) >> this->winID;
 
+  it = _params.find("meshCachePath");
+  if (it != _params.end())
+    this->dataPtr->meshCachePath = it->second;
+
+  it = _params.find("distortionCachePath");
+  if (it != _params.end())
+    this->dataPtr->distortionCachePath = it->second;
+
+  it = _params.find("heightmapUploadRows");
+  if (it != _params.end())
+    std::istringstream(it->second) >> this->dataPtr->heightmapUploadRows;
+
+  it = _params.find("hlmsCachePath");
+  if (it != _params.end())
+    this->dataPtr->hlmsCachePath = it->second;
+
   it = _params.find("metal");
   if (it != _params.end())
   {
@@ -362,6 +509,7 @@ void Ogre2RenderEngine::LoadAttempt()
   this->ogreRoot->initialise(false);
   this->CreateRenderWindow();
   this->CreateResources();
+  this->LoadHlmsCache();
 }
 
 //////////////////////////////////////////////////
@@ -1009,6 +1157,104 @@ void Ogre2RenderEngine::InitAttempt()
   this->scenes = Ogre2SceneStorePtr(new Ogre2SceneStore);
 }
 
+//////////////////////////////////////////////////
+void Ogre2RenderEngine::LoadHlmsCache()
+{
+  if (this->dataPtr->hlmsCachePath.empty() ||
+      !this->ogreRoot->getRenderSystem())
+  {
+    return;
+  }
+
+  std::string dir = hlmsCacheDir(this->dataPtr->hlmsCachePath,
+      this->ogreRoot->getRenderSystem());
+
+  // compiled microcode is only reused if the render system supports it
+  Ogre::GpuProgramManager &gpuProgramManager =
+      Ogre::GpuProgramManager::getSingleton();
+  gpuProgramManager.setSaveMicrocodesToCache(true);
+  readHlmsCacheFile(common::joinPaths(dir, "microcode.cache"),
+      [&](Ogre::DataStreamPtr &_stream)
+      {
+        gpuProgramManager.loadMicrocodeCache(_stream);
+      });
+
+  // generating the cached shaders and their PSOs now means materials do
+  // not stall the first frame they are rendered in
+  Ogre::HlmsManager *hlmsManager = this->ogreRoot->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  unsigned int loaded = 0u;
+  for (unsigned int i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    std::string file =
+        common::joinPaths(dir, "hlms" + std::to_string(i) + ".cache");
+    if (readHlmsCacheFile(file, [&](Ogre::DataStreamPtr &_stream)
+        {
+          diskCache.loadFrom(_stream);
+          diskCache.applyTo(hlms);
+        }))
+    {
+      ++loaded;
+    }
+  }
+
+  if (loaded > 0u)
+    igndbg << "Loaded shader cache from [" << dir << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+void Ogre2RenderEngine::SaveHlmsCache()
+{
+  if (this->dataPtr->hlmsCachePath.empty() ||
+      !this->ogreRoot->getRenderSystem() ||
+      !Ogre::GpuProgramManager::getSingletonPtr())
+  {
+    return;
+  }
+
+  std::string dir = hlmsCacheDir(this->dataPtr->hlmsCachePath,
+      this->ogreRoot->getRenderSystem());
+  if (!common::exists(dir) && !common::createDirectories(dir))
+  {
+    ignwarn << "Unable to create shader cache directory [" << dir << "]"
+            << std::endl;
+    return;
+  }
+
+  Ogre::HlmsManager *hlmsManager = this->ogreRoot->getHlmsManager();
+  Ogre::HlmsDiskCache diskCache(hlmsManager);
+  for (unsigned int i = Ogre::HLMS_LOW_LEVEL + 1u; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    diskCache.copyFrom(hlms);
+    writeHlmsCacheFile(
+        common::joinPaths(dir, "hlms" + std::to_string(i) + ".cache"),
+        [&](Ogre::DataStreamPtr &_stream)
+        {
+          diskCache.saveTo(_stream);
+        });
+  }
+
+  // only rewrite the microcode cache if new shaders were compiled
+  Ogre::GpuProgramManager &gpuProgramManager =
+      Ogre::GpuProgramManager::getSingleton();
+  if (gpuProgramManager.isCacheDirty())
+  {
+    writeHlmsCacheFile(common::joinPaths(dir, "microcode.cache"),
+        [&](Ogre::DataStreamPtr &_stream)
+        {
+          gpuProgramManager.saveMicrocodeCache(_stream);
+        });
+  }
+}
+
 /////////////////////////////////////////////////
 std::vector<unsigned int> Ogre2RenderEngine::FSAALevels() const
 {
@@ -1040,6 +1286,52 @@ Ogre::CompositorWorkspaceListener *Ogre2RenderEngine::TerraWorkspaceListener()
   return this->dataPtr->terraWorkspaceListener.get();
 }
 
+/////////////////////////////////////////////////
+void Ogre2RenderEngine::AcquireTexture(const std::string &_name)
+{
+  if (!_name.empty())
+    ++this->dataPtr->textureUseCount[_name];
+}
+
+/////////////////////////////////////////////////
+unsigned int Ogre2RenderEngine::ReleaseTexture(const std::string &_name)
+{
+  auto it = this->dataPtr->textureUseCount.find(_name);
+  if (it == this->dataPtr->textureUseCount.end())
+    return 0u;
+
+  if (--it->second > 0u)
+    return it->second;
+
+  this->dataPtr->textureUseCount.erase(it);
+  return 0u;
+}
+
+/////////////////////////////////////////////////
+unsigned int Ogre2RenderEngine::TextureUseCount(const std::string &_name) const
+{
+  auto it = this->dataPtr->textureUseCount.find(_name);
+  return it == this->dataPtr->textureUseCount.end() ? 0u : it->second;
+}
+
+/////////////////////////////////////////////////
+std::string Ogre2RenderEngine::MeshCachePath() const
+{
+  return this->dataPtr->meshCachePath;
+}
+
+/////////////////////////////////////////////////
+std::string Ogre2RenderEngine::DistortionCachePath() const
+{
+  return this->dataPtr->distortionCachePath;
+}
+
+/////////////////////////////////////////////////
+unsigned int Ogre2RenderEngine::HeightmapUploadRows() const
+{
+  return this->dataPtr->heightmapUploadRows;
+}
+
 // Register this plugin
 IGNITION_ADD_PLUGIN(ignition::rendering::Ogre2RenderEnginePlugin,
                     ignition::rendering::RenderEnginePlugin)
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/Scene.hh"
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <OgreGpuProgramManager.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+using namespace ignition;
+using namespace rendering;
+
+class Ogre2RenderEngineTest : public testing::Test
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Render a box in front of a camera
+/// \param[in] _engine Render engine
+/// \return True if the box was rendered
+static bool renderBox(RenderEngine *_engine)
+{
+  ScenePtr scene = _engine->CreateScene("scene");
+  if (!scene)
+    return false;
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  camera->SetImageWidth(50);
+  camera->SetImageHeight(50);
+  root->AddChild(camera);
+
+  DirectionalLightPtr light = scene->CreateDirectionalLight();
+  light->SetDirection(1.0, 0.0, -1.0);
+  root->AddChild(light);
+
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(3.0, 0.0, 0.0);
+  root->AddChild(box);
+
+  camera->Update();
+  _engine->DestroyScene(scene);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2RenderEngineTest, HlmsCacheLoaded)
+{
+  std::string cachePath = common::joinPaths(std::string(PROJECT_BUILD_PATH),
+      "test", "ogre2_hlms_cache");
+  common::removeAll(cachePath);
+
+  std::map<std::string, std::string> params;
+  params["hlmsCachePath"] = cachePath;
+
+  // first run compiles the shaders and saves them when unloaded
+  RenderEngine *engine = rendering::engine("ogre2", params);
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+  ASSERT_TRUE(renderBox(engine));
+  bool compiledMicrocode =
+      Ogre::GpuProgramManager::getSingleton().isCacheDirty();
+  rendering::unloadEngine(engine->Name());
+
+  if (!compiledMicrocode)
+  {
+    igndbg << "Render system does not cache shader microcode" << std::endl;
+    common::removeAll(cachePath);
+    return;
+  }
+
+  // second run finds every shader it needs in the loaded cache, so
+  // rendering the same scene compiles nothing new
+  engine = rendering::engine("ogre2", params);
+  ASSERT_NE(nullptr, engine);
+  ASSERT_TRUE(renderBox(engine));
+  EXPECT_FALSE(Ogre::GpuProgramManager::getSingleton().isCacheDirty());
+  rendering::unloadEngine(engine->Name());
+
+  // Clean up
+  common::removeAll(cachePath);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
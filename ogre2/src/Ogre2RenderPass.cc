@@ -19,6 +19,14 @@
 /// \brief Private data for the Ogre2RenderPass class
 class ignition::rendering::Ogre2RenderPassPrivate
 {
+  /// \brief Ogre camera the render pass is applied to
+  public: Ogre::Camera *ogreCamera = nullptr;
+
+  /// \brief Width of the image the render pass is applied to
+  public: unsigned int imageWidth = 0u;
+
+  /// \brief Height of the image the render pass is applied to
+  public: unsigned int imageHeight = 0u;
 };
 
 using namespace ignition;
@@ -46,6 +54,33 @@ void Ogre2RenderPass::CreateRenderPass()
   // To be overriden by derived render pass classes
 }
 
+//////////////////////////////////////////////////
+void Ogre2RenderPass::SetCamera(Ogre::Camera *_camera, unsigned int _width,
+    unsigned int _height)
+{
+  this->dataPtr->ogreCamera = _camera;
+  this->dataPtr->imageWidth = _width;
+  this->dataPtr->imageHeight = _height;
+}
+
+//////////////////////////////////////////////////
+Ogre::Camera *Ogre2RenderPass::OgreCamera() const
+{
+  return this->dataPtr->ogreCamera;
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2RenderPass::ImageWidth() const
+{
+  return this->dataPtr->imageWidth;
+}
+
+//////////////////////////////////////////////////
+unsigned int Ogre2RenderPass::ImageHeight() const
+{
+  return this->dataPtr->imageHeight;
+}
+
 //////////////////////////////////////////////////
 std::string Ogre2RenderPass::OgreCompositorNodeDefinitionName() const
 {
@@ -89,9 +89,6 @@ class ignition::rendering::Ogre2RenderTargetPrivate
   /// \brief Name of final rendering compositor node
   public: const std::string kFinalNodeName = "FinalComposition";
 
-  /// \brief Name of shadow compositor node
-  public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
-
   /// \brief Pointer to the internal ogre render texture objects
   /// There's two because we ping pong postprocessing effects
   /// and the final result is always in ogreTexture[1]
@@ -194,7 +191,7 @@ void Ogre2RenderTarget::BuildCompositor()
         Ogre::CompositorPassSceneDef *passScene =
             static_cast<Ogre::CompositorPassSceneDef *>(
             rt0TargetDef->addPass(Ogre::PASS_SCENE));
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mIncludeOverlays = false;
         passScene->mFirstRQ = 0u;
         passScene->mLastRQ = 2u;
@@ -230,7 +227,7 @@ void Ogre2RenderTarget::BuildCompositor()
             static_cast<Ogre::CompositorPassSceneDef *>(
             rt0TargetDef->addPass(Ogre::PASS_SCENE));
         passScene->mIncludeOverlays = true;
-        passScene->mShadowNode = this->dataPtr->kShadowNodeName;
+        passScene->mShadowNode = this->scene->ShadowNodeName();
         passScene->mFirstRQ = 2u;
       }
     }
@@ -661,6 +658,17 @@ void Ogre2RenderTarget::UpdateBackgroundMaterial()
 //////////////////////////////////////////////////
 void Ogre2RenderTarget::UpdateRenderPassChain()
 {
+  for (const auto &pass : this->renderPasses)
+  {
+    Ogre2RenderPass *ogre2RenderPass =
+        dynamic_cast<Ogre2RenderPass *>(pass.get());
+    if (ogre2RenderPass)
+    {
+      ogre2RenderPass->SetCamera(this->ogreCamera, this->width,
+          this->height);
+    }
+  }
+
   UpdateRenderPassChain(this->ogreCompositorWorkspace,
       this->ogreCompositorWorkspaceDefName,
       this->ogreCompositorWorkspaceDefName + "/" +
@@ -15,6 +15,9 @@
  *
  */
 
+#include <set>
+#include <unordered_set>
+
 #include <ignition/common/Console.hh>
 
 #include "ignition/rendering/RenderTypes.hh"
@@ -57,17 +60,19 @@
 #include <Compositor/Pass/PassClear/OgreCompositorPassClearDef.h>
 #include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
 #include <Compositor/Pass/PassScene/OgreCompositorPassSceneDef.h>
+#include <Hlms/Pbs/OgreHlmsPbsDatablock.h>
+#include <Hlms/Unlit/OgreHlmsUnlitDatablock.h>
 #include <OgreDepthBuffer.h>
+#include <OgreHlms.h>
+#include <OgreHlmsManager.h>
 #include <OgreRoot.h>
 #include <OgreSceneManager.h>
+#include <OgreTextureGpuManager.h>
 #include <Overlay/OgreOverlayManager.h>
 #include <Overlay/OgreOverlaySystem.h>
-#if OGRE_VERSION_MAJOR == 2 && OGRE_VERSION_MINOR == 1
-#include <OgreHlms.h>
-#include <OgreHlmsManager.h>
-#endif
 
 #include "Terra/Terra.h"
+#include "Terra/Hlms/OgreHlmsTerraDatablock.h"
 #include "Terra/Hlms/PbsListener/OgreHlmsPbsTerraShadows.h"
 #ifdef _MSC_VER
   #pragma warning(pop)
@@ -116,13 +121,65 @@ class ignition::rendering::Ogre2ScenePrivate
   /// \brief Flag to indicate if we should flush GPU very often (per camera)
   public: uint8_t cameraPassCountPerGpuFlush = 0u;
 
-  /// \brief Name of shadow compositor node
+  /// \brief True while rendering a batch of sensors in RenderSensors.
+  /// GPU commands are only flushed when cameraPassCountPerGpuFlush passes
+  /// are queued, and the frame is not ended until all sensors in the batch
+  /// have been rendered.
+  public: bool renderingSensorBatch = false;
+
+  /// \brief Ids of the visuals whose user data or geometries changed, see
+  /// MarkVisualDataChanged
+  public: std::vector<unsigned int> changedVisuals;
+
+  /// \brief Position of the first entry of changedVisuals in the log of
+  /// changed visuals
+  public: uint64_t changedVisualsStart = 0u;
+
+  /// \brief Maximum number of entries kept in changedVisuals
+  public: const size_t kMaxChangedVisuals = 4096u;
+
+  /// \brief Number of frames ended so far, see EndFrame
+  public: uint64_t frameCount = 0u;
+
+  /// \brief Prefix of the names of shadow compositor node definitions
   public: const std::string kShadowNodeName = "PbsMaterialsShadowNode";
+
+  /// \brief Name of the shadow compositor node definition used by the
+  /// cameras of this scene
+  public: std::string shadowNodeName;
+
+  /// \brief Names of the textures to unload if no datablock uses them, see
+  /// QueueTextureUnload
+  public: std::set<std::string> texturesToUnload;
 };
 
 using namespace ignition;
 using namespace rendering;
 
+//////////////////////////////////////////////////
+/// \brief Add the textures used by a datablock to a set
+/// \param[in] _datablock Datablock to look at
+/// \param[in] _texUnitCount Number of texture units of the datablock type
+/// \param[in,out] _textures Set the textures are added to
+/// \return True if _datablock is of type D
+template <typename D>
+static bool datablockTextures(Ogre::HlmsDatablock *_datablock,
+    size_t _texUnitCount, std::unordered_set<Ogre::TextureGpu *> &_textures)
+{
+  D *datablock = dynamic_cast<D *>(_datablock);
+  if (!datablock)
+    return false;
+
+  for (size_t texUnit = 0; texUnit < _texUnitCount; ++texUnit)
+  {
+    Ogre::TextureGpu *texture =
+        datablock->getTexture(static_cast<Ogre::uint8>(texUnit));
+    if (texture)
+      _textures.insert(texture);
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 Ogre2Scene::Ogre2Scene(unsigned int _id, const std::string &_name) :
   BaseScene(_id, _name), dataPtr(std::make_unique<Ogre2ScenePrivate>())
@@ -209,21 +266,10 @@ void Ogre2Scene::PreRender()
              "See Scene::SetCameraPassCountPerGpuFlush for details");
   this->dataPtr->frameUpdateStarted = true;
 
-  if (this->ShadowsDirty())
-  {
-    // notify all render targets
-    for (unsigned int i  = 0; i < this->SensorCount(); ++i)
-    {
-      auto camera = std::dynamic_pointer_cast<Camera>(
-          this->SensorByIndex(i));
-      if (camera)
-      {
-         camera->SetShadowsDirty();
-      }
-    }
+  this->UnloadQueuedTextures();
 
+  if (this->ShadowsDirty())
     this->UpdateShadowNode();
-  }
 
   BaseScene::PreRender();
 
@@ -290,6 +336,39 @@ void Ogre2Scene::PostRender()
   }
 }
 
+//////////////////////////////////////////////////
+void Ogre2Scene::RenderSensors(const std::vector<CameraPtr> &_cameras)
+{
+  // legacy mode has to flush and end the frame after every camera
+  if (this->LegacyAutoGpuFlush())
+  {
+    BaseScene::RenderSensors(_cameras);
+    return;
+  }
+
+  this->PreRender();
+
+  // schedule the workspaces of all sensors, only flushing in between when
+  // the cap on queued camera passes is reached
+  this->dataPtr->renderingSensorBatch = true;
+  for (auto &camera : _cameras)
+    camera->Render();
+  this->dataPtr->renderingSensorBatch = false;
+
+  // submit the work of the whole batch to the gpu at once so the readbacks
+  // below wait for the gpu at most once
+  if (this->dataPtr->currNumCameraPasses > 0u)
+  {
+    this->dataPtr->currNumCameraPasses = 0u;
+    this->FlushGpuCommandsOnly();
+  }
+
+  for (auto &camera : _cameras)
+    camera->PostRender();
+
+  this->PostRender();
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::StartForcedRender()
 {
@@ -366,6 +445,20 @@ void Ogre2Scene::FlushGpuCommandsAndStartNewFrame(uint8_t _numPasses,
 {
   this->dataPtr->currNumCameraPasses += _numPasses;
 
+  // RenderSensors flushes the rest of the batch and ends the frame once all
+  // sensors are rendered. In between only flush when the passes queued
+  // reach the cap, so the gpu work and staging memory held stay bounded.
+  if (this->dataPtr->renderingSensorBatch && !_startNewFrame)
+  {
+    if (this->dataPtr->currNumCameraPasses >=
+        this->dataPtr->cameraPassCountPerGpuFlush)
+    {
+      this->dataPtr->currNumCameraPasses = 0u;
+      this->FlushGpuCommandsOnly();
+    }
+    return;
+  }
+
   if (this->dataPtr->currNumCameraPasses >= dataPtr->cameraPassCountPerGpuFlush
       || _startNewFrame)
   {
@@ -441,6 +534,7 @@ void Ogre2Scene::EndFrame()
   }
 
   ogreRoot->_fireFrameEnded(evt);
+  ++this->dataPtr->frameCount;
 }
 
 //////////////////////////////////////////////////
@@ -467,6 +561,8 @@ void Ogre2Scene::Clear()
   this->meshFactory->Clear();
 
   BaseScene::Clear();
+
+  this->UnloadQueuedTextures();
 }
 
 //////////////////////////////////////////////////
@@ -482,6 +578,8 @@ void Ogre2Scene::Destroy()
 
   BaseScene::Destroy();
 
+  this->UnloadQueuedTextures();
+
   if (this->ogreSceneManager)
   {
     this->ogreSceneManager->removeRenderQueueListener(
@@ -542,6 +640,13 @@ void Ogre2Scene::UpdateAllHeightmaps(Ogre::Camera *_camera)
       heightmap->UpdateForRender(_camera);
       Ogre::Terra *terra = heightmap->Terra();
 
+      // Terra can't provide shadows until its heightmap is fully uploaded
+      if (!terra->isHeightMapLoaded())
+      {
+        ++itor;
+        continue;
+      }
+
       const Ogre::Vector2 origin2d = terra->getTerrainOrigin().xy() +
                                      terra->getXZDimensions() * 0.5f;
       const Ogre::Vector2 end2d = origin2d + terra->getXZDimensions();
@@ -641,6 +746,27 @@ void Ogre2Scene::UpdateShadowNode()
             << spotPointLightCount << " point / spot lights" << std::endl;
   }
 
+  // Shadow maps are reserved for a power of two number of point / spot
+  // lights. Ogre skips the shadow maps that have no light, so lights can be
+  // added, removed or stop casting shadows without changing the shadow node
+  // until a power of two is crossed. Shadow node definitions are kept and
+  // reused, so the cameras only rebuild their compositors when the number of
+  // shadow maps changes.
+  unsigned int spotPointShadowMapCount = spotPointLightCount > 0u ? 1u : 0u;
+  while (spotPointShadowMapCount < spotPointLightCount)
+    spotPointShadowMapCount <<= 1u;
+  spotPointShadowMapCount = std::min(spotPointShadowMapCount,
+      maxShadowMaps - dirLightCount * 3);
+
+  std::string shadowNodeDefName = this->dataPtr->kShadowNodeName + "_" +
+      std::to_string(dirLightCount) + "_" +
+      std::to_string(spotPointShadowMapCount);
+  if (shadowNodeDefName == this->dataPtr->shadowNodeName)
+  {
+    this->SetShadowsDirty(false);
+    return;
+  }
+
   auto engine = Ogre2RenderEngine::Instance();
   Ogre::CompositorManager2 *compositorManager =
       engine->OgreRoot()->getCompositorManager2();
@@ -682,7 +808,7 @@ void Ogre2Scene::UpdateShadowNode()
   unsigned int rowSize = maxTexSize / texSize;
   unsigned int colSize = rowSize;
 
-  for (unsigned int i = 0; i < spotPointLightCount; ++i)
+  for (unsigned int i = 0; i < spotPointShadowMapCount; ++i)
   {
     shadowParam.technique = Ogre::SHADOWMAP_FOCUSED;
     shadowParam.atlasId = atlasId;
@@ -712,16 +838,34 @@ void Ogre2Scene::UpdateShadowNode()
     }
   }
 
-  std::string shadowNodeDefName = this->dataPtr->kShadowNodeName;
-  if (compositorManager->hasShadowNodeDefinition(shadowNodeDefName))
-    compositorManager->removeShadowNodeDefinition(shadowNodeDefName);
+  // definitions are shared by all scenes with the same number of shadow maps
+  if (!compositorManager->hasShadowNodeDefinition(shadowNodeDefName))
+  {
+    this->CreateShadowNodeWithSettings(compositorManager, shadowNodeDefName,
+        shadowParams);
+  }
+  this->dataPtr->shadowNodeName = shadowNodeDefName;
 
-  this->CreateShadowNodeWithSettings(compositorManager, shadowNodeDefName,
-      shadowParams);
+  // notify all render targets
+  for (unsigned int i  = 0; i < this->SensorCount(); ++i)
+  {
+    auto camera = std::dynamic_pointer_cast<Camera>(
+        this->SensorByIndex(i));
+    if (camera)
+    {
+       camera->SetShadowsDirty();
+    }
+  }
 
   this->SetShadowsDirty(false);
 }
 
+//////////////////////////////////////////////////
+const std::string &Ogre2Scene::ShadowNodeName() const
+{
+  return this->dataPtr->shadowNodeName;
+}
+
 ////////////////////////////////////////////////////
 void Ogre2Scene::CreateShadowNodeWithSettings(
     Ogre::CompositorManager2 *_compositorManager,
@@ -1230,6 +1374,33 @@ MeshPtr Ogre2Scene::CreateMeshImpl(unsigned int _id,
   return (result) ? mesh : nullptr;
 }
 
+//////////////////////////////////////////////////
+MeshPtr Ogre2Scene::CreateMeshInstanceImpl(unsigned int _id,
+    const std::string &_name, MeshPtr _mesh)
+{
+  // assign the materials to the submeshes as they are created, so they do
+  // not get copies of the default materials that are replaced right away
+  std::vector<MaterialPtr> materials;
+  for (unsigned int i = 0; i < _mesh->SubMeshCount(); ++i)
+  {
+    materials.push_back(_mesh->Material() ? _mesh->Material() :
+        _mesh->SubMeshByIndex(i)->Material());
+  }
+
+  Ogre2MeshPtr mesh = this->meshFactory->Create(_mesh->Descriptor(),
+      materials);
+  if (nullptr == mesh)
+    return nullptr;
+  mesh->SetDescriptor(_mesh->Descriptor());
+
+  if (!this->InitObject(mesh, _id, _name))
+    return nullptr;
+
+  if (_mesh->Material())
+    mesh->SetMaterial(_mesh->Material(), false);
+  return mesh;
+}
+
 //////////////////////////////////////////////////
 CapsulePtr Ogre2Scene::CreateCapsuleImpl(unsigned int _id,
     const std::string &_name)
@@ -1448,6 +1619,100 @@ bool Ogre2Scene::ShadowsDirty() const
   return this->dataPtr->shadowsDirty;
 }
 
+//////////////////////////////////////////////////
+void Ogre2Scene::MarkVisualDataChanged(unsigned int _id)
+{
+  auto &changed = this->dataPtr->changedVisuals;
+
+  // drop the log when it gets too long, readers that did not catch up
+  // then update all visuals
+  if (changed.size() >= this->dataPtr->kMaxChangedVisuals)
+  {
+    this->dataPtr->changedVisualsStart += changed.size();
+    changed.clear();
+  }
+  changed.push_back(_id);
+}
+
+//////////////////////////////////////////////////
+bool Ogre2Scene::ChangedVisuals(uint64_t &_version,
+    std::vector<unsigned int> &_ids) const
+{
+  const auto &changed = this->dataPtr->changedVisuals;
+  uint64_t start = this->dataPtr->changedVisualsStart;
+  uint64_t end = start + changed.size();
+
+  bool complete = _version >= start;
+  if (complete && _version < end)
+  {
+    _ids.insert(_ids.end(),
+        changed.begin() + static_cast<std::ptrdiff_t>(_version - start),
+        changed.end());
+  }
+  _version = end;
+  return complete;
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::QueueTextureUnload(const std::string &_name)
+{
+  this->dataPtr->texturesToUnload.insert(_name);
+}
+
+//////////////////////////////////////////////////
+void Ogre2Scene::UnloadQueuedTextures()
+{
+  if (this->dataPtr->texturesToUnload.empty())
+    return;
+
+  std::set<std::string> names;
+  std::swap(names, this->dataPtr->texturesToUnload);
+
+  // collect the textures used by all datablocks once for the whole batch
+  Ogre::Root *root = Ogre2RenderEngine::Instance()->OgreRoot();
+  Ogre::HlmsManager *hlmsManager = root->getHlmsManager();
+  std::unordered_set<Ogre::TextureGpu *> usedTextures;
+  for (size_t i = Ogre::HLMS_PBS; i < Ogre::HLMS_MAX; ++i)
+  {
+    Ogre::Hlms *hlms = hlmsManager->getHlms(static_cast<Ogre::HlmsTypes>(i));
+    if (!hlms)
+      continue;
+
+    for (const auto &it : hlms->getDatablockMap())
+    {
+      Ogre::HlmsDatablock *datablock = it.second.datablock;
+      if (!datablockTextures<Ogre::HlmsPbsDatablock>(datablock,
+              Ogre::NUM_PBSM_TEXTURE_TYPES, usedTextures) &&
+          !datablockTextures<Ogre::HlmsUnlitDatablock>(datablock,
+              Ogre::NUM_UNLIT_TEXTURE_TYPES, usedTextures))
+      {
+        datablockTextures<Ogre::HlmsTerraDatablock>(datablock,
+            Ogre::NUM_TERRA_TEXTURE_TYPES, usedTextures);
+      }
+    }
+  }
+
+  Ogre::TextureGpuManager *textureManager =
+      root->getRenderSystem()->getTextureGpuManager();
+  Ogre2RenderEngine *engine = Ogre2RenderEngine::Instance();
+  for (const auto &name : names)
+  {
+    // the texture may have been used by a new material in the meantime
+    if (engine->TextureUseCount(name) > 0u)
+      continue;
+
+    Ogre::TextureGpu *texture = textureManager->findTextureNoThrow(name);
+    if (texture && usedTextures.find(texture) == usedTextures.end())
+      textureManager->destroyTexture(texture);
+  }
+}
+
+//////////////////////////////////////////////////
+uint64_t Ogre2Scene::FrameCount() const
+{
+  return this->dataPtr->frameCount;
+}
+
 //////////////////////////////////////////////////
 void Ogre2Scene::SetSkyEnabled(bool _enabled)
 {
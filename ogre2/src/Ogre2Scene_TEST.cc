@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
+#include "ignition/rendering/ogre2/Ogre2Scene.hh"
+#include "ignition/rendering/ogre2/Ogre2Visual.hh"
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <Compositor/OgreCompositorManager2.h>
+#include <OgreRoot.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+using namespace ignition;
+using namespace rendering;
+
+class Ogre2SceneTest : public testing::Test
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2SceneTest, ChangedVisuals)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  Ogre2ScenePtr scene =
+      std::dynamic_pointer_cast<Ogre2Scene>(engine->CreateScene("scene"));
+  ASSERT_NE(nullptr, scene);
+
+  // catch up with the visuals created with the scene
+  uint64_t version = 0u;
+  std::vector<unsigned int> ids;
+  EXPECT_TRUE(scene->ChangedVisuals(version, ids));
+  ids.clear();
+
+  // nothing changed
+  EXPECT_TRUE(scene->ChangedVisuals(version, ids));
+  EXPECT_TRUE(ids.empty());
+
+  // user data and geometry changes are logged
+  VisualPtr visual1 = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual1);
+  VisualPtr visual2 = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual2);
+  visual1->SetUserData("temperature", 300.0f);
+  visual2->AddGeometry(scene->CreateBox());
+  EXPECT_TRUE(scene->ChangedVisuals(version, ids));
+  ASSERT_EQ(2u, ids.size());
+  EXPECT_EQ(visual1->Id(), ids[0]);
+  EXPECT_EQ(visual2->Id(), ids[1]);
+
+  // a reader that is up to date only sees the new changes
+  uint64_t oldVersion = version;
+  ids.clear();
+  visual1->SetUserData("temperature", 310.0f);
+  EXPECT_TRUE(scene->ChangedVisuals(version, ids));
+  ASSERT_EQ(1u, ids.size());
+  EXPECT_EQ(visual1->Id(), ids[0]);
+
+  // a reader that fell too far behind must update all visuals
+  for (unsigned int i = 0; i < 10000u; ++i)
+    visual2->SetUserData("temperature", static_cast<float>(i));
+  ids.clear();
+  EXPECT_FALSE(scene->ChangedVisuals(oldVersion, ids));
+  EXPECT_TRUE(scene->ChangedVisuals(oldVersion, ids));
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Ogre2SceneTest, ShadowNodeReuse)
+{
+  RenderEngine *engine = rendering::engine("ogre2");
+  if (!engine)
+  {
+    igndbg << "Engine 'ogre2' is not supported" << std::endl;
+    return;
+  }
+
+  Ogre2ScenePtr scene =
+      std::dynamic_pointer_cast<Ogre2Scene>(engine->CreateScene("scene"));
+  ASSERT_NE(nullptr, scene);
+  Ogre::CompositorManager2 *compositorManager =
+      Ogre2RenderEngine::Instance()->OgreRoot()->getCompositorManager2();
+
+  // render a frame so the shadow node is updated for the current lights
+  auto update = [&scene]()
+  {
+    scene->PreRender();
+    scene->PostRender();
+    return scene->ShadowNodeName();
+  };
+
+  std::vector<LightPtr> lights;
+  auto addLight = [&scene, &lights]()
+  {
+    PointLightPtr light = scene->CreatePointLight();
+    light->SetCastShadows(true);
+    lights.push_back(light);
+  };
+
+  // shadow maps are reserved for 1, 2 and then 4 point lights
+  addLight();
+  std::string oneLight = update();
+  EXPECT_NE(std::string::npos, oneLight.find("_0_1"));
+
+  addLight();
+  std::string twoLights = update();
+  EXPECT_NE(oneLight, twoLights);
+  EXPECT_NE(std::string::npos, twoLights.find("_0_2"));
+  const Ogre::CompositorShadowNodeDef *twoLightsDef =
+      compositorManager->getShadowNodeDefinition(twoLights);
+  ASSERT_NE(nullptr, twoLightsDef);
+
+  addLight();
+  std::string fourLights = update();
+  EXPECT_NE(twoLights, fourLights);
+  EXPECT_NE(std::string::npos, fourLights.find("_0_4"));
+
+  // no power of two is crossed, the shadow node is unchanged
+  addLight();
+  EXPECT_EQ(fourLights, update());
+  scene->DestroyLight(lights.back());
+  lights.pop_back();
+  EXPECT_EQ(fourLights, update());
+
+  // going back to two lights reuses the earlier definition
+  scene->DestroyLight(lights.back());
+  lights.pop_back();
+  EXPECT_EQ(twoLights, update());
+  EXPECT_EQ(twoLightsDef,
+      compositorManager->getShadowNodeDefinition(twoLights));
+
+  // a light that stops casting shadows frees its shadow map
+  lights.back()->SetCastShadows(false);
+  EXPECT_EQ(oneLight, update());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
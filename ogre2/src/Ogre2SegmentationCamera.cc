@@ -16,6 +16,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/math/Color.hh>
@@ -29,6 +30,7 @@
 #include "ignition/rendering/ogre2/Ogre2RenderEngine.hh"
 #include "ignition/rendering/ogre2/Ogre2Scene.hh"
 #include "ignition/rendering/ogre2/Ogre2SegmentationCamera.hh"
+#include "ignition/rendering/PixelCopy.hh"
 #include "ignition/rendering/RenderTypes.hh"
 #include "ignition/rendering/Utils.hh"
 
@@ -65,6 +67,16 @@ class ignition::rendering::Ogre2SegmentationCameraPrivate
     unsigned int _width, unsigned int _height, unsigned int _channels,
     const std::string &_format)> newSegmentationFrame;
 
+  /// \brief buffer to store the label ids sent to label id listeners
+  public: std::vector<uint32_t> labelIdBuffer;
+
+  /// \brief New label ID Frame Event to notify listeners with new data
+  /// \param[in] _data Label id buffer data
+  /// \param[in] _width Width of the image
+  /// \param[in] _height Height of the image
+  public: ignition::common::EventT<void(const uint32_t *_data,
+    unsigned int _width, unsigned int _height)> newLabelIdFrame;
+
   /// \brief Material Switcher to switch item's material
   /// with colored version for segmentation
   public: std::unique_ptr<Ogre2SegmentationMaterialSwitcher>
@@ -250,7 +262,8 @@ void Ogre2SegmentationCamera::CreateSegmentationTexture()
 void Ogre2SegmentationCamera::PostRender()
 {
   // return if no one is listening to the new frame
-  if (this->dataPtr->newSegmentationFrame.ConnectionCount() == 0)
+  if (this->dataPtr->newSegmentationFrame.ConnectionCount() == 0 &&
+      this->dataPtr->newLabelIdFrame.ConnectionCount() == 0)
     return;
 
   const auto width = this->ImageWidth();
@@ -271,24 +284,17 @@ void Ogre2SegmentationCamera::PostRender()
     this->dataPtr->buffer = new uint8_t[bufferSize];
   }
 
-  uint8_t *bufferTmp = static_cast<uint8_t*>(box.data);
+  const uint8_t *bufferTmp = static_cast<const uint8_t *>(box.data);
 
-  auto rawChannelCount = 4u;
+  // remove the row padding and the alpha channel of the RGBA8 texture
+  copyRgba8ToRgb8(bufferTmp, box.bytesPerRow, this->dataPtr->buffer,
+      width, height);
 
-  for (unsigned int row = 0; row < height; ++row)
+  if (this->dataPtr->newLabelIdFrame.ConnectionCount() > 0)
   {
-    unsigned int rawDataRowIdx = row * box.bytesPerRow / bytesPerChannel;
-    for (unsigned int column = 0; column < width; ++column)
-    {
-      unsigned int idx = (row * width * channelCount) +
-          column * channelCount;
-      unsigned int rawIdx = rawDataRowIdx +
-          column * rawChannelCount;
-
-      this->dataPtr->buffer[idx] = bufferTmp[rawIdx];
-      this->dataPtr->buffer[idx + 1] = bufferTmp[rawIdx + 1];
-      this->dataPtr->buffer[idx + 2] = bufferTmp[rawIdx + 2];
-    }
+    this->LabelIdsFromTexture(bufferTmp, box.bytesPerRow);
+    this->dataPtr->newLabelIdFrame(
+        this->dataPtr->labelIdBuffer.data(), width, height);
   }
 
   this->dataPtr->newSegmentationFrame(
@@ -297,6 +303,55 @@ void Ogre2SegmentationCamera::PostRender()
     PixelUtil::Name(format));
 }
 
+/////////////////////////////////////////////////
+void Ogre2SegmentationCamera::LabelIdsFromTexture(const uint8_t *_data,
+    size_t _bytesPerRow)
+{
+  const auto width = this->ImageWidth();
+  const auto height = this->ImageHeight();
+  auto &labelIds = this->dataPtr->labelIdBuffer;
+  labelIds.resize(width * height);
+
+  // The label id map stores the semantic label in every channel, and the
+  // panoptic label in blue with the 16 bit instance count in green (high
+  // byte) and red (low byte), so the ids are the texels read as little
+  // endian integers. Colored maps keep the whole color for the lookup below
+  uint32_t mask = (!this->isColoredMap &&
+      this->type == SegmentationType::ST_SEMANTIC) ? 0xFFu : 0xFFFFFFu;
+  copyRgba8ToUint32(_data, _bytesPerRow, mask, labelIds.data(),
+      width, height);
+
+  if (!this->isColoredMap)
+    return;
+
+  // map colors back to labels. Neighboring pixels usually belong to the
+  // same object so remember the last lookup
+  const auto &colorToLabel = this->dataPtr->materialSwitcher->ColorToLabel();
+  const uint32_t backgroundId =
+      this->type == SegmentationType::ST_SEMANTIC ?
+      static_cast<uint32_t>(this->backgroundLabel) :
+      static_cast<uint32_t>(this->backgroundLabel) << 16;
+  uint32_t prevColor = 0u;
+  uint32_t prevId = backgroundId;
+  bool hasPrev = false;
+  for (auto &value : labelIds)
+  {
+    if (!hasPrev || value != prevColor)
+    {
+      prevColor = value;
+      hasPrev = true;
+
+      // color ids are r << 16 | g << 8 | b
+      int64_t colorId = ((value & 0xFFu) << 16) | (value & 0xFF00u) |
+          ((value >> 16) & 0xFFu);
+      auto it = colorToLabel.find(colorId);
+      prevId = it == colorToLabel.end() ?
+          backgroundId : static_cast<uint32_t>(it->second);
+    }
+    value = prevId;
+  }
+}
+
 /////////////////////////////////////////////////
 ignition::common::ConnectionPtr
   Ogre2SegmentationCamera::ConnectNewSegmentationFrame(
@@ -306,6 +361,15 @@ ignition::common::ConnectionPtr
   return this->dataPtr->newSegmentationFrame.Connect(_subscriber);
 }
 
+/////////////////////////////////////////////////
+ignition::common::ConnectionPtr
+  Ogre2SegmentationCamera::ConnectNewLabelIdFrame(
+  std::function<void(const uint32_t *, unsigned int, unsigned int)>
+  _subscriber)
+{
+  return this->dataPtr->newLabelIdFrame.Connect(_subscriber);
+}
+
 /////////////////////////////////////////////////
 void Ogre2SegmentationCamera::Render()
 {
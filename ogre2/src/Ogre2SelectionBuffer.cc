@@ -15,7 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include <ignition/math/Color.hh>
 
 #include "ignition/common/Console.hh"
@@ -35,6 +38,7 @@
 #include <Compositor/Pass/PassClear/OgreCompositorPassClearDef.h>
 #include <Compositor/Pass/PassQuad/OgreCompositorPassQuadDef.h>
 #include <Compositor/Pass/PassScene/OgreCompositorPassSceneDef.h>
+#include <OgreBitwise.h>
 #include <OgreCamera.h>
 #include <OgreDepthBuffer.h>
 #include <OgreItem.h>
@@ -51,6 +55,79 @@
 using namespace ignition;
 using namespace rendering;
 
+/// \brief Maximum ratio between the area of the rectangle rendered for a
+/// group of pixels and the number of pixels in the group. Groups of pixels
+/// that are more spread out are split
+static const uint64_t kMaxAreaPerPixel = 4u;
+
+/// \brief Area of the rectangles that are always rendered in one pass, no
+/// matter how few pixels they contain
+static const uint64_t kMinClusterArea = 64u;
+
+/// \brief Ratio between the area of the region render texture and the area
+/// needed by a query above which the texture is shrunk
+static const uint64_t kMaxRegionAreaRatio = 16u;
+
+//////////////////////////////////////////////////
+/// \brief Split pixels into groups whose bounding rectangles are small
+/// compared to the number of pixels they contain, so that pixels far apart
+/// do not require rendering everything between them. Groups are split at
+/// the largest gap along the longest side of their bounding rectangle.
+/// \param[in] _pixels All the pixels
+/// \param[in] _indices Indices of the pixels to split
+/// \param[out] _clusters Indices of the pixels of each group
+static void clusterPixels(const std::vector<math::Vector2i> &_pixels,
+    std::vector<unsigned int> _indices,
+    std::vector<std::vector<unsigned int>> &_clusters)
+{
+  math::Vector2i minPixel = _pixels[_indices[0]];
+  math::Vector2i maxPixel = minPixel;
+  for (unsigned int i : _indices)
+  {
+    minPixel.X(std::min(minPixel.X(), _pixels[i].X()));
+    minPixel.Y(std::min(minPixel.Y(), _pixels[i].Y()));
+    maxPixel.X(std::max(maxPixel.X(), _pixels[i].X()));
+    maxPixel.Y(std::max(maxPixel.Y(), _pixels[i].Y()));
+  }
+  uint64_t width = maxPixel.X() - minPixel.X() + 1;
+  uint64_t height = maxPixel.Y() - minPixel.Y() + 1;
+  if (width * height <=
+      std::max(kMinClusterArea, kMaxAreaPerPixel * _indices.size()))
+  {
+    _clusters.push_back(std::move(_indices));
+    return;
+  }
+
+  // the longest side is at least 2 pixels long, so there is a gap
+  bool alongX = width >= height;
+  auto coord = [&](unsigned int _i)
+  {
+    return alongX ? _pixels[_i].X() : _pixels[_i].Y();
+  };
+  std::sort(_indices.begin(), _indices.end(),
+      [&](unsigned int _a, unsigned int _b)
+      {
+        return coord(_a) < coord(_b);
+      });
+
+  size_t split = 1u;
+  int largestGap = 0;
+  for (size_t i = 1u; i < _indices.size(); ++i)
+  {
+    int gap = coord(_indices[i]) - coord(_indices[i - 1u]);
+    if (gap > largestGap)
+    {
+      largestGap = gap;
+      split = i;
+    }
+  }
+
+  clusterPixels(_pixels, std::vector<unsigned int>(_indices.begin(),
+      _indices.begin() + split), _clusters);
+  clusterPixels(_pixels, std::vector<unsigned int>(
+      _indices.begin() + split, _indices.end()), _clusters);
+}
+
 class ignition::rendering::Ogre2SelectionBufferPrivate
 {
   /// \brief This is a material listener and a RenderTargetListener.
@@ -93,6 +170,19 @@ class ignition::rendering::Ogre2SelectionBufferPrivate
 
   /// \brief The selection buffer material
   public: Ogre::MaterialPtr selectionMaterial;
+
+  /// \brief Render texture used to query more than one pixel
+  public: Ogre::TextureGpu *regionTexture = nullptr;
+
+  /// \brief Compositor workspace that renders to regionTexture
+  public: Ogre::CompositorWorkspace *regionWorkspace = nullptr;
+
+  /// \brief Width of regionTexture. The texture only grows, unless it gets
+  /// much larger than what queries need
+  public: unsigned int regionWidth = 0;
+
+  /// \brief Height of regionTexture
+  public: unsigned int regionHeight = 0;
 };
 
 /////////////////////////////////////////////////
@@ -165,6 +255,13 @@ void Ogre2SelectionBuffer::Update()
   if (!this->dataPtr->renderTexture)
     return;
 
+  this->UpdateWorkspace(this->dataPtr->ogreCompositorWorkspace);
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::UpdateWorkspace(
+    Ogre::CompositorWorkspace *_workspace)
+{
   this->dataPtr->materialSwitcher->Reset();
 
   this->dataPtr->scene->StartForcedRender();
@@ -174,14 +271,14 @@ void Ogre2SelectionBuffer::Update()
   // auto engine = Ogre2RenderEngine::Instance();
   // engine->OgreRoot()->renderOneFrame();
   // this->dataPtr->ogreCompositorWorkspace->setEnabled(false);
-  this->dataPtr->ogreCompositorWorkspace->_validateFinalTarget();
-  this->dataPtr->ogreCompositorWorkspace->_beginUpdate(false);
-  this->dataPtr->ogreCompositorWorkspace->_update();
-  this->dataPtr->ogreCompositorWorkspace->_endUpdate(false);
+  _workspace->_validateFinalTarget();
+  _workspace->_beginUpdate(false);
+  _workspace->_update();
+  _workspace->_endUpdate(false);
 
   Ogre::vector<Ogre::TextureGpu *>::type swappedTargets;
   swappedTargets.reserve(2u);
-  this->dataPtr->ogreCompositorWorkspace->_swapFinalTarget(swappedTargets);
+  _workspace->_swapFinalTarget(swappedTargets);
 
   this->dataPtr->scene->FlushGpuCommandsAndStartNewFrame(1u, false);
 
@@ -194,6 +291,8 @@ void Ogre2SelectionBuffer::Update()
 /////////////////////////////////////////////////
 void Ogre2SelectionBuffer::DeleteRTTBuffer()
 {
+  this->DeleteRegionRTT();
+
   if (this->dataPtr->ogreCompositorWorkspace)
   {
     // TODO(ahcorde): Remove the workspace. Potential leak here
@@ -372,6 +471,65 @@ void Ogre2SelectionBuffer::CreateRTTBuffer()
         false);
 }
 
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::CreateRegionRTT(unsigned int _width,
+    unsigned int _height)
+{
+  auto engine = Ogre2RenderEngine::Instance();
+  auto ogreRoot = engine->OgreRoot();
+
+  Ogre::TextureGpuManager *textureMgr =
+    ogreRoot->getRenderSystem()->getTextureGpuManager();
+  this->dataPtr->regionTexture =
+      textureMgr->createOrRetrieveTexture(
+        this->dataPtr->camera->getName() + "_SelectionRegionTex",
+        Ogre::GpuPageOutStrategy::SaveToSystemRam,
+        Ogre::TextureFlags::RenderToTexture,
+        Ogre::TextureTypes::Type2D);
+  this->dataPtr->regionTexture->setResolution(_width, _height);
+  this->dataPtr->regionTexture->setNumMipmaps(1u);
+  this->dataPtr->regionTexture->setPixelFormat(Ogre::PFG_RGBA32_FLOAT);
+
+  this->dataPtr->regionTexture->scheduleTransitionTo(
+    Ogre::GpuResidency::Resident);
+
+  // the compositor workspace definition does not depend on the size of the
+  // render texture so it is shared with the 1x1 selection buffer
+  this->dataPtr->regionWorkspace =
+      this->dataPtr->ogreCompMgr->addWorkspace(
+        this->dataPtr->scene->OgreSceneManager(),
+        this->dataPtr->regionTexture,
+        this->dataPtr->selectionCamera,
+        this->dataPtr->ogreCompWorkspaceDefName,
+        false);
+
+  this->dataPtr->regionWidth = _width;
+  this->dataPtr->regionHeight = _height;
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::DeleteRegionRTT()
+{
+  if (this->dataPtr->regionWorkspace)
+  {
+    this->dataPtr->ogreCompMgr->removeWorkspace(
+        this->dataPtr->regionWorkspace);
+    this->dataPtr->regionWorkspace = nullptr;
+  }
+
+  if (this->dataPtr->regionTexture)
+  {
+    auto engine = Ogre2RenderEngine::Instance();
+    auto ogreRoot = engine->OgreRoot();
+    ogreRoot->getRenderSystem()->getTextureGpuManager()->destroyTexture(
+      this->dataPtr->regionTexture);
+    this->dataPtr->regionTexture = nullptr;
+  }
+
+  this->dataPtr->regionWidth = 0;
+  this->dataPtr->regionHeight = 0;
+}
+
 /////////////////////////////////////////////////
 void Ogre2SelectionBuffer::SetDimensions(
   unsigned int _width, unsigned int _height)
@@ -398,6 +556,27 @@ Ogre::Item *Ogre2SelectionBuffer::OnSelectionClick(const int _x, const int _y)
 bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
     Ogre::Item *&_item, math::Vector3d &_point)
 {
+  std::vector<Ogre::Item *> items;
+  std::vector<math::Vector3d> points;
+  if (!this->ExecuteQuery({math::Vector2i(_x, _y)}, items, points) ||
+      !items[0])
+  {
+    return false;
+  }
+
+  _item = items[0];
+  _point = points[0];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Ogre2SelectionBuffer::ExecuteQuery(
+    const std::vector<math::Vector2i> &_pixels,
+    std::vector<Ogre::Item *> &_items, std::vector<math::Vector3d> &_points)
+{
+  _items.assign(_pixels.size(), nullptr);
+  _points.assign(_pixels.size(), math::Vector3d::Zero);
+
   if (!this->dataPtr->renderTexture)
     return false;
 
@@ -412,24 +591,98 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
       projectionMatrix.extractQuaternion().isNaN())
     return false;
 
-   const unsigned int targetWidth = this->dataPtr->width;
-   const unsigned int targetHeight = this->dataPtr->height;
+  const int targetWidth = static_cast<int>(this->dataPtr->width);
+  const int targetHeight = static_cast<int>(this->dataPtr->height);
 
-   if (_x < 0 || _y < 0 || _x >= static_cast<int>(targetWidth)
-       || _y >= static_cast<int>(targetHeight))
-     return false;
+  // pixels inside the image
+  std::vector<unsigned int> indices;
+  indices.reserve(_pixels.size());
+  for (unsigned int i = 0; i < _pixels.size(); ++i)
+  {
+    const auto &pixel = _pixels[i];
+    if (pixel.X() >= 0 && pixel.Y() >= 0 &&
+        pixel.X() < targetWidth && pixel.Y() < targetHeight)
+    {
+      indices.push_back(i);
+    }
+  }
+  if (indices.empty())
+    return false;
+
+  // render each group of nearby pixels in its own pass
+  std::vector<std::vector<unsigned int>> clusters;
+  clusterPixels(_pixels, std::move(indices), clusters);
+  for (const auto &cluster : clusters)
+    this->QueryRegion(_pixels, cluster, _items, _points);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Ogre2SelectionBuffer::QueryRegion(
+    const std::vector<math::Vector2i> &_pixels,
+    const std::vector<unsigned int> &_indices,
+    std::vector<Ogre::Item *> &_items, std::vector<math::Vector3d> &_points)
+{
+  // bounding rectangle of the pixels
+  math::Vector2i minPixel = _pixels[_indices[0]];
+  math::Vector2i maxPixel = minPixel;
+  for (unsigned int i : _indices)
+  {
+    minPixel.X(std::min(minPixel.X(), _pixels[i].X()));
+    minPixel.Y(std::min(minPixel.Y(), _pixels[i].Y()));
+    maxPixel.X(std::max(maxPixel.X(), _pixels[i].X()));
+    maxPixel.Y(std::max(maxPixel.Y(), _pixels[i].Y()));
+  }
+  unsigned int width = maxPixel.X() - minPixel.X() + 1;
+  unsigned int height = maxPixel.Y() - minPixel.Y() + 1;
+
+  // a single pixel is rendered to the 1x1 texture and larger rectangles to
+  // the region texture. The region texture is not recreated for every size,
+  // instead the rendered rectangle is extended to the size of the texture
+  // so that each texel still maps to one pixel.
+  Ogre::TextureGpu *texture = this->dataPtr->renderTexture;
+  Ogre::CompositorWorkspace *workspace =
+      this->dataPtr->ogreCompositorWorkspace;
+  if (width > 1u || height > 1u)
+  {
+    unsigned int regionWidth = this->dataPtr->regionWidth;
+    unsigned int regionHeight = this->dataPtr->regionHeight;
+    bool tooSmall = regionWidth < width || regionHeight < height;
+    bool tooLarge = static_cast<uint64_t>(regionWidth) * regionHeight >
+        kMaxRegionAreaRatio * width * height;
+    if (tooSmall || tooLarge)
+    {
+      if (tooLarge)
+      {
+        regionWidth = 0u;
+        regionHeight = 0u;
+      }
+      // round up to powers of two so that slowly growing queries do not
+      // recreate the texture every time
+      regionWidth = std::max(regionWidth,
+          Ogre::Bitwise::firstPO2From(width));
+      regionHeight = std::max(regionHeight,
+          Ogre::Bitwise::firstPO2From(height));
+      this->DeleteRegionRTT();
+      this->CreateRegionRTT(regionWidth, regionHeight);
+    }
+    width = this->dataPtr->regionWidth;
+    height = this->dataPtr->regionHeight;
+    texture = this->dataPtr->regionTexture;
+    workspace = this->dataPtr->regionWorkspace;
+  }
 
-  // 1x1 selection buffer, adapted from rviz
+  // render only the rectangle, adapted from rviz
   // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
-  unsigned int width = 1;
-  unsigned int height = 1;
-  float x1 = static_cast<float>(_x) /
+  const unsigned int targetWidth = this->dataPtr->width;
+  const unsigned int targetHeight = this->dataPtr->height;
+  float x1 = static_cast<float>(minPixel.X()) /
       static_cast<float>(targetWidth - 1) - 0.5f;
-  float y1 = static_cast<float>(_y) /
+  float y1 = static_cast<float>(minPixel.Y()) /
       static_cast<float>(targetHeight - 1) - 0.5f;
-  float x2 = static_cast<float>(_x+width) /
+  float x2 = static_cast<float>(minPixel.X() + width) /
       static_cast<float>(targetWidth - 1) - 0.5f;
-  float y2 = static_cast<float>(_y+height) /
+  float y2 = static_cast<float>(minPixel.Y() + height) /
       static_cast<float>(targetHeight - 1) - 0.5f;
 
   Ogre::Matrix4 scaleMatrix = Ogre::Matrix4::IDENTITY;
@@ -450,51 +703,40 @@ bool Ogre2SelectionBuffer::ExecuteQuery(const int _x, const int _y,
       this->dataPtr->camera->getDerivedOrientation());
 
   // update render texture
-  this->Update();
+  this->UpdateWorkspace(workspace);
 
   Ogre::Image2 image;
-  image.convertFromTexture(this->dataPtr->renderTexture, 0, 0);
-  Ogre::ColourValue pixel = image.getColourAt(0, 0, 0, 0);
-
-  float color = pixel[3];
-  uint32_t *rgba = reinterpret_cast<uint32_t *>(&color);
-  unsigned int r = *rgba >> 24 & 0xFF;
-  unsigned int g = *rgba >> 16 & 0xFF;
-  unsigned int b = *rgba >> 8 & 0xFF;
-
-  math::Vector3d point(pixel[0], pixel[1], pixel[2]);
+  image.convertFromTexture(texture, 0, 0);
 
   auto rot = Ogre2Conversions::Convert(
       this->dataPtr->camera->getParentSceneNode()->_getDerivedOrientation());
   auto pos = Ogre2Conversions::Convert(
       this->dataPtr->camera->getParentSceneNode()->_getDerivedPosition());
-  math::Pose3d p(pos, rot);
-  point = rot * point + pos;
-
-  ignition::math::Color cv;
-  cv.A(1.0);
-  cv.R(r / 255.0);
-  cv.G(g / 255.0);
-  cv.B(b / 255.0);
-
-  const std::string &entName =
-    this->dataPtr->materialSwitcher->EntityName(cv);
 
-  if (entName.empty())
+  for (unsigned int i : _indices)
   {
-    return false;
-  }
-  else
-  {
-    auto collection = this->dataPtr->sceneMgr->findMovableObjects(
-        Ogre::ItemFactory::FACTORY_TYPE_NAME, entName);
-    if (collection.empty())
-      return false;
-    else
-    {
-      _item = dynamic_cast<Ogre::Item *>(collection[0]);
-      _point = point;
-      return true;
-    }
+    Ogre::ColourValue pixel = image.getColourAt(
+        _pixels[i].X() - minPixel.X(), _pixels[i].Y() - minPixel.Y(), 0, 0);
+
+    float color = pixel[3];
+    uint32_t *rgba = reinterpret_cast<uint32_t *>(&color);
+    unsigned int r = *rgba >> 24 & 0xFF;
+    unsigned int g = *rgba >> 16 & 0xFF;
+    unsigned int b = *rgba >> 8 & 0xFF;
+
+    ignition::math::Color cv;
+    cv.A(1.0);
+    cv.R(r / 255.0);
+    cv.G(g / 255.0);
+    cv.B(b / 255.0);
+
+    // look up the item directly instead of searching the scene by name
+    Ogre::Item *item = this->dataPtr->materialSwitcher->EntityItem(cv);
+    if (!item)
+      continue;
+
+    math::Vector3d point(pixel[0], pixel[1], pixel[2]);
+    _items[i] = item;
+    _points[i] = rot * point + pos;
   }
 }
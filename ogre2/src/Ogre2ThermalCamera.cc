@@ -36,9 +36,12 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -53,8 +56,10 @@
 #include <ignition/common/Filesystem.hh>
 #include <ignition/math/Helpers.hh>
 
+#include "ignition/rendering/PixelCopy.hh"
 #include "ignition/rendering/RenderTypes.hh"
 #include "ignition/rendering/ogre2/Ogre2Conversions.hh"
+#include "ignition/rendering/ogre2/Ogre2Geometry.hh"
 #include "ignition/rendering/ogre2/Ogre2Includes.hh"
 #include "ignition/rendering/ogre2/Ogre2Material.hh"
 #include "ignition/rendering/ogre2/Ogre2ParticleEmitter.hh"
@@ -95,6 +100,24 @@ class Ogre2ThermalCameraMaterialSwitcher : public Ogre::Camera::Listener
   /// \param[in] _resolution Temperature linear resolution
   public: void SetLinearResolution(double _resolution);
 
+  /// \brief Update the thermal data cached for each visual. Only the
+  /// visuals that changed since the last update are processed, unless the
+  /// whole cache was invalidated.
+  private: void UpdateThermalData();
+
+  /// \brief Update the thermal data cached for a visual
+  /// \param[in] _id Id of the visual
+  private: void UpdateVisualThermalData(unsigned int _id);
+
+  /// \brief Remove the heat signature material created for a visual
+  /// \param[in] _id Id of the visual
+  private: void RemoveHeatSignatureMaterial(unsigned int _id);
+
+  /// \brief Store the original material or datablock of a sub item so
+  /// that it can be restored after rendering
+  /// \param[in] _subItem Ogre sub item
+  private: void SaveSubItemMaterial(Ogre::SubItem *_subItem);
+
   /// \brief Callback when a camara is about to be rendered
   /// \param[in] _cam Ogre camera pointer which is about to render
   private: virtual void cameraPreRenderScene(
@@ -117,10 +140,10 @@ class Ogre2ThermalCameraMaterialSwitcher : public Ogre::Camera::Listener
   /// signature texture applied to it
   private: Ogre::MaterialPtr baseHeatSigMaterial;
 
-  /// \brief A map of all items that have a heat signature material.
-  /// The key is the item's ID, and the value is the heat signature
-  /// for that item.
-  private: std::unordered_map<Ogre::IdType, Ogre::MaterialPtr>
+  /// \brief A map of all visuals that have a heat signature material.
+  /// The key is the visual's ID, and the value is the heat signature
+  /// for the items of that visual.
+  private: std::unordered_map<unsigned int, Ogre::MaterialPtr>
             heatSignatureMaterials;
 
   /// \brief The name of the thermal camera sensor
@@ -149,6 +172,58 @@ class Ogre2ThermalCameraMaterialSwitcher : public Ogre::Camera::Listener
 
   /// \brief thermal camera image bit depth
   private: unsigned int bitDepth = 16u;
+
+  /// \brief Type of thermal material applied to the items of a visual
+  private: enum class ThermalItemType
+  {
+    /// \brief Item with a uniform temperature
+    HEAT_SOURCE,
+
+    /// \brief Item with a heat signature texture
+    HEAT_SIGNATURE,
+
+    /// \brief Item whose temperature is derived from its color
+    BACKGROUND
+  };
+
+  /// \brief Thermal data cached for a visual so that its user data does
+  /// not need to be parsed every frame
+  private: struct ThermalVisualData
+  {
+    /// \brief Type of thermal material applied to the items of the visual
+    ThermalItemType type = ThermalItemType::BACKGROUND;
+
+    /// \brief The visual
+    std::weak_ptr<Ogre2Visual> visual;
+
+    /// \brief Temperature of a heat source visual, in kelvin
+    float temperature = 0.0f;
+  };
+
+  /// \brief Switch the material of an ogre item to its thermal material.
+  /// The original material is saved so that it can be restored after
+  /// rendering.
+  /// \param[in] _id Id of the visual the item belongs to
+  /// \param[in] _data Thermal data of the visual
+  /// \param[in] _visual The visual
+  /// \param[in] _item Ogre item of one of the geometries of the visual
+  private: void SwitchItemMaterial(unsigned int _id,
+      const ThermalVisualData &_data, const Ogre2VisualPtr &_visual,
+      Ogre::Item *_item);
+
+  /// \brief Thermal data cached for each visual with geometries. The key is
+  /// the visual's ID.
+  private: std::unordered_map<unsigned int, ThermalVisualData>
+      visualThermalData;
+
+  /// \brief Position in the scene's log of changed visuals up to which the
+  /// cached visual data is up to date
+  /// \sa Ogre2Scene::ChangedVisuals
+  private: uint64_t changedVisualsVersion = 0u;
+
+  /// \brief True if the data of all visuals must be updated, e.g. after the
+  /// image format changed
+  private: bool thermalDataDirty = true;
 };
 }
 }
@@ -230,227 +305,319 @@ void Ogre2ThermalCameraMaterialSwitcher::SetFormat(PixelFormat _format)
 {
   this->format = _format;
   this->bitDepth = 8u * PixelUtil::BytesPerChannel(format);
+
+  // heat signature materials depend on the bit depth
+  this->thermalDataDirty = true;
 }
 
 //////////////////////////////////////////////////
 void Ogre2ThermalCameraMaterialSwitcher::SetLinearResolution(double _resolution)
 {
   this->resolution = _resolution;
+
+  // heat signature materials depend on the resolution
+  this->thermalDataDirty = true;
 }
 //////////////////////////////////////////////////
-void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
-    Ogre::Camera * /*_cam*/)
+void Ogre2ThermalCameraMaterialSwitcher::UpdateThermalData()
 {
-  // swap item to use v1 shader material
-  // Note: keep an eye out for performance impact on switching materials
-  // on the fly. We are not doing this often so should be ok.
+  std::vector<unsigned int> changedVisuals;
+  bool complete = this->scene->ChangedVisuals(this->changedVisualsVersion,
+      changedVisuals);
+
+  if (!this->thermalDataDirty && complete)
+  {
+    // only the visuals that changed need to be parsed again
+    std::unordered_set<unsigned int> visualIds(changedVisuals.begin(),
+        changedVisuals.end());
+    for (unsigned int id : visualIds)
+      this->UpdateVisualThermalData(id);
+    return;
+  }
+
+  // rebuild the data of all visuals that have ogre items
+  this->visualThermalData.clear();
+  for (auto it = this->heatSignatureMaterials.begin();
+       it != this->heatSignatureMaterials.end(); ++it)
+  {
+    Ogre::MaterialManager::getSingleton().remove(it->second->getName());
+  }
+  this->heatSignatureMaterials.clear();
+
+  std::unordered_set<unsigned int> visualIds;
   auto itor = this->scene->OgreSceneManager()->getMovableObjectIterator(
       Ogre::ItemFactory::FACTORY_TYPE_NAME);
   while (itor.hasMoreElements())
   {
-    Ogre::MovableObject *object = itor.peekNext();
-    Ogre::Item *item = static_cast<Ogre::Item *>(object);
-
-    const std::string tempKey = "temperature";
-    // get visual
-    Ogre::Any userAny = item->getUserObjectBindings().getUserAny();
+    Ogre::MovableObject *object = itor.getNext();
+    Ogre::Any userAny = object->getUserObjectBindings().getUserAny();
     if (!userAny.isEmpty() && userAny.getType() == typeid(unsigned int))
     {
-      VisualPtr result;
       try
       {
-        result = this->scene->VisualById(Ogre::any_cast<unsigned int>(userAny));
+        visualIds.insert(Ogre::any_cast<unsigned int>(userAny));
       }
       catch(Ogre::Exception &e)
       {
         ignerr << "Ogre Error:" << e.getFullDescription() << "\n";
       }
-      Ogre2VisualPtr ogreVisual =
-          std::dynamic_pointer_cast<Ogre2Visual>(result);
+    }
+  }
 
-      // get temperature
-      Variant tempAny = ogreVisual->UserData(tempKey);
-      if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
-      {
-        float temp = -1.0;
-        bool foundTemp = true;
-        try
-        {
-          temp = std::get<float>(tempAny);
-        }
-        catch(...)
-        {
-          try
-          {
-            temp = std::get<double>(tempAny);
-          }
-          catch(...)
-          {
-            try
-            {
-              temp = std::get<int>(tempAny);
-            }
-            catch(std::bad_variant_access &e)
-            {
-              ignerr << "Error casting user data: " << e.what() << "\n";
-              temp = -1.0;
-              foundTemp = false;
-            }
-          }
-        }
+  for (unsigned int id : visualIds)
+    this->UpdateVisualThermalData(id);
+  this->thermalDataDirty = false;
+}
 
-        // if a non-positive temperature was given, clamp it to 0
-        if (foundTemp && temp < 0.0)
-        {
-          temp = 0.0;
-          ignwarn << "Unable to set negatve temperature for: "
-              << ogreVisual->Name() << ". Value cannot be lower than absolute "
-              << "zero. Clamping temperature to 0 degrees Kelvin."
-              << std::endl;
-        }
-        for (unsigned int i = 0; i < item->getNumSubItems(); ++i)
-        {
-          Ogre::SubItem *subItem = item->getSubItem(i);
-
-          // normalize temperature value
-          float color = (temp / this->resolution) / ((1 << bitDepth) - 1.0);
-
-          // set g, b, a to 0. This will be used by shaders to determine
-          // if particular fragment is a heat source or not
-          // see media/materials/programs/thermal_camera_fs.glsl
-          subItem->setCustomParameter(this->customParamIdx,
-              Ogre::Vector4(color, 0, 0, 0.0));
-          // case when item is using low level materials
-          // e.g. shaders
-          if (!subItem->getMaterial().isNull())
-          {
-            this->thermalMaterialMap[subItem] = subItem->getMaterial();
-          }
-          // regular Pbs Hlms datablock
-          else
-          {
-            Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-            this->datablockMap[subItem] = datablock;
-          }
-          subItem->setMaterial(this->heatSourceMaterial);
-        }
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::RemoveHeatSignatureMaterial(
+    unsigned int _id)
+{
+  auto matIt = this->heatSignatureMaterials.find(_id);
+  if (matIt != this->heatSignatureMaterials.end())
+  {
+    Ogre::MaterialManager::getSingleton().remove(matIt->second->getName());
+    this->heatSignatureMaterials.erase(matIt);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::UpdateVisualThermalData(
+    unsigned int _id)
+{
+  const std::string tempKey = "temperature";
+
+  // the heat signature or temperature range may have changed, so
+  // remove the material created for the previous values
+  this->visualThermalData.erase(_id);
+  this->RemoveHeatSignatureMaterial(_id);
+
+  // the visual may have been destroyed or lost its geometries
+  Ogre2VisualPtr ogreVisual =
+      std::dynamic_pointer_cast<Ogre2Visual>(this->scene->VisualById(_id));
+  if (!ogreVisual || ogreVisual->GeometryCount() == 0u)
+    return;
+
+  ThermalVisualData data;
+  data.visual = ogreVisual;
+
+  // get temperature
+  Variant tempAny = ogreVisual->UserData(tempKey);
+  if (tempAny.index() != 0 && !std::holds_alternative<std::string>(tempAny))
+  {
+    float temp = -1.0;
+    bool foundTemp = true;
+    try
+    {
+      temp = std::get<float>(tempAny);
+    }
+    catch(...)
+    {
+      try
+      {
+        temp = std::get<double>(tempAny);
       }
-      // get heat signature and the corresponding min/max temperature values
-      else if (auto heatSignature = std::get_if<std::string>(&tempAny))
+      catch(...)
       {
-        // if this is the first time rendering the heat signature,
-        // we need to make sure that the texture is loaded and applied to
-        // the heat signature material before loading the material
-        if (this->heatSignatureMaterials.find(item->getId()) ==
-            this->heatSignatureMaterials.end())
-        {
-          // make sure the texture is in ogre's resource path
-          const auto &texture = *heatSignature;
-          auto engine = Ogre2RenderEngine::Instance();
-          engine->AddResourcePath(texture);
-
-          // create a material for this item, now that the texture has been
-          // searched for. We must clone the base heat signature material since
-          // different items may use different textures. We also append the
-          // item's ID to the end of the new material name to ensure new
-          // material uniqueness in case two items use the same heat signature
-          // texture, but have different temperature ranges
-          std::string baseName = common::basename(texture);
-          auto heatSignatureMaterial = this->baseHeatSigMaterial->clone(
-              this->name + "_" + baseName + "_" +
-              Ogre::StringConverter::toString(item->getId()));
-          auto textureUnitStatePtr = heatSignatureMaterial->
-            getTechnique(0)->getPass(0)->getTextureUnitState(0);
-          Ogre::String textureName = baseName;
-          textureUnitStatePtr->setTextureName(textureName);
-
-          // set temperature range for the heat signature
-          auto minTempVariant = ogreVisual->UserData("minTemp");
-          auto maxTempVariant = ogreVisual->UserData("maxTemp");
-          auto minTemperature = std::get_if<float>(&minTempVariant);
-          auto maxTemperature = std::get_if<float>(&maxTempVariant);
-          if (minTemperature && maxTemperature)
-          {
-            // make sure the temperature range is between [min, max] kelvin
-            // for the given pixel format and camera resolution
-            float maxTemp = ((1 << bitDepth) - 1.0) * this->resolution;
-            Ogre::GpuProgramParametersSharedPtr params =
-              heatSignatureMaterial->getTechnique(0)->getPass(0)->
-              getFragmentProgramParameters();
-            params->setNamedConstant("minTemp",
-                std::max(static_cast<float>(*minTemperature), 0.0f));
-            params->setNamedConstant("maxTemp",
-                std::min(static_cast<float>(*maxTemperature), maxTemp));
-            params->setNamedConstant("bitDepth",
-                static_cast<int>(this->bitDepth));
-            params->setNamedConstant("resolution",
-                static_cast<float>(this->resolution));
-          }
-          heatSignatureMaterial->load();
-          this->heatSignatureMaterials[item->getId()] = heatSignatureMaterial;
-        }
-
-        for (unsigned int i = 0; i < item->getNumSubItems(); ++i)
+        try
         {
-          Ogre::SubItem *subItem = item->getSubItem(i);
-
-          // case when item is using low level materials
-          // e.g. shaders
-          if (!subItem->getMaterial().isNull())
-          {
-            this->thermalMaterialMap[subItem] = subItem->getMaterial();
-          }
-          // regular Pbs Hlms datablock
-          else
-          {
-            Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-            this->datablockMap[subItem] = datablock;
-          }
-
-          subItem->setMaterial(this->heatSignatureMaterials[item->getId()]);
+          temp = std::get<int>(tempAny);
         }
-      }
-      // background objects
-      else
-      {
-        Ogre::Aabb aabb = item->getWorldAabbUpdated();
-        Ogre::AxisAlignedBox box = Ogre::AxisAlignedBox(aabb.getMinimum(),
-            aabb.getMaximum());
-
-        // we will be converting rgb values to temperature values in shaders
-        // but we want to make sure the object rgb values are not affected by
-        // lighting, so disable lighting
-        // Also check if objects are within camera view
-        if (ogreVisual->GeometryCount() > 0u &&
-            this->ogreCamera->isVisible(box))
+        catch(std::bad_variant_access &e)
         {
-          auto geom = ogreVisual->GeometryByIndex(0);
-          if (geom)
-          {
-            MaterialPtr mat = geom->Material();
-            Ogre2MaterialPtr ogreMat =
-                std::dynamic_pointer_cast<Ogre2Material>(mat);
-            Ogre::HlmsUnlitDatablock *unlit = ogreMat->UnlitDatablock();
-            for (unsigned int i = 0; i < item->getNumSubItems(); ++i)
-            {
-              Ogre::SubItem *subItem = item->getSubItem(i);
-              if (!subItem->getMaterial().isNull())
-              {
-                this->thermalMaterialMap[subItem] = subItem->getMaterial();
-              }
-              // regular Pbs Hlms datablock
-              else
-              {
-                Ogre::HlmsDatablock *datablock = subItem->getDatablock();
-                this->datablockMap[subItem] = datablock;
-              }
-              subItem->setDatablock(unlit);
-            }
-          }
+          ignerr << "Error casting user data: " << e.what() << "\n";
+          temp = -1.0;
+          foundTemp = false;
         }
       }
     }
-    itor.moveNext();
+
+    // if a non-positive temperature was given, clamp it to 0
+    if (foundTemp && temp < 0.0)
+    {
+      temp = 0.0;
+      ignwarn << "Unable to set negatve temperature for: "
+          << ogreVisual->Name() << ". Value cannot be lower than absolute "
+          << "zero. Clamping temperature to 0 degrees Kelvin."
+          << std::endl;
+    }
+    data.type = ThermalItemType::HEAT_SOURCE;
+    data.temperature = temp;
+  }
+  // get heat signature and the corresponding min/max temperature values
+  else if (auto heatSignature = std::get_if<std::string>(&tempAny))
+  {
+    data.type = ThermalItemType::HEAT_SIGNATURE;
+
+    // make sure the texture is in ogre's resource path
+    const auto &texture = *heatSignature;
+    auto engine = Ogre2RenderEngine::Instance();
+    engine->AddResourcePath(texture);
+
+    // create a material for the items of this visual, now that the texture
+    // has been searched for. We must clone the base heat signature material
+    // since different visuals may use different textures. We also append
+    // the visual's ID to the end of the new material name to ensure new
+    // material uniqueness in case two visuals use the same heat signature
+    // texture, but have different temperature ranges
+    std::string baseName = common::basename(texture);
+    auto heatSignatureMaterial = this->baseHeatSigMaterial->clone(
+        this->name + "_" + baseName + "_" + std::to_string(_id));
+    auto textureUnitStatePtr = heatSignatureMaterial->
+      getTechnique(0)->getPass(0)->getTextureUnitState(0);
+    Ogre::String textureName = baseName;
+    textureUnitStatePtr->setTextureName(textureName);
+
+    // set temperature range for the heat signature
+    auto minTempVariant = ogreVisual->UserData("minTemp");
+    auto maxTempVariant = ogreVisual->UserData("maxTemp");
+    auto minTemperature = std::get_if<float>(&minTempVariant);
+    auto maxTemperature = std::get_if<float>(&maxTempVariant);
+    if (minTemperature && maxTemperature)
+    {
+      // make sure the temperature range is between [min, max] kelvin
+      // for the given pixel format and camera resolution
+      float maxTemp = ((1 << bitDepth) - 1.0) * this->resolution;
+      Ogre::GpuProgramParametersSharedPtr params =
+        heatSignatureMaterial->getTechnique(0)->getPass(0)->
+        getFragmentProgramParameters();
+      params->setNamedConstant("minTemp",
+          std::max(static_cast<float>(*minTemperature), 0.0f));
+      params->setNamedConstant("maxTemp",
+          std::min(static_cast<float>(*maxTemperature), maxTemp));
+      params->setNamedConstant("bitDepth",
+          static_cast<int>(this->bitDepth));
+      params->setNamedConstant("resolution",
+          static_cast<float>(this->resolution));
+    }
+    heatSignatureMaterial->load();
+    this->heatSignatureMaterials[_id] = heatSignatureMaterial;
+  }
+  // background objects
+  else
+  {
+    data.type = ThermalItemType::BACKGROUND;
+  }
+
+  this->visualThermalData[_id] = data;
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::SaveSubItemMaterial(
+    Ogre::SubItem *_subItem)
+{
+  // case when item is using low level materials
+  // e.g. shaders
+  if (!_subItem->getMaterial().isNull())
+  {
+    this->thermalMaterialMap[_subItem] = _subItem->getMaterial();
+  }
+  // regular Pbs Hlms datablock
+  else
+  {
+    Ogre::HlmsDatablock *datablock = _subItem->getDatablock();
+    this->datablockMap[_subItem] = datablock;
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::cameraPreRenderScene(
+    Ogre::Camera * /*_cam*/)
+{
+  // Parsing the temperature of every visual is expensive in large scenes,
+  // so it is only done for visuals that changed since the last frame
+  this->UpdateThermalData();
+
+  // swap item to use v1 shader material
+  // Note: keep an eye out for performance impact on switching materials
+  // on the fly. We are not doing this often so should be ok.
+  for (const auto &it : this->visualThermalData)
+  {
+    const ThermalVisualData &data = it.second;
+    Ogre2VisualPtr ogreVisual = data.visual.lock();
+    if (!ogreVisual)
+      continue;
+
+    for (unsigned int g = 0; g < ogreVisual->GeometryCount(); ++g)
+    {
+      Ogre2GeometryPtr geom = std::dynamic_pointer_cast<Ogre2Geometry>(
+          ogreVisual->GeometryByIndex(g));
+      Ogre::Item *item =
+          geom ? dynamic_cast<Ogre::Item *>(geom->OgreObject()) : nullptr;
+      if (item)
+        this->SwitchItemMaterial(it.first, data, ogreVisual, item);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2ThermalCameraMaterialSwitcher::SwitchItemMaterial(
+    unsigned int _id, const ThermalVisualData &_data,
+    const Ogre2VisualPtr &_visual, Ogre::Item *_item)
+{
+  if (_data.type == ThermalItemType::HEAT_SOURCE)
+  {
+    // normalize temperature value
+    float color = (_data.temperature / this->resolution) /
+        ((1 << bitDepth) - 1.0);
+
+    for (unsigned int i = 0; i < _item->getNumSubItems(); ++i)
+    {
+      Ogre::SubItem *subItem = _item->getSubItem(i);
+
+      // set g, b, a to 0. This will be used by shaders to determine
+      // if particular fragment is a heat source or not
+      // see media/materials/programs/thermal_camera_fs.glsl
+      // The custom parameter is set every frame since other sensors,
+      // e.g. gpu rays, use the same index
+      subItem->setCustomParameter(this->customParamIdx,
+          Ogre::Vector4(color, 0, 0, 0.0));
+      this->SaveSubItemMaterial(subItem);
+      subItem->setMaterial(this->heatSourceMaterial);
+    }
+  }
+  else if (_data.type == ThermalItemType::HEAT_SIGNATURE)
+  {
+    auto matIt = this->heatSignatureMaterials.find(_id);
+    if (matIt == this->heatSignatureMaterials.end())
+      return;
+
+    for (unsigned int i = 0; i < _item->getNumSubItems(); ++i)
+    {
+      Ogre::SubItem *subItem = _item->getSubItem(i);
+      this->SaveSubItemMaterial(subItem);
+      subItem->setMaterial(matIt->second);
+    }
+  }
+  // background objects
+  else
+  {
+    Ogre::Aabb aabb = _item->getWorldAabbUpdated();
+    Ogre::AxisAlignedBox box = Ogre::AxisAlignedBox(aabb.getMinimum(),
+        aabb.getMaximum());
+
+    // we will be converting rgb values to temperature values in shaders
+    // but we want to make sure the object rgb values are not affected by
+    // lighting, so disable lighting
+    // Also check if objects are within camera view
+    if (!this->ogreCamera->isVisible(box))
+      return;
+
+    auto geom = _visual->GeometryByIndex(0);
+    if (!geom)
+      return;
+
+    MaterialPtr mat = geom->Material();
+    Ogre2MaterialPtr ogreMat = std::dynamic_pointer_cast<Ogre2Material>(mat);
+    if (!ogreMat)
+      return;
+    Ogre::HlmsUnlitDatablock *unlit = ogreMat->UnlitDatablock();
+    for (unsigned int i = 0; i < _item->getNumSubItems(); ++i)
+    {
+      Ogre::SubItem *subItem = _item->getSubItem(i);
+      this->SaveSubItemMaterial(subItem);
+      subItem->setDatablock(unlit);
+    }
   }
 }
 
@@ -938,33 +1105,19 @@ void Ogre2ThermalCamera::PostRender()
   Ogre::TextureBox box = image.getData(0u);
   if (format == PF_L8)
   {
-    uint8_t *thermalBuffer = static_cast<uint8_t*>(box.data);
-    for (unsigned int i = 0u; i < height; ++i)
-    {
-      // the texture box step size could be larger than our image buffer step
-      // size
-      unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-      for (unsigned int j = 0u; j < width; ++j)
-      {
-        unsigned int idx = (i * width) + j;
-        this->dataPtr->thermalImage[idx] = thermalBuffer[rawDataRowIdx + j];
-      }
-    }
+    // widen 8 bit data into the 16 bit output image. The texture box step
+    // size could be larger than our image buffer step size
+    copyL8ToL16(static_cast<uint8_t *>(box.data), box.bytesPerRow,
+        this->dataPtr->thermalImage, width, height);
   }
   else
   {
     // fill thermal data
     // copy data row by row. The texture box may not be a contiguous region of
     // a texture
-    uint16_t * thermalBuffer = static_cast<uint16_t *>(box.data);
-    for (unsigned int i = 0; i < height; ++i)
-    {
-      unsigned int rawDataRowIdx = i * box.bytesPerRow / bytesPerChannel;
-      unsigned int rowIdx = i * width * channelCount;
-      memcpy(&this->dataPtr->thermalImage[rowIdx],
-          &thermalBuffer[rawDataRowIdx],
-          width * channelCount * bytesPerChannel);
-    }
+    size_t rowBytes = width * channelCount * bytesPerChannel;
+    copyPixelRows(box.data, box.bytesPerRow, this->dataPtr->thermalImage,
+        rowBytes, rowBytes, height);
   }
 
   this->dataPtr->newThermalFrame(
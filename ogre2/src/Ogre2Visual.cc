@@ -21,6 +21,7 @@
 #include "ignition/rendering/ogre2/Ogre2Geometry.hh"
 #include "ignition/rendering/ogre2/Ogre2ParticleEmitter.hh"
 #include "ignition/rendering/ogre2/Ogre2RenderTypes.hh"
+#include "ignition/rendering/ogre2/Ogre2Scene.hh"
 #include "ignition/rendering/ogre2/Ogre2Storage.hh"
 #include "ignition/rendering/ogre2/Ogre2Visual.hh"
 #include "ignition/rendering/Utils.hh"
@@ -103,6 +104,9 @@ void Ogre2Visual::SetVisible(bool _visible)
     return;
 
   this->ogreNode->setVisible(_visible);
+
+  // visibility cascades to the whole subtree
+  this->MarkBoundingBoxDirty(true);
 }
 
 //////////////////////////////////////////////////
@@ -120,6 +124,20 @@ void Ogre2Visual::SetVisibilityFlags(uint32_t _flags)
   }
 }
 
+//////////////////////////////////////////////////
+void Ogre2Visual::SetUserData(const std::string &_key, Variant _value)
+{
+  BaseVisual::SetUserData(_key, _value);
+  this->MarkDataChanged();
+}
+
+//////////////////////////////////////////////////
+void Ogre2Visual::MarkDataChanged()
+{
+  if (this->scene)
+    this->scene->MarkVisualDataChanged(this->Id());
+}
+
 //////////////////////////////////////////////////
 GeometryStorePtr Ogre2Visual::Geometries() const
 {
@@ -169,6 +187,7 @@ bool Ogre2Visual::AttachGeometry(GeometryPtr _geometry)
 
   derived->SetParent(this->SharedThis());
   this->ogreNode->attachObject(ogreObj);
+  this->MarkDataChanged();
 
   return true;
 }
@@ -196,11 +215,12 @@ bool Ogre2Visual::DetachGeometry(GeometryPtr _geometry)
   if (nullptr != derived->OgreObject())
     this->ogreNode->detachObject(derived->OgreObject());
   derived->SetParent(nullptr);
+  this->MarkDataChanged();
   return true;
 }
 
 //////////////////////////////////////////////////
-ignition::math::AxisAlignedBox Ogre2Visual::LocalBoundingBox() const
+ignition::math::AxisAlignedBox Ogre2Visual::LocalBoundingBoxImpl() const
 {
   ignition::math::AxisAlignedBox box;
   this->BoundsHelper(box, true /* local frame */);
@@ -208,10 +228,23 @@ ignition::math::AxisAlignedBox Ogre2Visual::LocalBoundingBox() const
 }
 
 //////////////////////////////////////////////////
-ignition::math::AxisAlignedBox Ogre2Visual::BoundingBox() const
+ignition::math::AxisAlignedBox Ogre2Visual::BoundingBoxImpl() const
 {
   ignition::math::AxisAlignedBox box;
-  this->BoundsHelper(box, false /* world frame */);
+  this->AttachedObjectBounds(box, false /* world frame */, this->WorldPose());
+
+  // world frame boxes can be merged without loss of precision so reuse the
+  // cached bounding boxes of the child visuals
+  auto childNodes = std::dynamic_pointer_cast<Ogre2NodeStore>(this->Children());
+  if (!childNodes)
+    return box;
+
+  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
+  {
+    Ogre2VisualPtr visual = std::dynamic_pointer_cast<Ogre2Visual>(it->second);
+    if (visual)
+      box.Merge(visual->BoundingBox());
+  }
   return box;
 }
 
@@ -229,6 +262,28 @@ void Ogre2Visual::BoundsHelper(ignition::math::AxisAlignedBox &_box,
   if (!this->ogreNode)
     return;
 
+  this->AttachedObjectBounds(_box, _local, _pose);
+
+  auto childNodes = std::dynamic_pointer_cast<Ogre2NodeStore>(this->Children());
+  if (!childNodes)
+    return;
+
+  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
+  {
+    NodePtr child = it->second;
+    Ogre2VisualPtr visual = std::dynamic_pointer_cast<Ogre2Visual>(child);
+    if (visual)
+      visual->BoundsHelper(_box, _local, _pose);
+  }
+}
+
+//////////////////////////////////////////////////
+void Ogre2Visual::AttachedObjectBounds(ignition::math::AxisAlignedBox &_box,
+    bool _local, const ignition::math::Pose3d &_pose) const
+{
+  if (!this->ogreNode)
+    return;
+
   ignition::math::Vector3d scale = this->WorldScale();
 
   for (size_t i = 0; i < this->ogreNode->numAttachedObjects(); i++)
@@ -282,18 +337,6 @@ void Ogre2Visual::BoundsHelper(ignition::math::AxisAlignedBox &_box,
       _box.Merge(box);
     }
   }
-
-  auto childNodes = std::dynamic_pointer_cast<Ogre2NodeStore>(this->Children());
-  if (!childNodes)
-    return;
-
-  for (auto it = childNodes->Begin(); it != childNodes->End(); ++it)
-  {
-    NodePtr child = it->second;
-    Ogre2VisualPtr visual = std::dynamic_pointer_cast<Ogre2Visual>(child);
-    if (visual)
-      visual->BoundsHelper(_box, _local, _pose);
-  }
 }
 
 //////////////////////////////////////////////////
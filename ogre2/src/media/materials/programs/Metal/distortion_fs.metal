@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// For details and documentation see: distortion_fs.glsl
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct PS_INPUT
+{
+  float2 uv0;
+};
+
+struct Params
+{
+  // Scale the input texture if necessary to crop black border
+  float3 scale;
+};
+
+fragment float4 main_metal
+(
+  PS_INPUT inPs [[stage_in]],
+  texture2d<float> RT [[texture(0)]],
+  texture2d<float> distortionMap [[texture(1)]],
+  sampler rtSampler [[sampler(0)]],
+  sampler mapSampler [[sampler(1)]],
+  constant Params &p [[buffer(PARAMETER_SLOT)]]
+)
+{
+  float2 scaleCenter = float2(0.5, 0.5);
+  float2 inputUV = (inPs.uv0.xy - scaleCenter) / p.scale.xy + scaleCenter;
+  float2 mapUV = distortionMap.sample(mapSampler, inputUV).xy;
+
+  if (mapUV.x < 0.0 || mapUV.y < 0.0)
+    return float4(0.0, 0.0, 0.0, 1.0);
+  return RT.sample(rtSampler, mapUV);
+}
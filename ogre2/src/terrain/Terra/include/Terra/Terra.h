@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreMovableObject.h"
 #include "OgreShaderParams.h"
+#include "OgreTextureBox.h"
 
 #include "Terra/TerrainCell.h"
 
@@ -99,6 +100,14 @@ namespace Ogre
         Vector3             m_prevLightDir;
         ShadowMapper        *m_shadowMapper;
 
+        /// Number of heightmap rows uploaded by each streamHeightMap call.
+        /// 0 uploads the whole heightmap in load
+        uint32              m_heightMapUploadRows;
+        /// Number of heightmap rows already uploaded to m_heightMapTex
+        uint32              m_uploadedRows;
+        /// Image data the remaining rows are uploaded from
+        TextureBox          m_pendingHeightMap;
+
         /// When rendering shadows we want to override the data calculated by update
         /// but only temporarily, for later restoring it.
         SavedState m_savedState;
@@ -128,9 +137,16 @@ namespace Ogre
         /// Called by @see createHeightmap
         void createHeightmapTexture( const Image2 &image, const String &imageName );
 
+        /// Uploads numRows rows of srcBox, starting at firstRow, to m_heightMapTex
+        void uploadHeightmapRows( const TextureBox &srcBox, uint32 firstRow, uint32 numRows );
+
         /// Calls createHeightmapTexture, loads image data to our CPU-side buffers
         void createHeightmap( Image2 &image, const String &imageName );
 
+        /// Creates the normal map, shadow mapper and descriptor set, which
+        /// need the whole heightmap to be in m_heightMapTex
+        void createHeightmapDependents(void);
+
         void createNormalTexture(void);
         void destroyNormalTexture(void);
 
@@ -189,6 +205,28 @@ namespace Ogre
         */
         void update( const Vector3 &lightDir, float lightEpsilon=1e-6f );
 
+        /** Sets how many rows of the heightmap are uploaded to the GPU by each call to
+            streamHeightMap, so that large heightmaps don't stall the frame they are loaded in.
+            Must be called before load. The terrain isn't rendered until all of the rows
+            are uploaded.
+        @param rows
+            Number of rows per call. 0 (default) uploads the whole heightmap in load.
+        @remarks
+            The image passed to load must outlive the upload.
+        */
+        void setHeightMapUploadRows( uint32 rows )      { m_heightMapUploadRows = rows; }
+        uint32 getHeightMapUploadRows(void) const       { return m_heightMapUploadRows; }
+
+        /** Uploads the next rows of a heightmap loaded with setHeightMapUploadRows.
+            Must be called once per frame, outside of compositor passes, until it returns true.
+        @return
+            True if the whole heightmap is loaded
+        */
+        bool streamHeightMap(void);
+
+        /// Returns true if the whole heightmap has been uploaded to the GPU
+        bool isHeightMapLoaded(void) const              { return m_uploadedRows >= m_depth; }
+
         void load( const String &texName, const Vector3 &center, const Vector3 &dimensions );
         void load( Image2 &image, Vector3 center, Vector3 dimensions,
                    const String &imageName = BLANKSTRING );
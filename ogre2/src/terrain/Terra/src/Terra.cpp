@@ -90,6 +90,8 @@ namespace Ogre
         m_normalMapTex( 0 ),
         m_prevLightDir( Vector3::ZERO ),
         m_shadowMapper( 0 ),
+        m_heightMapUploadRows( 0u ),
+        m_uploadedRows( 0u ),
         m_compositorManager( compositorManager ),
         m_camera( camera ),
         mHlmsTerraIndex( std::numeric_limits<uint32>::max() )
@@ -214,22 +216,67 @@ namespace Ogre
         m_heightMapTex->setPixelFormat( image.getPixelFormat() );
         m_heightMapTex->scheduleTransitionTo( GpuResidency::Resident );
 
-        StagingTexture *stagingTexture = textureManager->getStagingTexture( image.getWidth(),
-                                                                            image.getHeight(),
+        if( m_heightMapUploadRows > 0u && m_heightMapUploadRows < image.getHeight() )
+        {
+            //Rows are uploaded by streamHeightMap
+            m_pendingHeightMap = image.getData( 0 );
+            m_uploadedRows = 0u;
+            return;
+        }
+
+        //for( uint8 mip=0; mip<numMipmaps; ++mip )
+        uploadHeightmapRows( image.getData( 0 ), 0u, image.getHeight() );
+        m_uploadedRows = image.getHeight();
+
+        m_heightMapTex->notifyDataIsReady();
+    }
+    //-----------------------------------------------------------------------------------
+    void Terra::uploadHeightmapRows( const TextureBox &srcBox, uint32 firstRow, uint32 numRows )
+    {
+        const PixelFormatGpu pixelFormat = m_heightMapTex->getPixelFormat();
+        const uint32 width = static_cast<uint32>( srcBox.width );
+
+        TextureGpuManager *textureManager =
+                mManager->getDestinationRenderSystem()->getTextureGpuManager();
+        StagingTexture *stagingTexture = textureManager->getStagingTexture( width, numRows,
                                                                             1u, 1u,
-                                                                            image.getPixelFormat() );
+                                                                            pixelFormat );
         stagingTexture->startMapRegion();
-        TextureBox texBox = stagingTexture->mapRegion( image.getWidth(), image.getHeight(), 1u, 1u,
-                                                       image.getPixelFormat() );
+        TextureBox texBox = stagingTexture->mapRegion( width, numRows, 1u, 1u, pixelFormat );
 
-        //for( uint8 mip=0; mip<numMipmaps; ++mip )
-        texBox.copyFrom( image.getData( 0 ) );
+        TextureBox rows = srcBox;
+        rows.data = srcBox.at( 0, firstRow, 0 );
+        rows.height = numRows;
+        texBox.copyFrom( rows );
         stagingTexture->stopMapRegion();
-        stagingTexture->upload( texBox, m_heightMapTex, 0, 0, 0 );
+
+        TextureBox dstBox = m_heightMapTex->getEmptyBox( 0 );
+        dstBox.y = firstRow;
+        dstBox.height = numRows;
+        stagingTexture->upload( texBox, m_heightMapTex, 0, 0, &dstBox );
         textureManager->removeStagingTexture( stagingTexture );
         stagingTexture = 0;
+    }
+    //-----------------------------------------------------------------------------------
+    bool Terra::streamHeightMap(void)
+    {
+        if( isHeightMapLoaded() )
+            return true;
+
+        uint32 numRows = m_depth - m_uploadedRows;
+        if( m_heightMapUploadRows > 0u )
+            numRows = std::min( numRows, m_heightMapUploadRows );
+
+        uploadHeightmapRows( m_pendingHeightMap, m_uploadedRows, numRows );
+        m_uploadedRows += numRows;
 
+        if( !isHeightMapLoaded() )
+            return false;
+
+        m_pendingHeightMap = TextureBox();
         m_heightMapTex->notifyDataIsReady();
+        createHeightmapDependents();
+        return true;
     }
     //-----------------------------------------------------------------------------------
     void Terra::createHeightmap( Image2 &image, const String &imageName )
@@ -287,6 +334,23 @@ namespace Ogre
         m_xzRelativeSize = m_xzDimensions / Vector2( static_cast<Real>(m_width),
                                                      static_cast<Real>(m_depth) );
 
+        if( isHeightMapLoaded() )
+        {
+            createHeightmapDependents();
+        }
+        else
+        {
+            //Created by streamHeightMap once all rows are uploaded
+            destroyNormalTexture();
+            delete m_shadowMapper;
+            m_shadowMapper = 0;
+        }
+
+        calculateOptimumSkirtSize();
+    }
+    //-----------------------------------------------------------------------------------
+    void Terra::createHeightmapDependents(void)
+    {
         createNormalTexture();
 
         m_prevLightDir = Vector3::ZERO;
@@ -296,8 +360,6 @@ namespace Ogre
         m_shadowMapper->createShadowMap( getId(), m_heightMapTex );
 
         createDescriptorSet();
-
-        calculateOptimumSkirtSize();
     }
     //-----------------------------------------------------------------------------------
     void Terra::createNormalTexture(void)
@@ -525,6 +587,14 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     void Terra::update( const Vector3 &lightDir, float lightEpsilon )
     {
+        if( !isHeightMapLoaded() )
+        {
+            //Nothing to render until streamHeightMap is done
+            mRenderables.clear();
+            m_currentCell = 0;
+            return;
+        }
+
         const float lightCosAngleChange = Math::Clamp(
                     (float)m_prevLightDir.dotProduct( lightDir.normalisedCopy() ), -1.0f, 1.0f );
         if( lightCosAngleChange <= (1.0f - lightEpsilon) )
@@ -654,7 +724,11 @@ namespace Ogre
         Ogre::Image2 image;
         image.load( texName, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME );
 
+        //The image doesn't outlive this call, so it can't be streamed
+        const uint32 heightMapUploadRows = m_heightMapUploadRows;
+        m_heightMapUploadRows = 0u;
         load( image, center, dimensions, texName );
+        m_heightMapUploadRows = heightMapUploadRows;
     }
     //-----------------------------------------------------------------------------------
     void Terra::load( Image2 &image, Vector3 center,
@@ -804,7 +878,7 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     Ogre::TextureGpu* Terra::_getShadowMapTex(void) const
     {
-        return m_shadowMapper->getShadowMapTex();
+        return m_shadowMapper ? m_shadowMapper->getShadowMapTex() : 0;
     }
     //-----------------------------------------------------------------------------------
     Vector3 Terra::getTerrainOrigin( void ) const { return fromYUpSignPreserving( m_terrainOrigin ); }
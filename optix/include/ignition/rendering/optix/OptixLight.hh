@@ -67,6 +67,8 @@ namespace ignition
 
       protected: virtual void WritePoseToDeviceImpl();
 
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       protected: virtual OptixCommonLightData &CommonData() = 0;
 
       protected: virtual const OptixCommonLightData &CommonData() const = 0;
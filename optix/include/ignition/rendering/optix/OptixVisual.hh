@@ -40,6 +40,8 @@ namespace ignition
 
       public: virtual void PreRender();
 
+      protected: virtual bool PreRenderEveryFrame() const override;
+
       protected: virtual GeometryStorePtr Geometries() const;
 
       protected: virtual bool AttachGeometry(GeometryPtr _geometry);
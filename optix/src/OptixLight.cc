@@ -136,6 +136,13 @@ void OptixLight::WritePoseToDeviceImpl()
   _data.position.z = worldPose.Pos().Z();
 }
 
+//////////////////////////////////////////////////
+bool OptixLight::PreRenderEveryFrame() const
+{
+  // lights are added to the light manager every frame
+  return true;
+}
+
 //////////////////////////////////////////////////
 void OptixLight::Init()
 {
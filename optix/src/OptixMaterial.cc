@@ -57,6 +57,7 @@ void OptixMaterial::SetLightingEnabled(const bool _enabled)
 {
   this->lightingEnabled = _enabled;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -70,6 +71,7 @@ void OptixMaterial::SetAmbient(const math::Color &_color)
 {
   this->ambient = _color;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -83,6 +85,7 @@ void OptixMaterial::SetDiffuse(const math::Color &_color)
 {
   this->diffuse = _color;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -96,6 +99,7 @@ void OptixMaterial::SetSpecular(const math::Color &_color)
 {
   this->specular = _color;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void OptixMaterial::SetEmissive(const math::Color &_color)
 {
   this->emissive = _color;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -122,6 +127,7 @@ void OptixMaterial::SetShininess(const double _shininess)
 {
   this->shininess = _shininess;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -135,6 +141,7 @@ void OptixMaterial::SetTransparency(const double _transparency)
 {
   this->transparency = std::min(std::max(_transparency, 0.0), 1.0);
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -148,6 +155,7 @@ void OptixMaterial::SetReflectivity(const double _reflectivity)
 {
   this->reflectivity = std::min(std::max(_reflectivity, 0.0), 1.0);
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -161,6 +169,7 @@ void OptixMaterial::SetCastShadows(const bool _castShadows)
 {
   this->castShadows = _castShadows;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -174,6 +183,7 @@ void OptixMaterial::SetReceiveShadows(const bool _receiveShadows)
 {
   this->receiveShadows = _receiveShadows;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -187,6 +197,7 @@ void OptixMaterial::SetReflectionEnabled(const bool _reflectionEnabled)
 {
   this->reflectionEnabled = _reflectionEnabled;
   this->colorDirty = true;
+  this->SetPreRenderDirty();
 }
 
 //////////////////////////////////////////////////
@@ -212,6 +223,7 @@ void OptixMaterial::SetTexture(const std::string &_name)
   {
     this->textureName = _name;
     this->textureDirty = true;
+    this->SetPreRenderDirty();
   }
 }
 
@@ -222,6 +234,7 @@ void OptixMaterial::ClearTexture()
   {
     this->textureName = "";
     this->textureDirty = true;
+    this->SetPreRenderDirty();
   }
 }
 
@@ -248,6 +261,7 @@ void OptixMaterial::SetNormalMap(const std::string &_name)
   {
     this->normalMapName = _name;
     this->normalMapDirty = true;
+    this->SetPreRenderDirty();
   }
 }
 
@@ -258,6 +272,7 @@ void OptixMaterial::ClearNormalMap()
   {
     this->normalMapName = "";
     this->normalMapDirty = true;
+    this->SetPreRenderDirty();
   }
 }
 
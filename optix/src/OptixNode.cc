@@ -200,6 +200,7 @@ bool OptixNode::InheritScale() const
 void OptixNode::SetInheritScale(bool _inherit)
 {
   this->inheritScale = _inherit;
+  this->LocalTransformChanged(true);
 }
 
 //////////////////////////////////////////////////
@@ -62,6 +62,13 @@ void OptixVisual::PreRender()
   }
 }
 
+//////////////////////////////////////////////////
+bool OptixVisual::PreRenderEveryFrame() const
+{
+  // geometry scale is synced with the world scale every frame
+  return true;
+}
+
 //////////////////////////////////////////////////
 GeometryStorePtr OptixVisual::Geometries() const
 {
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/SubMesh.hh>
+
+#include "ignition/rendering/Bvh.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+namespace
+{
+/// \brief Node of a bounding volume hierarchy
+struct BvhNode
+{
+  /// \brief Minimum corner of the node bounds
+  math::Vector3d min;
+
+  /// \brief Maximum corner of the node bounds
+  math::Vector3d max;
+
+  /// \brief For leaves, index in the primitive order of the first
+  /// primitive. Otherwise index of the first of the two child nodes, the
+  /// second one follows it.
+  unsigned int offset = 0u;
+
+  /// \brief Number of primitives in a leaf, 0 for interior nodes
+  unsigned int count = 0u;
+};
+
+/// \brief Nodes and primitive order of a bounding volume hierarchy
+struct BvhData
+{
+  /// \brief Nodes, the root is the first one
+  std::vector<BvhNode> nodes;
+
+  /// \brief Primitive indices, sorted so that the primitives of each leaf
+  /// are contiguous
+  std::vector<unsigned int> order;
+};
+
+/// \brief Maximum number of primitives in a leaf
+static const unsigned int kMaxLeafSize = 4u;
+
+/// \brief Maximum depth of the hierarchy. The median split halves the
+/// primitives at every level so this is never reached in practice.
+static const unsigned int kMaxDepth = 64u;
+
+/////////////////////////////////////////////////
+/// \brief Build a hierarchy by splitting the primitives at the median
+/// centroid along the axis where the centroids are the most spread out.
+/// Primitives with empty or non finite bounds are left out.
+/// \param[in] _mins Minimum corner of each primitive
+/// \param[in] _maxs Maximum corner of each primitive
+/// \param[out] _data Hierarchy
+void buildBvh(const std::vector<math::Vector3d> &_mins,
+    const std::vector<math::Vector3d> &_maxs, BvhData &_data)
+{
+  _data.nodes.clear();
+  _data.order.clear();
+
+  std::vector<math::Vector3d> centroids(_mins.size());
+  for (unsigned int i = 0u; i < _mins.size(); ++i)
+  {
+    if (!_mins[i].IsFinite() || !_maxs[i].IsFinite() ||
+        _mins[i].X() > _maxs[i].X() || _mins[i].Y() > _maxs[i].Y() ||
+        _mins[i].Z() > _maxs[i].Z())
+    {
+      continue;
+    }
+    centroids[i] = (_mins[i] + _maxs[i]) * 0.5;
+    _data.order.push_back(i);
+  }
+
+  if (_data.order.empty())
+    return;
+
+  struct BuildTask
+  {
+    unsigned int node;
+    unsigned int first;
+    unsigned int count;
+    unsigned int depth;
+  };
+
+  _data.nodes.reserve(2u * _data.order.size() / kMaxLeafSize + 1u);
+  _data.nodes.emplace_back();
+  std::vector<BuildTask> tasks;
+  tasks.push_back({0u, 0u, static_cast<unsigned int>(_data.order.size()), 0u});
+  while (!tasks.empty())
+  {
+    BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    math::Vector3d boundsMin = _mins[_data.order[task.first]];
+    math::Vector3d boundsMax = _maxs[_data.order[task.first]];
+    math::Vector3d centroidMin = centroids[_data.order[task.first]];
+    math::Vector3d centroidMax = centroidMin;
+    for (unsigned int i = task.first + 1u; i < task.first + task.count; ++i)
+    {
+      unsigned int prim = _data.order[i];
+      boundsMin.Min(_mins[prim]);
+      boundsMax.Max(_maxs[prim]);
+      centroidMin.Min(centroids[prim]);
+      centroidMax.Max(centroids[prim]);
+    }
+
+    BvhNode &node = _data.nodes[task.node];
+    node.min = boundsMin;
+    node.max = boundsMax;
+
+    math::Vector3d extent = centroidMax - centroidMin;
+    int axis = 0;
+    if (extent.Y() > extent[axis])
+      axis = 1;
+    if (extent.Z() > extent[axis])
+      axis = 2;
+
+    // all the centroids are at the same spot, splitting would not help
+    if (task.count <= kMaxLeafSize || extent[axis] <= 0.0 ||
+        task.depth + 1u >= kMaxDepth)
+    {
+      node.offset = task.first;
+      node.count = task.count;
+      continue;
+    }
+
+    unsigned int half = task.count / 2u;
+    auto begin = _data.order.begin() + task.first;
+    std::nth_element(begin, begin + half, begin + task.count,
+        [&](unsigned int _a, unsigned int _b)
+        {
+          return centroids[_a][axis] < centroids[_b][axis];
+        });
+
+    unsigned int left = static_cast<unsigned int>(_data.nodes.size());
+    node.offset = left;
+    node.count = 0u;
+    // node is invalidated from here on
+    _data.nodes.emplace_back();
+    _data.nodes.emplace_back();
+    tasks.push_back({left, task.first, half, task.depth + 1u});
+    tasks.push_back({left + 1u, task.first + half, task.count - half,
+        task.depth + 1u});
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Slab test of a ray against the bounds of a node
+/// \param[in] _node Node to test
+/// \param[in] _origin Ray origin
+/// \param[in] _invDir Inverse of each component of the ray direction
+/// \param[in] _maxDist Hits further than this are ignored
+/// \param[out] _entry Distance at which the ray enters the node bounds
+/// \return True if the ray crosses the node bounds
+inline bool rayBox(const BvhNode &_node, const math::Vector3d &_origin,
+    const math::Vector3d &_invDir, double _maxDist, double &_entry)
+{
+  // a ray parallel to a slab and starting on its boundary gives NaN, which
+  // std::min / std::max drop in favor of the current interval
+  double tMin = 0.0;
+  double tMax = _maxDist;
+  for (unsigned int i = 0u; i < 3u; ++i)
+  {
+    double t1 = (_node.min[i] - _origin[i]) * _invDir[i];
+    double t2 = (_node.max[i] - _origin[i]) * _invDir[i];
+    tMin = std::max(tMin, std::min(t1, t2));
+    tMax = std::min(tMax, std::max(t1, t2));
+  }
+  _entry = tMin;
+  return tMin <= tMax;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the closest primitive hit by a ray, visiting the nodes
+/// closest first and skipping nodes further than the closest hit so far.
+/// \param[in] _data Hierarchy
+/// \param[in] _origin Ray origin
+/// \param[in] _dir Ray direction
+/// \param[in] _intersect Function that tests the ray against a primitive
+/// \param[out] _distance Distance to the closest hit
+/// \param[out] _index Index of the closest primitive hit
+/// \return True if a primitive was hit
+template <typename F>
+bool traverseBvh(const BvhData &_data, const math::Vector3d &_origin,
+    const math::Vector3d &_dir, const F &_intersect, double &_distance,
+    unsigned int &_index)
+{
+  if (_data.nodes.empty())
+    return false;
+
+  math::Vector3d invDir(1.0 / _dir.X(), 1.0 / _dir.Y(), 1.0 / _dir.Z());
+  double best = std::numeric_limits<double>::infinity();
+  bool hit = false;
+
+  unsigned int stack[kMaxDepth + 1u];
+  unsigned int top = 0u;
+  stack[top++] = 0u;
+  while (top > 0u)
+  {
+    const BvhNode &node = _data.nodes[stack[--top]];
+    double tNear;
+    if (!rayBox(node, _origin, invDir, best, tNear))
+      continue;
+
+    if (node.count > 0u)
+    {
+      for (unsigned int i = node.offset; i < node.offset + node.count; ++i)
+      {
+        unsigned int prim = _data.order[i];
+        double t;
+        if (_intersect(prim, t) && t < best)
+        {
+          best = t;
+          _index = prim;
+          hit = true;
+        }
+      }
+      continue;
+    }
+
+    // push the far child first so that the near one is visited first
+    double nearLeft;
+    double nearRight;
+    bool hitLeft = rayBox(_data.nodes[node.offset], _origin, invDir, best,
+        nearLeft);
+    bool hitRight = rayBox(_data.nodes[node.offset + 1u], _origin, invDir,
+        best, nearRight);
+    if (hitLeft && hitRight)
+    {
+      bool leftFirst = nearLeft <= nearRight;
+      stack[top++] = leftFirst ? node.offset + 1u : node.offset;
+      stack[top++] = leftFirst ? node.offset : node.offset + 1u;
+    }
+    else if (hitLeft)
+    {
+      stack[top++] = node.offset;
+    }
+    else if (hitRight)
+    {
+      stack[top++] = node.offset + 1u;
+    }
+  }
+
+  if (hit)
+    _distance = best;
+  return hit;
+}
+
+/////////////////////////////////////////////////
+/// \brief Moller-Trumbore ray triangle intersection, front faces only.
+/// \param[in] _origin Ray origin
+/// \param[in] _dir Ray direction
+/// \param[in] _a First vertex
+/// \param[in] _b Second vertex
+/// \param[in] _c Third vertex
+/// \param[out] _t Hit distance
+/// \return True if the ray hits the front face of the triangle
+inline bool rayTriangle(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, const math::Vector3d &_a,
+    const math::Vector3d &_b, const math::Vector3d &_c, double &_t)
+{
+  math::Vector3d e1 = _b - _a;
+  math::Vector3d e2 = _c - _a;
+  math::Vector3d p = _dir.Cross(e2);
+  // det is minus the dot product of the ray with the triangle normal so it
+  // is positive for front faces
+  double det = e1.Dot(p);
+  if (det <= 0.0)
+    return false;
+
+  double invDet = 1.0 / det;
+  math::Vector3d s = _origin - _a;
+  double u = s.Dot(p) * invDet;
+  if (u < 0.0 || u > 1.0)
+    return false;
+
+  math::Vector3d q = s.Cross(e1);
+  double v = _dir.Dot(q) * invDet;
+  if (v < 0.0 || u + v > 1.0)
+    return false;
+
+  _t = e2.Dot(q) * invDet;
+  return _t >= 0.0;
+}
+}
+
+/// \brief Private data for the Bvh class
+class ignition::rendering::BvhPrivate
+{
+  /// \brief Hierarchy
+  public: BvhData data;
+
+  /// \brief Number of primitives passed to Build
+  public: unsigned int primitiveCount = 0u;
+};
+
+/// \brief Private data for the MeshBvh class
+class ignition::rendering::MeshBvhPrivate
+{
+  /// \brief Build the hierarchy from the triangles
+  public: void Build();
+
+  /// \brief Triangle vertices, three per triangle
+  public: std::vector<math::Vector3d> vertices;
+
+  /// \brief Hierarchy over the triangles
+  public: BvhData data;
+
+  /// \brief Bounding box of the mesh
+  public: math::AxisAlignedBox box;
+};
+
+//////////////////////////////////////////////////
+void MeshBvhPrivate::Build()
+{
+  size_t triangleCount = this->vertices.size() / 3u;
+  std::vector<math::Vector3d> mins(triangleCount);
+  std::vector<math::Vector3d> maxs(triangleCount);
+  for (size_t i = 0u; i < triangleCount; ++i)
+  {
+    const math::Vector3d *v = &this->vertices[i * 3u];
+    mins[i] = v[0];
+    mins[i].Min(v[1]);
+    mins[i].Min(v[2]);
+    maxs[i] = v[0];
+    maxs[i].Max(v[1]);
+    maxs[i].Max(v[2]);
+  }
+  buildBvh(mins, maxs, this->data);
+
+  if (!this->data.nodes.empty())
+  {
+    this->box = math::AxisAlignedBox(this->data.nodes[0].min,
+        this->data.nodes[0].max);
+  }
+}
+
+//////////////////////////////////////////////////
+Bvh::Bvh()
+  : dataPtr(new BvhPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+Bvh::~Bvh()
+{
+}
+
+//////////////////////////////////////////////////
+void Bvh::Build(const std::vector<math::AxisAlignedBox> &_boxes)
+{
+  std::vector<math::Vector3d> mins(_boxes.size());
+  std::vector<math::Vector3d> maxs(_boxes.size());
+  for (unsigned int i = 0u; i < _boxes.size(); ++i)
+  {
+    mins[i] = _boxes[i].Min();
+    maxs[i] = _boxes[i].Max();
+  }
+  buildBvh(mins, maxs, this->dataPtr->data);
+  this->dataPtr->primitiveCount = static_cast<unsigned int>(_boxes.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int Bvh::PrimitiveCount() const
+{
+  return this->dataPtr->primitiveCount;
+}
+
+//////////////////////////////////////////////////
+bool Bvh::Intersect(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, const IntersectFunc &_intersect,
+    double &_distance, unsigned int &_index) const
+{
+  if (!_intersect)
+    return false;
+
+  return traverseBvh(this->dataPtr->data, _origin, _dir, _intersect,
+      _distance, _index);
+}
+
+//////////////////////////////////////////////////
+MeshBvh::MeshBvh(const std::vector<math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+  : dataPtr(new MeshBvhPrivate)
+{
+  this->dataPtr->vertices.reserve(_indices.size());
+  for (size_t i = 0u; i + 2u < _indices.size(); i += 3u)
+  {
+    if (_indices[i] >= _vertices.size() ||
+        _indices[i + 1u] >= _vertices.size() ||
+        _indices[i + 2u] >= _vertices.size())
+    {
+      continue;
+    }
+    this->dataPtr->vertices.push_back(_vertices[_indices[i]]);
+    this->dataPtr->vertices.push_back(_vertices[_indices[i + 1u]]);
+    this->dataPtr->vertices.push_back(_vertices[_indices[i + 2u]]);
+  }
+  this->dataPtr->Build();
+}
+
+//////////////////////////////////////////////////
+MeshBvh::MeshBvh(const MeshDescriptor &_desc)
+  : dataPtr(new MeshBvhPrivate)
+{
+  if (!_desc.mesh)
+  {
+    this->dataPtr->Build();
+    return;
+  }
+
+  this->dataPtr->vertices.reserve(_desc.mesh->IndexCount());
+  for (unsigned int i = 0u; i < _desc.mesh->SubMeshCount(); ++i)
+  {
+    auto s = _desc.mesh->SubMeshByIndex(i).lock();
+    if (!s || (!_desc.subMeshName.empty() && s->Name() != _desc.subMeshName) ||
+        s->SubMeshPrimitiveType() != common::SubMesh::TRIANGLES)
+    {
+      continue;
+    }
+
+    // copy the submesh only when it has to be modified
+    std::unique_ptr<common::SubMesh> centered;
+    const common::SubMesh *submesh = s.get();
+    if (_desc.centerSubMesh)
+    {
+      centered.reset(new common::SubMesh(*submesh));
+      centered->Center(math::Vector3d::Zero);
+      submesh = centered.get();
+    }
+
+    unsigned int vertexCount = submesh->VertexCount();
+    unsigned int indexCount = submesh->IndexCount();
+    for (unsigned int j = 0u; j + 2u < indexCount; j += 3u)
+    {
+      int a = submesh->Index(j);
+      int b = submesh->Index(j + 1u);
+      int c = submesh->Index(j + 2u);
+      if (a < 0 || b < 0 || c < 0 ||
+          static_cast<unsigned int>(a) >= vertexCount ||
+          static_cast<unsigned int>(b) >= vertexCount ||
+          static_cast<unsigned int>(c) >= vertexCount)
+      {
+        continue;
+      }
+      this->dataPtr->vertices.push_back(
+          submesh->Vertex(static_cast<unsigned int>(a)));
+      this->dataPtr->vertices.push_back(
+          submesh->Vertex(static_cast<unsigned int>(b)));
+      this->dataPtr->vertices.push_back(
+          submesh->Vertex(static_cast<unsigned int>(c)));
+    }
+  }
+  this->dataPtr->Build();
+}
+
+//////////////////////////////////////////////////
+MeshBvh::~MeshBvh()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshBvh::TriangleCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->vertices.size() / 3u);
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox MeshBvh::BoundingBox() const
+{
+  return this->dataPtr->box;
+}
+
+//////////////////////////////////////////////////
+bool MeshBvh::Intersect(const math::Vector3d &_origin,
+    const math::Vector3d &_dir, double &_distance) const
+{
+  const std::vector<math::Vector3d> &vertices = this->dataPtr->vertices;
+  unsigned int index;
+  return traverseBvh(this->dataPtr->data, _origin, _dir,
+      [&](unsigned int _triangle, double &_t)
+      {
+        const math::Vector3d *v = &vertices[_triangle * 3u];
+        return rayTriangle(_origin, _dir, v[0], v[1], v[2], _t);
+      }, _distance, index);
+}
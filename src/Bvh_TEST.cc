@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/MeshManager.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Bvh.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+/// \brief Unit cube centered at the origin, with outward facing triangles
+static void unitCube(std::vector<math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  for (unsigned int i = 0u; i < 8u; ++i)
+  {
+    _vertices.push_back(math::Vector3d(
+        (i & 1u) ? 0.5 : -0.5,
+        (i & 2u) ? 0.5 : -0.5,
+        (i & 4u) ? 0.5 : -0.5));
+  }
+  _indices = {
+    0, 2, 3,  0, 3, 1,  // -z
+    4, 5, 7,  4, 7, 6,  // +z
+    0, 1, 5,  0, 5, 4,  // -y
+    2, 6, 7,  2, 7, 3,  // +y
+    0, 4, 6,  0, 6, 2,  // -x
+    1, 3, 7,  1, 7, 5   // +x
+  };
+}
+
+/////////////////////////////////////////////////
+/// \brief Brute force ray triangle test used as reference
+static bool bruteForce(const std::vector<math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices, const math::Vector3d &_origin,
+    const math::Vector3d &_dir, double &_distance)
+{
+  std::vector<unsigned int> one(3u);
+  bool hit = false;
+  for (unsigned int i = 0u; i + 2u < _indices.size(); i += 3u)
+  {
+    one = {_indices[i], _indices[i + 1u], _indices[i + 2u]};
+    MeshBvh triangle(_vertices, one);
+    double t;
+    if (triangle.Intersect(_origin, _dir, t) && (!hit || t < _distance))
+    {
+      _distance = t;
+      hit = true;
+    }
+  }
+  return hit;
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, MeshBvhCube)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  unitCube(vertices, indices);
+
+  MeshBvh bvh(vertices, indices);
+  EXPECT_EQ(12u, bvh.TriangleCount());
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, -0.5), bvh.BoundingBox().Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 0.5), bvh.BoundingBox().Max());
+
+  // hit the front faces from outside
+  double distance = 0.0;
+  EXPECT_TRUE(bvh.Intersect(math::Vector3d(-2, 0.1, 0.2),
+      math::Vector3d(1, 0, 0), distance));
+  EXPECT_DOUBLE_EQ(1.5, distance);
+
+  EXPECT_TRUE(bvh.Intersect(math::Vector3d(0.1, 0.2, 3),
+      math::Vector3d(0, 0, -2), distance));
+  EXPECT_DOUBLE_EQ(1.25, distance);
+
+  // miss
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d(-2, 2, 0),
+      math::Vector3d(1, 0, 0), distance));
+
+  // pointing away
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d(-2, 0, 0),
+      math::Vector3d(-1, 0, 0), distance));
+
+  // back faces are not hit from inside
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d::Zero,
+      math::Vector3d(1, 0, 0), distance));
+
+  // invalid indices are skipped
+  indices.push_back(0u);
+  indices.push_back(1u);
+  indices.push_back(100u);
+  MeshBvh bvh2(vertices, indices);
+  EXPECT_EQ(12u, bvh2.TriangleCount());
+
+  // empty mesh
+  MeshBvh empty({}, {});
+  EXPECT_EQ(0u, empty.TriangleCount());
+  EXPECT_FALSE(empty.Intersect(math::Vector3d(-2, 0, 0),
+      math::Vector3d(1, 0, 0), distance));
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, MeshBvhRandomTriangles)
+{
+  std::mt19937 rng(1234u);
+  std::uniform_real_distribution<double> pos(-10.0, 10.0);
+  std::uniform_real_distribution<double> offset(-1.0, 1.0);
+
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0u; i < 500u; ++i)
+  {
+    math::Vector3d center(pos(rng), pos(rng), pos(rng));
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      indices.push_back(static_cast<unsigned int>(vertices.size()));
+      vertices.push_back(center +
+          math::Vector3d(offset(rng), offset(rng), offset(rng)));
+    }
+  }
+
+  MeshBvh bvh(vertices, indices);
+  EXPECT_EQ(500u, bvh.TriangleCount());
+
+  unsigned int hits = 0u;
+  for (unsigned int i = 0u; i < 200u; ++i)
+  {
+    math::Vector3d origin(pos(rng), pos(rng), pos(rng));
+    math::Vector3d dir(offset(rng), offset(rng), offset(rng));
+
+    double expected = 0.0;
+    double actual = 0.0;
+    bool expectedHit = bruteForce(vertices, indices, origin, dir, expected);
+    bool actualHit = bvh.Intersect(origin, dir, actual);
+    ASSERT_EQ(expectedHit, actualHit) << i;
+    if (expectedHit)
+    {
+      EXPECT_DOUBLE_EQ(expected, actual) << i;
+      ++hits;
+    }
+  }
+  // make sure the comparison covers hits too
+  EXPECT_GT(hits, 0u);
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, MeshBvhFromMesh)
+{
+  common::MeshManager::Instance()->CreateBox("bvh_test_box",
+      math::Vector3d(2, 2, 2), math::Vector2d(1, 1));
+  const common::Mesh *mesh =
+      common::MeshManager::Instance()->MeshByName("bvh_test_box");
+  ASSERT_NE(nullptr, mesh);
+
+  MeshBvh bvh{MeshDescriptor(mesh)};
+  EXPECT_EQ(12u, bvh.TriangleCount());
+  EXPECT_EQ(math::Vector3d(-1, -1, -1), bvh.BoundingBox().Min());
+  EXPECT_EQ(math::Vector3d(1, 1, 1), bvh.BoundingBox().Max());
+
+  double distance = 0.0;
+  EXPECT_TRUE(bvh.Intersect(math::Vector3d(5, 0, 0),
+      math::Vector3d(-1, 0, 0), distance));
+  EXPECT_DOUBLE_EQ(4.0, distance);
+
+  // unknown submesh
+  MeshDescriptor desc(mesh);
+  desc.subMeshName = "no_such_submesh";
+  MeshBvh none(desc);
+  EXPECT_EQ(0u, none.TriangleCount());
+
+  // descriptor without a mesh
+  MeshBvh empty{MeshDescriptor()};
+  EXPECT_EQ(0u, empty.TriangleCount());
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, Boxes)
+{
+  Bvh bvh;
+  EXPECT_EQ(0u, bvh.PrimitiveCount());
+
+  double distance = 0.0;
+  unsigned int index = 0u;
+  auto alwaysHit = [](unsigned int, double &_t)
+  {
+    _t = 0.0;
+    return true;
+  };
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d::Zero, math::Vector3d::UnitX,
+      alwaysHit, distance, index));
+
+  // a row of unit boxes along the x axis, plus an empty one
+  std::vector<math::AxisAlignedBox> boxes;
+  for (unsigned int i = 0u; i < 20u; ++i)
+  {
+    boxes.push_back(math::AxisAlignedBox(
+        math::Vector3d(i * 2.0, -0.5, -0.5),
+        math::Vector3d(i * 2.0 + 1.0, 0.5, 0.5)));
+  }
+  boxes.push_back(math::AxisAlignedBox());
+  bvh.Build(boxes);
+  EXPECT_EQ(21u, bvh.PrimitiveCount());
+
+  // primitives are hit at their box entry point
+  std::vector<unsigned int> tested;
+  auto boxHit = [&](unsigned int _index, double &_t)
+  {
+    tested.push_back(_index);
+    EXPECT_LT(_index, 20u);
+    _t = _index * 2.0 - 5.5;
+    return _t >= 0.0;
+  };
+
+  EXPECT_TRUE(bvh.Intersect(math::Vector3d(5.5, 0, 0), math::Vector3d::UnitX,
+      boxHit, distance, index));
+  EXPECT_EQ(3u, index);
+  EXPECT_DOUBLE_EQ(0.5, distance);
+  // boxes behind the ray and far away boxes are skipped
+  EXPECT_LT(tested.size(), boxes.size() / 2u);
+  for (auto t : tested)
+    EXPECT_GE(t, 2u);
+
+  // primitive rejected by the callback
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d(5.5, 0, 0), math::Vector3d::UnitX,
+      [](unsigned int, double &) { return false; }, distance, index));
+
+  // ray missing all boxes
+  EXPECT_FALSE(bvh.Intersect(math::Vector3d(0, 2, 0), math::Vector3d::UnitX,
+      alwaysHit, distance, index));
+
+  // rebuild with fewer boxes
+  boxes.resize(1u);
+  bvh.Build(boxes);
+  EXPECT_EQ(1u, bvh.PrimitiveCount());
+  EXPECT_TRUE(bvh.Intersect(math::Vector3d(-1, 0, 0), math::Vector3d::UnitX,
+      alwaysHit, distance, index));
+  EXPECT_EQ(0u, index);
+}
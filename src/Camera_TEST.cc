@@ -22,6 +22,7 @@
 #include "test_config.h"  // NOLINT(build/include)
 #include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/GaussianNoisePass.hh"
+#include "ignition/rendering/ImagePool.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/RenderPassSystem.hh"
@@ -47,6 +48,9 @@ class CameraTest : public testing::Test,
 
   /// \brief Test setting visibility mask
   public: void VisibilityMask(const std::string &_renderEngine);
+
+  /// \brief Test acquiring images from the camera image pool
+  public: void AcquireImage(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -356,6 +360,64 @@ void CameraTest::VisibilityMask(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void CameraTest::AcquireImage(const std::string &_renderEngine)
+{
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(80);
+  camera->SetImageHeight(60);
+  EXPECT_EQ(nullptr, camera->ImageBufferPool());
+
+  // acquired images are sized like the ones from CreateImage
+  Image created = camera->CreateImage();
+  Image acquired = camera->AcquireImage();
+  EXPECT_EQ(created.Width(), acquired.Width());
+  EXPECT_EQ(created.Height(), acquired.Height());
+  EXPECT_EQ(created.Format(), acquired.Format());
+  ImagePoolPtr pool = camera->ImageBufferPool();
+  ASSERT_NE(nullptr, pool);
+  EXPECT_EQ(1u, pool->AllocationCount());
+
+  // a capture loop that keeps the last frame only needs two buffers
+  for (unsigned int i = 0u; i < 10u; ++i)
+  {
+    Image image = camera->AcquireImage();
+    camera->Capture(image);
+    acquired = image;
+  }
+  EXPECT_EQ(2u, pool->AllocationCount());
+
+  // cameras can share a pool
+  CameraPtr camera2 = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera2);
+  camera2->SetImageWidth(80);
+  camera2->SetImageHeight(60);
+  camera2->SetImageBufferPool(pool);
+  EXPECT_EQ(pool, camera2->ImageBufferPool());
+  acquired = Image();
+  {
+    Image image = camera2->AcquireImage();
+    camera2->Capture(image);
+  }
+  EXPECT_EQ(2u, pool->AllocationCount());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(CameraTest, ViewProjectionMatrix)
 {
@@ -386,6 +448,12 @@ TEST_P(CameraTest, VisibilityMask)
   VisibilityMask(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(CameraTest, AcquireImage)
+{
+  AcquireImage(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(Camera, CameraTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
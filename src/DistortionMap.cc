@@ -0,0 +1,584 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+
+#include <ignition/math/Helpers.hh>
+
+#include "ignition/rendering/DistortionMap.hh"
+#include "ignition/rendering/detail/Hash.hh"
+
+/// \brief Private data for the DistortionMap class
+class ignition::rendering::DistortionMapPrivate
+{
+  /// \brief Width and height of the map in pixels
+  public: unsigned int size = 0u;
+
+  /// \brief Focal length in pixels
+  public: double focalLength = 1.0;
+
+  /// \brief Normalized distortion center
+  public: ignition::math::Vector2d center;
+
+  /// \brief Radial distortion coefficient k1
+  public: double k1 = 0.0;
+
+  /// \brief Radial distortion coefficient k2
+  public: double k2 = 0.0;
+
+  /// \brief Radial distortion coefficient k3
+  public: double k3 = 0.0;
+
+  /// \brief Tangential distortion coefficient p1
+  public: double p1 = 0.0;
+
+  /// \brief Tangential distortion coefficient p2
+  public: double p2 = 0.0;
+
+  /// \brief Map data, two floats per pixel
+  public: std::vector<float> data;
+
+  /// \brief Scale that crops the black corners of the distorted image
+  public: ignition::math::Vector2d cropScale = {1.0, 1.0};
+};
+
+using namespace ignition;
+using namespace rendering;
+
+/// \brief Magic number at the start of distortion map files
+static const char kFileMagic[8] = {'I', 'G', 'N', 'D', 'M', 'A', 'P', '1'};
+
+/// \brief Index of map pixels that no undistorted pixel maps to
+static const uint32_t kUnset = std::numeric_limits<uint32_t>::max();
+
+/// \brief Number of maps built
+static std::atomic<unsigned int> gBuildCount(0u);
+
+//////////////////////////////////////////////////
+/// \brief Apply Brown's distortion model, see
+/// http://en.wikipedia.org/wiki/Distortion_%28optics%29#Software_correction
+/// This is DistortionMap::Distort without the vector temporaries.
+static void distort(double _x, double _y, const DistortionMapPrivate &_p,
+    double &_outX, double &_outY)
+{
+  const double width = _p.size;
+  const double scale = width / _p.focalLength;
+  const double nx = (_x - _p.center.X()) * scale;
+  const double ny = (_y - _p.center.Y()) * scale;
+  const double rSq = nx * nx + ny * ny;
+
+  // radial
+  const double radial = 1.0 + _p.k1 * rSq + _p.k2 * rSq * rSq +
+      _p.k3 * rSq * rSq * rSq;
+  double dx = nx * radial;
+  double dy = ny * radial;
+
+  // tangential
+  dx += _p.p2 * (rSq + 2 * (nx * nx)) + 2 * _p.p1 * nx * ny;
+  dy += _p.p1 * (rSq + 2 * (ny * ny)) + 2 * _p.p2 * nx * ny;
+
+  _outX = (_p.center.X() * width + dx * _p.focalLength) / width;
+  _outY = (_p.center.Y() * width + dy * _p.focalLength) / width;
+}
+
+//////////////////////////////////////////////////
+/// \brief Run a function over the rows of a map, splitting them between
+/// worker threads for large maps
+/// \param[in] _rows Number of rows
+/// \param[in] _pixels Number of pixels of the map
+/// \param[in] _func Function called with a range of rows [begin, end)
+static void parallelRows(unsigned int _rows, size_t _pixels,
+    const std::function<void(unsigned int, unsigned int)> &_func)
+{
+  unsigned int threadCount = std::min(std::thread::hardware_concurrency(),
+      _rows);
+  if (threadCount <= 1u || _pixels < 65536u)
+  {
+    _func(0u, _rows);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0u; t < threadCount; ++t)
+  {
+    unsigned int begin = _rows * t / threadCount;
+    unsigned int end = _rows * (t + 1u) / threadCount;
+    threads.emplace_back(_func, begin, end);
+  }
+  for (auto &thread : threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+/// \brief Create the private data of a map
+static std::unique_ptr<DistortionMapPrivate> makeParams(unsigned int _size,
+    double _focalLength, const math::Vector2d &_center, double _k1,
+    double _k2, double _k3, double _p1, double _p2)
+{
+  auto p = std::make_unique<DistortionMapPrivate>();
+  p->size = _size;
+  p->focalLength = _focalLength;
+  p->center = _center;
+  p->k1 = _k1;
+  p->k2 = _k2;
+  p->k3 = _k3;
+  p->p1 = _p1;
+  p->p2 = _p2;
+  return p;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the parameters of a map, in the order they are written to
+/// map files
+static std::vector<double> params(const DistortionMapPrivate &_p)
+{
+  return {_p.focalLength, _p.center.X(), _p.center.Y(),
+      _p.k1, _p.k2, _p.k3, _p.p1, _p.p2};
+}
+
+//////////////////////////////////////////////////
+DistortionMap::DistortionMap(unsigned int _size, double _focalLength,
+    const math::Vector2d &_center, double _k1, double _k2, double _k3,
+    double _p1, double _p2)
+  : DistortionMap(makeParams(_size, _focalLength, _center, _k1, _k2, _k3,
+        _p1, _p2))
+{
+  this->Build();
+}
+
+//////////////////////////////////////////////////
+DistortionMap::DistortionMap(std::unique_ptr<DistortionMapPrivate> _dataPtr)
+  : dataPtr(std::move(_dataPtr))
+{
+  const DistortionMapPrivate &p = *this->dataPtr;
+
+  // Scale up the image to crop the black corners of barrel distortion.
+  // If not used with a square distortion map, this calculation will result
+  // in stretching of the final output image.
+  if (p.k1 < 0 && p.size > 0u)
+  {
+    double ax, ay, bx, by;
+    distort(0.0, 0.0, p, ax, ay);
+    distort(1.0, 1.0, p, bx, by);
+    math::Vector2d newScale(bx - ax, by - ay);
+    // If the scale is extremely small, don't crop
+    if (newScale.X() < 1e-7 || newScale.Y() < 1e-7)
+    {
+      ignerr << "Distortion model attempted to apply a scale parameter of ("
+             << newScale.X() << ", " << newScale.Y()
+             << "), which is invalid." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->cropScale = newScale;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+DistortionMap::~DistortionMap()
+{
+}
+
+//////////////////////////////////////////////////
+void DistortionMap::Build()
+{
+  const DistortionMapPrivate &p = *this->dataPtr;
+  const unsigned int n = p.size;
+  const size_t pixelCount = static_cast<size_t>(n) * n;
+  const double step = n > 0u ? 1.0 / n : 0.0;
+  // Half step size added to the mapped coordinates, necessary for the
+  // render pass to correctly interpolate pixel values
+  const double halfTexel = 0.5 * step;
+
+  // Map every undistorted pixel to the distorted pixel it lands on. This is
+  // where the time goes, and every pixel is independent.
+  std::vector<uint32_t> target(pixelCount);
+  parallelRows(n, pixelCount, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int row = _begin; row < _end; ++row)
+    {
+      for (unsigned int col = 0u; col < n; ++col)
+      {
+        double x, y;
+        distort(col * step, row * step, p, x, y);
+        double distortedCol = std::round(x * n);
+        double distortedRow = std::round(y * n);
+        uint32_t &t = target[static_cast<size_t>(row) * n + col];
+        // mapping outside of the image bounds is expected and normal to
+        // ensure no black borders
+        if (distortedCol >= 0.0 && distortedCol < n &&
+            distortedRow >= 0.0 && distortedRow < n)
+        {
+          t = static_cast<uint32_t>(distortedRow) * n +
+              static_cast<uint32_t>(distortedCol);
+        }
+        else
+        {
+          t = kUnset;
+        }
+      }
+    }
+  });
+
+  // Resolve pixels that several undistorted pixels land on. For significant
+  // distortions this makes sure the distorted image does not seem to fold
+  // over itself, by favoring pixels closer to the center of distortion.
+  // This runs in source order so the result does not depend on threading.
+  std::vector<uint32_t> source(pixelCount, kUnset);
+  const double centerX = p.center.X() * n;
+  const double centerY = p.center.Y() * n;
+  for (size_t i = 0u; i < pixelCount; ++i)
+  {
+    uint32_t t = target[i];
+    if (t == kUnset)
+      continue;
+    uint32_t &s = source[t];
+    if (s != kUnset)
+    {
+      // current and new coordinates that map to this destination
+      double curX = ((s % n) * step + halfTexel) * n - centerX;
+      double curY = ((s / n) * step + halfTexel) * n - centerY;
+      double newX = static_cast<double>(i % n) - centerX;
+      double newY = static_cast<double>(i / n) - centerY;
+      if (newX * newX + newY * newY < curX * curX + curY * curY)
+        s = static_cast<uint32_t>(i);
+    }
+    else
+    {
+      s = static_cast<uint32_t>(i);
+    }
+  }
+  target.clear();
+  target.shrink_to_fit();
+
+  // Write the map, filling pixels that nothing maps to by interpolating
+  // their eight neighbours
+  this->dataPtr->data.resize(pixelCount * 2u);
+  float *data = this->dataPtr->data.data();
+  parallelRows(n, pixelCount, [&](unsigned int _begin, unsigned int _end)
+  {
+    auto value = [&](int _x, int _y, double &_vx, double &_vy)
+    {
+      if (_x < 0 || _x >= static_cast<int>(n) ||
+          _y < 0 || _y >= static_cast<int>(n))
+      {
+        return false;
+      }
+      uint32_t s = source[static_cast<size_t>(_y) * n + _x];
+      if (s == kUnset)
+        return false;
+      _vx = (s % n) * step + halfTexel;
+      _vy = (s / n) * step + halfTexel;
+      return true;
+    };
+
+    const int offsets[8][2] = {
+        {1, 0}, {-1, 0}, {0, -1}, {0, 1},
+        {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    for (unsigned int row = _begin; row < _end; ++row)
+    {
+      float *dst = data + static_cast<size_t>(row) * n * 2u;
+      for (unsigned int col = 0u; col < n; ++col)
+      {
+        const int x = static_cast<int>(col);
+        const int y = static_cast<int>(row);
+        double vx, vy;
+        if (value(x, y, vx, vy))
+        {
+          *dst++ = static_cast<float>(vx);
+          *dst++ = static_cast<float>(vy);
+          continue;
+        }
+
+        double ix = 0.0;
+        double iy = 0.0;
+        double divisor = 0.0;
+        for (unsigned int k = 0u; k < 8u; ++k)
+        {
+          if (value(x + offsets[k][0], y + offsets[k][1], vx, vy))
+          {
+            // diagonal neighbours are further away and weigh less
+            double weight = k < 4u ? 1.0 : 0.707;
+            divisor += weight;
+            ix += vx * weight;
+            iy += vy * weight;
+          }
+        }
+        if (divisor > 0.5)
+        {
+          ix /= divisor;
+          iy /= divisor;
+        }
+        *dst++ = static_cast<float>(math::clamp(ix, 0.0, 1.0));
+        *dst++ = static_cast<float>(math::clamp(iy, 0.0, 1.0));
+      }
+    }
+  });
+
+  ++gBuildCount;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const DistortionMap> DistortionMap::Shared(
+    unsigned int _size, double _focalLength, const math::Vector2d &_center,
+    double _k1, double _k2, double _k3, double _p1, double _p2,
+    const std::string &_cachePath)
+{
+  // each entry becomes ready once its map is loaded or built. The mutex is
+  // only held to look up and insert entries so maps with different keys
+  // are built concurrently, while users of the same key wait for the map.
+  using SharedMap = std::shared_future<std::weak_ptr<const DistortionMap>>;
+  static std::mutex mutex;
+  static std::map<std::string, SharedMap> maps;
+
+  auto ready = [](const SharedMap &_entry)
+  {
+    return _entry.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready;
+  };
+
+  std::unique_ptr<DistortionMapPrivate> p = makeParams(_size, _focalLength,
+      _center, _k1, _k2, _k3, _p1, _p2);
+  std::shared_ptr<DistortionMap> map(new DistortionMap(std::move(p)));
+  std::string key = map->Key();
+
+  std::promise<std::weak_ptr<const DistortionMap>> promise;
+  while (true)
+  {
+    SharedMap entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = maps.find(key);
+      if (it == maps.end() ||
+          (ready(it->second) && it->second.get().expired()))
+      {
+        // drop the entries of maps that are no longer used
+        for (auto m = maps.begin(); m != maps.end();)
+        {
+          if (ready(m->second) && m->second.get().expired())
+            m = maps.erase(m);
+          else
+            ++m;
+        }
+        maps[key] = promise.get_future().share();
+        break;
+      }
+      entry = it->second;
+    }
+
+    // the map may be released by all its users before it is shared here,
+    // in which case it is looked up again
+    auto existing = entry.get().lock();
+    if (existing)
+      return existing;
+  }
+
+  std::string file;
+  if (!_cachePath.empty())
+    file = common::joinPaths(_cachePath, key + ".distortion");
+  if (file.empty() || !common::isFile(file) || !map->Load(file))
+  {
+    map->Build();
+    if (!file.empty())
+    {
+      if (!common::isDirectory(_cachePath) &&
+          !common::createDirectories(_cachePath))
+      {
+        ignwarn << "Unable to create distortion map cache directory ["
+                << _cachePath << "]" << std::endl;
+      }
+      else
+      {
+        map->Save(file);
+      }
+    }
+  }
+
+  promise.set_value(map);
+  return map;
+}
+
+//////////////////////////////////////////////////
+math::Vector2d DistortionMap::Distort(const math::Vector2d &_in,
+    const math::Vector2d &_center, double _k1, double _k2, double _k3,
+    double _p1, double _p2, unsigned int _width, double _f)
+{
+  DistortionMapPrivate p;
+  p.size = _width;
+  p.focalLength = _f;
+  p.center = _center;
+  p.k1 = _k1;
+  p.k2 = _k2;
+  p.k3 = _k3;
+  p.p1 = _p1;
+  p.p2 = _p2;
+  math::Vector2d out;
+  distort(_in.X(), _in.Y(), p, out.X(), out.Y());
+  return out;
+}
+
+//////////////////////////////////////////////////
+unsigned int DistortionMap::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+const float *DistortionMap::Data() const
+{
+  return this->dataPtr->data.data();
+}
+
+//////////////////////////////////////////////////
+math::Vector2d DistortionMap::Value(int _x, int _y) const
+{
+  int size = static_cast<int>(this->dataPtr->size);
+  if (_x < 0 || _x >= size || _y < 0 || _y >= size ||
+      this->dataPtr->data.empty())
+  {
+    return math::Vector2d(-1, -1);
+  }
+  size_t idx = (static_cast<size_t>(_y) * size + _x) * 2u;
+  return math::Vector2d(this->dataPtr->data[idx],
+      this->dataPtr->data[idx + 1u]);
+}
+
+//////////////////////////////////////////////////
+std::string DistortionMap::Key() const
+{
+  // hash the exact bits of the parameters with 64 bit FNV-1a
+  uint64_t hash = detail::fnv1a(&this->dataPtr->size,
+      sizeof(this->dataPtr->size), detail::kFnv1aOffset);
+  for (double v : params(*this->dataPtr))
+    hash = detail::fnv1a(&v, sizeof(v), hash);
+
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+//////////////////////////////////////////////////
+math::Vector2d DistortionMap::CropScale() const
+{
+  return this->dataPtr->cropScale;
+}
+
+//////////////////////////////////////////////////
+bool DistortionMap::Save(const std::string &_filename) const
+{
+  // write to a temporary file first so other processes never read a
+  // partially written map
+  std::random_device rd;
+  std::string tmpFilename = _filename + "." + std::to_string(rd());
+  {
+    std::ofstream out(tmpFilename, std::ios::binary);
+    if (!out)
+    {
+      ignwarn << "Unable to write distortion map [" << _filename << "]"
+              << std::endl;
+      return false;
+    }
+    uint32_t size = this->dataPtr->size;
+    out.write(kFileMagic, sizeof(kFileMagic));
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    for (double v : params(*this->dataPtr))
+      out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+    out.write(reinterpret_cast<const char *>(this->dataPtr->data.data()),
+        this->dataPtr->data.size() * sizeof(float));
+    if (!out)
+    {
+      out.close();
+      std::remove(tmpFilename.c_str());
+      ignwarn << "Unable to write distortion map [" << _filename << "]"
+              << std::endl;
+      return false;
+    }
+  }
+
+  if (std::rename(tmpFilename.c_str(), _filename.c_str()) != 0)
+  {
+    std::remove(tmpFilename.c_str());
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool DistortionMap::Load(const std::string &_filename)
+{
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  char magic[sizeof(kFileMagic)];
+  uint32_t size = 0u;
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char *>(&size), sizeof(size));
+  bool valid = in && std::memcmp(magic, kFileMagic, sizeof(magic)) == 0 &&
+      size == this->dataPtr->size;
+  for (double v : params(*this->dataPtr))
+  {
+    double fileValue;
+    in.read(reinterpret_cast<char *>(&fileValue), sizeof(fileValue));
+    valid = valid && in && std::memcmp(&v, &fileValue, sizeof(v)) == 0;
+  }
+  if (!valid)
+  {
+    ignwarn << "Ignoring distortion map [" << _filename << "] that was "
+            << "written for other parameters" << std::endl;
+    return false;
+  }
+
+  std::vector<float> data(static_cast<size_t>(size) * size * 2u);
+  in.read(reinterpret_cast<char *>(data.data()),
+      data.size() * sizeof(float));
+  if (!in)
+  {
+    ignwarn << "Unable to read distortion map [" << _filename << "]"
+            << std::endl;
+    return false;
+  }
+  this->dataPtr->data = std::move(data);
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int DistortionMap::BuildCount()
+{
+  return gBuildCount;
+}
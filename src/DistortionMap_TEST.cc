@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/DistortionMap.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, NoDistortion)
+{
+  // without distortion every pixel maps to itself
+  const unsigned int size = 64u;
+  DistortionMap map(size, 32.0, math::Vector2d(0.5, 0.5), 0, 0, 0, 0, 0);
+  EXPECT_EQ(size, map.Size());
+  ASSERT_NE(nullptr, map.Data());
+  EXPECT_EQ(math::Vector2d(1, 1), map.CropScale());
+
+  const double halfTexel = 0.5 / size;
+  for (unsigned int y = 0u; y < size; ++y)
+  {
+    for (unsigned int x = 0u; x < size; ++x)
+    {
+      math::Vector2d v = map.Value(x, y);
+      EXPECT_NEAR(x / static_cast<double>(size) + halfTexel, v.X(), 1e-6);
+      EXPECT_NEAR(y / static_cast<double>(size) + halfTexel, v.Y(), 1e-6);
+    }
+  }
+
+  // out of the map
+  EXPECT_EQ(math::Vector2d(-1, -1), map.Value(-1, 0));
+  EXPECT_EQ(math::Vector2d(-1, -1), map.Value(0, size));
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, Distort)
+{
+  math::Vector2d center(0.5, 0.5);
+  // the center does not move
+  EXPECT_EQ(center, DistortionMap::Distort(center, center, -0.1, 0.01, 0,
+      0.001, 0.002, 100u, 50.0));
+
+  // without distortion nothing moves
+  math::Vector2d in(0.2, 0.7);
+  math::Vector2d out = DistortionMap::Distort(in, center, 0, 0, 0, 0, 0,
+      100u, 50.0);
+  EXPECT_NEAR(in.X(), out.X(), 1e-12);
+  EXPECT_NEAR(in.Y(), out.Y(), 1e-12);
+
+  // barrel distortion pulls points towards the center, pincushion
+  // distortion pushes them away
+  math::Vector2d barrel = DistortionMap::Distort(in, center, -0.1, 0, 0, 0,
+      0, 100u, 50.0);
+  math::Vector2d pincushion = DistortionMap::Distort(in, center, 0.1, 0, 0,
+      0, 0, 100u, 50.0);
+  EXPECT_LT(barrel.Distance(center), in.Distance(center));
+  EXPECT_GT(pincushion.Distance(center), in.Distance(center));
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, Barrel)
+{
+  const unsigned int size = 320u;
+  const double focalLength = size / (2 * std::tan(1.047 / 2));
+  DistortionMap map(size, focalLength, math::Vector2d(0.5, 0.5),
+      -0.1349, -0.51868, -0.001, 0, 0);
+
+  // the black corners are cropped
+  math::Vector2d scale = map.CropScale();
+  EXPECT_LT(scale.X(), 1.0);
+  EXPECT_LT(scale.Y(), 1.0);
+  EXPECT_GT(scale.X(), 0.0);
+
+  // every pixel holds normalized image coordinates
+  const double halfTexel = 0.5 / size;
+  for (unsigned int y = 0u; y < size; ++y)
+  {
+    for (unsigned int x = 0u; x < size; ++x)
+    {
+      math::Vector2d v = map.Value(x, y);
+      EXPECT_GE(v.X(), 0.0);
+      EXPECT_LE(v.X(), 1.0);
+      EXPECT_GE(v.Y(), 0.0);
+      EXPECT_LE(v.Y(), 1.0);
+    }
+  }
+  math::Vector2d center = map.Value(size / 2, size / 2);
+  EXPECT_NEAR(0.5 + halfTexel, center.X(), 1.0 / size);
+  EXPECT_NEAR(0.5 + halfTexel, center.Y(), 1.0 / size);
+
+  // pixels near the edge sample further out than they are
+  math::Vector2d edge = map.Value(size / 2, 2);
+  EXPECT_LT(edge.Y(), 2.0 / size);
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, Shared)
+{
+  const unsigned int size = 128u;
+  math::Vector2d center(0.5, 0.5);
+  unsigned int builds = DistortionMap::BuildCount();
+
+  auto map = DistortionMap::Shared(size, 100.0, center, -0.2, 0, 0, 0, 0);
+  ASSERT_NE(nullptr, map);
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+
+  // identical cameras share the map
+  auto map2 = DistortionMap::Shared(size, 100.0, center, -0.2, 0, 0, 0, 0);
+  EXPECT_EQ(map, map2);
+  EXPECT_EQ(map->Key(), map2->Key());
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+
+  // other parameters make another map
+  auto map3 = DistortionMap::Shared(size, 100.0, center, -0.3, 0, 0, 0, 0);
+  EXPECT_NE(map, map3);
+  EXPECT_NE(map->Key(), map3->Key());
+  EXPECT_EQ(builds + 2u, DistortionMap::BuildCount());
+
+  // the same parameters give the same map when built directly
+  DistortionMap direct(size, 100.0, center, -0.2, 0, 0, 0, 0);
+  EXPECT_EQ(map->Key(), direct.Key());
+  for (unsigned int i = 0u; i < size * size * 2u; ++i)
+    ASSERT_EQ(map->Data()[i], direct.Data()[i]) << i;
+
+  // maps are freed with their last user and rebuilt on the next request
+  map.reset();
+  map2.reset();
+  builds = DistortionMap::BuildCount();
+  map = DistortionMap::Shared(size, 100.0, center, -0.2, 0, 0, 0, 0);
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, SharedConcurrent)
+{
+  const unsigned int size = 128u;
+  math::Vector2d center(0.5, 0.5);
+  unsigned int builds = DistortionMap::BuildCount();
+
+  // cameras created at the same time wait for the map of their lens and
+  // build maps of different lenses side by side
+  const unsigned int threadCount = 8u;
+  std::vector<std::shared_ptr<const DistortionMap>> maps(threadCount);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0u; i < threadCount; ++i)
+  {
+    threads.emplace_back([&maps, &center, i, size]()
+    {
+      double k1 = (i % 2u == 0u) ? -0.25 : -0.35;
+      maps[i] = DistortionMap::Shared(size, 100.0, center, k1, 0, 0, 0, 0);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+
+  EXPECT_EQ(builds + 2u, DistortionMap::BuildCount());
+  for (unsigned int i = 0u; i < threadCount; ++i)
+  {
+    ASSERT_NE(nullptr, maps[i]);
+    EXPECT_EQ(maps[i % 2u], maps[i]) << i;
+  }
+  EXPECT_NE(maps[0], maps[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapTest, Cache)
+{
+  std::string cachePath = common::joinPaths(std::string(PROJECT_BUILD_PATH),
+      "test", "distortion_cache");
+  common::removeAll(cachePath);
+
+  const unsigned int size = 96u;
+  math::Vector2d center(0.45, 0.55);
+  unsigned int builds = DistortionMap::BuildCount();
+  std::vector<float> data;
+  {
+    auto map = DistortionMap::Shared(size, 80.0, center, 0.1, 0.02, 0,
+        0.001, 0, cachePath);
+    ASSERT_NE(nullptr, map);
+    data.assign(map->Data(), map->Data() + size * size * 2u);
+    EXPECT_TRUE(common::isFile(
+        common::joinPaths(cachePath, map->Key() + ".distortion")));
+  }
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+
+  // the map is read back from the cache instead of being built
+  auto map = DistortionMap::Shared(size, 80.0, center, 0.1, 0.02, 0,
+      0.001, 0, cachePath);
+  ASSERT_NE(nullptr, map);
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+  for (unsigned int i = 0u; i < data.size(); ++i)
+    ASSERT_EQ(data[i], map->Data()[i]) << i;
+
+  // maps are not loaded from files written for other parameters
+  std::string file = common::joinPaths(cachePath, map->Key() + ".distortion");
+  DistortionMap other(size, 80.0, center, 0.2, 0, 0, 0, 0);
+  EXPECT_FALSE(other.Load(file));
+  EXPECT_FALSE(other.Load(common::joinPaths(cachePath, "missing")));
+  EXPECT_TRUE(other.Save(common::joinPaths(cachePath, "other.distortion")));
+  EXPECT_TRUE(other.Load(common::joinPaths(cachePath, "other.distortion")));
+
+  common::removeAll(cachePath);
+}
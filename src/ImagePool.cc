@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <mutex>
+
+#include "ignition/rendering/ImagePool.hh"
+
+/// \brief Private data for the ImagePool class
+class ignition::rendering::ImagePoolPrivate
+{
+  /// \brief Destructor
+  public: ~ImagePoolPrivate();
+
+  /// \brief Take back the buffer of a released image
+  /// \param[in] _buffer Image buffer
+  /// \param[in] _size Size of the buffer in bytes
+  public: void Release(unsigned char *_buffer, unsigned int _size);
+
+  /// \brief Free all the buffers that are not in use
+  public: void Clear();
+
+  /// \brief Mutex protecting the members below, buffers can be released
+  /// from any thread
+  public: std::mutex mutex;
+
+  /// \brief Released buffers keyed by their size in bytes
+  public: std::multimap<unsigned int, unsigned char *> freeBuffers;
+
+  /// \brief Number of buffers allocated by the pool
+  public: unsigned int allocationCount = 0u;
+
+  /// \brief Maximum number of free buffers kept for reuse
+  public: unsigned int maxFreeCount = 8u;
+};
+
+using namespace ignition;
+using namespace rendering;
+
+//////////////////////////////////////////////////
+ImagePoolPrivate::~ImagePoolPrivate()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+void ImagePoolPrivate::Release(unsigned char *_buffer, unsigned int _size)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->freeBuffers.size() < this->maxFreeCount)
+    {
+      this->freeBuffers.emplace(_size, _buffer);
+      return;
+    }
+  }
+  delete [] _buffer;
+}
+
+//////////////////////////////////////////////////
+void ImagePoolPrivate::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &buffer : this->freeBuffers)
+    delete [] buffer.second;
+  this->freeBuffers.clear();
+}
+
+//////////////////////////////////////////////////
+ImagePool::ImagePool() :
+  dataPtr(std::make_shared<ImagePoolPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+ImagePool::~ImagePool()
+{
+}
+
+//////////////////////////////////////////////////
+Image ImagePool::Acquire(unsigned int _width, unsigned int _height,
+    PixelFormat _format)
+{
+  Image image;
+  image.width = _width;
+  image.height = _height;
+  image.format = PixelUtil::Sanitize(_format);
+  unsigned int size = image.MemorySize();
+
+  unsigned char *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto it = this->dataPtr->freeBuffers.find(size);
+    if (it != this->dataPtr->freeBuffers.end())
+    {
+      buffer = it->second;
+      this->dataPtr->freeBuffers.erase(it);
+    }
+    else
+    {
+      ++this->dataPtr->allocationCount;
+    }
+  }
+  if (!buffer)
+    buffer = new unsigned char[size];
+
+  // the buffer goes back to the pool if it still exists when the last copy
+  // of the image is destroyed
+  std::weak_ptr<ImagePoolPrivate> pool = this->dataPtr;
+  image.data = Image::DataPtr(buffer, [pool, size](unsigned char *_buffer)
+      {
+        auto poolPtr = pool.lock();
+        if (poolPtr)
+          poolPtr->Release(_buffer, size);
+        else
+          delete [] _buffer;
+      });
+  return image;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImagePool::AllocationCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->allocationCount;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImagePool::FreeCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->freeBuffers.size());
+}
+
+//////////////////////////////////////////////////
+void ImagePool::SetMaxFreeCount(unsigned int _count)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->maxFreeCount = _count;
+  while (this->dataPtr->freeBuffers.size() > _count)
+  {
+    auto it = this->dataPtr->freeBuffers.begin();
+    delete [] it->second;
+    this->dataPtr->freeBuffers.erase(it);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ImagePool::MaxFreeCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->maxFreeCount;
+}
+
+//////////////////////////////////////////////////
+void ImagePool::Clear()
+{
+  this->dataPtr->Clear();
+}
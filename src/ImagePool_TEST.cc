@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/ImagePool.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(ImagePoolTest, Reuse)
+{
+  ImagePool pool;
+  EXPECT_EQ(0u, pool.AllocationCount());
+  EXPECT_EQ(0u, pool.FreeCount());
+  EXPECT_EQ(8u, pool.MaxFreeCount());
+
+  const void *data = nullptr;
+  {
+    Image image = pool.Acquire(32, 16, PF_R8G8B8);
+    EXPECT_EQ(32u, image.Width());
+    EXPECT_EQ(16u, image.Height());
+    EXPECT_EQ(PF_R8G8B8, image.Format());
+    EXPECT_EQ(32u * 16u * 3u, image.MemorySize());
+    ASSERT_NE(nullptr, image.Data());
+    data = image.Data();
+    EXPECT_EQ(1u, pool.AllocationCount());
+
+    // copies share the buffer, which is only released with the last one
+    Image copy = image;
+    EXPECT_EQ(data, copy.Data());
+  }
+  EXPECT_EQ(1u, pool.FreeCount());
+
+  // a capture loop reuses the released buffer every frame
+  for (unsigned int i = 0u; i < 100u; ++i)
+  {
+    Image image = pool.Acquire(32, 16, PF_R8G8B8);
+    EXPECT_EQ(data, image.Data());
+  }
+  EXPECT_EQ(1u, pool.AllocationCount());
+
+  // a double buffered loop needs two buffers
+  Image previous = pool.Acquire(32, 16, PF_R8G8B8);
+  for (unsigned int i = 0u; i < 100u; ++i)
+  {
+    Image image = pool.Acquire(32, 16, PF_R8G8B8);
+    EXPECT_NE(previous.Data(), image.Data());
+    previous = image;
+  }
+  EXPECT_EQ(2u, pool.AllocationCount());
+
+  // buffers of another size are not reused
+  {
+    Image image = pool.Acquire(16, 16, PF_R8G8B8);
+    EXPECT_EQ(16u * 16u * 3u, image.MemorySize());
+  }
+  EXPECT_EQ(3u, pool.AllocationCount());
+
+  // same memory size in another format
+  {
+    Image image = pool.Acquire(32, 4, PF_FLOAT32_RGB);
+    EXPECT_EQ(PF_FLOAT32_RGB, image.Format());
+    EXPECT_EQ(32u * 16u * 3u, image.MemorySize());
+  }
+  EXPECT_EQ(3u, pool.AllocationCount());
+
+  pool.Clear();
+  EXPECT_EQ(0u, pool.FreeCount());
+}
+
+/////////////////////////////////////////////////
+TEST(ImagePoolTest, MaxFreeCount)
+{
+  ImagePool pool;
+  pool.SetMaxFreeCount(2u);
+  EXPECT_EQ(2u, pool.MaxFreeCount());
+
+  {
+    std::vector<Image> images;
+    for (unsigned int i = 0u; i < 4u; ++i)
+      images.push_back(pool.Acquire(8, 8, PF_L8));
+    EXPECT_EQ(4u, pool.AllocationCount());
+  }
+  EXPECT_EQ(2u, pool.FreeCount());
+
+  pool.SetMaxFreeCount(1u);
+  EXPECT_EQ(1u, pool.FreeCount());
+
+  pool.SetMaxFreeCount(0u);
+  EXPECT_EQ(0u, pool.FreeCount());
+  {
+    Image image = pool.Acquire(8, 8, PF_L8);
+  }
+  EXPECT_EQ(0u, pool.FreeCount());
+  EXPECT_EQ(5u, pool.AllocationCount());
+}
+
+/////////////////////////////////////////////////
+TEST(ImagePoolTest, Lifetime)
+{
+  // images may outlive their pool
+  Image image;
+  {
+    ImagePool pool;
+    image = pool.Acquire(4, 4, PF_R8G8B8A8);
+  }
+  ASSERT_NE(nullptr, image.Data<unsigned char>());
+  image.Data<unsigned char>()[0] = 1u;
+  image = Image();
+
+  // images released from other threads
+  auto pool = std::make_shared<ImagePool>();
+  for (unsigned int i = 0u; i < 10u; ++i)
+  {
+    Image threadImage = pool->Acquire(64, 64, PF_R8G8B8);
+    std::thread thread([](Image _image)
+        {
+          _image.Data<unsigned char>()[0] = 1u;
+        }, threadImage);
+    threadImage = Image();
+    thread.join();
+  }
+  EXPECT_EQ(1u, pool->AllocationCount());
+  EXPECT_EQ(1u, pool->FreeCount());
+}
@@ -16,13 +16,17 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <ignition/common/Console.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
+#include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Marker.hh"
 #include "ignition/rendering/Scene.hh"
+#include "ignition/rendering/Visual.hh"
 
 using namespace ignition;
 using namespace rendering;
@@ -32,6 +36,9 @@ class MarkerTest : public testing::Test,
                    public testing::WithParamInterface<const char *>
 {
   public: void Marker(const std::string &_renderEngine);
+
+  /// \brief Test the bounds of a marker updated over many frames
+  public: void MarkerStreaming(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -109,6 +116,44 @@ void MarkerTest::Marker(const std::string &_renderEngine)
   EXPECT_NO_THROW(marker->SetPoint(0, math::Vector3d(3, 1, 2)));
   EXPECT_NO_THROW(marker->ClearPoints());
 
+  // update the points over several frames, growing, shrinking and editing
+  // single points so the per frame buffer updates are exercised
+  marker->SetType(MarkerType::MT_LINE_STRIP);
+  for (unsigned int i = 0u; i < 8u; ++i)
+  {
+    unsigned int count = (i % 2u == 0u) ? 100u + i * 10u : 10u;
+    marker->ClearPoints();
+    for (unsigned int j = 0u; j < count; ++j)
+      marker->AddPoint(math::Vector3d(j, i, 0), math::Color::White);
+    EXPECT_NO_THROW(marker->PreRender());
+
+    EXPECT_NO_THROW(marker->SetPoint(count / 2u, math::Vector3d(0, 0, 1)));
+    EXPECT_NO_THROW(marker->PreRender());
+  }
+  EXPECT_NO_THROW(marker->ClearPoints());
+  EXPECT_NO_THROW(marker->PreRender());
+
+  // bulk point api, with and without colors
+  std::vector<float> positions;
+  std::vector<math::Color> colors;
+  for (unsigned int i = 0u; i < 1000u; ++i)
+  {
+    positions.insert(positions.end(), {i * 0.1f, 1.0f, 2.0f});
+    colors.push_back(math::Color(0, 1, 0));
+  }
+  marker->SetType(MarkerType::MT_POINTS);
+  EXPECT_NO_THROW(marker->SetPoints(positions.data(), colors.data(), 1000u));
+  EXPECT_NO_THROW(marker->PreRender());
+  EXPECT_NO_THROW(marker->AppendPoints(positions.data(), nullptr, 500u));
+  EXPECT_NO_THROW(marker->SetPoint(1400u, math::Vector3d(3, 1, 2)));
+  EXPECT_NO_THROW(marker->PreRender());
+  EXPECT_NO_THROW(marker->SetPoints(positions.data(), nullptr, 10u));
+  EXPECT_NO_THROW(marker->AddPoint(math::Vector3d(0, 1, 2),
+      math::Color::White));
+  EXPECT_NO_THROW(marker->PreRender());
+  EXPECT_NO_THROW(marker->SetPoints(nullptr, nullptr, 0u));
+  EXPECT_NO_THROW(marker->PreRender());
+
   EXPECT_DOUBLE_EQ(1.0, marker->Size());
   marker->SetSize(3.0);
   EXPECT_DOUBLE_EQ(3.0, marker->Size());
@@ -118,12 +163,86 @@ void MarkerTest::Marker(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void MarkerTest::MarkerStreaming(const std::string &_renderEngine)
+{
+  if (_renderEngine != "ogre2")
+  {
+    igndbg << "Marker streaming not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+           << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(32);
+  camera->SetImageHeight(32);
+  root->AddChild(camera);
+
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  root->AddChild(visual);
+
+  MarkerPtr marker = scene->CreateMarker();
+  ASSERT_NE(nullptr, marker);
+  marker->SetType(MarkerType::MT_LINE_STRIP);
+  visual->AddGeometry(marker);
+
+  // grow the line and move its first point outwards over more frames than
+  // the vertex buffer has regions, so every region is written several times
+  // from the ranges changed while it was in flight
+  const unsigned int frames = 10u;
+  for (unsigned int i = 0u; i < frames; ++i)
+  {
+    marker->AddPoint(math::Vector3d(i, 1, 0), math::Color::White);
+    if (i > 0u)
+      marker->SetPoint(0u, math::Vector3d(0, -static_cast<double>(i), 0));
+    camera->Update();
+
+    math::AxisAlignedBox box = visual->LocalBoundingBox();
+    double minY = (i > 0u) ? -static_cast<double>(i) : 1.0;
+    EXPECT_EQ(math::Vector3d(0, minY, 0), box.Min()) << "frame " << i;
+    EXPECT_EQ(math::Vector3d(i, 1, 0), box.Max()) << "frame " << i;
+  }
+
+  // removing points shrinks the bounds again
+  marker->ClearPoints();
+  marker->AddPoint(math::Vector3d(0, 0, 0), math::Color::White);
+  marker->AddPoint(math::Vector3d(1, 1, 1), math::Color::White);
+  camera->Update();
+  math::AxisAlignedBox box = visual->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0, 0, 0), box.Min());
+  EXPECT_EQ(math::Vector3d(1, 1, 1), box.Max());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(MarkerTest, Marker)
 {
   Marker(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(MarkerTest, MarkerStreaming)
+{
+  MarkerStreaming(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(Marker, MarkerTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
@@ -20,9 +20,11 @@
 #include <string>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
 #include <ignition/common/Skeleton.hh>
 #include <ignition/common/SkeletonAnimation.hh>
+#include <ignition/common/SubMesh.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 #include "ignition/rendering/Camera.hh"
@@ -46,6 +48,9 @@ class MeshTest : public testing::Test,
   /// \brief Test mesh clone API
   public: void MeshClone(const std::string &_renderEngine);
 
+  /// \brief Test loading a mesh with many large submeshes
+  public: void MeshManySubMeshes(const std::string &_renderEngine);
+
   public: const std::string TEST_MEDIA_PATH =
         common::joinPaths(std::string(PROJECT_SOURCE_PATH),
         "test", "media", "meshes");
@@ -291,6 +296,82 @@ TEST_P(MeshTest, MeshClone)
   MeshClone(GetParam());
 }
 
+/////////////////////////////////////////////////
+void MeshTest::MeshManySubMeshes(const std::string &_renderEngine)
+{
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+
+  // a mesh made of a grid of triangle strips, with enough vertices for
+  // the submeshes to be loaded in parallel
+  const unsigned int subMeshCount = 16u;
+  const unsigned int vertexCount = 3000u;
+  common::Mesh *commonMesh = new common::Mesh();
+  commonMesh->SetName("many_submeshes_test_mesh");
+  for (unsigned int i = 0u; i < subMeshCount; ++i)
+  {
+    common::SubMesh subMesh;
+    subMesh.SetName("submesh_" + std::to_string(i));
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    for (unsigned int j = 0u; j < vertexCount; ++j)
+    {
+      subMesh.AddVertex(math::Vector3d(i + (j % 2u), j * 0.01, 0.0));
+      subMesh.AddNormal(math::Vector3d::UnitZ);
+      subMesh.AddTexCoord(math::Vector2d(j % 2u, j * 0.001));
+    }
+    for (unsigned int j = 0u; j + 2u < vertexCount; ++j)
+    {
+      subMesh.AddIndex(j);
+      subMesh.AddIndex(j + 1u);
+      subMesh.AddIndex(j + 2u);
+    }
+    commonMesh->AddSubMesh(subMesh);
+  }
+  common::MeshManager::Instance()->AddMesh(commonMesh);
+
+  MeshDescriptor descriptor("many_submeshes_test_mesh");
+  MeshPtr mesh = scene->CreateMesh(descriptor);
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_EQ(subMeshCount, mesh->SubMeshCount());
+  for (unsigned int i = 0u; i < mesh->SubMeshCount(); ++i)
+    EXPECT_NE(nullptr, mesh->SubMeshByIndex(i)->Material());
+
+  // a second mesh from the same descriptor reuses the loaded data
+  MeshPtr mesh2 = scene->CreateMesh(descriptor);
+  ASSERT_TRUE(mesh2 != nullptr);
+  EXPECT_EQ(subMeshCount, mesh2->SubMeshCount());
+
+  // a single recentered submesh
+  descriptor.subMeshName = "submesh_3";
+  descriptor.centerSubMesh = true;
+  MeshPtr centered = scene->CreateMesh(descriptor);
+  ASSERT_TRUE(centered != nullptr);
+  EXPECT_EQ(1u, centered->SubMeshCount());
+
+  // the original mesh data is left untouched
+  auto subMesh = commonMesh->SubMeshByName("submesh_3").lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_EQ(math::Vector3d(3, 0, 0), subMesh->Vertex(0u));
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshTest, MeshManySubMeshes)
+{
+  MeshManySubMeshes(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(Mesh, MeshTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define IGN_RENDERING_PIXELCOPY_SSE2
+#endif
+
+#include "ignition/rendering/PixelCopy.hh"
+
+namespace ignition
+{
+namespace rendering
+{
+inline namespace IGNITION_RENDERING_VERSION_NAMESPACE {
+//
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+/////////////////////////////////////////////////
+/// \brief Copy one channel of a row of 4 channel float pixels, 4 pixels
+/// at a time. The channel is a template parameter because shuffle masks
+/// must be compile time constants.
+/// \param[in, out] _src Source row, advanced past the copied pixels
+/// \param[in, out] _dst Destination row, advanced past the copied pixels
+/// \param[in] _count Number of pixels to copy, must be a multiple of 4
+template <int C>
+static void copyChannel4(const float *&_src, float *&_dst, unsigned int _count)
+{
+  for (unsigned int j = 0u; j < _count; j += 4u)
+  {
+    __m128 p0 = _mm_loadu_ps(_src);
+    __m128 p1 = _mm_loadu_ps(_src + 4);
+    __m128 p2 = _mm_loadu_ps(_src + 8);
+    __m128 p3 = _mm_loadu_ps(_src + 12);
+    // [c0 c0 c1 c1], [c2 c2 c3 c3] -> [c0 c1 c2 c3]
+    __m128 a = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(C, C, C, C));
+    __m128 b = _mm_shuffle_ps(p2, p3, _MM_SHUFFLE(C, C, C, C));
+    _mm_storeu_ps(_dst, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _src += 16;
+    _dst += 4;
+  }
+}
+#endif
+
+/////////////////////////////////////////////////
+void copyPixelRows(const void *_src, size_t _srcRowBytes,
+    void *_dst, size_t _dstRowBytes, size_t _rowBytes,
+    unsigned int _height)
+{
+  // rows are contiguous in both buffers so do a single copy
+  if (_srcRowBytes == _rowBytes && _dstRowBytes == _rowBytes)
+  {
+    memcpy(_dst, _src, _rowBytes * _height);
+    return;
+  }
+
+  const uint8_t *src = static_cast<const uint8_t *>(_src);
+  uint8_t *dst = static_cast<uint8_t *>(_dst);
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    memcpy(dst, src, _rowBytes);
+    src += _srcRowBytes;
+    dst += _dstRowBytes;
+  }
+}
+
+/////////////////////////////////////////////////
+void copyRgbaToRgb(const float *_src, size_t _srcRowBytes,
+    float *_dst, unsigned int _width, unsigned int _height)
+{
+  const uint8_t *srcRow = reinterpret_cast<const uint8_t *>(_src);
+  float *dst = _dst;
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    const float *src = reinterpret_cast<const float *>(srcRow);
+    unsigned int j = 0u;
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+    // pack 4 RGBA pixels (4 registers) into 4 RGB pixels (3 registers)
+    for (; j + 4u <= _width; j += 4u)
+    {
+      __m128 p0 = _mm_loadu_ps(src);
+      __m128 p1 = _mm_loadu_ps(src + 4);
+      __m128 p2 = _mm_loadu_ps(src + 8);
+      __m128 p3 = _mm_loadu_ps(src + 12);
+
+      // [r0 g0 b0 r1]
+      __m128 t0 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 2, 2));
+      __m128 o0 = _mm_shuffle_ps(p0, t0, _MM_SHUFFLE(2, 0, 1, 0));
+      // [g1 b1 r2 g2]
+      __m128 o1 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 0, 2, 1));
+      // [b2 r3 g3 b3]
+      __m128 t2 = _mm_shuffle_ps(p2, p3, _MM_SHUFFLE(0, 0, 2, 2));
+      __m128 o2 = _mm_shuffle_ps(t2, p3, _MM_SHUFFLE(2, 1, 2, 0));
+
+      _mm_storeu_ps(dst, o0);
+      _mm_storeu_ps(dst + 4, o1);
+      _mm_storeu_ps(dst + 8, o2);
+      src += 16;
+      dst += 12;
+    }
+#endif
+    for (; j < _width; ++j)
+    {
+      dst[0] = src[0];
+      dst[1] = src[1];
+      dst[2] = src[2];
+      src += 4;
+      dst += 3;
+    }
+    srcRow += _srcRowBytes;
+  }
+}
+
+/////////////////////////////////////////////////
+void copyChannel(const float *_src, size_t _srcRowBytes,
+    unsigned int _channels, unsigned int _channel,
+    float *_dst, unsigned int _width, unsigned int _height)
+{
+  if (_channel >= _channels)
+    return;
+
+  if (_channels == 1u)
+  {
+    copyPixelRows(_src, _srcRowBytes, _dst, _width * sizeof(float),
+        _width * sizeof(float), _height);
+    return;
+  }
+
+  const uint8_t *srcRow = reinterpret_cast<const uint8_t *>(_src);
+  float *dst = _dst;
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    const float *src = reinterpret_cast<const float *>(srcRow);
+    unsigned int j = 0u;
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+    if (_channels == 4u)
+    {
+      j = _width & ~3u;
+      switch (_channel)
+      {
+        case 0u: copyChannel4<0>(src, dst, j); break;
+        case 1u: copyChannel4<1>(src, dst, j); break;
+        case 2u: copyChannel4<2>(src, dst, j); break;
+        default: copyChannel4<3>(src, dst, j); break;
+      }
+    }
+#endif
+    for (; j < _width; ++j)
+    {
+      *dst++ = src[_channel];
+      src += _channels;
+    }
+    srcRow += _srcRowBytes;
+  }
+}
+
+/////////////////////////////////////////////////
+void copyL8ToL16(const uint8_t *_src, size_t _srcRowBytes,
+    uint16_t *_dst, unsigned int _width, unsigned int _height)
+{
+  const uint8_t *srcRow = _src;
+  uint16_t *dst = _dst;
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    const uint8_t *src = srcRow;
+    unsigned int j = 0u;
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+    // interleave 16 bytes with zeros to get 16 little endian uint16 values
+    const __m128i zero = _mm_setzero_si128();
+    for (; j + 16u <= _width; j += 16u)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+          _mm_unpacklo_epi8(v, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8),
+          _mm_unpackhi_epi8(v, zero));
+      src += 16;
+      dst += 16;
+    }
+#endif
+    for (; j < _width; ++j)
+      *dst++ = *src++;
+    srcRow += _srcRowBytes;
+  }
+}
+
+/////////////////////////////////////////////////
+void copyRgba8ToRgb8(const uint8_t *_src, size_t _srcRowBytes,
+    uint8_t *_dst, unsigned int _width, unsigned int _height)
+{
+  const uint8_t *srcRow = _src;
+  uint8_t *dst = _dst;
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    const uint8_t *src = srcRow;
+    unsigned int j = 0u;
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+    // pack each pair of RGBA pixels in a 64 bit lane into 6 bytes,
+    // [r0 g0 b0 a0 r1 g1 b1 a1] -> [r0 g0 b0 r1 g1 b1 0 0], and write the
+    // two lanes 6 bytes apart. Each store writes 2 bytes past the packed
+    // pixels, so stop one pixel before the end of the row.
+    const __m128i loMask = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+    const __m128i hiMask = _mm_set_epi32(0x0000FFFF,
+        static_cast<int>(0xFF000000u), 0x0000FFFF,
+        static_cast<int>(0xFF000000u));
+    for (; j + 5u <= _width; j += 4u)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      __m128i packed = _mm_or_si128(_mm_and_si128(v, loMask),
+          _mm_and_si128(_mm_srli_epi64(v, 8), hiMask));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), packed);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 6),
+          _mm_srli_si128(packed, 8));
+      src += 16;
+      dst += 12;
+    }
+#endif
+    for (; j < _width; ++j)
+    {
+      dst[0] = src[0];
+      dst[1] = src[1];
+      dst[2] = src[2];
+      src += 4;
+      dst += 3;
+    }
+    srcRow += _srcRowBytes;
+  }
+}
+
+/////////////////////////////////////////////////
+void copyRgba8ToUint32(const uint8_t *_src, size_t _srcRowBytes,
+    uint32_t _mask, uint32_t *_dst, unsigned int _width,
+    unsigned int _height)
+{
+  const uint8_t *srcRow = _src;
+  uint32_t *dst = _dst;
+  for (unsigned int i = 0u; i < _height; ++i)
+  {
+    const uint8_t *src = srcRow;
+    unsigned int j = 0u;
+#ifdef IGN_RENDERING_PIXELCOPY_SSE2
+    // x86 is little endian so a pixel loaded as a 32 bit integer is
+    // already r | g << 8 | b << 16 | a << 24
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(_mask));
+    for (; j + 4u <= _width; j += 4u)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+          _mm_and_si128(v, mask));
+      src += 16;
+      dst += 4;
+    }
+#endif
+    for (; j < _width; ++j)
+    {
+      uint32_t value = static_cast<uint32_t>(src[0]) |
+          (static_cast<uint32_t>(src[1]) << 8) |
+          (static_cast<uint32_t>(src[2]) << 16) |
+          (static_cast<uint32_t>(src[3]) << 24);
+      *dst++ = value & _mask;
+      src += 4;
+    }
+    srcRow += _srcRowBytes;
+  }
+}
+}
+}
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/PixelCopy.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyPixelRows)
+{
+  // 5 x 3 image of 2 byte pixels with 6 bytes of padding per row
+  const unsigned int width = 5u;
+  const unsigned int height = 3u;
+  const size_t rowBytes = width * 2u;
+  const size_t srcRowBytes = rowBytes + 6u;
+
+  std::vector<uint8_t> src(srcRowBytes * height, 0xFF);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < rowBytes; ++j)
+      src[i * srcRowBytes + j] = static_cast<uint8_t>(i * rowBytes + j);
+  }
+
+  std::vector<uint8_t> dst(rowBytes * height, 0u);
+  copyPixelRows(src.data(), srcRowBytes, dst.data(), rowBytes, rowBytes,
+      height);
+  for (unsigned int i = 0u; i < dst.size(); ++i)
+    EXPECT_EQ(i, dst[i]);
+
+  // contiguous rows
+  std::vector<uint8_t> dst2(rowBytes * height, 0u);
+  copyPixelRows(dst.data(), rowBytes, dst2.data(), rowBytes, rowBytes,
+      height);
+  EXPECT_EQ(dst, dst2);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyRgbaToRgb)
+{
+  // use a width that is not a multiple of the vector width and pad each
+  // row by 2 pixels
+  const unsigned int width = 11u;
+  const unsigned int height = 4u;
+  const unsigned int srcRowFloats = (width + 2u) * 4u;
+
+  std::vector<float> src(srcRowFloats * height, -1.0f);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+    {
+      for (unsigned int c = 0u; c < 4u; ++c)
+      {
+        src[i * srcRowFloats + j * 4u + c] =
+            static_cast<float>((i * width + j) * 10u + c);
+      }
+    }
+  }
+
+  std::vector<float> dst(width * height * 3u, 0.0f);
+  copyRgbaToRgb(src.data(), srcRowFloats * sizeof(float), dst.data(),
+      width, height);
+
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+    {
+      for (unsigned int c = 0u; c < 3u; ++c)
+      {
+        EXPECT_FLOAT_EQ(static_cast<float>((i * width + j) * 10u + c),
+            dst[(i * width + j) * 3u + c]);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyChannel)
+{
+  const unsigned int width = 9u;
+  const unsigned int height = 3u;
+
+  for (unsigned int channels : {1u, 3u, 4u})
+  {
+    const unsigned int srcRowFloats = (width + 1u) * channels;
+    std::vector<float> src(srcRowFloats * height, -1.0f);
+    for (unsigned int i = 0u; i < height; ++i)
+    {
+      for (unsigned int j = 0u; j < width; ++j)
+      {
+        for (unsigned int c = 0u; c < channels; ++c)
+        {
+          src[i * srcRowFloats + j * channels + c] =
+              static_cast<float>((i * width + j) * 10u + c);
+        }
+      }
+    }
+
+    for (unsigned int channel = 0u; channel < channels; ++channel)
+    {
+      std::vector<float> dst(width * height, 0.0f);
+      copyChannel(src.data(), srcRowFloats * sizeof(float), channels,
+          channel, dst.data(), width, height);
+      for (unsigned int i = 0u; i < width * height; ++i)
+        EXPECT_FLOAT_EQ(static_cast<float>(i * 10u + channel), dst[i]);
+    }
+  }
+
+  // out of range channel leaves the destination untouched
+  std::vector<float> src(4u, 1.0f);
+  float dst = 0.0f;
+  copyChannel(src.data(), 4u * sizeof(float), 4u, 4u, &dst, 1u, 1u);
+  EXPECT_FLOAT_EQ(0.0f, dst);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyL8ToL16)
+{
+  const unsigned int width = 37u;
+  const unsigned int height = 2u;
+  const size_t srcRowBytes = 40u;
+
+  std::vector<uint8_t> src(srcRowBytes * height, 0u);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+      src[i * srcRowBytes + j] = static_cast<uint8_t>(200u + i * 20u + j);
+  }
+
+  std::vector<uint16_t> dst(width * height, 0u);
+  copyL8ToL16(src.data(), srcRowBytes, dst.data(), width, height);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+    {
+      EXPECT_EQ(static_cast<uint8_t>(200u + i * 20u + j),
+          dst[i * width + j]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyRgba8ToRgb8)
+{
+  // widths around the vector width, with padded rows
+  for (unsigned int width : {1u, 4u, 5u, 9u, 33u})
+  {
+    const unsigned int height = 3u;
+    const size_t srcRowBytes = width * 4u + 8u;
+
+    std::vector<uint8_t> src(srcRowBytes * height, 0xEE);
+    for (unsigned int i = 0u; i < height; ++i)
+    {
+      for (unsigned int j = 0u; j < width * 4u; ++j)
+        src[i * srcRowBytes + j] = static_cast<uint8_t>(i * 100u + j);
+    }
+
+    // one extra byte to check that nothing is written past the image
+    std::vector<uint8_t> dst(width * height * 3u + 1u, 0u);
+    copyRgba8ToRgb8(src.data(), srcRowBytes, dst.data(), width, height);
+
+    for (unsigned int i = 0u; i < height; ++i)
+    {
+      for (unsigned int j = 0u; j < width; ++j)
+      {
+        for (unsigned int c = 0u; c < 3u; ++c)
+        {
+          EXPECT_EQ(static_cast<uint8_t>(i * 100u + j * 4u + c),
+              dst[(i * width + j) * 3u + c]) << width;
+        }
+      }
+    }
+    EXPECT_EQ(0u, dst.back()) << width;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyTest, CopyRgba8ToUint32)
+{
+  const unsigned int width = 7u;
+  const unsigned int height = 2u;
+  const size_t srcRowBytes = width * 4u + 4u;
+
+  std::vector<uint8_t> src(srcRowBytes * height, 0xEE);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+    {
+      uint8_t *p = &src[i * srcRowBytes + j * 4u];
+      p[0] = static_cast<uint8_t>(j);
+      p[1] = static_cast<uint8_t>(i);
+      p[2] = 0x12u;
+      p[3] = 0xFFu;
+    }
+  }
+
+  std::vector<uint32_t> dst(width * height, 0u);
+  copyRgba8ToUint32(src.data(), srcRowBytes, 0x00FFFFFFu, dst.data(),
+      width, height);
+  for (unsigned int i = 0u; i < height; ++i)
+  {
+    for (unsigned int j = 0u; j < width; ++j)
+      EXPECT_EQ(0x120000u | (i << 8) | j, dst[i * width + j]);
+  }
+
+  // only keep the red channel
+  copyRgba8ToUint32(src.data(), srcRowBytes, 0xFFu, dst.data(),
+      width, height);
+  for (unsigned int i = 0u; i < width * height; ++i)
+    EXPECT_EQ(i % width, dst[i]);
+}
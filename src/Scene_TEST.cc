@@ -17,17 +17,67 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
+#include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderTarget.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
+#include "ignition/rendering/Visual.hh"
+#include "ignition/rendering/base/BaseMaterial.hh"
+#include "ignition/rendering/base/BaseObject.hh"
 
 using namespace ignition;
 using namespace rendering;
 
+/// \brief Object that belongs to a scene
+class TestObject : public BaseObject
+{
+  // Documentation inherited
+  public: ScenePtr Scene() const override
+  {
+    return this->scene;
+  }
+
+  /// \brief Scene the object belongs to
+  public: ScenePtr scene;
+};
+
+/// \brief Material that counts how many times it is pre-rendered
+class PreRenderCountMaterial : public BaseMaterial<TestObject>
+{
+  /// \brief Constructor
+  /// \param[in] _scene Scene the material belongs to
+  public: explicit PreRenderCountMaterial(ScenePtr _scene)
+  {
+    this->scene = _scene;
+    this->id = std::numeric_limits<unsigned int>::max();
+    this->name = "pre_render_count";
+  }
+
+  // Documentation inherited
+  public: void PreRender() override
+  {
+    ++this->preRenderCount;
+  }
+
+  /// \brief Simulate a change that is applied in PreRender
+  public: void Change()
+  {
+    this->SetPreRenderDirty();
+  }
+
+  /// \brief Number of PreRender calls
+  public: unsigned int preRenderCount = 0u;
+};
+
 class SceneTest : public testing::Test,
                   public testing::WithParamInterface<const char *>
 {
@@ -60,6 +110,15 @@ class SceneTest : public testing::Test,
 
   /// \brief Test enablng sky
   public: void Sky(const std::string &_renderEngine);
+
+  /// \brief Test looking up visuals by id, name and index
+  public: void VisualLookup(const std::string &_renderEngine);
+
+  /// \brief Test that only changed materials are pre-rendered
+  public: void PreRenderMaterials(const std::string &_renderEngine);
+
+  /// \brief Test that sensors are pre-rendered once per frame
+  public: void PreRenderSensors(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -781,6 +840,178 @@ void SceneTest::Sky(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void SceneTest::VisualLookup(const std::string &_renderEngine)
+{
+  auto engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine << "' is not supported" << std::endl;
+    return;
+  }
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // verify all visuals can be found by id, name and index, and that
+  // visuals are ordered by name
+  auto checkVisuals = [&scene]()
+  {
+    std::string prevName;
+    for (unsigned int i = 0u; i < scene->VisualCount(); ++i)
+    {
+      VisualPtr visual = scene->VisualByIndex(i);
+      ASSERT_NE(nullptr, visual);
+      EXPECT_LT(prevName, visual->Name());
+      EXPECT_EQ(visual, scene->VisualById(visual->Id()));
+      EXPECT_EQ(visual, scene->VisualByName(visual->Name()));
+      EXPECT_TRUE(scene->HasVisual(visual));
+      prevName = visual->Name();
+    }
+    EXPECT_EQ(nullptr, scene->VisualByIndex(scene->VisualCount()));
+  };
+
+  // create visuals in an order different from their name order
+  const unsigned int visualCount = 200u;
+  std::vector<VisualPtr> visuals;
+  for (unsigned int i = 0u; i < visualCount; ++i)
+  {
+    unsigned int n = (i * 37u) % visualCount;
+    VisualPtr visual = scene->CreateVisual("visual_" +
+        std::string(n < 10u ? "00" : (n < 100u ? "0" : "")) +
+        std::to_string(n));
+    ASSERT_NE(nullptr, visual);
+    visuals.push_back(visual);
+  }
+  unsigned int count = scene->VisualCount();
+  checkVisuals();
+
+  // destroy some visuals from the middle and the end of the store
+  for (unsigned int i = 0u; i < visualCount; i += 3u)
+  {
+    scene->DestroyVisual(visuals[i]);
+    EXPECT_FALSE(scene->HasVisual(visuals[i]));
+    EXPECT_EQ(nullptr, scene->VisualById(visuals[i]->Id()));
+    EXPECT_EQ(nullptr, scene->VisualByName(visuals[i]->Name()));
+    --count;
+  }
+  scene->DestroyVisualByIndex(scene->VisualCount() - 1u);
+  --count;
+  EXPECT_EQ(count, scene->VisualCount());
+  checkVisuals();
+
+  // names of destroyed visuals can be reused
+  VisualPtr visual = scene->CreateVisual(visuals[0]->Name());
+  ASSERT_NE(nullptr, visual);
+  EXPECT_EQ(visual, scene->VisualByName(visuals[0]->Name()));
+  checkVisuals();
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+void SceneTest::PreRenderMaterials(const std::string &_renderEngine)
+{
+  auto engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine << "' is not supported" << std::endl;
+    return;
+  }
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // populate the scene with objects that do not change between frames
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  visual->AddGeometry(scene->CreateBox());
+  visual->SetMaterial(scene->CreateMaterial());
+  scene->RootVisual()->AddChild(visual);
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  scene->RootVisual()->AddChild(camera);
+  scene->CreateDirectionalLight();
+
+  auto material = std::make_shared<PreRenderCountMaterial>(scene);
+  scene->RegisterMaterial(material->Name(), material);
+  EXPECT_TRUE(scene->MaterialRegistered(material->Name()));
+
+  // a newly registered material is pre-rendered once
+  scene->PreRender();
+  EXPECT_EQ(1u, material->preRenderCount);
+
+  // nothing changes between these frames
+  for (unsigned int i = 0; i < 10u; ++i)
+    scene->PreRender();
+  EXPECT_EQ(1u, material->preRenderCount);
+
+  // changes are applied once in the next frame
+  material->Change();
+  material->Change();
+  EXPECT_EQ(1u, material->preRenderCount);
+  scene->PreRender();
+  EXPECT_EQ(2u, material->preRenderCount);
+  scene->PreRender();
+  EXPECT_EQ(2u, material->preRenderCount);
+
+  // unregistered materials are not pre-rendered
+  material->Change();
+  scene->UnregisterMaterial(material->Name());
+  scene->PreRender();
+  EXPECT_EQ(2u, material->preRenderCount);
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+void SceneTest::PreRenderSensors(const std::string &_renderEngine)
+{
+  auto engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine << "' is not supported" << std::endl;
+    return;
+  }
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  // a camera attached to a visual
+  VisualPtr visual = scene->CreateVisual();
+  ASSERT_NE(nullptr, visual);
+  scene->RootVisual()->AddChild(visual);
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  visual->AddChild(camera);
+
+  // each PreRender of the camera halves its distance to the follow target,
+  // so the camera position tells how many times it was pre-rendered
+  VisualPtr target = scene->CreateVisual();
+  ASSERT_NE(nullptr, target);
+  scene->RootVisual()->AddChild(target);
+  camera->SetFollowTarget(target, math::Vector3d(8, 0, 0), true);
+  camera->SetFollowPGain(0.5);
+
+  scene->PreRender();
+  EXPECT_DOUBLE_EQ(4.0, camera->WorldPosition().X());
+  scene->PreRender();
+  EXPECT_DOUBLE_EQ(6.0, camera->WorldPosition().X());
+
+  // the camera is still pre-rendered once when its parent changed
+  visual->SetLocalPosition(0, 0, 0);
+  scene->PreRender();
+  EXPECT_DOUBLE_EQ(7.0, camera->WorldPosition().X());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneTest, Scene)
 {
@@ -835,6 +1066,24 @@ TEST_P(SceneTest, Sky)
   Sky(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneTest, VisualLookup)
+{
+  VisualLookup(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneTest, PreRenderMaterials)
+{
+  PreRenderMaterials(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneTest, PreRenderSensors)
+{
+  PreRenderSensors(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(Scene, SceneTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
@@ -17,13 +17,17 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 
+#include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/Geometry.hh"
+#include "ignition/rendering/Material.hh"
+#include "ignition/rendering/Mesh.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
@@ -56,11 +60,21 @@ class VisualTest : public testing::Test,
   /// \brief Test getting setting bounding boxes
   public: void BoundingBox(const std::string &_renderEngine);
 
+  /// \brief Test that bounding boxes are updated when the scene graph
+  /// changes
+  public: void BoundingBoxUpdate(const std::string &_renderEngine);
+
   /// \brief Test changing to wireframe
   public: void Wireframe(const std::string &_renderEngine);
 
   /// \brief Test cloning visuals
   public: void Clone(const std::string &_renderEngine);
+
+  /// \brief Test cloning visuals as instances sharing materials
+  public: void CloneInstance(const std::string &_renderEngine);
+
+  /// \brief Test pre-rendering a scene graph that changes between frames
+  public: void PreRender(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -590,6 +604,107 @@ TEST_P(VisualTest, BoundingBox)
   BoundingBox(GetParam());
 }
 
+/////////////////////////////////////////////////
+void VisualTest::BoundingBoxUpdate(const std::string &_renderEngine)
+{
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene10");
+  ASSERT_NE(nullptr, scene);
+
+  // parent with a box and a child visual with a box
+  VisualPtr parent = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  parent->AddGeometry(scene->CreateBox());
+  VisualPtr child = scene->CreateVisual();
+  ASSERT_NE(nullptr, child);
+  child->AddGeometry(scene->CreateBox());
+  child->SetLocalPosition(2, 0, 0);
+  parent->AddChild(child);
+
+  math::AxisAlignedBox box = parent->BoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, -0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(2.5, 0.5, 0.5), box.Max());
+
+  // repeated queries on an unchanged scene return the same box
+  EXPECT_EQ(box, parent->BoundingBox());
+  EXPECT_EQ(box, parent->LocalBoundingBox());
+
+  // moving the parent moves the world box of both visuals but not the
+  // local box
+  parent->SetWorldPosition(0, 0, 1);
+  box = parent->BoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, 0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(2.5, 0.5, 1.5), box.Max());
+  box = child->BoundingBox();
+  EXPECT_EQ(math::Vector3d(1.5, -0.5, 0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(2.5, 0.5, 1.5), box.Max());
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, -0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(2.5, 0.5, 0.5), box.Max());
+
+  // moving the child updates the boxes of the parent
+  child->SetLocalPosition(0, 3, 0);
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, -0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 3.5, 0.5), box.Max());
+  box = parent->BoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, 0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 3.5, 1.5), box.Max());
+
+  // scaling the parent scales both boxes
+  parent->SetLocalScale(2.0);
+  box = child->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-1, -1, -1), box.Min());
+  EXPECT_EQ(math::Vector3d(1, 1, 1), box.Max());
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-1, -1, -1), box.Min());
+  EXPECT_EQ(math::Vector3d(1, 7, 1), box.Max());
+  parent->SetLocalScale(1.0);
+
+  // adding a geometry to a grandchild updates the boxes of all ancestors
+  VisualPtr grandChild = scene->CreateVisual();
+  ASSERT_NE(nullptr, grandChild);
+  grandChild->SetLocalPosition(0, 0, 3);
+  child->AddChild(grandChild);
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0.5, 3.5, 0.5), box.Max());
+  grandChild->AddGeometry(scene->CreateBox());
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(0.5, 3.5, 3.5), box.Max());
+
+  // moving the parent moves the cached world box of the grandchild
+  box = grandChild->BoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, 2.5, 3.5), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 3.5, 4.5), box.Max());
+  parent->SetWorldPosition(1, 0, 1);
+  box = grandChild->BoundingBox();
+  EXPECT_EQ(math::Vector3d(0.5, 2.5, 3.5), box.Min());
+  EXPECT_EQ(math::Vector3d(1.5, 3.5, 4.5), box.Max());
+
+  // removing the child shrinks the box of the parent
+  parent->RemoveChild(child);
+  box = parent->LocalBoundingBox();
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, -0.5), box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 0.5), box.Max());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_P(VisualTest, BoundingBoxUpdate)
+{
+  BoundingBoxUpdate(GetParam());
+}
+
 /////////////////////////////////////////////////
 void VisualTest::Wireframe(const std::string &_renderEngine)
 {
@@ -763,6 +878,225 @@ TEST_P(VisualTest, Clone)
   Clone(GetParam());
 }
 
+/////////////////////////////////////////////////
+void VisualTest::CloneInstance(const std::string &_renderEngine)
+{
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene11");
+  ASSERT_NE(nullptr, scene);
+
+  // a box with a child cylinder, sharing a material
+  VisualPtr parent = scene->CreateVisual();
+  ASSERT_NE(nullptr, parent);
+  parent->AddGeometry(scene->CreateBox());
+  VisualPtr child = scene->CreateVisual();
+  ASSERT_NE(nullptr, child);
+  child->AddGeometry(scene->CreateCylinder());
+  parent->AddChild(child);
+
+  MaterialPtr material = scene->CreateMaterial();
+  ASSERT_NE(nullptr, material);
+  material->SetDiffuse(math::Color(0.1f, 0.9f, 0.3f, 1.0f));
+  parent->SetMaterial(material);
+
+  parent->SetLocalScale(math::Vector3d(1, 2, 3));
+  parent->SetUserData("label", 5);
+
+  // many instances of the same visual
+  const unsigned int instanceCount = 50u;
+  std::vector<VisualPtr> instances;
+  for (unsigned int i = 0u; i < instanceCount; ++i)
+  {
+    VisualPtr instance = parent->CloneInstance("", scene->RootVisual());
+    ASSERT_NE(nullptr, instance);
+    instance->SetWorldPosition(math::Vector3d(i, 0, 0));
+    instances.push_back(instance);
+  }
+
+  // the instances are separate visuals with the same properties
+  for (const auto &instance : instances)
+  {
+    EXPECT_NE(parent->Id(), instance->Id());
+    EXPECT_EQ(parent->LocalScale(), instance->LocalScale());
+    EXPECT_EQ(parent->UserData("label"), instance->UserData("label"));
+    EXPECT_EQ(parent->ChildCount(), instance->ChildCount());
+    EXPECT_EQ(parent->GeometryCount(), instance->GeometryCount());
+
+    // which share the materials instead of copying them
+    EXPECT_EQ(parent->Material(), instance->Material());
+    ASSERT_EQ(1u, instance->GeometryCount());
+    EXPECT_EQ(parent->GeometryByIndex(0u)->Material(),
+        instance->GeometryByIndex(0u)->Material());
+    ASSERT_EQ(1u, instance->ChildCount());
+    VisualPtr instanceChild =
+        std::dynamic_pointer_cast<Visual>(instance->ChildByIndex(0u));
+    ASSERT_NE(nullptr, instanceChild);
+    EXPECT_NE(child->Id(), instanceChild->Id());
+    EXPECT_EQ(child->Material(), instanceChild->Material());
+  }
+  EXPECT_EQ(math::Vector3d(instanceCount - 1u, 0, 0),
+      instances.back()->WorldPosition());
+
+  // destroying an instance leaves the shared material to the source visual
+  scene->DestroyVisual(instances.back(), true);
+  instances.pop_back();
+  ASSERT_NE(nullptr, parent->Material());
+  EXPECT_TRUE(scene->MaterialRegistered(parent->Material()->Name()));
+  EXPECT_EQ(parent->Material(), instances.front()->Material());
+
+  // visuals without a material can be instanced too
+  VisualPtr plain = scene->CreateVisual();
+  ASSERT_NE(nullptr, plain);
+  plain->AddGeometry(scene->CreateSphere());
+  VisualPtr plainInstance = plain->CloneInstance("plainInstance", nullptr);
+  ASSERT_NE(nullptr, plainInstance);
+  EXPECT_EQ("plainInstance", plainInstance->Name());
+  EXPECT_EQ(1u, plainInstance->GeometryCount());
+
+  // the materials owned by the geometries of the source, for the whole mesh
+  // or per submesh, are shared with the instances and outlive the source
+  GeometryPtr box = scene->CreateBox();
+  ASSERT_NE(nullptr, box);
+  box->SetMaterial(material);
+  VisualPtr source = scene->CreateVisual();
+  ASSERT_NE(nullptr, source);
+  source->AddGeometry(box);
+  source->AddGeometry(scene->CreateSphere());
+  MeshPtr sphere =
+      std::dynamic_pointer_cast<Mesh>(source->GeometryByIndex(1u));
+  ASSERT_NE(nullptr, sphere);
+  ASSERT_LT(0u, sphere->SubMeshCount());
+  std::vector<std::string> sharedMaterials;
+  sharedMaterials.push_back(box->Material()->Name());
+  sharedMaterials.push_back(sphere->SubMeshByIndex(0u)->Material()->Name());
+
+  std::vector<VisualPtr> sourceInstances;
+  for (unsigned int i = 0u; i < 2u; ++i)
+  {
+    VisualPtr instance = source->CloneInstance("", scene->RootVisual());
+    ASSERT_NE(nullptr, instance);
+    ASSERT_EQ(2u, instance->GeometryCount());
+    EXPECT_EQ(box->Material(), instance->GeometryByIndex(0u)->Material());
+    MeshPtr instanceSphere =
+        std::dynamic_pointer_cast<Mesh>(instance->GeometryByIndex(1u));
+    ASSERT_NE(nullptr, instanceSphere);
+    EXPECT_EQ(sphere->SubMeshByIndex(0u)->Material(),
+        instanceSphere->SubMeshByIndex(0u)->Material());
+    sourceInstances.push_back(instance);
+  }
+
+  scene->DestroyVisual(source);
+  for (const auto &name : sharedMaterials)
+    EXPECT_TRUE(scene->MaterialRegistered(name)) << name;
+
+  // the instances can still be rendered
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  camera->SetImageWidth(64u);
+  camera->SetImageHeight(64u);
+  scene->RootVisual()->AddChild(camera);
+  camera->SetLocalPosition(-5, 0, 0);
+  camera->Update();
+  camera->Update();
+
+  // the last instance destroys the shared materials
+  scene->DestroyVisual(sourceInstances.front());
+  for (const auto &name : sharedMaterials)
+    EXPECT_TRUE(scene->MaterialRegistered(name)) << name;
+  camera->Update();
+  scene->DestroyVisual(sourceInstances.back());
+  for (const auto &name : sharedMaterials)
+    EXPECT_FALSE(scene->MaterialRegistered(name)) << name;
+
+  // clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_P(VisualTest, CloneInstance)
+{
+  CloneInstance(GetParam());
+}
+
+/////////////////////////////////////////////////
+void VisualTest::PreRender(const std::string &_renderEngine)
+{
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene9");
+  ASSERT_NE(nullptr, scene);
+  VisualPtr root = scene->RootVisual();
+  ASSERT_NE(nullptr, root);
+
+  // build a chain of visuals with a box at the end
+  VisualPtr first = scene->CreateVisual();
+  ASSERT_NE(nullptr, first);
+  first->SetLocalPosition(1, 0, 0);
+  root->AddChild(first);
+  VisualPtr parent = first;
+  for (unsigned int i = 0; i < 4u; ++i)
+  {
+    VisualPtr visual = scene->CreateVisual();
+    ASSERT_NE(nullptr, visual);
+    visual->SetLocalPosition(1, 0, 0);
+    parent->AddChild(visual);
+    parent = visual;
+  }
+  VisualPtr leaf = parent;
+  leaf->AddGeometry(scene->CreateBox());
+
+  // nothing changes between these frames
+  for (unsigned int i = 0; i < 3u; ++i)
+    scene->PreRender();
+  EXPECT_EQ(math::Vector3d(5, 0, 0), leaf->WorldPosition());
+
+  // change the scene graph after it has been pre-rendered and verify the
+  // changes are picked up
+  VisualPtr child = scene->CreateVisual();
+  ASSERT_NE(nullptr, child);
+  child->SetLocalPosition(0, 1, 0);
+  leaf->AddChild(child);
+  child->AddGeometry(scene->CreateSphere());
+  MaterialPtr material = scene->CreateMaterial();
+  material->SetDiffuse(1.0, 0.0, 0.0);
+  child->SetMaterial(material);
+  scene->PreRender();
+  EXPECT_EQ(math::Vector3d(5, 1, 0), child->WorldPosition());
+  EXPECT_EQ(math::Color(1.0f, 0.0f, 0.0f), child->Material()->Diffuse());
+
+  first->SetLocalPosition(2, 0, 0);
+  scene->PreRender();
+  EXPECT_EQ(math::Vector3d(6, 1, 0), child->WorldPosition());
+
+  leaf->RemoveChild(child);
+  scene->PreRender();
+  EXPECT_EQ(0u, leaf->ChildCount());
+  EXPECT_EQ(1u, leaf->GeometryCount());
+
+  // clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_P(VisualTest, PreRender)
+{
+  PreRender(GetParam());
+}
 
 INSTANTIATE_TEST_CASE_P(Visual, VisualTest,
     RENDER_ENGINE_VALUES,
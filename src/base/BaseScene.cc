@@ -39,6 +39,7 @@
 #include "ignition/rendering/GizmoVisual.hh"
 #include "ignition/rendering/GpuRays.hh"
 #include "ignition/rendering/Grid.hh"
+#include "ignition/rendering/Mesh.hh"
 #include "ignition/rendering/ParticleEmitter.hh"
 #include "ignition/rendering/RayQuery.hh"
 #include "ignition/rendering/RenderTarget.hh"
@@ -621,18 +622,25 @@ void BaseScene::RegisterMaterial(const std::string &_name,
     MaterialPtr _material)
 {
   if (_material)
+  {
     this->Materials()->Put(_name, _material);
+    this->SetMaterialPreRenderDirty(_material);
+  }
 }
 
 //////////////////////////////////////////////////
 void BaseScene::UnregisterMaterial(const std::string &_name)
 {
+  MaterialPtr material = this->Materials()->Get(_name);
+  if (material)
+    this->preRenderMaterials.erase(material->Id());
   this->Materials()->Remove(_name);
 }
 
 //////////////////////////////////////////////////
 void BaseScene::UnregisterMaterials()
 {
+  this->preRenderMaterials.clear();
   this->Materials()->RemoveAll();
 }
 
@@ -642,14 +650,45 @@ void BaseScene::DestroyMaterial(MaterialPtr _material)
   if (!_material)
     return;
 
+  // shared materials are destroyed by their last owner
+  auto owners = this->materialOwners.find(_material->Id());
+  if (owners != this->materialOwners.end())
+  {
+    if (--owners->second > 0u)
+      return;
+    this->materialOwners.erase(owners);
+  }
+
   std::string matName = _material->Name();
   _material->Destroy();
   this->UnregisterMaterial(matName);
 }
 
+//////////////////////////////////////////////////
+void BaseScene::ShareMaterial(MaterialPtr _material)
+{
+  if (_material)
+    this->materialOwners.emplace(_material->Id(), 1u);
+}
+
+//////////////////////////////////////////////////
+bool BaseScene::AcquireMaterial(MaterialPtr _material)
+{
+  if (!_material)
+    return false;
+
+  auto owners = this->materialOwners.find(_material->Id());
+  if (owners == this->materialOwners.end())
+    return false;
+
+  ++owners->second;
+  return true;
+}
+
 //////////////////////////////////////////////////
 void BaseScene::DestroyMaterials()
 {
+  this->materialOwners.clear();
   for (unsigned int i = 0; i < this->Materials()->Size(); ++i)
   {
     auto m = this->Materials()->GetByIndex(i);
@@ -1211,6 +1250,49 @@ MeshPtr BaseScene::CreateMesh(const MeshDescriptor &_desc)
   return this->CreateMeshImpl(objId, objName, _desc);
 }
 
+//////////////////////////////////////////////////
+MeshPtr BaseScene::CreateMeshInstance(MeshPtr _mesh)
+{
+  if (!_mesh)
+    return nullptr;
+
+  // the mesh and its instances own the materials together, so the materials
+  // outlive the mesh while instances still use them
+  this->ShareMaterial(_mesh->Material());
+  for (unsigned int i = 0; i < _mesh->SubMeshCount(); ++i)
+    this->ShareMaterial(_mesh->SubMeshByIndex(i)->Material());
+
+  const MeshDescriptor &desc = _mesh->Descriptor();
+  std::string meshName = (desc.mesh) ? desc.mesh->Name() : desc.meshName;
+  unsigned int objId = this->CreateObjectId();
+  std::string objName = this->CreateObjectName(objId, "Mesh-" + meshName);
+  return this->CreateMeshInstanceImpl(objId, objName, _mesh);
+}
+
+//////////////////////////////////////////////////
+MeshPtr BaseScene::CreateMeshInstanceImpl(unsigned int _id,
+    const std::string &_name, MeshPtr _mesh)
+{
+  MeshPtr mesh = this->CreateMeshImpl(_id, _name, _mesh->Descriptor());
+  if (!mesh)
+    return nullptr;
+
+  if (_mesh->Material())
+  {
+    mesh->SetMaterial(_mesh->Material(), false);
+    return mesh;
+  }
+
+  for (unsigned int i = 0; i < _mesh->SubMeshCount() &&
+      i < mesh->SubMeshCount(); ++i)
+  {
+    MaterialPtr material = _mesh->SubMeshByIndex(i)->Material();
+    if (material)
+      mesh->SubMeshByIndex(i)->SetMaterial(material, false);
+  }
+  return mesh;
+}
+
 //////////////////////////////////////////////////
 HeightmapPtr BaseScene::CreateHeightmap(const HeightmapDescriptor &_desc)
 {
@@ -1393,6 +1475,33 @@ bool BaseScene::SkyEnabled() const
 void BaseScene::PreRender()
 {
   this->RootVisual()->PreRender();
+
+  // sensors are skipped by the traversal above since they need to update
+  // every frame, e.g. to follow a node, and would otherwise keep all their
+  // ancestors dirty
+  SensorStorePtr sensors = this->Sensors();
+  for (unsigned int i = 0; i < sensors->Size(); ++i)
+    sensors->GetByIndex(i)->PreRender();
+
+  // visuals with no changes in their subtree are skipped during the
+  // traversal so their geometries do not get a chance to update their
+  // materials. Update the materials that changed since the last frame here
+  // instead. Materials may mark themselves dirty again while pre-rendered.
+  std::map<unsigned int, std::weak_ptr<Material>> dirtyMaterials;
+  std::swap(dirtyMaterials, this->preRenderMaterials);
+  for (auto &it : dirtyMaterials)
+  {
+    MaterialPtr material = it.second.lock();
+    if (material)
+      material->PreRender();
+  }
+}
+
+//////////////////////////////////////////////////
+void BaseScene::SetMaterialPreRenderDirty(MaterialPtr _material)
+{
+  if (_material)
+    this->preRenderMaterials[_material->Id()] = _material;
 }
 
 //////////////////////////////////////////////////
@@ -1417,6 +1526,21 @@ bool BaseScene::LegacyAutoGpuFlush() const
   return true;
 }
 
+//////////////////////////////////////////////////
+void BaseScene::RenderSensors(const std::vector<CameraPtr> &_cameras)
+{
+  this->PreRender();
+
+  for (auto &camera : _cameras)
+    camera->Render();
+
+  for (auto &camera : _cameras)
+    camera->PostRender();
+
+  if (!this->LegacyAutoGpuFlush())
+    this->PostRender();
+}
+
 //////////////////////////////////////////////////
 void BaseScene::Clear()
 {
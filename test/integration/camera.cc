@@ -17,12 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <ignition/common/Console.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 
 #include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/GpuRays.hh"
+#include "ignition/rendering/RayQuery.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
@@ -301,6 +304,60 @@ void CameraTest::VisualAt(const std::string &_renderEngine)
     }
   }
 
+  // query all the positions at once, including ones outside the image
+  std::vector<math::Vector2i> positions;
+  for (auto x = 0u; x < camera->ImageWidth(); x = x + 100)
+    positions.push_back(math::Vector2i(x, camera->ImageHeight() / 2));
+  positions.push_back(math::Vector2i(-1, 0));
+  positions.push_back(math::Vector2i(camera->ImageWidth(), 0));
+  std::vector<VisualPtr> visuals = camera->VisualsAt(positions);
+  ASSERT_EQ(positions.size(), visuals.size());
+  for (unsigned int i = 0u; i < positions.size(); ++i)
+  {
+    EXPECT_EQ(camera->VisualAt(positions[i]), visuals[i])
+        << "X: " << positions[i].X();
+  }
+
+  // a dense block of pixels queried together with a pixel far away, and
+  // then a smaller block
+  for (int size : {5, 2})
+  {
+    positions.clear();
+    int centerX = static_cast<int>(camera->ImageWidth() / 2);
+    int centerY = static_cast<int>(camera->ImageHeight() / 2);
+    for (int y = centerY - size; y <= centerY + size; ++y)
+    {
+      for (int x = centerX - size; x <= centerX + size; ++x)
+        positions.push_back(math::Vector2i(x, y));
+    }
+    positions.push_back(math::Vector2i(0, 0));
+    visuals = camera->VisualsAt(positions);
+    ASSERT_EQ(positions.size(), visuals.size());
+    for (unsigned int i = 0u; i < positions.size(); ++i)
+    {
+      EXPECT_EQ(camera->VisualAt(positions[i]), visuals[i])
+          << "X: " << positions[i].X() << " Y: " << positions[i].Y();
+    }
+  }
+
+  // batched ray query results match single ray queries
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_NE(nullptr, rayQuery);
+  std::vector<math::Vector2d> coords;
+  for (double x = -0.9; x < 1.0; x += 0.3)
+    coords.push_back(math::Vector2d(x, 0.0));
+  std::vector<RayQueryResult> results = rayQuery->ClosestPoints(camera,
+      coords);
+  ASSERT_EQ(coords.size(), results.size());
+  for (unsigned int i = 0u; i < coords.size(); ++i)
+  {
+    rayQuery->SetFromCamera(camera, coords[i]);
+    RayQueryResult result = rayQuery->ClosestPoint();
+    EXPECT_EQ(result.objectId, results[i].objectId) << "X: " << coords[i].X();
+    EXPECT_NEAR(result.distance, results[i].distance, 1e-3);
+    EXPECT_TRUE(result.point.Equal(results[i].point, 1e-3));
+  }
+
   // change camera size
   camera->SetImageWidth(1200);
   camera->SetImageHeight(800);
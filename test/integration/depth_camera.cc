@@ -34,6 +34,7 @@
 
 unsigned int g_depthCounter = 0;
 unsigned int g_pointCloudCounter = 0;
+unsigned int g_depthViewCounter = 0;
 
 void OnNewDepthFrame(float *_scanDest, const float *_scan,
                   unsigned int _width, unsigned int _height,
@@ -57,6 +58,19 @@ void OnNewRgbPointCloud(float *_scanDest, const float *_scan,
   g_pointCloudCounter++;
 }
 
+void OnNewDepthFrameView(float *_depthDest, const float *_data,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _channels, unsigned int _rowStride,
+                  const std::string &/*_format*/)
+{
+  for (unsigned int i = 0; i < _height; ++i)
+  {
+    for (unsigned int j = 0; j < _width; ++j)
+      _depthDest[i * _width + j] = _data[i * _rowStride + j * _channels];
+  }
+  g_depthViewCounter++;
+}
+
 class DepthCameraTest: public testing::Test,
   public testing::WithParamInterface<const char *>
 {
@@ -66,6 +80,9 @@ class DepthCameraTest: public testing::Test,
   // Compare depth camera image before and after adding particles
   // in the scene
   public: void DepthCameraParticles(const std::string &_renderEngine);
+
+  // Verify depth data is delivered one update late with async readback
+  public: void DepthCameraAsyncReadback(const std::string &_renderEngine);
 };
 
 void DepthCameraTest::DepthCameraBoxes(
@@ -173,14 +190,34 @@ void DepthCameraTest::DepthCameraBoxes(
             std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
             std::placeholders::_4, std::placeholders::_5));
 
+    // depth frame view callback
+    float *viewScan = new float[imgHeight_ * imgWidth_];
+    ignition::common::ConnectionPtr connection3 =
+      depthCamera->ConnectNewDepthFrameView(
+          std::bind(&::OnNewDepthFrameView, viewScan,
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+            std::placeholders::_4, std::placeholders::_5,
+            std::placeholders::_6));
+
     // update and verify we get new data
     g_depthCounter = 0u;
     g_pointCloudCounter = 0u;
+    g_depthViewCounter = 0u;
     depthCamera->Update();
     scene->SetTime(scene->Time() + std::chrono::milliseconds(16));
     EXPECT_EQ(1u, g_depthCounter);
     EXPECT_EQ(1u, g_pointCloudCounter);
 
+    // depth read through the view should match the depth frame
+    if (connection3)
+    {
+      EXPECT_EQ(1u, g_depthViewCounter);
+      for (int i = 0; i < imgHeight_ * imgWidth_; ++i)
+        EXPECT_FLOAT_EQ(scan[i], viewScan[i]);
+    }
+    connection3.reset();
+    delete [] viewScan;
+
     // compute mid, left, and right indices to be used later for retrieving data
     // from depth and point cloud image
 
@@ -785,6 +822,109 @@ void DepthCameraTest::DepthCameraParticles(
   ignition::rendering::unloadEngine(engine->Name());
 }
 
+void DepthCameraTest::DepthCameraAsyncReadback(
+    const std::string &_renderEngine)
+{
+  unsigned int imgWidth = 128u;
+  unsigned int imgHeight = 128u;
+
+  double unitBoxSize = 1.0;
+  ignition::math::Vector3d boxPosition(1.8, 0.0, 0.0);
+
+  // asynchronous readback is only supported in ogre2
+  if (_renderEngine.compare("ogre2") != 0)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' doesn't support async readback" << std::endl;
+    return;
+  }
+
+  // Setup ign-rendering with an empty scene
+  auto *engine = ignition::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ignition::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ignition::rendering::VisualPtr root = scene->RootVisual();
+
+  // create box visual
+  ignition::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(boxPosition);
+  box->SetLocalScale(unitBoxSize, unitBoxSize, unitBoxSize);
+  root->AddChild(box);
+  {
+    // Create depth camera
+    auto depthCamera = scene->CreateDepthCamera("DepthCamera");
+    ASSERT_NE(depthCamera, nullptr);
+
+    depthCamera->SetImageWidth(imgWidth);
+    depthCamera->SetImageHeight(imgHeight);
+    depthCamera->SetFarClipPlane(10.0);
+    depthCamera->SetNearClipPlane(0.15);
+    depthCamera->SetAspectRatio(1.0);
+    depthCamera->SetHFOV(1.05);
+
+    EXPECT_FALSE(depthCamera->AsyncReadback());
+    depthCamera->SetAsyncReadback(true);
+    EXPECT_TRUE(depthCamera->AsyncReadback());
+
+    depthCamera->CreateDepthTexture();
+    root->AddChild(depthCamera);
+
+    float *scan = new float[imgHeight * imgWidth];
+    ignition::common::ConnectionPtr connection =
+      depthCamera->ConnectNewDepthFrame(
+          std::bind(&::OnNewDepthFrame, scan,
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+            std::placeholders::_4, std::placeholders::_5));
+
+    // first update only queues a download so no data should be delivered
+    g_depthCounter = 0u;
+    depthCamera->Update();
+    EXPECT_EQ(0u, g_depthCounter);
+
+    // data of the previous frame is delivered on every following update
+    for (unsigned int i = 0u; i < 3u; ++i)
+    {
+      depthCamera->Update();
+      EXPECT_EQ(i + 1u, g_depthCounter);
+    }
+
+    unsigned int mid = imgHeight / 2u * imgWidth + imgWidth / 2u - 1u;
+    double expectedRange = boxPosition.X() - unitBoxSize * 0.5;
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+
+    // move the box away. The first update still delivers the old frame
+    ignition::math::Vector3d boxPositionFar(1.8 + 1.0, 0.0, 0.0);
+    box->SetLocalPosition(boxPositionFar);
+    depthCamera->Update();
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+    depthCamera->Update();
+    EXPECT_NEAR(expectedRange + 1.0, scan[mid], DEPTH_TOL);
+
+    // switching back to synchronous readback delivers data right away
+    depthCamera->SetAsyncReadback(false);
+    EXPECT_FALSE(depthCamera->AsyncReadback());
+    box->SetLocalPosition(boxPosition);
+    g_depthCounter = 0u;
+    depthCamera->Update();
+    EXPECT_EQ(1u, g_depthCounter);
+    EXPECT_NEAR(expectedRange, scan[mid], DEPTH_TOL);
+
+    // Clean up
+    connection.reset();
+    delete [] scan;
+  }
+
+  engine->DestroyScene(scene);
+  ignition::rendering::unloadEngine(engine->Name());
+}
+
 TEST_P(DepthCameraTest, DepthCameraBoxes)
 {
   DepthCameraBoxes(GetParam());
@@ -795,6 +935,11 @@ TEST_P(DepthCameraTest, DepthCameraParticles)
   DepthCameraParticles(GetParam());
 }
 
+TEST_P(DepthCameraTest, DepthCameraAsyncReadback)
+{
+  DepthCameraAsyncReadback(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(DepthCamera, DepthCameraTest,
     RENDER_ENGINE_VALUES, ignition::rendering::PrintToStringParam());
 
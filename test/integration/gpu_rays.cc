@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Image.hh>
 #include <ignition/common/Filesystem.hh>
@@ -67,6 +71,12 @@ class GpuRaysTest: public testing::Test,
 
   // Test single ray box intersection
   public: void SingleRay(const std::string &_renderEngine);
+
+  // Test adaptive resolution of the cubemap faces
+  public: void AdaptiveCubemapResolution(const std::string &_renderEngine);
+
+  // Test sampling the cubemap rendered by another sensor
+  public: void SharedCubemap(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -158,6 +168,18 @@ void GpuRaysTest::Configure(const std::string &_renderEngine)
     gpuRays->SetVerticalResolution(-0.8);
     EXPECT_DOUBLE_EQ(2.4, gpuRays->HorizontalResolution());
     EXPECT_DOUBLE_EQ(0.8, gpuRays->VerticalResolution());
+
+    EXPECT_FALSE(gpuRays->AdaptiveCubemapResolution());
+    gpuRays->SetAdaptiveCubemapResolution(true);
+    EXPECT_TRUE(gpuRays->AdaptiveCubemapResolution());
+
+    EXPECT_EQ(nullptr, gpuRays->CubemapSource());
+    GpuRaysPtr source = scene->CreateGpuRays("gpu_rays_source");
+    gpuRays->SetCubemapSource(source);
+    EXPECT_EQ(source, gpuRays->CubemapSource());
+    gpuRays->SetCubemapSource(nullptr);
+    EXPECT_EQ(nullptr, gpuRays->CubemapSource());
+    scene->DestroySensor(source);
   }
 
   // Clean up
@@ -834,6 +856,256 @@ void GpuRaysTest::SingleRay(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+/// \brief Compare the ranges of a lidar with a narrow vertical field of view
+/// with and without adaptive cubemap resolution
+void GpuRaysTest::AdaptiveCubemapResolution(const std::string &_renderEngine)
+{
+#ifdef __APPLE__
+  ignerr << "Skipping test for apple, see issue #35." << std::endl;
+  return;
+#endif
+
+  if (_renderEngine == "optix")
+  {
+    igndbg << "GpuRays not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  const double hMinAngle = -IGN_PI;
+  const double hMaxAngle = IGN_PI;
+  const double vMinAngle = -IGN_PI/12.0;
+  const double vMaxAngle = IGN_PI/12.0;
+  const double minRange = 0.1;
+  const double maxRange = 10.0;
+  const unsigned int hRayCount = 720;
+  const unsigned int vRayCount = 8;
+
+  // create and populate scene
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+
+#if IGNITION_RENDERING_MAJOR_VERSION <= 6
+  // HACK: Tell ign-rendering6 to listen to SetTime calls
+  scene->SetTime(std::chrono::nanoseconds(-1));
+#endif
+
+  VisualPtr root = scene->RootVisual();
+
+  // two lidars at the same pose, one with adaptive cubemap resolution
+  GpuRaysPtr gpuRays[2];
+  for (unsigned int i = 0; i < 2u; ++i)
+  {
+    gpuRays[i] = scene->CreateGpuRays("adaptive_gpu_rays_" +
+        std::to_string(i));
+    ASSERT_TRUE(gpuRays[i] != nullptr);
+    gpuRays[i]->SetWorldPosition(0, 0, 0.5);
+    gpuRays[i]->SetNearClipPlane(minRange);
+    gpuRays[i]->SetFarClipPlane(maxRange);
+    gpuRays[i]->SetAngleMin(hMinAngle);
+    gpuRays[i]->SetAngleMax(hMaxAngle);
+    gpuRays[i]->SetVerticalAngleMin(vMinAngle);
+    gpuRays[i]->SetVerticalAngleMax(vMaxAngle);
+    gpuRays[i]->SetRayCount(hRayCount);
+    gpuRays[i]->SetVerticalRayCount(vRayCount);
+    root->AddChild(gpuRays[i]);
+  }
+  gpuRays[1]->SetAdaptiveCubemapResolution(true);
+
+  // boxes in front, to the left and behind the lidars
+  std::vector<math::Vector3d> boxPositions = {
+      math::Vector3d(2, 0, 0.5),
+      math::Vector3d(0, 3, 0.5),
+      math::Vector3d(-4, 1, 0.5)};
+  for (unsigned int i = 0; i < boxPositions.size(); ++i)
+  {
+    VisualPtr box = scene->CreateVisual("AdaptiveTestBox" + std::to_string(i));
+    box->AddGeometry(scene->CreateBox());
+    box->SetWorldPosition(boxPositions[i]);
+    root->AddChild(box);
+  }
+
+  unsigned int channels = gpuRays[0]->Channels();
+  unsigned int size = hRayCount * vRayCount * channels;
+  std::vector<float> scan(size);
+  std::vector<float> adaptiveScan(size);
+  common::ConnectionPtr c1 =
+    gpuRays[0]->ConnectNewGpuRaysFrame(
+        std::bind(&::OnNewGpuRaysFrame, scan.data(),
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+  common::ConnectionPtr c2 =
+    gpuRays[1]->ConnectNewGpuRaysFrame(
+        std::bind(&::OnNewGpuRaysFrame, adaptiveScan.data(),
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+
+  gpuRays[0]->Update();
+  gpuRays[1]->Update();
+  scene->SetTime(scene->Time() + std::chrono::milliseconds(16));
+
+  // both lidars see the same ranges. Compare the range channel only.
+  unsigned int hits = 0u;
+  for (unsigned int i = 0; i < size; i += channels)
+  {
+    if (std::isinf(scan[i]))
+    {
+      EXPECT_FLOAT_EQ(scan[i], adaptiveScan[i]) << i;
+      continue;
+    }
+    EXPECT_NEAR(scan[i], adaptiveScan[i], LASER_TOL) << i;
+    hits++;
+  }
+  EXPECT_LT(0u, hits);
+
+  c1.reset();
+  c2.reset();
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+/// \brief Render lidars that sample the cubemap of another lidar and compare
+/// their ranges with a lidar that renders its own cubemap
+void GpuRaysTest::SharedCubemap(const std::string &_renderEngine)
+{
+#ifdef __APPLE__
+  ignerr << "Skipping test for apple, see issue #35." << std::endl;
+  return;
+#endif
+
+  if (_renderEngine == "optix")
+  {
+    igndbg << "GpuRays not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  const double hMinAngle = -IGN_PI/2.0;
+  const double hMaxAngle = IGN_PI/2.0;
+  const double minRange = 0.1;
+  const double maxRange = 10.0;
+  const unsigned int hRayCount = 321;
+  const unsigned int mid = hRayCount / 2u;
+
+  // create and populate scene
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+  // render all sensors within one frame so the cubemap is rendered once
+  scene->SetCameraPassCountPerGpuFlush(6u);
+
+  VisualPtr root = scene->RootVisual();
+
+  // 0: source looking along +X
+  // 1: looking along +Y and sampling the cubemap of the source
+  // 2: same pose as 1 but rendering its own cubemap
+  // 3: sampling the cubemap of the source from a different position, which
+  //    is not supported so it renders its own cubemap
+  std::vector<math::Pose3d> poses = {
+      math::Pose3d(0, 0, 0.5, 0, 0, 0),
+      math::Pose3d(0, 0, 0.5, 0, 0, IGN_PI/2.0),
+      math::Pose3d(0, 0, 0.5, 0, 0, IGN_PI/2.0),
+      math::Pose3d(0, 0.5, 0.5, 0, 0, IGN_PI/2.0)};
+  std::vector<GpuRaysPtr> gpuRays;
+  std::vector<CameraPtr> sensors;
+  for (unsigned int i = 0; i < poses.size(); ++i)
+  {
+    GpuRaysPtr lidar = scene->CreateGpuRays("shared_gpu_rays_" +
+        std::to_string(i));
+    ASSERT_TRUE(lidar != nullptr);
+    lidar->SetWorldPose(poses[i]);
+    lidar->SetNearClipPlane(minRange);
+    lidar->SetFarClipPlane(maxRange);
+    lidar->SetAngleMin(hMinAngle);
+    lidar->SetAngleMax(hMaxAngle);
+    lidar->SetRayCount(hRayCount);
+    root->AddChild(lidar);
+    gpuRays.push_back(lidar);
+    sensors.push_back(lidar);
+  }
+  gpuRays[1]->SetCubemapSource(gpuRays[0]);
+  gpuRays[3]->SetCubemapSource(gpuRays[0]);
+
+  // boxes in front of and to the left of the sensors
+  VisualPtr box01 = scene->CreateVisual("SharedTestBox1");
+  box01->AddGeometry(scene->CreateBox());
+  box01->SetWorldPosition(2, 0, 0.5);
+  root->AddChild(box01);
+
+  VisualPtr box02 = scene->CreateVisual("SharedTestBox2");
+  box02->AddGeometry(scene->CreateBox());
+  box02->SetWorldPosition(0.5, 2, 0.5);
+  box02->SetWorldRotation(0, 0, IGN_PI/4.0);
+  root->AddChild(box02);
+
+  unsigned int channels = gpuRays[0]->Channels();
+  std::vector<std::vector<float>> scans(gpuRays.size(),
+      std::vector<float>(hRayCount * channels));
+  std::vector<common::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < gpuRays.size(); ++i)
+  {
+    connections.push_back(gpuRays[i]->ConnectNewGpuRaysFrame(
+        std::bind(&::OnNewGpuRaysFrame, scans[i].data(),
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5)));
+  }
+
+  for (unsigned int n = 0; n < 2u; ++n)
+  {
+    scene->RenderSensors(sensors);
+
+    // box in front of the source
+    EXPECT_NEAR(1.5, scans[0][mid * channels], LASER_TOL);
+
+    // the shared and the standalone sensors see the same ranges. Ranges
+    // on the rotated box are sampled from differently oriented cubemap
+    // texels so only compare them loosely.
+    unsigned int hits = 0u;
+    for (unsigned int i = 0; i < hRayCount; ++i)
+    {
+      float shared = scans[1][i * channels];
+      float expected = scans[2][i * channels];
+      if (std::isinf(expected) || std::isinf(shared))
+        continue;
+      EXPECT_NEAR(expected, shared, 1e-2) << i;
+      hits++;
+    }
+    EXPECT_LT(hRayCount / 4u, hits);
+    EXPECT_EQ(std::isinf(scans[1][0]), std::isinf(scans[2][0]));
+    EXPECT_EQ(std::isinf(scans[1][(hRayCount - 1u) * channels]),
+              std::isinf(scans[2][(hRayCount - 1u) * channels]));
+
+    // the sensor at a different position is not affected by the source
+    EXPECT_NEAR(scans[2][mid * channels] - 0.5, scans[3][mid * channels],
+        1e-2);
+  }
+
+  connections.clear();
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(GpuRaysTest, Configure)
 {
@@ -864,6 +1136,18 @@ TEST_P(GpuRaysTest, SingleRay)
   SingleRay(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(GpuRaysTest, AdaptiveCubemapResolution)
+{
+  AdaptiveCubemapResolution(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(GpuRaysTest, SharedCubemap)
+{
+  SharedCubemap(GetParam());
+}
+
 
 INSTANTIATE_TEST_CASE_P(GpuRays, GpuRaysTest,
     RENDER_ENGINE_VALUES,
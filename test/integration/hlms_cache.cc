@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/Image.hh"
+#include "ignition/rendering/RenderEngine.hh"
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/Scene.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+class HlmsCacheTest: public testing::Test,
+                     public testing::WithParamInterface<const char *>
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+
+  // Test that shaders are written to and read from the hlms cache
+  public: void HlmsCache(const std::string &_renderEngine);
+};
+
+/////////////////////////////////////////////////
+/// \brief Count the cache files in the directories of an hlms cache
+static unsigned int cachedFileCount(const std::string &_path)
+{
+  unsigned int count = 0u;
+  for (common::DirIter dir(_path); dir != common::DirIter(); ++dir)
+  {
+    if (!common::isDirectory(*dir))
+      continue;
+    for (common::DirIter file(*dir); file != common::DirIter(); ++file)
+    {
+      std::string name = common::basename(*file);
+      if (name.size() > 6u && name.substr(name.size() - 6u) == ".cache")
+        ++count;
+    }
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Render a red box in front of a camera
+/// \param[in] _engine Render engine
+/// \return Rendered image
+static std::vector<unsigned char> renderBox(RenderEngine *_engine)
+{
+  ScenePtr scene = _engine->CreateScene("scene");
+  EXPECT_NE(nullptr, scene);
+  if (!scene)
+    return {};
+  scene->SetAmbientLight(0.3, 0.3, 0.3);
+  VisualPtr root = scene->RootVisual();
+
+  CameraPtr camera = scene->CreateCamera();
+  camera->SetImageWidth(50);
+  camera->SetImageHeight(50);
+  root->AddChild(camera);
+
+  DirectionalLightPtr light = scene->CreateDirectionalLight();
+  light->SetDirection(1.0, 0.0, -1.0);
+  root->AddChild(light);
+
+  MaterialPtr red = scene->CreateMaterial();
+  red->SetDiffuse(1.0, 0.0, 0.0);
+  VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(3.0, 0.0, 0.0);
+  box->SetMaterial(red);
+  root->AddChild(box);
+
+  Image image = camera->CreateImage();
+  camera->Capture(image);
+  std::vector<unsigned char> data(image.Data<unsigned char>(),
+      image.Data<unsigned char>() + image.MemorySize());
+
+  scene->DestroyMaterial(red);
+  _engine->DestroyScene(scene);
+  return data;
+}
+
+/////////////////////////////////////////////////
+void HlmsCacheTest::HlmsCache(const std::string &_renderEngine)
+{
+  if (_renderEngine != "ogre2")
+  {
+    igndbg << "Hlms cache not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  // override and make sure not to look for resources in installed share dir
+  std::string projectSrcPath = PROJECT_SOURCE_PATH;
+  std::string env = "IGN_RENDERING_RESOURCE_PATH=" + projectSrcPath;
+  putenv(const_cast<char *>(env.c_str()));
+
+  std::string cachePath = common::joinPaths(std::string(PROJECT_BUILD_PATH),
+      "test", "hlms_cache");
+  common::removeAll(cachePath);
+
+  std::map<std::string, std::string> params;
+  params["hlmsCachePath"] = cachePath;
+
+  // first run generates the shaders and writes them to the cache when the
+  // engine is unloaded
+  RenderEngine *engine = rendering::engine(_renderEngine, params);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+  std::vector<unsigned char> image = renderBox(engine);
+  ASSERT_FALSE(image.empty());
+  rendering::unloadEngine(engine->Name());
+
+  unsigned int fileCount = cachedFileCount(cachePath);
+  EXPECT_GT(fileCount, 0u);
+
+  // second run loads the shaders from the cache and renders the same image
+  engine = rendering::engine(_renderEngine, params);
+  ASSERT_NE(nullptr, engine);
+  std::vector<unsigned char> cachedImage = renderBox(engine);
+  ASSERT_EQ(image.size(), cachedImage.size());
+  EXPECT_EQ(0, std::memcmp(image.data(), cachedImage.data(), image.size()));
+  rendering::unloadEngine(engine->Name());
+  EXPECT_EQ(fileCount, cachedFileCount(cachePath));
+
+  // Clean up
+  common::removeAll(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_P(HlmsCacheTest, HlmsCache)
+{
+  HlmsCache(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(HlmsCache, HlmsCacheTest,
+    RENDER_ENGINE_VALUES,
+    ignition::rendering::PrintToStringParam());
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -59,6 +59,9 @@ class LidarVisualTest: public testing::Test,
 
   // Test vertical measurements
   public: void LaserVertical(const std::string &_renderEngine);
+
+  // Test updating a multi ring point cloud
+  public: void PointCloud(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -563,6 +566,72 @@ void LidarVisualTest::LaserVertical(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void LidarVisualTest::PointCloud(const std::string &_renderEngine)
+{
+  if (_renderEngine == "optix")
+  {
+    igndbg << "LidarVisual not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+
+  // a 16 ring lidar where every other ray does not hit anything
+  const unsigned int hRayCount = 360u;
+  const unsigned int vRayCount = 16u;
+  const double maxRange = 10.0;
+  std::vector<double> pts;
+  for (unsigned int i = 0u; i < hRayCount * vRayCount; ++i)
+    pts.push_back(i % 2u ? ignition::math::INF_D : 1.0 + (i % 7u));
+
+  LidarVisualPtr lidarVis = scene->CreateLidarVisual();
+  lidarVis->SetMinRange(0.1);
+  lidarVis->SetMaxRange(maxRange);
+  lidarVis->SetMinHorizontalAngle(-IGN_PI);
+  lidarVis->SetMaxHorizontalAngle(IGN_PI);
+  lidarVis->SetMinVerticalAngle(-0.25);
+  lidarVis->SetMaxVerticalAngle(0.25);
+  lidarVis->SetHorizontalRayCount(hRayCount);
+  lidarVis->SetVerticalRayCount(vRayCount);
+  lidarVis->SetType(LidarVisualType::LVT_POINTS);
+  scene->RootVisual()->AddChild(lidarVis);
+
+  // update a few scans, hiding and showing the rays that do not hit
+  for (bool displayNonHitting : {true, false, false, true})
+  {
+    lidarVis->SetDisplayNonHitting(displayNonHitting);
+    lidarVis->SetPoints(pts);
+    lidarVis->Update();
+    EXPECT_EQ(hRayCount * vRayCount, lidarVis->PointCount());
+    EXPECT_EQ(pts, lidarVis->Points());
+  }
+
+  // switching to another type and back recreates the visuals
+  lidarVis->SetType(LidarVisualType::LVT_TRIANGLE_STRIPS);
+  lidarVis->SetPoints(pts);
+  lidarVis->Update();
+  lidarVis->SetType(LidarVisualType::LVT_POINTS);
+  lidarVis->SetOffset(ignition::math::Pose3d(0, 0, 1, 0, 0, 0.5));
+  lidarVis->SetPoints(pts);
+  lidarVis->Update();
+  EXPECT_EQ(pts, lidarVis->Points());
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(LidarVisualTest, Configure)
 {
@@ -581,6 +650,12 @@ TEST_P(LidarVisualTest, LaserVertical)
   LaserVertical(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(LidarVisualTest, PointCloud)
+{
+  PointCloud(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(LidarVisual, LidarVisualTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
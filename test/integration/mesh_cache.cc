@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/MeshManager.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Mesh.hh"
+#include "ignition/rendering/RenderEngine.hh"
+#include "ignition/rendering/RenderingIface.hh"
+#include "ignition/rendering/Scene.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+class MeshCacheTest: public testing::Test,
+                     public testing::WithParamInterface<const char *>
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    ignition::common::Console::SetVerbosity(4);
+  }
+
+  // Test that converted meshes are written to and read from the mesh cache
+  public: void MeshCache(const std::string &_renderEngine);
+};
+
+/////////////////////////////////////////////////
+/// \brief Count the mesh files in a mesh cache directory
+static unsigned int cachedMeshCount(const std::string &_path)
+{
+  unsigned int count = 0u;
+  for (common::DirIter file(_path); file != common::DirIter(); ++file)
+  {
+    std::string name = common::basename(*file);
+    if (name.size() > 5u && name.substr(name.size() - 5u) == ".mesh")
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+void MeshCacheTest::MeshCache(const std::string &_renderEngine)
+{
+  if (_renderEngine != "ogre2")
+  {
+    igndbg << "Mesh cache not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  std::string cachePath = common::joinPaths(std::string(PROJECT_BUILD_PATH),
+      "test", "mesh_cache");
+  common::removeAll(cachePath);
+  ASSERT_TRUE(common::createDirectories(cachePath));
+
+  // a two triangle quad, written to a file since only meshes loaded from
+  // files are cached
+  std::string meshFile = common::joinPaths(cachePath, "quad.obj");
+  {
+    std::ofstream out(meshFile);
+    out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        << "vn 0 0 1\n"
+        << "f 1//1 2//1 3//1\nf 1//1 3//1 4//1\n";
+  }
+  const common::Mesh *commonMesh =
+      common::MeshManager::Instance()->Load(meshFile);
+  ASSERT_NE(nullptr, commonMesh);
+
+  std::map<std::string, std::string> params;
+  params["meshCachePath"] = cachePath;
+
+  // first run converts the mesh and writes it to the cache
+  RenderEngine *engine = rendering::engine(_renderEngine, params);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  MeshDescriptor desc(commonMesh);
+  desc.meshName = meshFile;
+  MeshPtr mesh = scene->CreateMesh(desc);
+  ASSERT_NE(nullptr, mesh);
+  unsigned int subMeshCount = mesh->SubMeshCount();
+  EXPECT_GT(subMeshCount, 0u);
+  EXPECT_EQ(1u, cachedMeshCount(cachePath));
+
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+
+  // second run loads the mesh from the cache without adding entries
+  engine = rendering::engine(_renderEngine, params);
+  ASSERT_NE(nullptr, engine);
+  scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  mesh = scene->CreateMesh(desc);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(subMeshCount, mesh->SubMeshCount());
+  EXPECT_EQ(1u, cachedMeshCount(cachePath));
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+
+  // changing the mesh file adds a new entry, its content is part of the key
+  {
+    std::ofstream out(meshFile, std::ios::app);
+    out << "# changed\n";
+  }
+  engine = rendering::engine(_renderEngine, params);
+  ASSERT_NE(nullptr, engine);
+  scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  mesh = scene->CreateMesh(desc);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(subMeshCount, mesh->SubMeshCount());
+  EXPECT_EQ(2u, cachedMeshCount(cachePath));
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+  common::removeAll(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshCacheTest, MeshCache)
+{
+  MeshCache(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(MeshCache, MeshCacheTest,
+    RENDER_ENGINE_VALUES,
+    ignition::rendering::PrintToStringParam());
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
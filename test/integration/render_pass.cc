@@ -414,13 +414,6 @@ void RenderPassTest::Distortion(const std::string &_renderEngine)
     return;
   }
 
-  if (_renderEngine == "ogre2")
-  {
-    igndbg << "Distortion is currently not supported in OGRE2" << std::endl;
-    return;
-
-  }
-
   // add resources in build dir
   engine->AddResourcePath(
       common::joinPaths(std::string(PROJECT_BUILD_PATH), "src"));
@@ -17,11 +17,18 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/SubMesh.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 
 #include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/DepthCamera.hh"
+#include "ignition/rendering/RayQuery.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
@@ -45,6 +52,12 @@ class SceneTest: public testing::Test,
 
   // Test and verify camera tracking
   public: void VisualAt(const std::string &_renderEngine);
+
+  // Test rendering a batch of sensors in a single frame
+  public: void RenderSensors(const std::string &_renderEngine);
+
+  // Test batched ray queries using bounding volume hierarchies
+  public: void RayQueryBvh(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -226,6 +239,236 @@ void SceneTest::VisualAt(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void SceneTest::RenderSensors(const std::string &_renderEngine)
+{
+  if (_renderEngine == "optix")
+  {
+    igndbg << "Depth cameras not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  // create and populate scene
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+  scene->SetCameraPassCountPerGpuFlush(6u);
+
+  VisualPtr root = scene->RootVisual();
+
+  // create box visual in front of the cameras
+  VisualPtr box = scene->CreateVisual("box");
+  ASSERT_TRUE(box != nullptr);
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(2, 0, 0);
+  root->AddChild(box);
+
+  // create depth cameras at different distances from the box
+  const unsigned int cameraCount = 4u;
+  std::vector<CameraPtr> cameras;
+  std::vector<common::ConnectionPtr> connections;
+  std::vector<unsigned int> frameCount(cameraCount, 0u);
+  std::vector<float> midDepth(cameraCount, 0.0f);
+  for (unsigned int i = 0u; i < cameraCount; ++i)
+  {
+    DepthCameraPtr camera =
+        scene->CreateDepthCamera("depth_camera_" + std::to_string(i));
+    ASSERT_TRUE(camera != nullptr);
+    camera->SetLocalPosition(-0.5 * i, 0.0, 0.0);
+    camera->SetImageWidth(64);
+    camera->SetImageHeight(64);
+    camera->SetNearClipPlane(0.1);
+    camera->SetFarClipPlane(10.0);
+    camera->SetAspectRatio(1.0);
+    camera->SetHFOV(IGN_PI / 4);
+    camera->CreateDepthTexture();
+    root->AddChild(camera);
+
+    connections.push_back(camera->ConnectNewDepthFrame(
+        [&frameCount, &midDepth, i](const float *_depth, unsigned int _width,
+        unsigned int _height, unsigned int, const std::string &)
+        {
+          frameCount[i]++;
+          midDepth[i] = _depth[_height / 2u * _width + _width / 2u];
+        }));
+    cameras.push_back(camera);
+  }
+
+  // every sensor should receive exactly one frame per batch
+  for (unsigned int n = 1u; n <= 3u; ++n)
+  {
+    scene->RenderSensors(cameras);
+    for (unsigned int i = 0u; i < cameraCount; ++i)
+    {
+      EXPECT_EQ(n, frameCount[i]);
+      EXPECT_NEAR(1.5 + 0.5 * i, midDepth[i], 1e-3);
+    }
+  }
+
+  // Clean up
+  connections.clear();
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+/////////////////////////////////////////////////
+void SceneTest::RayQueryBvh(const std::string &_renderEngine)
+{
+  if (_renderEngine == "optix")
+  {
+    igndbg << "RayQuery not supported yet in rendering engine: "
+            << _renderEngine << std::endl;
+    return;
+  }
+
+  // create and populate scene
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+
+  VisualPtr root = scene->RootVisual();
+
+  // transformed box and sphere, same as in VisualAt
+  VisualPtr box = scene->CreateVisual("box");
+  ASSERT_TRUE(box != nullptr);
+  box->AddGeometry(scene->CreateBox());
+  box->SetOrigin(0.0, 0.5, 0.0);
+  box->SetLocalPosition(3, 0, 0);
+  box->SetLocalRotation(IGN_PI / 4, 0, IGN_PI / 3);
+  box->SetLocalScale(1, 2.5, 1);
+  root->AddChild(box);
+
+  VisualPtr sphere = scene->CreateVisual("sphere");
+  ASSERT_TRUE(sphere != nullptr);
+  sphere->AddGeometry(scene->CreateSphere());
+  sphere->SetOrigin(0.0, -0.5, 0.0);
+  sphere->SetLocalPosition(3, 0, 0);
+  sphere->SetLocalRotation(0, 0, 0);
+  sphere->SetLocalScale(1, 2.5, 1);
+  root->AddChild(sphere);
+
+  CameraPtr camera = scene->CreateCamera("camera");
+  ASSERT_TRUE(camera != nullptr);
+  camera->SetImageWidth(320);
+  camera->SetImageHeight(240);
+  root->AddChild(camera);
+
+  // render a frame so that all the transforms are up to date
+  camera->Update();
+
+  // a grid of rays from behind the camera, some of them missing everything
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  for (double y = -2.0; y <= 2.0; y += 0.1)
+  {
+    for (double z = -1.5; z <= 1.5; z += 0.25)
+    {
+      origins.push_back(math::Vector3d(-1, 0, 0));
+      directions.push_back(math::Vector3d(4, y, z));
+    }
+  }
+
+  RayQueryPtr rayQuery = scene->CreateRayQuery();
+  ASSERT_TRUE(rayQuery != nullptr);
+  EXPECT_EQ(RQM_DEFAULT, rayQuery->Mode());
+
+  // mismatched input
+  EXPECT_TRUE(rayQuery->ClosestPointsAlongRays(origins, {}).empty());
+
+  std::vector<RayQueryResult> expected =
+      rayQuery->ClosestPointsAlongRays(origins, directions);
+  ASSERT_EQ(origins.size(), expected.size());
+
+  rayQuery->SetMode(RQM_BVH);
+  EXPECT_EQ(RQM_BVH, rayQuery->Mode());
+  std::vector<RayQueryResult> actual =
+      rayQuery->ClosestPointsAlongRays(origins, directions);
+  ASSERT_EQ(origins.size(), actual.size());
+
+  unsigned int boxHits = 0u;
+  unsigned int sphereHits = 0u;
+  for (unsigned int i = 0u; i < origins.size(); ++i)
+  {
+    EXPECT_EQ(static_cast<bool>(expected[i]), static_cast<bool>(actual[i]))
+        << "dir: " << directions[i];
+    if (!expected[i] || !actual[i])
+      continue;
+
+    EXPECT_EQ(expected[i].objectId, actual[i].objectId);
+    EXPECT_NEAR(expected[i].distance, actual[i].distance, 1e-4);
+    EXPECT_TRUE(expected[i].point.Equal(actual[i].point, 1e-4));
+    if (actual[i].objectId == box->Id())
+      ++boxHits;
+    else if (actual[i].objectId == sphere->Id())
+      ++sphereHits;
+  }
+  EXPECT_GT(boxHits, 0u);
+  EXPECT_GT(sphereHits, 0u);
+
+  // single ray queries go through the same path
+  rayQuery->SetOrigin(math::Vector3d(-1, 0, 0));
+  rayQuery->SetDirection(math::Vector3d(4, 1.25, 0));
+  RayQueryResult result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_EQ(sphere->Id(), result.objectId);
+
+  // moving a visual is picked up by the next query
+  sphere->SetLocalPosition(3, 0, 10);
+  camera->Update();
+  result = rayQuery->ClosestPoint();
+  EXPECT_FALSE(result);
+
+  // the triangles of a mesh are still available to the query after the
+  // mesh it was created from is freed
+  {
+    std::unique_ptr<common::Mesh> quadMesh(new common::Mesh());
+    quadMesh->SetName("ray_query_bvh_quad");
+    common::SubMesh subMesh;
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    subMesh.AddVertex(0, -1, -1);
+    subMesh.AddVertex(0, 1, -1);
+    subMesh.AddVertex(0, 1, 1);
+    subMesh.AddVertex(0, -1, 1);
+    // both windings so that the quad can be hit from either side
+    for (unsigned int index : {0u, 1u, 2u, 0u, 2u, 3u, 0u, 2u, 1u, 0u, 3u, 2u})
+      subMesh.AddIndex(index);
+    quadMesh->AddSubMesh(subMesh);
+
+    VisualPtr quad = scene->CreateVisual("quad");
+    ASSERT_TRUE(quad != nullptr);
+    quad->AddGeometry(scene->CreateMesh(quadMesh.get()));
+    quad->SetLocalPosition(6, 0, -10);
+    root->AddChild(quad);
+  }
+  camera->Update();
+
+  rayQuery->SetOrigin(math::Vector3d(-1, 0, -10));
+  rayQuery->SetDirection(math::Vector3d(1, 0, 0));
+  result = rayQuery->ClosestPoint();
+  EXPECT_TRUE(result);
+  EXPECT_EQ(scene->VisualByName("quad")->Id(), result.objectId);
+  EXPECT_NEAR(7.0, result.distance, 1e-4);
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneTest, AddRemoveVisuals)
 {
@@ -238,6 +481,18 @@ TEST_P(SceneTest, VisualAt)
   VisualAt(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneTest, RenderSensors)
+{
+  RenderSensors(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneTest, RayQueryBvh)
+{
+  RayQueryBvh(GetParam());
+}
+
 // It doesn't suppot optix just yet
 INSTANTIATE_TEST_CASE_P(Scene, SceneTest,
     RENDER_ENGINE_VALUES,
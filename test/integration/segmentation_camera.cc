@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Event.hh>
@@ -74,6 +76,19 @@ void OnNewSegmentationFrame(const uint8_t *_data,
   g_mutex.unlock();
 }
 
+/// \brief Label id buffer
+std::vector<uint32_t> g_labelIds;
+
+//////////////////////////////////////////////////
+/// \brief callback to get the label id buffer
+void OnNewLabelIdFrame(const uint32_t *_data,
+                    unsigned int _width, unsigned int _height)
+{
+  g_mutex.lock();
+  g_labelIds.assign(_data, _data + _width * _height);
+  g_mutex.unlock();
+}
+
 //////////////////////////////////////////////////
 /// \brief Build the scene with 3 boxes besides each other
 /// the 2 outer boxes have the same label & the middle is different
@@ -175,9 +190,17 @@ void SegmentationCameraTest::SegmentationCameraBoxes(
           std::placeholders::_4, std::placeholders::_5));
   ASSERT_NE(nullptr, connection);
 
+  ignition::common::ConnectionPtr labelIdConnection =
+      camera->ConnectNewLabelIdFrame(
+          std::bind(OnNewLabelIdFrame,
+          std::placeholders::_1, std::placeholders::_2,
+          std::placeholders::_3));
+  ASSERT_NE(nullptr, labelIdConnection);
+
   // Update once to create image
   camera->Update();
   EXPECT_EQ(1, g_counter);
+  ASSERT_EQ(static_cast<size_t>(width * height), g_labelIds.size());
 
   // get the center of each box, the percentages locates the center
   math::Vector2d leftProj(width * 0.25, height * 0.5);
@@ -206,6 +229,12 @@ void SegmentationCameraTest::SegmentationCameraBoxes(
   int background = g_buffer[0];
   EXPECT_EQ(background, backgroundLabel);
 
+  // label ids match the label map
+  EXPECT_EQ(1u, g_labelIds[leftIndex / 3]);
+  EXPECT_EQ(2u, g_labelIds[middleIndex / 3]);
+  EXPECT_EQ(1u, g_labelIds[rightIndex / 3]);
+  EXPECT_EQ(static_cast<uint32_t>(backgroundLabel), g_labelIds[0]);
+
   // Instance/Panoptic test
   camera->SetSegmentationType(SegmentationType::ST_PANOPTIC);
 
@@ -237,6 +266,27 @@ void SegmentationCameraTest::SegmentationCameraBoxes(
   EXPECT_EQ(1, rightCount);
   EXPECT_EQ(2, leftCount);
 
+  // label ids are the composite ids
+  EXPECT_EQ((1u << 16) | 2u, g_labelIds[leftIndex / 3]);
+  EXPECT_EQ((2u << 16) | 1u, g_labelIds[middleIndex / 3]);
+  EXPECT_EQ((1u << 16) | 1u, g_labelIds[rightIndex / 3]);
+
+  // colored map, the label ids are looked up from the colors
+  camera->EnableColoredMap(true);
+  g_labelIds.clear();
+  camera->Update();
+  ASSERT_EQ(static_cast<size_t>(width * height), g_labelIds.size());
+  EXPECT_EQ((1u << 16) | 2u, g_labelIds[leftIndex / 3]);
+  EXPECT_EQ((2u << 16) | 1u, g_labelIds[middleIndex / 3]);
+  EXPECT_EQ((1u << 16) | 1u, g_labelIds[rightIndex / 3]);
+
+  camera->SetSegmentationType(SegmentationType::ST_SEMANTIC);
+  camera->Update();
+  EXPECT_EQ(1u, g_labelIds[leftIndex / 3]);
+  EXPECT_EQ(2u, g_labelIds[middleIndex / 3]);
+  EXPECT_EQ(1u, g_labelIds[rightIndex / 3]);
+  EXPECT_EQ(static_cast<uint32_t>(backgroundLabel), g_labelIds[0]);
+
   // Clean up
   engine->DestroyScene(scene);
   ignition::rendering::unloadEngine(engine->Name());
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Image.hh>
 
@@ -24,6 +26,7 @@
 
 #include "ignition/rendering/Camera.hh"
 #include "ignition/rendering/Image.hh"
+#include "ignition/rendering/Light.hh"
 #include "ignition/rendering/PixelFormat.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
@@ -37,6 +40,10 @@ class ShadowsTest: public testing::Test,
 {
   // Test and verify shadows are generated
   public: void Shadows(const std::string &_renderEngine);
+
+  // Test and verify shadows are still generated while shadow casting lights
+  // are added and removed
+  public: void ShadowCastingLights(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -201,12 +208,145 @@ void ShadowsTest::Shadows(const std::string &_renderEngine)
   rendering::unloadEngine(engine->Name());
 }
 
+/////////////////////////////////////////////////
+void ShadowsTest::ShadowCastingLights(const std::string &_renderEngine)
+{
+  // override and make sure not to look for resources in installed share dir
+  std::string projectSrcPath = PROJECT_SOURCE_PATH;
+  std::string env = "IGN_RENDERING_RESOURCE_PATH=" + projectSrcPath;
+  putenv(const_cast<char *>(env.c_str()));
+
+  RenderEngine *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_TRUE(scene != nullptr);
+  scene->SetAmbientLight(0.3, 0.3, 0.3);
+
+  VisualPtr root = scene->RootVisual();
+
+  // downward looking camera
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_TRUE(camera != nullptr);
+  camera->SetImageWidth(10);
+  camera->SetImageHeight(10);
+  camera->SetLocalRotation(0, 1.57, 0);
+  root->AddChild(camera);
+
+  DirectionalLightPtr light = scene->CreateDirectionalLight();
+  light->SetDirection(0.0, 0.0, -1);
+  light->SetDiffuseColor(0.5, 0.5, 0.5);
+  light->SetSpecularColor(0.5, 0.5, 0.5);
+  root->AddChild(light);
+
+  MaterialPtr white = scene->CreateMaterial();
+  white->SetAmbient(1.0, 1.0, 1.0);
+  white->SetDiffuse(1.0, 1.0, 1.0);
+  white->SetSpecular(1.0, 1.0, 1.0);
+  white->SetCastShadows(true);
+
+  // box that casts shadows on the left side of the image
+  VisualPtr boxTop = scene->CreateVisual();
+  boxTop->AddGeometry(scene->CreateBox());
+  boxTop->SetLocalPosition(0.0, 0.5, 0.55);
+  boxTop->SetMaterial(white, false);
+  root->AddChild(boxTop);
+
+  MaterialPtr green = scene->CreateMaterial();
+  green->SetAmbient(0.0, 0.5, 0.0);
+  green->SetDiffuse(0.0, 0.7, 0.0);
+  green->SetSpecular(0.5, 0.5, 0.5);
+
+  VisualPtr boxBottom = scene->CreateVisual();
+  boxBottom->AddGeometry(scene->CreateBox());
+  boxBottom->SetLocalPosition(0.0, 0.0, -1.0);
+  boxBottom->SetMaterial(green);
+  root->AddChild(boxBottom);
+
+  Image image = camera->CreateImage();
+  unsigned int height = camera->ImageHeight();
+  unsigned int width = camera->ImageWidth();
+  unsigned int bpp = PixelUtil::BytesPerPixel(camera->ImageFormat());
+  unsigned int step = width * bpp;
+
+  // capture an image and verify the directional light shadow is there
+  auto verifyShadow = [&]()
+  {
+    unsigned int shaded = 0;
+    unsigned int unshaded = 0;
+    camera->Capture(image);
+    unsigned char *data = image.Data<unsigned char>();
+    for (unsigned int i = 0; i < height; ++i)
+    {
+      for (unsigned int j = 0; j < step; j += bpp)
+      {
+        unsigned int idx = i * step + j;
+        unsigned int sum = data[idx] + data[idx + 1] + data[idx + 2];
+        if (j < step / 2)
+          shaded += sum;
+        else
+          unshaded += sum;
+      }
+    }
+    // Test currently fails on macOS
+#ifndef __APPLE__
+    EXPECT_LT(shaded, unshaded);
+#endif
+  };
+
+  verifyShadow();
+
+  // add shadow casting point lights far away from the boxes, one by one
+  std::vector<PointLightPtr> pointLights;
+  for (unsigned int i = 0; i < 5u; ++i)
+  {
+    PointLightPtr pointLight = scene->CreatePointLight();
+    pointLight->SetLocalPosition(100.0 + i, 100.0, 100.0);
+    pointLight->SetAttenuationRange(1.0);
+    pointLight->SetCastShadows(true);
+    root->AddChild(pointLight);
+    pointLights.push_back(pointLight);
+    verifyShadow();
+  }
+
+  // stop casting shadows from the point lights, then remove them
+  for (auto &pointLight : pointLights)
+  {
+    pointLight->SetCastShadows(false);
+    verifyShadow();
+  }
+  for (auto &pointLight : pointLights)
+  {
+    scene->DestroyLight(pointLight);
+    verifyShadow();
+  }
+
+  // Clean up materials
+  scene->DestroyMaterial(white);
+  scene->DestroyMaterial(green);
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ShadowsTest, Shadows)
 {
   Shadows(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ShadowsTest, ShadowCastingLights)
+{
+  ShadowCastingLights(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(Shadows, ShadowsTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());
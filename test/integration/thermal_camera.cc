@@ -260,6 +260,32 @@ void ThermalCameraTest::ThermalCameraBoxes(
       }
     }
 
+    // move the box back into view and change its temperature. Verify the
+    // new temperature is picked up by the thermal camera
+    if (!_useHeatSignature)
+    {
+      box->SetLocalPosition(boxPosition);
+      thermalCamera->Update();
+      EXPECT_NEAR(boxTemp, thermalData[mid] * linearResolution,
+          boxTempRange);
+
+      float newBoxTemp = 330.0f;
+      box->SetUserData("temperature", newBoxTemp);
+      thermalCamera->Update();
+      EXPECT_NEAR(newBoxTemp, thermalData[mid] * linearResolution,
+          boxTempRange);
+      EXPECT_NEAR(ambientTemp, thermalData[left] * linearResolution,
+          ambientTempRange);
+
+      // replace the box geometry and verify the new geometry uses the
+      // box temperature
+      box->RemoveGeometries();
+      box->AddGeometry(scene->CreateBox());
+      thermalCamera->Update();
+      EXPECT_NEAR(newBoxTemp, thermalData[mid] * linearResolution,
+          boxTempRange);
+    }
+
     // Clean up
     connection.reset();
     delete [] thermalData;
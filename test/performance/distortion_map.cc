@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/DistortionMap.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+/// \brief Reference implementation of the map built by the ogre distortion
+/// pass: a single threaded loop over math::Vector2d, without the hole
+/// filling pass.
+static void referenceMap(unsigned int _size, double _focalLength,
+    const math::Vector2d &_center, double _k1, double _k2, double _k3,
+    std::vector<math::Vector2d> &_map)
+{
+  _map.assign(_size * _size, math::Vector2d(-1, -1));
+  const double step = 1.0 / _size;
+  const math::Vector2d halfTexel(0.5 * step, 0.5 * step);
+  const math::Vector2d centerCoordinates = _center * _size;
+  for (unsigned int row = 0u; row < _size; ++row)
+  {
+    for (unsigned int col = 0u; col < _size; ++col)
+    {
+      math::Vector2d location(col * step, row * step);
+      math::Vector2d distorted = DistortionMap::Distort(location, _center,
+          _k1, _k2, _k3, 0, 0, _size, _focalLength);
+      double c = std::round(distorted.X() * _size);
+      double r = std::round(distorted.Y() * _size);
+      if (c < 0 || r < 0 || c >= _size || r >= _size)
+        continue;
+      math::Vector2d &v = _map[static_cast<unsigned int>(r) * _size +
+          static_cast<unsigned int>(c)];
+      if (v != math::Vector2d(-1, -1) &&
+          math::Vector2d(col, row).Distance(centerCoordinates) >=
+          (v * _size).Distance(centerCoordinates))
+      {
+        continue;
+      }
+      v = location + halfTexel;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DistortionMapPerformanceTest, Build)
+{
+  // a 1280 x 1280 map for a 90 degree fisheye like lens
+  const unsigned int size = 1280u;
+  const double focalLength = size / (2 * std::tan(IGN_PI / 4));
+  const math::Vector2d center(0.5, 0.5);
+  const double k1 = -0.25;
+  const double k2 = 0.05;
+  const double k3 = -0.002;
+
+  std::vector<math::Vector2d> reference;
+  auto start = std::chrono::steady_clock::now();
+  referenceMap(size, focalLength, center, k1, k2, k3, reference);
+  auto end = std::chrono::steady_clock::now();
+  double referenceTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  start = std::chrono::steady_clock::now();
+  DistortionMap map(size, focalLength, center, k1, k2, k3, 0, 0);
+  end = std::chrono::steady_clock::now();
+  double buildTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  // every mapped pixel matches the reference
+  for (unsigned int i = 0u; i < reference.size(); ++i)
+  {
+    if (reference[i].X() < -0.5)
+      continue;
+    ASSERT_NEAR(reference[i].X(), map.Data()[i * 2u], 1e-6) << i;
+    ASSERT_NEAR(reference[i].Y(), map.Data()[i * 2u + 1u], 1e-6) << i;
+  }
+
+  // a fleet of identical cameras shares one map
+  const unsigned int cameraCount = 24u;
+  std::vector<std::shared_ptr<const DistortionMap>> maps;
+  unsigned int builds = DistortionMap::BuildCount();
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0u; i < cameraCount; ++i)
+  {
+    maps.push_back(DistortionMap::Shared(size, focalLength, center, k1, k2,
+        k3, 0, 0));
+  }
+  end = std::chrono::steady_clock::now();
+  double sharedTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  for (const auto &m : maps)
+    EXPECT_EQ(maps.front(), m);
+
+  igndbg << size << " x " << size << " distortion map: "
+         << "reference[" << referenceTime << " ms] "
+         << "DistortionMap[" << buildTime << " ms] "
+         << cameraCount << " cameras sharing a map[" << sharedTime << " ms]"
+         << std::endl;
+
+  // the map is built once for all the cameras
+  EXPECT_EQ(builds + 1u, DistortionMap::BuildCount());
+}
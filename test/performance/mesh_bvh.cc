@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/math/Helpers.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/Bvh.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/////////////////////////////////////////////////
+/// \brief Reference implementation of the triangle loop done by the ray
+/// queries before MeshBvh was introduced: test every triangle of the mesh.
+bool referenceIntersect(const std::vector<math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices, const math::Vector3d &_origin,
+    const math::Vector3d &_dir, double &_distance)
+{
+  bool hit = false;
+  for (unsigned int i = 0u; i + 2u < _indices.size(); i += 3u)
+  {
+    const math::Vector3d &a = _vertices[_indices[i]];
+    math::Vector3d e1 = _vertices[_indices[i + 1u]] - a;
+    math::Vector3d e2 = _vertices[_indices[i + 2u]] - a;
+    math::Vector3d p = _dir.Cross(e2);
+    double det = e1.Dot(p);
+    if (det <= 0.0)
+      continue;
+    math::Vector3d s = _origin - a;
+    double u = s.Dot(p) / det;
+    if (u < 0.0 || u > 1.0)
+      continue;
+    math::Vector3d q = s.Cross(e1);
+    double v = _dir.Dot(q) / det;
+    if (v < 0.0 || u + v > 1.0)
+      continue;
+    double t = e2.Dot(q) / det;
+    if (t >= 0.0 && (!hit || t < _distance))
+    {
+      _distance = t;
+      hit = true;
+    }
+  }
+  return hit;
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBvhPerformanceTest, SphereRays)
+{
+  // a unit UV sphere with 2 * 128 * 128 triangles
+  const unsigned int rings = 128u;
+  const unsigned int segments = 128u;
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0u; i <= rings; ++i)
+  {
+    double theta = IGN_PI * i / rings;
+    for (unsigned int j = 0u; j <= segments; ++j)
+    {
+      double phi = 2.0 * IGN_PI * j / segments;
+      vertices.push_back(math::Vector3d(std::sin(theta) * std::cos(phi),
+          std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  for (unsigned int i = 0u; i < rings; ++i)
+  {
+    for (unsigned int j = 0u; j < segments; ++j)
+    {
+      unsigned int a = i * (segments + 1u) + j;
+      unsigned int b = a + segments + 1u;
+      indices.insert(indices.end(), {a, b, a + 1u, a + 1u, b, b + 1u});
+    }
+  }
+
+  // a grasp planner like fan of rays around the sphere
+  const unsigned int rayCount = 2000u;
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> directions;
+  for (unsigned int i = 0u; i < rayCount; ++i)
+  {
+    double angle = 2.0 * IGN_PI * i / rayCount;
+    math::Vector3d origin(3.0 * std::cos(angle), 3.0 * std::sin(angle),
+        std::sin(7.0 * angle));
+    origins.push_back(origin);
+    directions.push_back(math::Vector3d(0, 0, 0.5 * std::cos(5.0 * angle)) -
+        origin);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  MeshBvh bvh(vertices, indices);
+  auto end = std::chrono::steady_clock::now();
+  double buildTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  std::vector<double> expected(rayCount, -1.0);
+  std::vector<bool> expectedHits(rayCount, false);
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0u; i < rayCount; ++i)
+  {
+    expectedHits[i] = referenceIntersect(vertices, indices, origins[i],
+        directions[i], expected[i]);
+  }
+  end = std::chrono::steady_clock::now();
+  double referenceTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  std::vector<double> actual(rayCount, -1.0);
+  std::vector<bool> actualHits(rayCount, false);
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0u; i < rayCount; ++i)
+    actualHits[i] = bvh.Intersect(origins[i], directions[i], actual[i]);
+  end = std::chrono::steady_clock::now();
+  double bvhTime =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  // the bvh hits the same triangles as the brute force loop. Every ray
+  // aims inside the sphere so it hits.
+  for (unsigned int i = 0u; i < rayCount; ++i)
+  {
+    EXPECT_TRUE(expectedHits[i]) << i;
+    EXPECT_EQ(expectedHits[i], actualHits[i]) << i;
+    EXPECT_NEAR(expected[i], actual[i], 1e-9) << i;
+  }
+
+  igndbg << rayCount << " rays against " << bvh.TriangleCount()
+         << " triangles: reference[" << referenceTime << " ms] "
+         << "MeshBvh build[" << buildTime << " ms] "
+         << "MeshBvh[" << bvhTime << " ms]" << std::endl;
+}
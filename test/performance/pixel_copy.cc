@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/rendering/PixelCopy.hh"
+
+using namespace ignition;
+using namespace rendering;
+
+/// \brief Number of times each copy is repeated when timing
+static const unsigned int kIterations = 200u;
+
+/////////////////////////////////////////////////
+/// \brief Reference implementation of the readback copy used by GpuRays
+/// before copyRgbaToRgb was introduced: de-pad into an RGBA buffer and then
+/// strip the alpha channel with a scalar loop.
+void referenceRgbaToRgb(const float *_src, size_t _srcRowBytes,
+    float *_rgbaBuffer, float *_dst, unsigned int _width,
+    unsigned int _height)
+{
+  for (unsigned int i = 0; i < _height; ++i)
+  {
+    unsigned int rawDataRowIdx = i * _srcRowBytes / sizeof(float);
+    unsigned int rowIdx = i * _width * 4u;
+    memcpy(&_rgbaBuffer[rowIdx], &_src[rawDataRowIdx],
+        _width * 4u * sizeof(float));
+  }
+
+  for (unsigned int row = 0; row < _height; ++row)
+  {
+    for (unsigned int column = 0; column < _width; ++column)
+    {
+      unsigned int idx = (row * _width * 3u) + column * 3u;
+      unsigned int rawIdx = (row * _width * 4u) + column * 4u;
+      _dst[idx] = _rgbaBuffer[rawIdx];
+      _dst[idx + 1] = _rgbaBuffer[rawIdx + 1];
+      _dst[idx + 2] = _rgbaBuffer[rawIdx + 2];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Time how long it takes to run a function kIterations times
+/// \param[in] _func Function to run
+/// \return Average time in microseconds
+template <typename F>
+double timeIt(F _func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0u; i < kIterations; ++i)
+    _func();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      kIterations;
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyPerformanceTest, RgbaToRgb)
+{
+  // a 2048 x 128 lidar scan with padded texture rows
+  const unsigned int width = 2048u;
+  const unsigned int height = 128u;
+  const size_t srcRowBytes = (width + 64u) * 4u * sizeof(float);
+
+  std::vector<float> src(srcRowBytes / sizeof(float) * height);
+  for (size_t i = 0u; i < src.size(); ++i)
+    src[i] = static_cast<float>(i);
+
+  std::vector<float> rgbaBuffer(width * height * 4u);
+  std::vector<float> expected(width * height * 3u);
+  std::vector<float> actual(width * height * 3u);
+
+  double referenceTime = timeIt([&]()
+  {
+    referenceRgbaToRgb(src.data(), srcRowBytes, rgbaBuffer.data(),
+        expected.data(), width, height);
+  });
+
+  double fusedTime = timeIt([&]()
+  {
+    copyRgbaToRgb(src.data(), srcRowBytes, actual.data(), width, height);
+  });
+
+  EXPECT_EQ(expected, actual);
+
+  igndbg << "RGBA to RGB " << width << "x" << height << ": "
+         << "reference[" << referenceTime << " us] "
+         << "copyRgbaToRgb[" << fusedTime << " us]" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyPerformanceTest, Channel)
+{
+  // a 1280 x 720 depth camera frame
+  const unsigned int width = 1280u;
+  const unsigned int height = 720u;
+  const size_t srcRowBytes = width * 4u * sizeof(float);
+
+  std::vector<float> src(width * height * 4u);
+  for (size_t i = 0u; i < src.size(); ++i)
+    src[i] = static_cast<float>(i);
+
+  std::vector<float> expected(width * height);
+  std::vector<float> actual(width * height);
+
+  double referenceTime = timeIt([&]()
+  {
+    for (unsigned int i = 0; i < height; ++i)
+    {
+      unsigned int step = i * width * 4u;
+      for (unsigned int j = 0; j < width; ++j)
+        expected[i * width + j] = src[step + j * 4u];
+    }
+  });
+
+  double channelTime = timeIt([&]()
+  {
+    copyChannel(src.data(), srcRowBytes, 4u, 0u, actual.data(), width,
+        height);
+  });
+
+  EXPECT_EQ(expected, actual);
+
+  igndbg << "Channel extraction " << width << "x" << height << ": "
+         << "reference[" << referenceTime << " us] "
+         << "copyChannel[" << channelTime << " us]" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(PixelCopyPerformanceTest, Rgba8ToRgb8)
+{
+  // a 1920 x 1080 segmentation camera frame with padded texture rows
+  const unsigned int width = 1920u;
+  const unsigned int height = 1080u;
+  const size_t srcRowBytes = (width + 64u) * 4u;
+
+  std::vector<uint8_t> src(srcRowBytes * height);
+  for (size_t i = 0u; i < src.size(); ++i)
+    src[i] = static_cast<uint8_t>(i * 7u);
+
+  std::vector<uint8_t> expected(width * height * 3u);
+  std::vector<uint8_t> actual(width * height * 3u);
+
+  // per pixel loop used by the segmentation camera before copyRgba8ToRgb8
+  double referenceTime = timeIt([&]()
+  {
+    for (unsigned int row = 0; row < height; ++row)
+    {
+      unsigned int rawDataRowIdx = row * srcRowBytes;
+      for (unsigned int column = 0; column < width; ++column)
+      {
+        unsigned int idx = (row * width * 3u) + column * 3u;
+        unsigned int rawIdx = rawDataRowIdx + column * 4u;
+        expected[idx] = src[rawIdx];
+        expected[idx + 1] = src[rawIdx + 1];
+        expected[idx + 2] = src[rawIdx + 2];
+      }
+    }
+  });
+
+  double packTime = timeIt([&]()
+  {
+    copyRgba8ToRgb8(src.data(), srcRowBytes, actual.data(), width, height);
+  });
+
+  EXPECT_EQ(expected, actual);
+
+  std::vector<uint32_t> ids(width * height);
+  double idTime = timeIt([&]()
+  {
+    copyRgba8ToUint32(src.data(), srcRowBytes, 0x00FFFFFFu, ids.data(),
+        width, height);
+  });
+
+  // the ids are the rgb values of each pixel, without alpha
+  for (size_t i = 0u; i < ids.size(); ++i)
+  {
+    uint32_t id = expected[i * 3u] | (expected[i * 3u + 1u] << 8u) |
+        (expected[i * 3u + 2u] << 16u);
+    ASSERT_EQ(id, ids[i]) << i;
+  }
+
+  igndbg << "RGBA8 to RGB8 " << width << "x" << height << ": "
+         << "reference[" << referenceTime << " us] "
+         << "copyRgba8ToRgb8[" << packTime << " us] "
+         << "copyRgba8ToUint32[" << idTime << " us]" << std::endl;
+}
@@ -22,10 +22,17 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <string>
+#include <vector>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 
+#include "ignition/rendering/Camera.hh"
+#include "ignition/rendering/Material.hh"
 #include "ignition/rendering/RenderEngine.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
@@ -44,6 +51,13 @@ class SceneFactoryTest: public testing::Test,
 
   /// \brief Test creating and destroying visuals
   public: void VisualMemoryLeak(const std::string &_renderEngine);
+
+  /// \brief Test destroying many materials that share textures
+  public: void TexturedMaterialDestroy(const std::string &_renderEngine);
+
+  /// \brief Test destroying many materials that each use their own texture
+  public: void DistinctTexturedMaterialDestroy(
+              const std::string &_renderEngine);
 };
 
 
@@ -178,6 +192,74 @@ void SceneFactoryTest::VisualMemoryLeak(const std::string &_renderEngine)
   checkMemLeak(_renderEngine, function);
 }
 
+/////////////////////////////////////////////////
+void SceneFactoryTest::TexturedMaterialDestroy(
+    const std::string &_renderEngine)
+{
+  auto engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine << "' is not supported" << std::endl;
+    return;
+  }
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+
+  const std::string mediaPath = common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "media", "materials",
+      "textures");
+  const std::string texture = common::joinPaths(mediaPath, "texture.png");
+  const std::string normalMap =
+      common::joinPaths(mediaPath, "flat_normal.png");
+
+  // materials sharing the same textures, as loaded by meshes of the same
+  // model spawned many times
+  const unsigned int numMaterials = 2000;
+  std::vector<MaterialPtr> materials;
+  for (unsigned int i = 0; i < numMaterials; ++i)
+  {
+    MaterialPtr mat = scene->CreateMaterial();
+    mat->SetTexture(texture);
+    mat->SetNormalMap(normalMap);
+    materials.push_back(mat);
+  }
+
+  // report how long destroying each half takes, which should not depend on
+  // the number of materials left
+  auto destroyMaterials = [&](unsigned int _begin, unsigned int _end)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = _begin; i < _end; ++i)
+      scene->DestroyMaterial(materials[i]);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  const unsigned int half = numMaterials / 2u;
+  double firstHalfMs = destroyMaterials(1u, half);
+  double secondHalfMs = destroyMaterials(half, numMaterials);
+  materials.resize(1u);
+
+  igndbg << "Destroyed " << numMaterials - 1u << " textured materials: "
+         << "first half[" << firstHalfMs << " ms] "
+         << "second half[" << secondHalfMs << " ms]" << std::endl;
+
+  // the textures are still used by the remaining material
+  EXPECT_EQ(texture, materials[0]->Texture());
+  EXPECT_EQ(normalMap, materials[0]->NormalMap());
+
+  // the textures can be set again once all users are gone
+  scene->DestroyMaterial(materials[0]);
+  MaterialPtr mat = scene->CreateMaterial();
+  mat->SetTexture(texture);
+  EXPECT_EQ(texture, mat->Texture());
+  scene->DestroyMaterial(mat);
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneFactoryTest, MaterialMemoryLeak)
 {
@@ -190,6 +272,93 @@ TEST_P(SceneFactoryTest, VisualMemoryLeak)
   VisualMemoryLeak(GetParam());
 }
 
+/////////////////////////////////////////////////
+void SceneFactoryTest::DistinctTexturedMaterialDestroy(
+    const std::string &_renderEngine)
+{
+  auto engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine << "' is not supported" << std::endl;
+    return;
+  }
+
+  auto scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  CameraPtr camera = scene->CreateCamera();
+  ASSERT_NE(nullptr, camera);
+  scene->RootVisual()->AddChild(camera);
+
+  // one texture file per material, as loaded by many different models
+  const std::string texture = common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "media", "materials",
+      "textures", "texture.png");
+  const std::string texturePath = common::joinPaths(
+      std::string(PROJECT_BUILD_PATH), "test", "distinct_textures");
+  common::removeAll(texturePath);
+  ASSERT_TRUE(common::createDirectories(texturePath));
+
+  const unsigned int numMaterials = 500;
+  std::vector<std::string> textures;
+  std::vector<MaterialPtr> materials;
+  for (unsigned int i = 0; i < numMaterials; ++i)
+  {
+    textures.push_back(common::joinPaths(texturePath,
+        "texture_" + std::to_string(i) + ".png"));
+    ASSERT_TRUE(common::copyFile(texture, textures.back()));
+
+    MaterialPtr mat = scene->CreateMaterial();
+    mat->SetTexture(textures.back());
+    materials.push_back(mat);
+  }
+
+  // each texture is released as its last material is destroyed, and the
+  // unused textures are unloaded in one batch at the start of the frame
+  auto start = std::chrono::steady_clock::now();
+  for (auto &mat : materials)
+    scene->DestroyMaterial(mat);
+  auto end = std::chrono::steady_clock::now();
+  double destroyMs =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  materials.clear();
+
+  start = std::chrono::steady_clock::now();
+  camera->Update();
+  end = std::chrono::steady_clock::now();
+  double frameMs =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  igndbg << "Destroyed " << numMaterials << " materials with distinct "
+         << "textures[" << destroyMs << " ms] first frame after[" << frameMs
+         << " ms]" << std::endl;
+
+  // the unloaded textures can be used again
+  for (unsigned int i = 0; i < numMaterials; i += 100u)
+  {
+    MaterialPtr mat = scene->CreateMaterial();
+    mat->SetTexture(textures[i]);
+    EXPECT_EQ(textures[i], mat->Texture());
+    scene->DestroyMaterial(mat);
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+  common::removeAll(texturePath);
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneFactoryTest, TexturedMaterialDestroy)
+{
+  TexturedMaterialDestroy(GetParam());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneFactoryTest, DistinctTexturedMaterialDestroy)
+{
+  DistinctTexturedMaterialDestroy(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(SceneFactory, SceneFactoryTest,
     RENDER_ENGINE_VALUES,
     ignition::rendering::PrintToStringParam());